@@ -0,0 +1,52 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Global allocator with heap usage accounting
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// library includes
+#include <apps/benchmark/core/memory.h>
+// std includes
+#include <cstdlib>
+#include <new>
+
+// Replaces global allocator of the whole binary, so it's linked only into benchmark tools
+
+void* operator new(std::size_t size)
+{
+  Benchmark::RegisterAllocation(size);
+  if (void* res = std::malloc(size ? size : 1))
+  {
+    return res;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
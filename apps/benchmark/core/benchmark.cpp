@@ -11,11 +11,17 @@
 // local includes
 #include "benchmark.h"
 #include "ay.h"
+#include "fm.h"
+#include "memory.h"
 #include "mixer.h"
+#include "saa.h"
+#include "track_model.h"
 #include "z80.h"
 // common includes
 #include <contract.h>
 #include <make_ptr.h>
+// library includes
+#include <time/timer.h>
 // boost includes
 #include <boost/format.hpp>
 
@@ -73,6 +79,82 @@ namespace Benchmark
     }
   }  // namespace AY
 
+  namespace TFM
+  {
+    class PerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      std::string Category() const override
+      {
+        return "FM chip emulation";
+      }
+
+      std::string Name() const override
+      {
+        return "TurboFM";
+      }
+
+      double Execute() const override
+      {
+        const Devices::TFM::Chip::Ptr dev = CreateDevice(3500000, SOUND_FREQ);
+        return Test(*dev, TEST_DURATION, FRAME_DURATION);
+      }
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      visitor.OnPerformanceTest(PerformanceTest());
+    }
+  }  // namespace TFM
+
+  namespace SAA
+  {
+    class PerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      explicit PerformanceTest(Devices::SAA::InterpolationType interpolate)
+        : Interpolate(interpolate)
+      {}
+
+      std::string Category() const override
+      {
+        return "SAA chip emulation";
+      }
+
+      std::string Name() const override
+      {
+        switch (Interpolate)
+        {
+        case Devices::SAA::INTERPOLATION_NONE:
+          return "No interpolation";
+        case Devices::SAA::INTERPOLATION_LQ:
+          return "LQ interpolation";
+        case Devices::SAA::INTERPOLATION_HQ:
+          return "HQ interpolation";
+        default:
+          Require(false);
+          return "Invalid interpolation";
+        }
+      }
+
+      double Execute() const override
+      {
+        const Devices::SAA::Chip::Ptr dev = CreateDevice(8000000, SOUND_FREQ, Interpolate);
+        return Test(*dev, TEST_DURATION, FRAME_DURATION);
+      }
+
+    private:
+      const Devices::SAA::InterpolationType Interpolate;
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      visitor.OnPerformanceTest(PerformanceTest(Devices::SAA::INTERPOLATION_NONE));
+      visitor.OnPerformanceTest(PerformanceTest(Devices::SAA::INTERPOLATION_LQ));
+      visitor.OnPerformanceTest(PerformanceTest(Devices::SAA::INTERPOLATION_HQ));
+    }
+  }  // namespace SAA
+
   namespace Z80
   {
     class MemoryPerformanceTest : public Benchmark::PerformanceTest
@@ -203,10 +285,112 @@ namespace Benchmark
     }
   }  // namespace Mixer
 
+  namespace TrackModel
+  {
+    const uint_t TRACKS_COUNT = 1000;
+    const uint_t PASSES_COUNT = 10000;
+
+    class BuildingPerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      explicit BuildingPerformanceTest(uint_t channels)
+        : Channels(channels)
+      {}
+
+      std::string Category() const override
+      {
+        return "Track model";
+      }
+
+      std::string Name() const override
+      {
+        return (boost::format("%u-channels building") % Channels).str();
+      }
+
+      double Execute() const override
+      {
+        return TestBuilding(Channels, TRACKS_COUNT);
+      }
+
+    private:
+      const uint_t Channels;
+    };
+
+    class TraversalPerformanceTest : public Benchmark::PerformanceTest
+    {
+    public:
+      explicit TraversalPerformanceTest(uint_t channels)
+        : Channels(channels)
+      {}
+
+      std::string Category() const override
+      {
+        return "Track model";
+      }
+
+      std::string Name() const override
+      {
+        return (boost::format("%u-channels traversal") % Channels).str();
+      }
+
+      double Execute() const override
+      {
+        return TestTraversal(Channels, PASSES_COUNT);
+      }
+
+    private:
+      const uint_t Channels;
+    };
+
+    void ForAllTests(TestsVisitor& visitor)
+    {
+      for (uint_t chan : {3, 6})
+      {
+        visitor.OnPerformanceTest(BuildingPerformanceTest(chan));
+        visitor.OnPerformanceTest(TraversalPerformanceTest(chan));
+      }
+    }
+  }  // namespace TrackModel
+
   void ForAllTests(TestsVisitor& visitor)
   {
     AY::ForAllTests(visitor);
+    TFM::ForAllTests(visitor);
+    SAA::ForAllTests(visitor);
     Z80::ForAllTests(visitor);
     Mixer::ForAllTests(visitor);
+    TrackModel::ForAllTests(visitor);
+  }
+
+  Result Run(const PerformanceTest& test, const RunParameters& params)
+  {
+    for (unsigned run = 0; run != params.Warmup; ++run)
+    {
+      test.Execute();
+    }
+    std::vector<double> speeds;
+    speeds.reserve(params.Runs);
+    double emulatedSeconds = 0;
+    const AllocationsCounter counter;
+    for (unsigned run = 0; run != params.Runs; ++run)
+    {
+      const Time::Timer timer;
+      const auto speed = test.Execute();
+      const auto elapsed = timer.Elapsed<Time::Microsecond>().Get();
+      speeds.push_back(speed);
+      // performance index is the ratio of emulated time to spent time
+      emulatedSeconds += speed * elapsed / Time::Microseconds::PER_SECOND;
+    }
+    const auto usage = counter.Get();
+    Result res;
+    res.Category = test.Category();
+    res.Name = test.Name();
+    res.Speed = Statistics(std::move(speeds));
+    if (emulatedSeconds > 0)
+    {
+      res.AllocationsPerSecond = usage.Allocations / emulatedSeconds;
+      res.BytesPerSecond = usage.Bytes / emulatedSeconds;
+    }
+    return res;
   }
 }  // namespace Benchmark
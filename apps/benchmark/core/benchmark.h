@@ -13,6 +13,8 @@
 
 #pragma once
 
+// local includes
+#include "report.h"
 // std includes
 #include <string>
 
@@ -38,4 +40,13 @@ namespace Benchmark
   };
 
   void ForAllTests(TestsVisitor& visitor);
+
+  struct RunParameters
+  {
+    //! Runs to stabilize caches and frequency scaling, not accounted in result
+    unsigned Warmup = 1;
+    unsigned Runs = 3;
+  };
+
+  Result Run(const PerformanceTest& test, const RunParameters& params);
 }  // namespace Benchmark
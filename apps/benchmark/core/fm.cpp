@@ -0,0 +1,116 @@
+/**
+ *
+ * @file
+ *
+ * @brief  FM test implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "fm.h"
+// common includes
+#include <make_ptr.h>
+// library includes
+#include <time/timer.h>
+
+namespace
+{
+  class FMParameters : public Devices::FM::ChipParameters
+  {
+  public:
+    FMParameters(uint64_t clockFreq, uint_t soundFreq)
+      : Clock(clockFreq)
+      , Sound(soundFreq)
+    {}
+
+    uint_t Version() const override
+    {
+      return 1;
+    }
+
+    uint64_t ClockFreq() const override
+    {
+      return Clock;
+    }
+
+    uint_t SoundFreq() const override
+    {
+      return Sound;
+    }
+
+  private:
+    const uint64_t Clock;
+    const uint_t Sound;
+  };
+
+  void SetupVoice(uint_t chip, uint_t chan, Devices::TFM::Registers& regs)
+  {
+    const uint_t voice = chip * Devices::FM::VOICES + chan;
+    for (uint_t op = 0; op != 4; ++op)
+    {
+      const uint_t base = chan + op * 4;
+      regs.emplace_back(chip, 0x30 + base, op + 1);         // DT/MUL
+      regs.emplace_back(chip, 0x40 + base, 8 * op + voice);  // TL
+      regs.emplace_back(chip, 0x50 + base, 0x1f);            // KS/AR
+      regs.emplace_back(chip, 0x60 + base, 0x08 + op);       // DR
+      regs.emplace_back(chip, 0x70 + base, 0x04);            // SR
+      regs.emplace_back(chip, 0x80 + base, 0x27);            // SL/RR
+    }
+    regs.emplace_back(chip, 0xb0 + chan, ((voice & 7) << 3) | (voice % 8));  // FB/ALGO
+  }
+}  // namespace
+
+namespace Benchmark
+{
+  namespace TFM
+  {
+    Devices::TFM::Chip::Ptr CreateDevice(uint64_t clockFreq, uint_t soundFreq)
+    {
+      return Devices::TFM::CreateChip(MakePtr<FMParameters>(clockFreq, soundFreq));
+    }
+
+    double Test(Devices::TFM::Chip& dev, const Time::Milliseconds& duration, const Time::Microseconds& frameDuration)
+    {
+      using namespace Devices::TFM;
+      const Time::Timer timer;
+      DataChunk chunk;
+      for (uint_t chip = 0; chip != CHIPS; ++chip)
+      {
+        for (uint_t chan = 0; chan != Devices::FM::VOICES; ++chan)
+        {
+          SetupVoice(chip, chan, chunk.Data);
+        }
+      }
+      dev.RenderData(chunk);
+      const auto period = frameDuration.CastTo<TimeUnit>();
+      const auto frames = duration.Divide<uint_t>(frameDuration);
+      for (uint_t val = 0; val != frames; ++val)
+      {
+        chunk.Data.clear();
+        for (uint_t voice = 0; voice != VOICES; ++voice)
+        {
+          const uint_t chip = voice / Devices::FM::VOICES;
+          const uint_t chan = voice % Devices::FM::VOICES;
+          const uint_t fnum = 0x200 + ((val * (voice + 1)) & 0x1ff);
+          const uint_t block = 2 + voice % 4;
+          chunk.Data.emplace_back(chip, 0xa4 + chan, (block << 3) | (fnum >> 8));
+          chunk.Data.emplace_back(chip, 0xa0 + chan, fnum & 0xff);
+          // retrigger notes periodically, some voices are released most of time
+          if ((val + voice) % 16 == 0)
+          {
+            const bool keyOn = ((val / 16 + voice) % 3) != 0;
+            chunk.Data.emplace_back(chip, 0x28, chan);
+            chunk.Data.emplace_back(chip, 0x28, (keyOn ? 0xf0 : 0x00) | chan);
+          }
+        }
+        chunk.TimeStamp += period;
+        dev.RenderTill(chunk.TimeStamp);
+        dev.RenderData(chunk);
+      }
+      const auto elapsed = timer.Elapsed<TimeUnit>();
+      return double(chunk.TimeStamp.Get()) / elapsed.Get();
+    }
+  }  // namespace TFM
+}  // namespace Benchmark
@@ -0,0 +1,24 @@
+/**
+ *
+ * @file
+ *
+ * @brief  FM test interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// library includes
+#include <devices/tfm.h>
+#include <time/duration.h>
+
+namespace Benchmark
+{
+  namespace TFM
+  {
+    Devices::TFM::Chip::Ptr CreateDevice(uint64_t clockFreq, uint_t soundFreq);
+    double Test(Devices::TFM::Chip& dev, const Time::Milliseconds& duration, const Time::Microseconds& frameDuration);
+  }  // namespace TFM
+}  // namespace Benchmark
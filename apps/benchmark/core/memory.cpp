@@ -0,0 +1,39 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Heap usage measurement implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "memory.h"
+
+namespace
+{
+  // heap usage of current thread since its start
+  thread_local Benchmark::MemoryUsage Allocated;
+}  // namespace
+
+namespace Benchmark
+{
+  void RegisterAllocation(std::size_t size)
+  {
+    ++Allocated.Allocations;
+    Allocated.Bytes += size;
+  }
+
+  AllocationsCounter::AllocationsCounter()
+    : Start(Allocated)
+  {}
+
+  MemoryUsage AllocationsCounter::Get() const
+  {
+    MemoryUsage res;
+    res.Allocations = Allocated.Allocations - Start.Allocations;
+    res.Bytes = Allocated.Bytes - Start.Bytes;
+    return res;
+  }
+}  // namespace Benchmark
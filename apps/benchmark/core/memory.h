@@ -0,0 +1,39 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Heap usage measurement interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// std includes
+#include <cstddef>
+
+namespace Benchmark
+{
+  struct MemoryUsage
+  {
+    std::size_t Allocations = 0;
+    std::size_t Bytes = 0;
+  };
+
+  //! @brief Accounts allocation in current thread
+  //! @note Called by replaced global allocator from benchmark_allocator library. Without it all the usage is zero
+  void RegisterAllocation(std::size_t size);
+
+  //! @brief Gathers heap usage of current thread during object's lifetime
+  class AllocationsCounter
+  {
+  public:
+    AllocationsCounter();
+
+    MemoryUsage Get() const;
+
+  private:
+    const MemoryUsage Start;
+  };
+}  // namespace Benchmark
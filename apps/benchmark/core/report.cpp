@@ -0,0 +1,265 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Benchmark results reporting implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "report.h"
+// common includes
+#include <make_ptr.h>
+// std includes
+#include <cstdio>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace Benchmark
+{
+  class TextReport : public Report
+  {
+  public:
+    explicit TextReport(std::ostream& out)
+      : Out(out)
+    {}
+
+    void Add(const Result& res) override
+    {
+      if (res.Category != LastCategory)
+      {
+        Out << "Test for " << res.Category << std::endl;
+        LastCategory = res.Category;
+      }
+      const auto& speed = res.Speed;
+      Out << " " << res.Name << ": x" << speed.Median();
+      if (speed.Count() > 1)
+      {
+        Out << " [x" << speed.Min() << "..x" << speed.Max() << " in " << speed.Count() << " runs]";
+      }
+      Out << ", " << res.AllocationsPerSecond << " allocations/s, " << res.BytesPerSecond << " bytes/s" << std::endl;
+    }
+
+    void Finish() override {}
+
+  private:
+    std::ostream& Out;
+    std::string LastCategory;
+  };
+
+  class JsonReport : public Report
+  {
+  public:
+    explicit JsonReport(std::ostream& out)
+      : Out(out)
+    {
+      Out << "{\"results\":[";
+    }
+
+    void Add(const Result& res) override
+    {
+      const auto& speed = res.Speed;
+      Out << (First ? "\n" : ",\n") << "{\"category\":";
+      WriteString(res.Category);
+      Out << ",\"name\":";
+      WriteString(res.Name);
+      Out << ",\"runs\":" << speed.Count() << ",\"median\":" << speed.Median() << ",\"p10\":" << speed.Percentile(10)
+          << ",\"p90\":" << speed.Percentile(90) << ",\"min\":" << speed.Min() << ",\"max\":" << speed.Max()
+          << ",\"allocations_per_second\":" << res.AllocationsPerSecond
+          << ",\"bytes_per_second\":" << res.BytesPerSecond << '}';
+      First = false;
+    }
+
+    void Finish() override
+    {
+      Out << "\n]}" << std::endl;
+    }
+
+  private:
+    void WriteString(const std::string& str)
+    {
+      Out << '\"';
+      for (const auto sym : str)
+      {
+        if (sym == '\"' || sym == '\\')
+        {
+          Out << '\\' << sym;
+        }
+        else if (static_cast<unsigned char>(sym) < ' ')
+        {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", unsigned(sym));
+          Out << buf;
+        }
+        else
+        {
+          Out << sym;
+        }
+      }
+      Out << '\"';
+    }
+
+  private:
+    std::ostream& Out;
+    bool First = true;
+  };
+
+  namespace Csv
+  {
+    const char DELIMITER = ',';
+    const char QUOTE = '\"';
+
+    void WriteField(const std::string& str, std::ostream& out)
+    {
+      if (str.find_first_of(",\"\r\n") == std::string::npos)
+      {
+        out << str;
+        return;
+      }
+      out << QUOTE;
+      for (const auto sym : str)
+      {
+        if (sym == QUOTE)
+        {
+          out << QUOTE;
+        }
+        out << sym;
+      }
+      out << QUOTE;
+    }
+
+    std::vector<std::string> ParseLine(const std::string& line)
+    {
+      std::vector<std::string> result(1);
+      bool quoted = false;
+      for (std::size_t pos = 0; pos < line.size(); ++pos)
+      {
+        const auto sym = line[pos];
+        if (quoted)
+        {
+          if (sym != QUOTE)
+          {
+            result.back() += sym;
+          }
+          else if (pos + 1 < line.size() && line[pos + 1] == QUOTE)
+          {
+            result.back() += sym;
+            ++pos;
+          }
+          else
+          {
+            quoted = false;
+          }
+        }
+        else if (sym == QUOTE)
+        {
+          quoted = true;
+        }
+        else if (sym == DELIMITER)
+        {
+          result.emplace_back();
+        }
+        else if (sym != '\r')
+        {
+          result.back() += sym;
+        }
+      }
+      return result;
+    }
+  }  // namespace Csv
+
+  class CsvReport : public Report
+  {
+  public:
+    explicit CsvReport(std::ostream& out)
+      : Out(out)
+    {
+      Out << "category,name,runs,median,p10,p90,min,max,allocations_per_second,bytes_per_second" << std::endl;
+    }
+
+    void Add(const Result& res) override
+    {
+      const auto& speed = res.Speed;
+      Csv::WriteField(res.Category, Out);
+      Out << Csv::DELIMITER;
+      Csv::WriteField(res.Name, Out);
+      Out << Csv::DELIMITER << speed.Count() << Csv::DELIMITER << speed.Median() << Csv::DELIMITER
+          << speed.Percentile(10) << Csv::DELIMITER << speed.Percentile(90) << Csv::DELIMITER << speed.Min()
+          << Csv::DELIMITER << speed.Max() << Csv::DELIMITER << res.AllocationsPerSecond << Csv::DELIMITER
+          << res.BytesPerSecond << std::endl;
+    }
+
+    void Finish() override
+    {
+      Out.flush();
+    }
+
+  private:
+    std::ostream& Out;
+  };
+
+  Report::Ptr CreateTextReport(std::ostream& out)
+  {
+    return MakePtr<TextReport>(out);
+  }
+
+  Report::Ptr CreateJsonReport(std::ostream& out)
+  {
+    return MakePtr<JsonReport>(out);
+  }
+
+  Report::Ptr CreateCsvReport(std::ostream& out)
+  {
+    return MakePtr<CsvReport>(out);
+  }
+
+  Report::Ptr CreateReport(const std::string& format, std::ostream& out)
+  {
+    if (format == "text")
+    {
+      return CreateTextReport(out);
+    }
+    else if (format == "json")
+    {
+      return CreateJsonReport(out);
+    }
+    else if (format == "csv")
+    {
+      return CreateCsvReport(out);
+    }
+    else
+    {
+      return {};
+    }
+  }
+
+  Baseline LoadBaseline(std::istream& in)
+  {
+    const std::size_t CATEGORY_FIELD = 0;
+    const std::size_t NAME_FIELD = 1;
+    const std::size_t MEDIAN_FIELD = 3;
+
+    Baseline result;
+    std::string line;
+    while (std::getline(in, line))
+    {
+      const auto fields = Csv::ParseLine(line);
+      if (fields.size() <= MEDIAN_FIELD)
+      {
+        continue;
+      }
+      try
+      {
+        result[{fields[CATEGORY_FIELD], fields[NAME_FIELD]}] = std::stod(fields[MEDIAN_FIELD]);
+      }
+      catch (const std::exception&)
+      {
+        // header or corrupted line
+      }
+    }
+    return result;
+  }
+}  // namespace Benchmark
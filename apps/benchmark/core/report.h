@@ -0,0 +1,61 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Benchmark results reporting interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// local includes
+#include "statistics.h"
+// std includes
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace Benchmark
+{
+  struct Result
+  {
+    std::string Category;
+    std::string Name;
+    //! Performance index of each measured run
+    Statistics Speed;
+    //! Heap usage per second of emulated time
+    double AllocationsPerSecond = 0;
+    double BytesPerSecond = 0;
+  };
+
+  class Report
+  {
+  public:
+    using Ptr = std::unique_ptr<Report>;
+    virtual ~Report() = default;
+
+    virtual void Add(const Result& res) = 0;
+    //! @brief Completes output, no more results are accepted after call
+    virtual void Finish() = 0;
+  };
+
+  //! @brief Human-readable report grouped by categories
+  Report::Ptr CreateTextReport(std::ostream& out);
+  Report::Ptr CreateJsonReport(std::ostream& out);
+  //! @brief Report in format suitable for baseline loading
+  Report::Ptr CreateCsvReport(std::ostream& out);
+
+  //! @param format One of "text", "json" or "csv"
+  //! @return Empty pointer for unknown format
+  Report::Ptr CreateReport(const std::string& format, std::ostream& out);
+
+  //! @brief Median speeds by category and name
+  using Baseline = std::map<std::pair<std::string, std::string>, double>;
+
+  //! @brief Loads baseline from csv report, unparsed lines are skipped
+  Baseline LoadBaseline(std::istream& in);
+}  // namespace Benchmark
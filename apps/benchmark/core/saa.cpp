@@ -0,0 +1,105 @@
+/**
+ *
+ * @file
+ *
+ * @brief  SAA test implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "saa.h"
+// common includes
+#include <make_ptr.h>
+// library includes
+#include <time/timer.h>
+
+namespace
+{
+  class SAAParameters : public Devices::SAA::ChipParameters
+  {
+  public:
+    SAAParameters(uint64_t clockFreq, uint_t soundFreq, Devices::SAA::InterpolationType interpolate)
+      : Clock(clockFreq)
+      , Sound(soundFreq)
+      , Interpolate(interpolate)
+    {}
+
+    uint_t Version() const override
+    {
+      return 1;
+    }
+
+    uint64_t ClockFreq() const override
+    {
+      return Clock;
+    }
+
+    uint_t SoundFreq() const override
+    {
+      return Sound;
+    }
+
+    Devices::SAA::InterpolationType Interpolation() const override
+    {
+      return Interpolate;
+    }
+
+  private:
+    const uint64_t Clock;
+    const uint_t Sound;
+    const Devices::SAA::InterpolationType Interpolate;
+  };
+}  // namespace
+
+namespace Benchmark
+{
+  namespace SAA
+  {
+    Devices::SAA::Chip::Ptr CreateDevice(uint64_t clockFreq, uint_t soundFreq,
+                                         Devices::SAA::InterpolationType interpolate)
+    {
+      return Devices::SAA::CreateChip(MakePtr<SAAParameters>(clockFreq, soundFreq, interpolate));
+    }
+
+    double Test(Devices::SAA::Chip& dev, const Time::Milliseconds& duration, const Time::Microseconds& frameDuration)
+    {
+      using namespace Devices::SAA;
+      const Time::Timer timer;
+      DataChunk chunk;
+      chunk.Data.Mask = ~uint32_t(0);
+      // all the tones, noise on two channels, envelope on one of the subdevices
+      chunk.Data.Data[Registers::TONEMIXER] = 0x3f;
+      chunk.Data.Data[Registers::NOISEMIXER] = 0x09;
+      chunk.Data.Data[Registers::NOISECLOCK] = 0x31;
+      chunk.Data.Data[Registers::ENVELOPE1] = 0x8a;
+      dev.RenderData(chunk);
+      const auto period = frameDuration.CastTo<TimeUnit>();
+      const auto frames = duration.Divide<uint_t>(frameDuration);
+      for (uint_t val = 0; val != frames; ++val)
+      {
+        chunk.Data.Mask = 0;
+        for (uint_t chan = 0; chan != 6; ++chan)
+        {
+          // etracker-like usage: tones are changed every frame, volumes sometimes, octaves rarely
+          const uint_t note = (val * (chan + 1) / 4) % 96;
+          chunk.Data.Data[Registers::TONENUMBER0 + chan] = (note % 12) * 21;
+          chunk.Data.Data[Registers::LEVEL0 + chan] = ((val + chan) % 16) * 0x11;
+          chunk.Data.Data[Registers::TONEOCTAVE01 + chan / 2] = 0x11 * (1 + (note / 12) % 7);
+          chunk.Data.Mask |= (1u << (Registers::TONENUMBER0 + chan)) | (1u << (Registers::LEVEL0 + chan));
+        }
+        if (val % 8 == 0)
+        {
+          chunk.Data.Mask |= (1u << Registers::TONEOCTAVE01) | (1u << Registers::TONEOCTAVE23)
+                             | (1u << Registers::TONEOCTAVE45);
+        }
+        chunk.TimeStamp += period;
+        dev.RenderTill(chunk.TimeStamp);
+        dev.RenderData(chunk);
+      }
+      const auto elapsed = timer.Elapsed<TimeUnit>();
+      return double(chunk.TimeStamp.Get()) / elapsed.Get();
+    }
+  }  // namespace SAA
+}  // namespace Benchmark
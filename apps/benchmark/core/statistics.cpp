@@ -0,0 +1,46 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Measurements statistics implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "statistics.h"
+// std includes
+#include <algorithm>
+#include <cmath>
+
+namespace Benchmark
+{
+  Statistics::Statistics(std::vector<double> samples)
+    : Samples(std::move(samples))
+  {
+    std::sort(Samples.begin(), Samples.end());
+  }
+
+  double Statistics::Min() const
+  {
+    return Samples.empty() ? 0 : Samples.front();
+  }
+
+  double Statistics::Max() const
+  {
+    return Samples.empty() ? 0 : Samples.back();
+  }
+
+  double Statistics::Percentile(double percent) const
+  {
+    if (Samples.empty())
+    {
+      return 0;
+    }
+    const auto rank = std::clamp(percent, 0.0, 100.0) * (Samples.size() - 1) / 100;
+    const auto lower = static_cast<std::size_t>(std::floor(rank));
+    const auto upper = std::min(lower + 1, Samples.size() - 1);
+    return Samples[lower] + (Samples[upper] - Samples[lower]) * (rank - lower);
+  }
+}  // namespace Benchmark
@@ -0,0 +1,45 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Measurements statistics interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// std includes
+#include <vector>
+
+namespace Benchmark
+{
+  //! @brief Order statistics of repeated measurements
+  class Statistics
+  {
+  public:
+    Statistics() = default;
+    explicit Statistics(std::vector<double> samples);
+
+    std::size_t Count() const
+    {
+      return Samples.size();
+    }
+
+    double Min() const;
+    double Max() const;
+
+    double Median() const
+    {
+      return Percentile(50);
+    }
+
+    //! @param percent Value in range [0..100]
+    //! @return Linearly interpolated value between the closest ranks, 0 if empty
+    double Percentile(double percent) const;
+
+  private:
+    std::vector<double> Samples;
+  };
+}  // namespace Benchmark
@@ -0,0 +1,177 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Track model test implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "track_model.h"
+// library includes
+#include <module/players/tracking.h>
+#include <time/duration.h>
+#include <time/timer.h>
+
+namespace Benchmark
+{
+  namespace TrackModel
+  {
+    const uint_t PATTERNS_COUNT = 64;
+    const uint_t PATTERN_SIZE = 64;
+    const uint_t TEMPO = 6;
+    const Time::Milliseconds FRAME_DURATION(20);
+    const auto TRACK_DURATION = FRAME_DURATION * (PATTERNS_COUNT * PATTERN_SIZE * TEMPO);
+
+    // typical tracker's content: some empty lines and cells, few commands
+    class RandomContent
+    {
+    public:
+      uint_t Next()
+      {
+        Seed = Seed * 1103515245 + 12345;
+        return Seed >> 8;
+      }
+
+    private:
+      uint32_t Seed = 1;
+    };
+
+    template<uint_t Channels>
+    Module::PatternsSet::Ptr BuildPatterns()
+    {
+      auto builder = Module::PatternsBuilder::Create<Channels>();
+      RandomContent rnd;
+      for (uint_t pat = 0; pat != PATTERNS_COUNT; ++pat)
+      {
+        builder.SetPattern(pat);
+        for (uint_t row = 0; row != PATTERN_SIZE; ++row)
+        {
+          if (rnd.Next() % 4 == 0)
+          {
+            continue;
+          }
+          builder.StartLine(row);
+          if (row % 16 == 0)
+          {
+            builder.SetTempo(TEMPO);
+          }
+          for (uint_t chan = 0; chan != Channels; ++chan)
+          {
+            const auto val = rnd.Next();
+            if (val & 1)
+            {
+              continue;
+            }
+            builder.SetChannel(chan);
+            auto& cell = builder.GetChannel();
+            cell.SetEnabled(true);
+            cell.SetNote((val >> 1) % 96);
+            if (val & 0x100)
+            {
+              cell.SetSample((val >> 9) & 31);
+              cell.SetOrnament((val >> 14) & 15);
+            }
+            if (val & 0x40000)
+            {
+              cell.AddCommand((val >> 19) & 7, (val >> 22) & 15);
+            }
+            if ((val & 0x600000) == 0x600000)
+            {
+              cell.AddCommand(8, (val >> 3) & 255, (val >> 11) & 255);
+            }
+          }
+        }
+        builder.FinishPattern(PATTERN_SIZE);
+      }
+      return builder.CaptureResult();
+    }
+
+    Module::PatternsSet::Ptr BuildPatterns(uint_t channels)
+    {
+      switch (channels)
+      {
+      case 1:
+        return BuildPatterns<1>();
+      case 3:
+        return BuildPatterns<3>();
+      case 4:
+        return BuildPatterns<4>();
+      case 6:
+        return BuildPatterns<6>();
+      default:
+        return {};
+      }
+    }
+
+    // access data the same way as players do while rendering
+    uint_t Traverse(const Module::PatternsSet& patterns, uint_t channels)
+    {
+      uint_t result = 0;
+      for (uint_t pat = 0; pat != PATTERNS_COUNT; ++pat)
+      {
+        const auto* pattern = patterns.Get(pat);
+        for (uint_t row = 0, size = pattern->GetSize(); row != size; ++row)
+        {
+          const auto* line = pattern->GetLine(row);
+          if (!line)
+          {
+            continue;
+          }
+          result += line->GetTempo();
+          for (uint_t chan = 0; chan != channels; ++chan)
+          {
+            const auto* cell = line->GetChannel(chan);
+            if (!cell)
+            {
+              continue;
+            }
+            if (const auto* note = cell->GetNote())
+            {
+              result += *note;
+            }
+            if (const auto* sample = cell->GetSample())
+            {
+              result += *sample;
+            }
+            if (const auto* ornament = cell->GetOrnament())
+            {
+              result += *ornament;
+            }
+            for (auto it = cell->GetCommands(); it; ++it)
+            {
+              result += it->Type + it->Param1 + it->Param2;
+            }
+          }
+        }
+      }
+      return result;
+    }
+
+    double TestBuilding(uint_t channels, uint_t tracks)
+    {
+      const Time::Timer timer;
+      for (uint_t idx = 0; idx != tracks; ++idx)
+      {
+        BuildPatterns(channels);
+      }
+      const auto elapsed = timer.Elapsed();
+      return (TRACK_DURATION * tracks).Divide<double>(elapsed);
+    }
+
+    double TestTraversal(uint_t channels, uint_t passes)
+    {
+      const auto patterns = BuildPatterns(channels);
+      const Time::Timer timer;
+      volatile uint_t dummy = 0;
+      for (uint_t idx = 0; idx != passes; ++idx)
+      {
+        dummy = dummy + Traverse(*patterns, channels);
+      }
+      const auto elapsed = timer.Elapsed();
+      return (TRACK_DURATION * passes).Divide<double>(elapsed);
+    }
+  }  // namespace TrackModel
+}  // namespace Benchmark
@@ -0,0 +1,25 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Track model test interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// common includes
+#include <types.h>
+
+namespace Benchmark
+{
+  namespace TrackModel
+  {
+    //! @return Ratio of built tracks' total duration to building time
+    double TestBuilding(uint_t channels, uint_t tracks);
+    //! @return Ratio of track's duration multiplied by passes count to traversal time
+    double TestTraversal(uint_t channels, uint_t passes);
+  }  // namespace TrackModel
+}  // namespace Benchmark
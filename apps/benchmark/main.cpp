@@ -9,31 +9,224 @@
  **/
 
 #include "core/benchmark.h"
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <vector>
+
+#include <boost/program_options.hpp>
 
 namespace
 {
-  class ExecuteTestsVisitor : public Benchmark::TestsVisitor
+  struct Options
+  {
+    Benchmark::RunParameters Run;
+    std::vector<std::string> Categories;
+    bool List = false;
+    std::string Format = "text";
+    std::string Output;
+    std::string Baseline;
+    double Threshold = 5;
+    std::string Compare;
+  };
+
+  //! @return false if application should exit
+  bool ParseOptions(int argc, char* argv[], Options& opts)
+  {
+    using namespace boost::program_options;
+    const auto helpKey = "help";
+    options_description options("Usage:\nbenchmark [options]\nExit code is 2 if any regression against baseline found");
+    auto opt = options.add_options();
+    opt(helpKey, "show this message");
+    opt("warmup", value<unsigned>(&opts.Run.Warmup)->default_value(opts.Run.Warmup), "runs before measurement");
+    opt("runs", value<unsigned>(&opts.Run.Runs)->default_value(opts.Run.Runs), "measured runs");
+    opt("category", value<std::vector<std::string>>(&opts.Categories),
+        "execute only tests with category containing specified text, may be repeated");
+    opt("list", bool_switch(&opts.List), "list tests without executing");
+    opt("format", value<std::string>(&opts.Format)->default_value(opts.Format), "report format: text, json or csv");
+    opt("output", value<std::string>(&opts.Output), "write report to file instead of standard output");
+    opt("baseline", value<std::string>(&opts.Baseline), "compare median speeds with csv report of previous run");
+    opt("threshold", value<double>(&opts.Threshold)->default_value(opts.Threshold),
+        "allowed slowdown against baseline in percents");
+    opt("compare", value<std::string>(&opts.Compare),
+        "do not execute tests, compare csv report with baseline instead");
+
+    variables_map vars;
+    store(parse_command_line(argc, argv, options), vars);
+    notify(vars);
+    if (vars.count(helpKey) || !opts.Run.Runs || (!opts.Compare.empty() && opts.Baseline.empty()))
+    {
+      std::cout << options << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool IsSelected(const Options& opts, const std::string& category)
+  {
+    if (opts.Categories.empty())
+    {
+      return true;
+    }
+    for (const auto& filter : opts.Categories)
+    {
+      if (category.find(filter) != std::string::npos)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  class ListTestsVisitor : public Benchmark::TestsVisitor
   {
   public:
+    explicit ListTestsVisitor(const Options& opts)
+      : Opts(opts)
+    {}
+
     void OnPerformanceTest(const Benchmark::PerformanceTest& test) override
     {
       const std::string cat = test.Category();
-      if (cat != LastCategory)
+      if (IsSelected(Opts, cat))
       {
-        std::cout << "Test for " << cat << std::endl;
-        LastCategory = cat;
+        std::cout << cat << ": " << test.Name() << std::endl;
       }
-      std::cout << " " << test.Name() << ": " << std::flush << 'x' << test.Execute() << std::endl;
     }
 
   private:
-    std::string LastCategory;
+    const Options& Opts;
   };
+
+  class ExecuteTestsVisitor : public Benchmark::TestsVisitor
+  {
+  public:
+    ExecuteTestsVisitor(const Options& opts, Benchmark::Report& report)
+      : Opts(opts)
+      , Target(report)
+    {}
+
+    void OnPerformanceTest(const Benchmark::PerformanceTest& test) override
+    {
+      if (!IsSelected(Opts, test.Category()))
+      {
+        return;
+      }
+      auto res = Benchmark::Run(test, Opts.Run);
+      Target.Add(res);
+      Results[{res.Category, res.Name}] = res.Speed.Median();
+    }
+
+    const Benchmark::Baseline& GetResults() const
+    {
+      return Results;
+    }
+
+  private:
+    const Options& Opts;
+    Benchmark::Report& Target;
+    Benchmark::Baseline Results;
+  };
+
+  bool LoadBaseline(const std::string& filename, Benchmark::Baseline& result)
+  {
+    std::ifstream in(filename.c_str());
+    if (!in)
+    {
+      std::cerr << "Failed to open " << filename << std::endl;
+      return false;
+    }
+    result = Benchmark::LoadBaseline(in);
+    return true;
+  }
+
+  //! @return Regressions count
+  unsigned CompareWithBaseline(const Benchmark::Baseline& current, const Benchmark::Baseline& baseline,
+                               double threshold)
+  {
+    unsigned regressions = 0;
+    for (const auto& ref : baseline)
+    {
+      const auto it = current.find(ref.first);
+      if (it == current.end() || ref.second <= 0)
+      {
+        continue;
+      }
+      const auto change = 100 * (it->second - ref.second) / ref.second;
+      const bool regressed = change < -threshold;
+      std::cerr << (regressed ? "REGRESSION " : "") << ref.first.first << ": " << ref.first.second << ": x"
+                << ref.second << " -> x" << it->second << " (" << (change >= 0 ? "+" : "") << change << "%)"
+                << std::endl;
+      regressions += regressed;
+    }
+    return regressions;
+  }
 }  // namespace
 
-int main()
+int main(int argc, char* argv[])
 {
-  ExecuteTestsVisitor visitor;
-  Benchmark::ForAllTests(visitor);
+  Options opts;
+  try
+  {
+    if (!ParseOptions(argc, argv, opts))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (opts.List)
+  {
+    ListTestsVisitor visitor(opts);
+    Benchmark::ForAllTests(visitor);
+    return EXIT_SUCCESS;
+  }
+  Benchmark::Baseline results;
+  if (!opts.Compare.empty())
+  {
+    if (!LoadBaseline(opts.Compare, results))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    std::ofstream file;
+    if (!opts.Output.empty())
+    {
+      file.open(opts.Output.c_str());
+      if (!file)
+      {
+        std::cerr << "Failed to open " << opts.Output << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    std::ostream& out = opts.Output.empty() ? std::cout : file;
+    const auto report = Benchmark::CreateReport(opts.Format, out);
+    if (!report)
+    {
+      std::cerr << "Unknown report format " << opts.Format << std::endl;
+      return EXIT_FAILURE;
+    }
+    ExecuteTestsVisitor visitor(opts, *report);
+    Benchmark::ForAllTests(visitor);
+    report->Finish();
+    results = visitor.GetResults();
+  }
+  Benchmark::Baseline baseline;
+  if (!opts.Baseline.empty())
+  {
+    if (!LoadBaseline(opts.Baseline, baseline))
+    {
+      return EXIT_FAILURE;
+    }
+    if (CompareWithBaseline(results, baseline, opts.Threshold))
+    {
+      return 2;
+    }
+  }
+  return EXIT_SUCCESS;
 }
@@ -17,6 +17,7 @@
 #include <analysis/scanner.h>
 #include <async/data_receiver.h>
 #include <binary/format_factories.h>
+#include <binary/hash.h>
 #include <debug/log.h>
 #include <formats/archived/decoders.h>
 #include <formats/chiptune/decoders.h>
@@ -33,11 +34,17 @@
 #include <strings/format.h>
 #include <strings/template.h>
 // std includes
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <future>
 #include <iostream>
 #include <locale>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <set>
+#include <unordered_map>
 // boost includes
 #include <boost/algorithm/string/join.hpp>
 #include <boost/filesystem.hpp>
@@ -409,6 +416,196 @@ namespace
     std::size_t Total;
     uint64_t TotalSize;
   };
+
+  /*
+    Passes only the first result with specific content to delegate. Duplicates are skipped or stored as links to
+    the first saved file. Known contents may be persisted in database file to be used in subsequent runs.
+  */
+  class DeduplicationTarget : public Parsing::Target
+  {
+  public:
+    enum Mode
+    {
+      SKIP,
+      HARDLINK,
+      SYMLINK
+    };
+
+    DeduplicationTarget(Mode mode, String database, Parsing::Target::Ptr delegate)
+      : LinkMode(mode)
+      , Database(std::move(database))
+      , Delegate(std::move(delegate))
+    {
+      if (!Database.empty())
+      {
+        Load();
+      }
+    }
+
+    void ApplyData(Parsing::Result::Ptr result) override
+    {
+      const auto hash = Binary::Murmur3(*result->Data());
+      Entry::Ptr entry;
+      bool isNew = false;
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        auto& stored = Entries[hash];
+        if (!stored)
+        {
+          stored = std::make_shared<Entry>(result->Name());
+          isNew = true;
+        }
+        entry = stored;
+      }
+      if (isNew)
+      {
+        Save(*entry, std::move(result));
+      }
+      else if (LinkMode == SKIP)
+      {
+        ++Duplicates;
+      }
+      else if (!Link(*entry, result->Name()))
+      {
+        // e.g. filesystem does not support links or original was not saved
+        Delegate->ApplyData(std::move(result));
+      }
+    }
+
+    void Flush() override
+    {
+      if (!Database.empty())
+      {
+        Store();
+      }
+      Dbg("%1% duplicates skipped, %2% linked", Duplicates, Links);
+      Delegate->Flush();
+    }
+
+  private:
+    struct Entry
+    {
+      typedef std::shared_ptr<Entry> Ptr;
+
+      explicit Entry(String path)
+        : Path(std::move(path))
+        , Saved(Signal.get_future())
+      {}
+
+      const String Path;
+      std::promise<void> Signal;
+      const std::shared_future<void> Saved;
+    };
+
+    struct HashFunction
+    {
+      std::size_t operator()(const Binary::Hash128& hash) const
+      {
+        return static_cast<std::size_t>(hash.Low);
+      }
+    };
+
+    void Save(Entry& entry, Parsing::Result::Ptr result)
+    {
+      try
+      {
+        Delegate->ApplyData(std::move(result));
+      }
+      catch (...)
+      {
+        entry.Signal.set_value();
+        throw;
+      }
+      entry.Signal.set_value();
+    }
+
+    //! @return false if data should be saved instead
+    bool Link(const Entry& original, const String& name)
+    {
+      // original may still be stored in another thread
+      original.Saved.wait();
+      const auto from = boost::filesystem::path(name);
+      const auto to = boost::filesystem::path(original.Path);
+      if (from == to)
+      {
+        ++Duplicates;
+        return true;
+      }
+      boost::system::error_code err;
+      if (!boost::filesystem::exists(to, err) || boost::filesystem::exists(from, err))
+      {
+        return false;
+      }
+      if (from.has_parent_path())
+      {
+        boost::filesystem::create_directories(from.parent_path(), err);
+      }
+      if (LinkMode == HARDLINK)
+      {
+        boost::filesystem::create_hard_link(to, from, err);
+      }
+      else
+      {
+        boost::filesystem::create_symlink(boost::filesystem::absolute(to), from, err);
+      }
+      if (err)
+      {
+        Dbg("Failed to link %1% to %2%: %3%", name, original.Path, err.message());
+        return false;
+      }
+      ++Links;
+      return true;
+    }
+
+    // Format: <hash in hex> <path>. Entries for removed files are ignored
+    void Load()
+    {
+      boost::filesystem::ifstream input{boost::filesystem::path(Database)};
+      std::string hex, path;
+      std::size_t loaded = 0;
+      while (input >> hex && std::getline(input >> std::ws, path))
+      {
+        Binary::Hash128 hash;
+        boost::system::error_code err;
+        if (hex.size() == 32 && std::sscanf(hex.c_str(), "%16" SCNx64 "%16" SCNx64, &hash.High, &hash.Low) == 2
+            && boost::filesystem::exists(path, err))
+        {
+          const auto entry = std::make_shared<Entry>(path);
+          entry->Signal.set_value();
+          Entries.emplace(hash, entry);
+          ++loaded;
+        }
+      }
+      Dbg("Loaded %1% entries from %2%", loaded, Database);
+    }
+
+    void Store() const
+    {
+      boost::filesystem::ofstream output(boost::filesystem::path{Database}, std::ios::trunc);
+      for (const auto& entry : Entries)
+      {
+        boost::system::error_code err;
+        if (boost::filesystem::exists(entry.second->Path, err))
+        {
+          output << Strings::Format("%1$016x%2$016x ", entry.first.High, entry.first.Low) << entry.second->Path
+                 << '\n';
+        }
+      }
+      if (!output.flush())
+      {
+        std::cout << Strings::Format("Failed to store duplicates database to %1%", Database) << std::endl;
+      }
+    }
+
+  private:
+    const Mode LinkMode;
+    const String Database;
+    const Parsing::Target::Ptr Delegate;
+    std::mutex Guard;
+    std::unordered_map<Binary::Hash128, Entry::Ptr, HashFunction> Entries;
+    std::atomic<std::size_t> Duplicates = 0;
+    std::atomic<std::size_t> Links = 0;
+  };
 }  // namespace
 
 namespace Parsing
@@ -422,6 +619,21 @@ namespace Parsing
   {
     return MakePtr<StatisticTarget>();
   }
+
+  Parsing::Target::Ptr CreateDeduplicationTarget(const String& mode, const String& database,
+                                                 Parsing::Target::Ptr target)
+  {
+    static const std::map<String, DeduplicationTarget::Mode> MODES = {
+        {"skip", DeduplicationTarget::SKIP},
+        {"hardlink", DeduplicationTarget::HARDLINK},
+        {"symlink", DeduplicationTarget::SYMLINK}};
+    const auto it = MODES.find(mode);
+    if (it == MODES.end())
+    {
+      throw boost::program_options::invalid_option_value(mode);
+    }
+    return MakePtr<DeduplicationTarget>(it->second, database, std::move(target));
+  }
 }  // namespace Parsing
 
 namespace
@@ -937,6 +1149,8 @@ namespace
     virtual std::size_t SaveThreadsCount() const = 0;
     virtual std::size_t SaveDataQueueSize() const = 0;
     virtual bool StatisticOutput() const = 0;
+    virtual String DeduplicationMode() const = 0;
+    virtual String DeduplicationDatabase() const = 0;
   };
 
   class AnalysisOptions
@@ -952,7 +1166,13 @@ namespace
   {
     const Parsing::Target::Ptr save = opts.StatisticOutput() ? Parsing::CreateStatisticTarget()
                                                              : Parsing::CreateSaveTarget();
-    const Analysis::NodeReceiver::Ptr makeName = MakePtr<TargetNamePoint>(opts.TargetNameTemplate(), save);
+    const String dedupMode = opts.DeduplicationMode();
+    // links make no sense for statistic
+    const Parsing::Target::Ptr dedup =
+        dedupMode.empty() ? save
+                          : Parsing::CreateDeduplicationTarget(opts.StatisticOutput() ? "skip" : dedupMode,
+                                                               opts.DeduplicationDatabase(), save);
+    const Analysis::NodeReceiver::Ptr makeName = MakePtr<TargetNamePoint>(opts.TargetNameTemplate(), dedup);
     const Analysis::NodeReceiver::Ptr storeAll = makeName;
     const Analysis::NodeReceiver::Ptr storeNoEmpty = opts.IgnoreEmptyData() ? Analysis::CreateEmptyDataFilter(storeAll)
                                                                             : storeAll;
@@ -1060,6 +1280,11 @@ namespace
               SaveDataQueueSizeValue)
               .c_str());
       opt("statistic", bool_switch(&StatisticOutputValue), "do not save any data, just collect summary statistic");
+      opt("dedup", value<String>(&DeduplicationModeValue),
+          "store only the first of the files with the same content. Duplicates are skipped (skip) or replaced by "
+          "links to the first one (hardlink, symlink)");
+      opt("dedup-database", value<String>(&DeduplicationDatabaseValue),
+          "file to keep known contents between runs. Valuable only with --dedup");
     }
 
     std::size_t AnalysisThreads() const override
@@ -1107,6 +1332,16 @@ namespace
       return StatisticOutputValue;
     }
 
+    String DeduplicationMode() const override
+    {
+      return DeduplicationModeValue;
+    }
+
+    String DeduplicationDatabase() const override
+    {
+      return DeduplicationDatabaseValue;
+    }
+
     const boost::program_options::options_description& GetOptionsDescription() const
     {
       return OptionsDescription;
@@ -1122,6 +1357,8 @@ namespace
     std::size_t SaveThreadsCountValue;
     std::size_t SaveDataQueueSizeValue;
     bool StatisticOutputValue;
+    String DeduplicationModeValue;
+    String DeduplicationDatabaseValue;
     boost::program_options::options_description OptionsDescription;
   };
 }  // namespace
@@ -30,7 +30,6 @@
 // std includes
 #include <atomic>
 #include <ctime>
-#include <deque>
 
 namespace
 {
@@ -80,59 +79,6 @@ namespace
   static_assert(Sound::Sample::BITS == 16, "Incompatible sound sample bits count");
   static_assert(Sound::Sample::MID == 0, "Incompatible sound sample type");
 
-  class BufferTarget
-  {
-  public:
-    void Add(Sound::Chunk data)
-    {
-      TotalSamples += data.size();
-      Buffers.emplace_back(std::move(data));
-    }
-
-    std::size_t GetSamples(std::size_t count, int16_t* target)
-    {
-      if (Buffers.empty())
-      {
-        return 0;
-      }
-      Buff& cur = Buffers.front();
-      const std::size_t samples = count / Sound::Sample::CHANNELS;
-      const std::size_t copied = cur.Get(samples, target);
-      if (0 == cur.Avail)
-      {
-        Buffers.pop_front();
-      }
-      return copied * Sound::Sample::CHANNELS;
-    }
-
-    uint64_t GetTotalSamplesDone() const
-    {
-      return TotalSamples;
-    }
-
-  private:
-    struct Buff
-    {
-      explicit Buff(Sound::Chunk data)
-        : Data(std::move(data))
-        , Avail(Data.size())
-      {}
-
-      std::size_t Get(std::size_t count, void* target)
-      {
-        const std::size_t toCopy = std::min(count, Avail);
-        std::memcpy(target, &Data.back() + 1 - Avail, toCopy * sizeof(Data.front()));
-        Avail -= toCopy;
-        return toCopy;
-      }
-
-      Sound::Chunk Data;
-      std::size_t Avail;
-    };
-    std::deque<Buff> Buffers;
-    uint64_t TotalSamples = 0;
-  };
-
   class RenderingPerformanceAccountant
   {
   public:
@@ -267,27 +213,16 @@ namespace
     bool Render(uint_t samples, int16_t* buffer) override
     {
       Analyzer.FrameStarted();
-      auto rest = samples;
-      auto* target = buffer;
-      for (;;)
-      {
-        if (const auto got = Buffer.GetSamples(rest, target))
-        {
-          target += got;
-          rest -= got;
-          if (!rest)
-          {
-            break;
-          }
-        }
-        auto chunk = RenderNextFrame();
-        if (chunk.empty())
-        {
-          break;
-        }
-        Buffer.Add(std::move(chunk));
-      }
-      std::fill_n(target, rest, 0);
+      ApplyParameters();
+      const auto toRender = samples / Sound::Sample::CHANNELS;
+      // java arrays are at least 8-bytes aligned
+      const auto target = static_cast<Sound::Sample*>(static_cast<void*>(buffer));
+      RenderingPerformance.StartAccounting();
+      const auto done = Renderer->Render(Looped, target, toRender);
+      RenderingPerformance.StopAccounting();
+      TotalSamples += done;
+      const auto rest = samples - done * Sound::Sample::CHANNELS;
+      std::fill_n(buffer + done * Sound::Sample::CHANNELS, rest, 0);
       Analyzer.FrameReady(samples, buffer);
       return rest == 0;
     }
@@ -299,26 +234,16 @@ namespace
 
     uint_t GetPlaybackPerformance() const override
     {
-      return RenderingPerformance.Measure(Buffer.GetTotalSamplesDone(), Samplerate);
+      return RenderingPerformance.Measure(TotalSamples, Samplerate);
     }
 
     // TODO: move to State
     uint_t GetPlaybackProgress() const override
     {
-      const auto played = Time::Microseconds::FromRatio(Buffer.GetTotalSamplesDone(), Samplerate);
+      const auto played = Time::Microseconds::FromRatio(TotalSamples, Samplerate);
       return (played * 100).Divide<uint_t>(Duration);
     }
 
-  private:
-    Sound::Chunk RenderNextFrame()
-    {
-      ApplyParameters();
-      RenderingPerformance.StartAccounting();
-      auto chunk = Renderer->Render(Looped);
-      RenderingPerformance.StopAccounting();
-      return chunk;
-    }
-
   private:
     void ApplyParameters()
     {
@@ -333,9 +258,9 @@ namespace
     const uint_t Samplerate;
     const Parameters::Container::Ptr LocalParameters;
     Parameters::TrackingHelper<Parameters::Accessor> Props;
-    const Module::Renderer::Ptr Renderer;
+    const Module::PipelinedRenderer::Ptr Renderer;
     const Module::State::Ptr State;
-    BufferTarget Buffer;
+    uint64_t TotalSamples = 0;
     Sound::LoopParameters Looped;
     RenderingPerformanceAccountant RenderingPerformance;
     AnalyzerControl Analyzer;
@@ -77,6 +77,15 @@ namespace Parameters
         //! Default value
         const IntType FILES_LIMIT_DEFAULT = 1000;
         //@}
+
+        //@{
+        //! @name Upcoming items count prepared for playback in background
+
+        //! Parameter name
+        const auto PREFETCH_ITEMS = PREFIX + "Prefetch"_id;
+        //! Default value
+        const IntType PREFETCH_ITEMS_DEFAULT = 2;
+        //@}
       }  // namespace Cache
 
       namespace Store
@@ -34,6 +34,50 @@ namespace
 
   const unsigned NO_INDEX = ~0;
 
+  // Follows play order starting from the planned next item. Only the planned one is known in random mode
+  class UpcomingItemsIterator : public Playlist::Item::Collection
+  {
+  public:
+    UpcomingItemsIterator(Playlist::Model::Ptr model, unsigned first, unsigned current, unsigned playorderMode)
+      : Model(model)
+      , Index(first)
+      , Current(current)
+      , PlayorderMode(playorderMode)
+      , Item(NO_INDEX != first ? Model->GetItem(first) : Playlist::Item::Data::Ptr())
+    {}
+
+    bool IsValid() const override
+    {
+      return !!Item;
+    }
+
+    Playlist::Item::Data::Ptr Get() const override
+    {
+      return Item;
+    }
+
+    void Next() override
+    {
+      if (Playlist::Item::RANDOMIZED == (PlayorderMode & Playlist::Item::RANDOMIZED))
+      {
+        Item.reset();
+        return;
+      }
+      if (++Index >= Model->CountItems() && Playlist::Item::LOOPED == (PlayorderMode & Playlist::Item::LOOPED))
+      {
+        Index = 0;
+      }
+      Item = Index != Current ? Model->GetItem(Index) : Playlist::Item::Data::Ptr();
+    }
+
+  private:
+    const Playlist::Model::Ptr Model;
+    unsigned Index;
+    const unsigned Current;
+    const unsigned PlayorderMode;
+    Playlist::Item::Data::Ptr Item;
+  };
+
   class ItemIteratorImpl : public Playlist::Item::Iterator
   {
   public:
@@ -42,6 +86,8 @@ namespace
       , Model(model)
       , Index(NO_INDEX)
       , State(Playlist::Item::STOPPED)
+      , PlayorderMode(0)
+      , Upcoming(NO_INDEX)
     {
       Require(connect(Model, SIGNAL(IndicesChanged(Playlist::Model::OldToNewIndexMap::Ptr)),
                       SLOT(UpdateIndices(Playlist::Model::OldToNewIndexMap::Ptr))));
@@ -59,7 +105,17 @@ namespace
 
     bool Next(unsigned playorderMode) override
     {
-      return Index != NO_INDEX && Navigate(Index + 1, playorderMode);
+      if (Index == NO_INDEX)
+      {
+        return false;
+      }
+      if (PlayorderMode != playorderMode)
+      {
+        PlayorderMode = playorderMode;
+        PlanUpcoming();
+      }
+      // follow the plan already reported via UpcomingItems
+      return Upcoming != NO_INDEX && SelectItem(Upcoming);
     }
 
     bool Prev(unsigned playorderMode) override
@@ -72,6 +128,19 @@ namespace
       State = state;
     }
 
+    void SetPlayorderMode(unsigned playorderMode) override
+    {
+      if (PlayorderMode != playorderMode)
+      {
+        PlayorderMode = playorderMode;
+        if (Index != NO_INDEX)
+        {
+          PlanUpcoming();
+          EmitUpcoming();
+        }
+      }
+    }
+
     void Select(unsigned idx) override
     {
       Activate(idx);
@@ -98,6 +167,7 @@ namespace
       {
         Dbg("Iterator: index updated %1% -> %2%", Index, *moved);
         Index = *moved;
+        UpdateUpcoming(*remapping);
         return;
       }
       const uint_t oldIndex = Index;
@@ -115,6 +185,7 @@ namespace
       {
         Dbg("Iterator: selected %1%", idx);
         Index = idx;
+        PlanUpcoming();
         if (item->GetState())
         {
           State = Playlist::Item::ERROR;
@@ -124,6 +195,7 @@ namespace
           State = Playlist::Item::STOPPED;
           emit ItemActivated(item);
           emit ItemActivated(Index);
+          EmitUpcoming();
         }
         return true;
       }
@@ -131,11 +203,18 @@ namespace
     }
 
     bool Navigate(int newIndex, unsigned playorderMode)
+    {
+      const unsigned mappedIndex = MapIndex(newIndex, playorderMode);
+      return mappedIndex != NO_INDEX && SelectItem(mappedIndex);
+    }
+
+    //! @return NO_INDEX if there's no item to navigate to
+    unsigned MapIndex(int newIndex, unsigned playorderMode) const
     {
       const unsigned itemsCount = Model->CountItems();
       if (!itemsCount)
       {
-        return false;
+        return NO_INDEX;
       }
       const bool isEnd = newIndex >= int(itemsCount) || newIndex < 0;
       if (isEnd)
@@ -146,12 +225,38 @@ namespace
         }
         else
         {
-          return false;
+          return NO_INDEX;
         }
       }
       const bool isRandom = Playlist::Item::RANDOMIZED == (playorderMode & Playlist::Item::RANDOMIZED);
-      const unsigned mappedIndex = isRandom ? Randomized(newIndex, itemsCount) : newIndex;
-      return SelectItem(mappedIndex);
+      return isRandom ? Randomized(newIndex, itemsCount) : newIndex;
+    }
+
+    // next item is chosen in advance, so random one can be prefetched and played without gap
+    void PlanUpcoming()
+    {
+      Upcoming = MapIndex(int(Index) + 1, PlayorderMode);
+      Dbg("Iterator: planned %1% after %2%", Upcoming, Index);
+    }
+
+    void EmitUpcoming()
+    {
+      emit UpcomingItems(MakePtr<UpcomingItemsIterator>(Model, Upcoming, Index, PlayorderMode));
+    }
+
+    void UpdateUpcoming(const Playlist::Model::OldToNewIndexMap& remapping)
+    {
+      const bool isRandom = Playlist::Item::RANDOMIZED == (PlayorderMode & Playlist::Item::RANDOMIZED);
+      const Playlist::Model::IndexType* moved = Upcoming != NO_INDEX ? remapping.FindNewIndex(Upcoming) : nullptr;
+      if (isRandom && moved)
+      {
+        Upcoming = *moved;
+      }
+      else
+      {
+        PlanUpcoming();
+      }
+      EmitUpcoming();
     }
 
     void Activate(unsigned idx)
@@ -160,13 +265,16 @@ namespace
       {
         Index = idx;
         Dbg("Iterator: activated at %1%.", idx);
+        PlanUpcoming();
         emit Activated(item);
+        EmitUpcoming();
       }
     }
 
     void Deactivate()
     {
       Index = NO_INDEX;
+      Upcoming = NO_INDEX;
       Dbg("Iterator: invalidated after removing.");
       emit Deactivated();
     }
@@ -175,6 +283,8 @@ namespace
     const Playlist::Model::Ptr Model;
     unsigned Index;
     Playlist::Item::State State;
+    unsigned PlayorderMode;
+    unsigned Upcoming;
   };
 
   class ControllerImpl : public Playlist::Controller
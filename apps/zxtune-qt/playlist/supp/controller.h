@@ -61,6 +61,8 @@ namespace Playlist
       virtual State GetState() const = 0;
       // change
       virtual void SetState(State state) = 0;
+      //! @brief Set mode used to plan the item following the current one
+      virtual void SetPlayorderMode(unsigned playorderMode) = 0;
       // navigate
       virtual bool Next(unsigned playorderMode) = 0;
       virtual bool Prev(unsigned playorderMode) = 0;
@@ -77,6 +79,8 @@ namespace Playlist
       void Activated(Playlist::Item::Data::Ptr);
       void ItemActivated(Playlist::Item::Data::Ptr);
       void ItemActivated(unsigned idx);
+      //! Items following activated one in play order, iterating over model so should be processed immediately
+      void UpcomingItems(Playlist::Item::Collection::Ptr);
       void Deactivated();
     };
   }  // namespace Item
@@ -19,16 +19,19 @@
 #include <make_ptr.h>
 #include <progress_callback.h>
 // library includes
+#include <binary/hash.h>
 #include <core/additional_files_resolve.h>
 #include <core/module_detect.h>
 #include <core/module_open.h>
 #include <core/plugin.h>
 #include <core/plugin_attrs.h>
+#include <core/plugins_parameters.h>
 #include <core/src/location.h>
 #include <debug/log.h>
 #include <io/api.h>
 #include <module/attributes.h>
 #include <module/properties/path.h>
+#include <parameters/convert.h>
 #include <parameters/merged_accessor.h>
 #include <parameters/merged_container.h>
 #include <parameters/template.h>
@@ -470,12 +473,13 @@ namespace
     {
       try
       {
-        State = Error();
-        return Source.GetModule(AdjustedParams);
+        auto holder = Source.GetModule(AdjustedParams);
+        SetState(Error());
+        return holder;
       }
       catch (const Error& e)
       {
-        State = e;
+        SetState(e);
       }
       return Module::Holder::Ptr();
     }
@@ -500,6 +504,7 @@ namespace
     // playlist-related properties
     Error GetState() const override
     {
+      const std::lock_guard<std::mutex> lock(StateLock);
       return State;
     }
 
@@ -559,6 +564,13 @@ namespace
     }
 
   private:
+    // module may be opened in background, e.g. for prefetching
+    void SetState(Error state) const
+    {
+      const std::lock_guard<std::mutex> lock(StateLock);
+      State = std::move(state);
+    }
+
     void SetValue(Parameters::Identifier /*name*/, Parameters::IntType /*val*/) override
     {
       OnPropertyChanged();
@@ -618,6 +630,7 @@ namespace
     String Title;
     String Comment;
     Time::Milliseconds Duration;
+    mutable std::mutex StateLock;
     mutable Error State;
   };
 
@@ -673,12 +686,59 @@ namespace
     const DataSource::Ptr Source;
   };
 
+  // items keep only properties and duration of detected modules, so playable model is built on playback
+  Parameters::Accessor::Ptr CreateDetectParameters(Parameters::Accessor::Ptr coreParams)
+  {
+    auto forced = Parameters::Container::Create();
+    forced->SetValue(Parameters::ZXTune::Core::Plugins::METADATA_ONLY, 1);
+    return Parameters::CreateMergedAccessor(std::move(forced), std::move(coreParams));
+  }
+
+  // order-independent to not depend on accessors layering
+  class SettingsHash : public Parameters::Visitor
+  {
+  public:
+    uint64_t Get() const
+    {
+      return Value;
+    }
+
+    void SetValue(Parameters::Identifier name, Parameters::IntType val) override
+    {
+      Add(name, Parameters::ConvertToString(val));
+    }
+
+    void SetValue(Parameters::Identifier name, StringView val) override
+    {
+      Add(name, Parameters::ConvertToString(val));
+    }
+
+    void SetValue(Parameters::Identifier name, Binary::View val) override
+    {
+      Add(name, Parameters::ConvertToString(val));
+    }
+
+  private:
+    void Add(Parameters::Identifier name, const String& val)
+    {
+      if (!name.RelativeTo(Parameters::ZXTune::Core::Plugins::PREFIX).IsEmpty())
+      {
+        const auto entry = String(static_cast<StringView>(name)) + '=' + val;
+        Value += Binary::Murmur3(Binary::View(entry.data(), entry.size())).Low;
+      }
+    }
+
+  private:
+    uint64_t Value = 0;
+  };
+
   class DataProviderImpl : public Playlist::Item::DataProvider
   {
   public:
     explicit DataProviderImpl(Parameters::Accessor::Ptr parameters)
       : Provider(MakePtr<CachedDataProvider>(parameters))
       , CoreParams(parameters)
+      , DetectParams(CreateDetectParameters(parameters))
       , Attributes(MakePtr<DynamicAttributesProvider>())
     {}
 
@@ -691,7 +751,7 @@ namespace
       {
         auto data = Provider->GetData(id->Path());
         DetectCallback detectCallback(detectParams, Attributes, Provider, CoreParams, std::move(id));
-        Module::Detect(*CoreParams, std::move(data), detectCallback);
+        Module::Detect(*DetectParams, std::move(data), detectCallback);
       }
       else
       {
@@ -705,12 +765,20 @@ namespace
 
       auto data = Provider->GetData(id->Path());
       DetectCallback detectCallback(detectParams, Attributes, Provider, CoreParams, id);
-      Module::Open(*CoreParams, std::move(data), id->Subpath(), detectCallback);
+      Module::Open(*DetectParams, std::move(data), id->Subpath(), detectCallback);
+    }
+
+    uint64_t GetSettingsHash() const override
+    {
+      SettingsHash hash;
+      CoreParams->Process(hash);
+      return hash.Get();
     }
 
   private:
     const CachedDataProvider::Ptr Provider;
     const Parameters::Accessor::Ptr CoreParams;
+    const Parameters::Accessor::Ptr DetectParams;
     const DynamicAttributesProvider::Ptr Attributes;
   };
 }  // namespace
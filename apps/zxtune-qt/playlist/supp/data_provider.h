@@ -40,6 +40,9 @@ namespace Playlist
 
       virtual void OpenModule(const String& path, DetectParameters& detectParams) const = 0;
 
+      //! @return Hash of current plugins settings affecting detection results
+      virtual uint64_t GetSettingsHash() const = 0;
+
       static Ptr Create(Parameters::Accessor::Ptr parameters);
     };
   }  // namespace Item
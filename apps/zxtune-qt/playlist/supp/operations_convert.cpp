@@ -75,6 +75,8 @@ namespace
 
     void OnFinish() override {}
 
+    void OnTransition() override {}
+
     void WaitForFinish()
     {
       if (Event.WaitForAny(STOPPED, CANCELED) == CANCELED)
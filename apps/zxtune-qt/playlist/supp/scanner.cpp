@@ -18,13 +18,30 @@
 #include <make_ptr.h>
 // library includes
 #include <async/coroutine.h>
+#include <async/data_receiver.h>
+#include <async/ordered_receiver.h>
+#include <async/scheduler.h>
 #include <debug/log.h>
 #include <time/elapsed.h>
 // std includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <map>
 #include <mutex>
+#include <thread>
+#include <vector>
 // qt includes
-#include <QtCore/QDirIterator>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QStringList>
+#include <QtGui/QDesktopServices>
 
 #define FILE_TAG EA26A866
 
@@ -40,230 +57,410 @@ namespace
     virtual void Add(const QStringList& items) = 0;
   };
 
-  class FilenamesSource
+  // size and modification time, used to find out unchanged files
+  struct FileStamp
   {
-  public:
-    virtual ~FilenamesSource() = default;
+    qint64 Size = -1;
+    qint64 LastModified = -1;
 
-    virtual bool Empty() const = 0;
-    virtual QString GetNext() = 0;
-  };
+    FileStamp() = default;
 
-  class SourceFilenames
-    : public FilenamesTarget
-    , public FilenamesSource
-  {
-  public:
-    void Add(const QStringList& items) override
+    explicit FileStamp(const QFileInfo& info)
     {
-      Items.append(items);
+      if (info.isFile())
+      {
+        Size = info.size();
+        LastModified = info.lastModified().toMSecsSinceEpoch();
+      }
     }
 
-    bool Empty() const override
+    bool IsValid() const
     {
-      return Items.isEmpty();
+      return Size >= 0;
     }
 
-    QString GetNext() override
+    bool operator==(const FileStamp& rh) const
     {
-      Require(!Items.isEmpty());
-      return Items.takeFirst();
+      return Size == rh.Size && LastModified == rh.LastModified;
     }
+  };
 
-  private:
-    QStringList Items;
+  struct FileEntry
+  {
+    QString Path;
+    FileStamp Stamp;
+  };
+
+  struct DirectoryEntry
+  {
+    typedef std::shared_ptr<DirectoryEntry> Ptr;
+
+    explicit DirectoryEntry(QString path)
+      : Path(std::move(path))
+    {}
+
+    const QString Path;
+    // filled by lister
+    bool Listed = false;
+    std::vector<FileEntry> Files;
+    std::vector<Ptr> Subdirectories;
   };
 
-  class ResolvedFilenames : public FilenamesSource
+  /*
+    Lists directories on shared scheduler. Subdirectories listing is started as soon as parent is listed, so the whole
+    tree is enumerated concurrently while consumer walks it in natural order.
+  */
+  class DirectoriesLister : public std::enable_shared_from_this<DirectoriesLister>
   {
   public:
-    explicit ResolvedFilenames(FilenamesSource& delegate)
-      : Delegate(delegate)
+    typedef std::shared_ptr<DirectoriesLister> Ptr;
+
+    DirectoriesLister()
+      : Scheduler(Async::Scheduler::GetShared())
     {}
 
-    bool Empty() const override
+    //! @param path file or directory
+    DirectoryEntry::Ptr Start(const QString& path)
     {
-      return NoCurrentDir() && Delegate.Empty();
+      auto entry = MakePtr<DirectoryEntry>(path);
+      ++Pending;
+      Scheduler->Post([self = shared_from_this(), entry]() { self->List(*entry); }, Async::Scheduler::Priority::HIGH);
+      return entry;
     }
 
-    QString GetNext() override
+    void WaitListed(const DirectoryEntry& entry)
     {
-      while (NoCurrentDir())
-      {
-        const QString res = Delegate.GetNext();
-        if (IsDir(res))
-        {
-          OpenDir(res);
-          continue;
-        }
-        else
-        {
-          CloseDir();
-          return res;
-        }
-      }
-      return CurDir->next();
+      std::unique_lock<std::mutex> lock(Lock);
+      Listed.wait(lock, [&entry]() { return entry.Listed; });
     }
 
-  private:
-    bool NoCurrentDir() const
+    void Cancel()
     {
-      return nullptr == CurDir.get() || !CurDir->hasNext();
+      Canceled = true;
     }
 
-    static bool IsDir(const QString& name)
+    unsigned FoundFiles() const
     {
-      return QFileInfo(name).isDir();
+      return Found;
     }
 
-    void OpenDir(const QString& name)
+    bool IsFinished() const
     {
-      const QDir::Filters filter = QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden;
-      CurDir.reset(new QDirIterator(name, filter, QDirIterator::Subdirectories));
+      return Pending == 0;
     }
 
-    void CloseDir()
+  private:
+    void List(DirectoryEntry& entry)
     {
-      CurDir.reset(nullptr);
+      std::vector<FileEntry> files;
+      std::vector<DirectoryEntry::Ptr> subdirs;
+      try
+      {
+        const QFileInfo info(entry.Path);
+        if (!info.isDir())
+        {
+          files.push_back({entry.Path, FileStamp(info)});
+        }
+        else if (!Canceled)
+        {
+          const QDir::Filters filter = QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden;
+          for (const auto& sub : QDir(entry.Path).entryInfoList(filter, QDir::Name))
+          {
+            if (!sub.isDir())
+            {
+              files.push_back({sub.filePath(), FileStamp(sub)});
+            }
+            else if (!sub.isSymLink())
+            {
+              subdirs.push_back(Start(sub.filePath()));
+            }
+          }
+        }
+      }
+      catch (const std::exception&)
+      {}
+      Found += static_cast<unsigned>(files.size());
+      {
+        const std::lock_guard<std::mutex> lock(Lock);
+        entry.Files = std::move(files);
+        entry.Subdirectories = std::move(subdirs);
+        entry.Listed = true;
+      }
+      --Pending;
+      Listed.notify_all();
     }
 
   private:
-    FilenamesSource& Delegate;
-    std::unique_ptr<QDirIterator> CurDir;
+    const Async::Scheduler::Ptr Scheduler;
+    std::mutex Lock;
+    std::condition_variable Listed;
+    std::atomic<bool> Canceled = false;
+    std::atomic<unsigned> Found = 0;
+    std::atomic<unsigned> Pending = 0;
   };
 
-  class PrefetchedFilenames : public FilenamesSource
+  class FilesQueue
+    : public FilenamesTarget
+    , public Playlist::ScanStatus
   {
   public:
-    PrefetchedFilenames(FilenamesSource& delegate, int lowerBound, int upperBound)
-      : Delegate(delegate)
-      , LowerBound(lowerBound)
-      , UpperBound(upperBound)
+    typedef std::shared_ptr<FilesQueue> Ptr;
+
+    FilesQueue()
+      : Lister(MakePtr<DirectoriesLister>())
     {}
 
-    bool Empty() const override
+    ~FilesQueue() override
     {
-      return Cache.isEmpty() && Delegate.Empty();
+      Lister->Cancel();
     }
 
-    QString GetNext() override
+    void Add(const QStringList& items) override
     {
-      Prefetch();
-      Require(!Cache.isEmpty());
-      return Cache.takeFirst();
+      const std::lock_guard<std::mutex> lock(Lock);
+      for (const auto& item : items)
+      {
+        Roots.push_back(Lister->Start(item));
+      }
     }
 
-  private:
-    void Prefetch()
+    // called from scanning thread only, depth-first traversal of added items
+    bool GetNext(FileEntry& file)
     {
-      int curSize = Cache.size();
-      if (curSize < LowerBound && !Delegate.Empty())
+      for (;;)
       {
-        for (; curSize < UpperBound && !Delegate.Empty(); ++curSize)
+        if (Walk.empty() && !TakeRoot())
         {
-          Cache.append(Delegate.GetNext());
+          return false;
+        }
+        auto& top = Walk.back();
+        Lister->WaitListed(*top.Entry);
+        if (top.Files < top.Entry->Files.size())
+        {
+          file = std::move(top.Entry->Files[top.Files++]);
+          return true;
+        }
+        else if (top.Subdirectories < top.Entry->Subdirectories.size())
+        {
+          auto next = std::move(top.Entry->Subdirectories[top.Subdirectories++]);
+          Walk.push_back({std::move(next)});
+        }
+        else
+        {
+          Walk.pop_back();
         }
       }
     }
 
-  private:
-    FilenamesSource& Delegate;
-    const int LowerBound;
-    const int UpperBound;
-    QStringList Cache;
-  };
+    void Cancel()
+    {
+      Lister->Cancel();
+    }
 
-  class FilenamesSourceStatistic : public FilenamesSource
-  {
-  public:
-    FilenamesSourceStatistic(FilenamesSource& delegate)
-      : Delegate(delegate)
-      , GotFilenames(0)
-    {}
+    void SetCurrentFile(const QString& file)
+    {
+      const std::lock_guard<std::mutex> lock(Lock);
+      Current = file;
+    }
+
+    void FileDone()
+    {
+      ++Done;
+    }
+
+    // ScanStatus
+    unsigned DoneFiles() const override
+    {
+      return Done;
+    }
+
+    unsigned FoundFiles() const override
+    {
+      return Lister->FoundFiles();
+    }
 
-    bool Empty() const override
+    QString CurrentFile() const override
     {
-      return Delegate.Empty();
+      const std::lock_guard<std::mutex> lock(Lock);
+      return Current;
     }
 
-    QString GetNext() override
+    bool SearchFinished() const override
     {
-      ++GotFilenames;
-      return Delegate.GetNext();
+      return Lister->IsFinished();
     }
 
-    unsigned Get() const
+  private:
+    bool TakeRoot()
     {
-      return GotFilenames;
+      const std::lock_guard<std::mutex> lock(Lock);
+      if (Roots.empty())
+      {
+        return false;
+      }
+      Walk.push_back({std::move(Roots.front())});
+      Roots.pop_front();
+      return true;
     }
 
   private:
-    FilenamesSource& Delegate;
-    unsigned GotFilenames;
+    struct WalkPosition
+    {
+      DirectoryEntry::Ptr Entry;
+      std::size_t Files = 0;
+      std::size_t Subdirectories = 0;
+    };
+
+    const DirectoriesLister::Ptr Lister;
+    mutable std::mutex Lock;
+    std::deque<DirectoryEntry::Ptr> Roots;
+    std::vector<WalkPosition> Walk;
+    std::atomic<unsigned> Done = 0;
+    QString Current;
   };
 
-  class FilesQueue
-    : public FilenamesTarget
-    , public FilenamesSource
-    , public Playlist::ScanStatus
+  const QDataStream::Version INDEX_STREAM_VERSION = QDataStream::Qt_4_6;
+  const quint32 INDEX_FORMAT_VERSION = 2;
+
+  QString GetIndexFilename()
   {
-  public:
-    typedef std::shared_ptr<FilesQueue> Ptr;
+    QDir dir(QDesktopServices::storageLocation(QDesktopServices::DataLocation));
+    const auto dirPath = QCoreApplication::applicationName();
+    if (!dir.mkpath(dirPath) || !dir.cd(dirPath))
+    {
+      return {};
+    }
+    return dir.absoluteFilePath("Scan.index");
+  }
 
-    FilesQueue()
-      : Resolved(Source)
-      , ResolvedStatistic(Resolved)
-      , Prefetched(ResolvedStatistic, 500, 1000)
-      , PrefetchedStatistic(Prefetched)
-    {}
+  /*
+    Modules found in already scanned files. Allows to open them directly instead of full detection on rescan.
+    Shared by all the scanners and stored between sessions. Entries are valid only for the same plugins settings.
+  */
+  class FilesIndex
+  {
+  public:
+    typedef std::shared_ptr<FilesIndex> Ptr;
 
-    void Add(const QStringList& items) override
+    explicit FilesIndex(QString filename)
+      : Filename(std::move(filename))
     {
-      const std::lock_guard<std::mutex> lock(Lock);
-      Source.Add(items);
+      Load();
     }
 
-    // FilenamesSource
-    bool Empty() const override
+    static Ptr GetShared()
     {
-      return Prefetched.Empty();
+      static const auto instance = MakePtr<FilesIndex>(GetIndexFilename());
+      return instance;
     }
 
-    QString GetNext() override
+    bool Find(const FileEntry& file, quint64 settings, std::vector<String>& modules) const
     {
+      if (!file.Stamp.IsValid())
+      {
+        return false;
+      }
       const std::lock_guard<std::mutex> lock(Lock);
-      return Current = PrefetchedStatistic.GetNext();
+      const auto it = Entries.find(file.Path);
+      if (it == Entries.end() || !(it->second.Stamp == file.Stamp) || it->second.Settings != settings)
+      {
+        return false;
+      }
+      modules = it->second.Modules;
+      return true;
     }
 
-    // ScanStatus
-    unsigned DoneFiles() const override
+    void Add(const FileEntry& file, quint64 settings, std::vector<String> modules)
     {
-      return PrefetchedStatistic.Get();
+      if (file.Stamp.IsValid())
+      {
+        const std::lock_guard<std::mutex> lock(Lock);
+        Entries[file.Path] = {file.Stamp, settings, std::move(modules)};
+        Modified = true;
+      }
     }
 
-    unsigned FoundFiles() const override
+    //! @brief Stores index if changed since last call
+    void Flush()
     {
-      return ResolvedStatistic.Get();
+      const std::lock_guard<std::mutex> lock(Lock);
+      if (!Modified || Filename.isEmpty())
+      {
+        return;
+      }
+      QFile device(Filename);
+      if (!device.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      {
+        Dbg("Failed to store index to '%1%'", FromQString(Filename));
+        return;
+      }
+      QDataStream stream(&device);
+      stream.setVersion(INDEX_STREAM_VERSION);
+      stream << INDEX_FORMAT_VERSION << static_cast<quint32>(Entries.size());
+      for (const auto& entry : Entries)
+      {
+        stream << entry.first << entry.second.Stamp.Size << entry.second.Stamp.LastModified << entry.second.Settings
+               << static_cast<quint32>(entry.second.Modules.size());
+        for (const auto& module : entry.second.Modules)
+        {
+          stream << ToQString(module);
+        }
+      }
+      Modified = false;
+      Dbg("Stored %1% files to index", Entries.size());
     }
 
-    QString CurrentFile() const override
+  private:
+    void Load()
     {
-      return Current;
+      QFile device(Filename);
+      if (Filename.isEmpty() || !device.open(QIODevice::ReadOnly))
+      {
+        return;
+      }
+      QDataStream stream(&device);
+      stream.setVersion(INDEX_STREAM_VERSION);
+      quint32 version = 0;
+      quint32 files = 0;
+      stream >> version >> files;
+      if (version != INDEX_FORMAT_VERSION)
+      {
+        return;
+      }
+      for (; files != 0 && stream.status() == QDataStream::Ok; --files)
+      {
+        QString path;
+        Entry entry;
+        quint32 modules = 0;
+        stream >> path >> entry.Stamp.Size >> entry.Stamp.LastModified >> entry.Settings >> modules;
+        for (; modules != 0 && stream.status() == QDataStream::Ok; --modules)
+        {
+          QString module;
+          stream >> module;
+          entry.Modules.push_back(FromQString(module));
+        }
+        Entries[path] = std::move(entry);
+      }
+      if (stream.status() != QDataStream::Ok)
+      {
+        Dbg("Corrupted index at '%1%'", FromQString(Filename));
+        Entries.clear();
+      }
+      Dbg("Loaded %1% files from index", Entries.size());
     }
 
-    bool SearchFinished() const override
+  private:
+    struct Entry
     {
-      return Resolved.Empty();
-    }
+      FileStamp Stamp;
+      quint64 Settings = 0;
+      std::vector<String> Modules;
+    };
 
-  private:
-    std::mutex Lock;
-    SourceFilenames Source;
-    ResolvedFilenames Resolved;
-    FilenamesSourceStatistic ResolvedStatistic;
-    PrefetchedFilenames Prefetched;
-    FilenamesSourceStatistic PrefetchedStatistic;
-    QString Current;
+    const QString Filename;
+    mutable std::mutex Lock;
+    std::map<QString, Entry> Entries;
+    bool Modified = false;
   };
 
   class ScannerCallback
@@ -271,7 +468,6 @@ namespace
   public:
     virtual ~ScannerCallback() = default;
 
-    virtual void OnItem(Playlist::Item::Data::Ptr item) = 0;
     virtual void OnItems(Playlist::Item::Collection::Ptr items) = 0;
     virtual void OnScanStart(Playlist::ScanStatus::Ptr status) = 0;
     virtual void OnProgress(unsigned progress) = 0;
@@ -280,11 +476,42 @@ namespace
     virtual void OnScanEnd() = 0;
   };
 
-  class DetectParamsAdapter : public Playlist::Item::DetectParameters
+  typedef std::vector<Playlist::Item::Data::Ptr> ItemsList;
+
+  class ItemsBatch : public Playlist::Item::Collection
   {
   public:
-    DetectParamsAdapter(ScannerCallback& cb, Log::ProgressCallback& progress)
-      : Callback(cb)
+    explicit ItemsBatch(ItemsList items)
+      : Items(std::move(items))
+    {}
+
+    bool IsValid() const override
+    {
+      return Position < Items.size();
+    }
+
+    Playlist::Item::Data::Ptr Get() const override
+    {
+      Require(IsValid());
+      return Items[Position];
+    }
+
+    void Next() override
+    {
+      Require(IsValid());
+      ++Position;
+    }
+
+  private:
+    const ItemsList Items;
+    std::size_t Position = 0;
+  };
+
+  class CollectItemsParams : public Playlist::Item::DetectParameters
+  {
+  public:
+    CollectItemsParams(ItemsList& items, Log::ProgressCallback& progress)
+      : Items(items)
       , Progress(progress)
     {}
 
@@ -295,7 +522,7 @@ namespace
 
     void ProcessItem(Playlist::Item::Data::Ptr item) override
     {
-      Callback.OnItem(item);
+      Items.push_back(std::move(item));
     }
 
     Log::ProgressCallback* GetProgress() const override
@@ -304,49 +531,191 @@ namespace
     }
 
   private:
-    ScannerCallback& Callback;
+    ItemsList& Items;
     Log::ProgressCallback& Progress;
   };
 
   const auto UI_NOTIFICATION_PERIOD = Time::Milliseconds(500);
 
+  // thrown on scanning workers to abort file processing
+  class ScanCanceled : public std::exception
+  {};
+
+  // cancel state shared by scanning thread and workers
+  class ScanControl
+  {
+  public:
+    void Reset()
+    {
+      Canceled = false;
+    }
+
+    void Cancel()
+    {
+      Canceled = true;
+    }
+
+    //! @throws ScanCanceled if canceled
+    void Check() const
+    {
+      if (Canceled)
+      {
+        throw ScanCanceled();
+      }
+    }
+
+  private:
+    std::atomic<bool> Canceled = false;
+  };
+
+  // used on scanning workers, so aborts file processing on stop instead of yielding
   class ProgressCallbackAdapter : public Log::ProgressCallback
   {
   public:
-    ProgressCallbackAdapter(ScannerCallback& cb, Async::Scheduler& sched)
+    ProgressCallbackAdapter(ScannerCallback& cb, const ScanControl& control)
       : Callback(cb)
-      , Scheduler(sched)
+      , Control(control)
       , ReportTimeout(UI_NOTIFICATION_PERIOD)
     {}
 
     void OnProgress(uint_t current) override
     {
+      Control.Check();
       if (ReportTimeout())
       {
         Callback.OnProgress(current);
-        Scheduler.Yield();
       }
     }
 
     void OnProgress(uint_t current, const String& message) override
     {
+      Control.Check();
       if (ReportTimeout())
       {
         Callback.OnProgress(current);
         Callback.OnMessage(ToQString(message));
-        Scheduler.Yield();
       }
     }
 
   private:
     ScannerCallback& Callback;
-    Async::Scheduler& Scheduler;
+    const ScanControl& Control;
     Time::Elapsed ReportTimeout;
   };
 
+  struct ScanTask
+  {
+    std::size_t Index = 0;
+    FileEntry File;
+  };
+
+  struct ScanResult
+  {
+    std::size_t Index = 0;
+    Playlist::Item::Collection::Ptr Playlist;
+    ItemsList Items;
+    Error State;
+  };
+
+  class FileScanner
+  {
+  public:
+    virtual ~FileScanner() = default;
+
+    virtual void Scan(const FileEntry& file, ScanResult& result) const = 0;
+  };
+
+  class ScanEndpoint : public DataReceiver<ScanTask>
+  {
+  public:
+    ScanEndpoint(const FileScanner& scanner, FilesQueue& queue, DataReceiver<ScanResult>& target)
+      : Scanner(scanner)
+      , Queue(queue)
+      , Target(target)
+    {}
+
+    void ApplyData(ScanTask task) override
+    {
+      ScanResult result;
+      result.Index = task.Index;
+      try
+      {
+        Queue.SetCurrentFile(task.File.Path);
+        Scanner.Scan(task.File, result);
+      }
+      catch (const ScanCanceled&)
+      {}
+      // every index should be passed to keep ordering
+      Target.ApplyData(std::move(result));
+    }
+
+    void Flush() override {}
+
+  private:
+    const FileScanner& Scanner;
+    FilesQueue& Queue;
+    DataReceiver<ScanResult>& Target;
+  };
+
+  // called in order of scanned files, passes items to model in batches to reduce locking and notifications
+  class BatchingEndpoint : public DataReceiver<ScanResult>
+  {
+  public:
+    BatchingEndpoint(ScannerCallback& cb, FilesQueue& queue)
+      : Callback(cb)
+      , Queue(queue)
+      , SendTimeout(UI_NOTIFICATION_PERIOD)
+    {}
+
+    void ApplyData(ScanResult result) override
+    {
+      if (result.Playlist)
+      {
+        Send();
+        Callback.OnItems(std::move(result.Playlist));
+      }
+      Batch.insert(Batch.end(), std::make_move_iterator(result.Items.begin()),
+                   std::make_move_iterator(result.Items.end()));
+      if (result.State)
+      {
+        Send();
+        Callback.OnError(result.State);
+      }
+      Queue.FileDone();
+      if (Batch.size() >= MAX_BATCH_SIZE || SendTimeout())
+      {
+        Send();
+      }
+    }
+
+    void Flush() override
+    {
+      Send();
+    }
+
+  private:
+    void Send()
+    {
+      if (!Batch.empty())
+      {
+        ItemsList items;
+        items.swap(Batch);
+        Callback.OnItems(MakePtr<ItemsBatch>(std::move(items)));
+      }
+    }
+
+  private:
+    static const std::size_t MAX_BATCH_SIZE = 1000;
+    ScannerCallback& Callback;
+    FilesQueue& Queue;
+    Time::Elapsed SendTimeout;
+    ItemsList Batch;
+  };
+
   class ScanRoutine
     : public FilenamesTarget
     , public Async::Coroutine
+    , private FileScanner
   {
   public:
     typedef std::shared_ptr<ScanRoutine> Ptr;
@@ -354,60 +723,112 @@ namespace
     ScanRoutine(ScannerCallback& cb, Playlist::Item::DataProvider::Ptr provider)
       : Callback(cb)
       , Provider(std::move(provider))
+      , Index(FilesIndex::GetShared())
     {
       CreateQueue();
     }
 
     void Add(const QStringList& items) override
     {
-      Queue->Add(items);
+      GetQueue()->Add(items);
+    }
+
+    //! @brief Aborts processing of files being scanned, should be called before job stopping
+    void Cancel()
+    {
+      Control.Cancel();
     }
 
     void Initialize() override
     {
-      Callback.OnScanStart(Queue);
+      Control.Reset();
+      Callback.OnScanStart(GetQueue());
     }
 
     void Finalize() override
     {
+      GetQueue()->Cancel();
+      Index->Flush();
       Callback.OnScanEnd();
       CreateQueue();
     }
 
+    // scanning thread stops passing files to workers while paused, workers are shared and never wait for resume
     void Suspend() override {}
 
     void Resume() override {}
 
-    void Execute(Async::Scheduler& sched) override
+    void Execute(Async::Coroutine::Scheduler& sched) override
     {
-      ProgressCallbackAdapter cb(Callback, sched);
-      while (!Queue->Empty())
+      const auto queue = GetQueue();
+      Settings = Provider->GetSettingsHash();
+      const auto workers = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+      const auto target = std::make_shared<Async::OrderedReceiver<ScanResult>>(MakePtr<BatchingEndpoint>(Callback, *queue));
+      auto scanner = Async::DataReceiver<ScanTask>::Create(
+          workers, workers * 4, MakePtr<ScanEndpoint>(static_cast<const FileScanner&>(*this), *queue, *target));
+      try
       {
-        try
+        // limit results waiting for slow file
+        const std::size_t maxPending = workers * 64;
+        std::size_t index = 0;
+        for (FileEntry file; queue->GetNext(file);)
         {
-          const QString file = Queue->GetNext();
-          ScanFile(file, cb);
+          sched.Yield();
+          if (index >= maxPending && !target->WaitDelivered(index - maxPending))
+          {
+            break;
+          }
+          scanner->ApplyData({index++, std::move(file)});
         }
-        catch (const std::exception&)
-        {}
+        scanner->Flush();
       }
+      catch (...)
+      {
+        // keep already found items on stopping
+        Control.Cancel();
+        scanner.reset();
+        FlushResults(*target);
+        throw;
+      }
+      FlushResults(*target);
     }
 
   private:
+    // items may be added concurrently with scanning
+    FilesQueue::Ptr GetQueue() const
+    {
+      const std::lock_guard<std::mutex> lock(QueueLock);
+      return Queue;
+    }
+
     void CreateQueue()
     {
-      Queue = MakePtr<FilesQueue>();
+      auto queue = MakePtr<FilesQueue>();
+      const std::lock_guard<std::mutex> lock(QueueLock);
+      Queue = std::move(queue);
+    }
+
+    static void FlushResults(DataReceiver<ScanResult>& target)
+    {
+      try
+      {
+        target.Flush();
+      }
+      catch (const std::exception&)
+      {}
     }
 
-    void ScanFile(const QString& name, Log::ProgressCallback& cb)
+    void Scan(const FileEntry& file, ScanResult& result) const override
     {
-      if (!ProcessAsPlaylist(name, cb))
+      Control.Check();
+      ProgressCallbackAdapter cb(Callback, Control);
+      if (!ProcessAsPlaylist(file.Path, cb, result))
       {
-        DetectSubitems(name, cb);
+        DetectSubitems(file, cb, result);
       }
     }
 
-    bool ProcessAsPlaylist(const QString& path, Log::ProgressCallback& cb)
+    bool ProcessAsPlaylist(const QString& path, Log::ProgressCallback& cb, ScanResult& result) const
     {
       try
       {
@@ -416,32 +837,53 @@ namespace
         {
           return false;
         }
-        Callback.OnItems(playlist->GetItems());
+        result.Playlist = playlist->GetItems();
       }
       catch (const Error& e)
       {
-        Callback.OnError(e);
+        result.State = e;
       }
       return true;
     }
 
-    void DetectSubitems(const QString& itemPath, Log::ProgressCallback& cb)
+    void DetectSubitems(const FileEntry& file, Log::ProgressCallback& cb, ScanResult& result) const
     {
       try
       {
-        DetectParamsAdapter params(Callback, cb);
-        Provider->DetectModules(FromQString(itemPath), params);
+        CollectItemsParams params(result.Items, cb);
+        std::vector<String> modules;
+        if (Index->Find(file, Settings, modules))
+        {
+          for (const auto& module : modules)
+          {
+            Provider->OpenModule(module, params);
+          }
+        }
+        else
+        {
+          Provider->DetectModules(FromQString(file.Path), params);
+          for (const auto& item : result.Items)
+          {
+            modules.push_back(item->GetFullPath());
+          }
+          Index->Add(file, Settings, std::move(modules));
+        }
       }
       catch (const Error& e)
       {
-        Callback.OnError(e);
+        result.State = e;
       }
     }
 
   private:
     ScannerCallback& Callback;
     const Playlist::Item::DataProvider::Ptr Provider;
+    const FilesIndex::Ptr Index;
+    mutable std::mutex QueueLock;
     FilesQueue::Ptr Queue;
+    ScanControl Control;
+    // set before passing files to workers
+    quint64 Settings = 0;
   };
 
   class ScannerImpl
@@ -494,15 +936,11 @@ namespace
     void Stop() override
     {
       Dbg("Stopping %1%", this);
+      Routine->Cancel();
       ScanJob->Stop();
     }
 
   private:
-    void OnItem(Playlist::Item::Data::Ptr item) override
-    {
-      emit ItemFound(item);
-    }
-
     void OnItems(Playlist::Item::Collection::Ptr items) override
     {
       emit ItemsFound(items);
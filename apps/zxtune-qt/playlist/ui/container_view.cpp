@@ -381,6 +381,11 @@ namespace
                       SLOT(ActivateItem(Playlist::Item::Data::Ptr))));
       Require(connect(plView, SIGNAL(ItemActivated(Playlist::Item::Data::Ptr)),
                       SIGNAL(ItemActivated(Playlist::Item::Data::Ptr))));
+      Require(connect(plView, SIGNAL(UpcomingItems(Playlist::Item::Collection::Ptr)),
+                      SIGNAL(UpcomingItems(Playlist::Item::Collection::Ptr))));
+      // bound parameters are updated by previously connected handlers
+      Require(plView->connect(actionLoop, SIGNAL(toggled(bool)), SLOT(UpdatePlayorder())));
+      Require(plView->connect(actionRandom, SIGNAL(toggled(bool)), SLOT(UpdatePlayorder())));
       if (!ActivePlaylistView)
       {
         SwitchTo(plView);
@@ -71,6 +71,7 @@ namespace Playlist
     signals:
       void Activated(Playlist::Item::Data::Ptr);
       void ItemActivated(Playlist::Item::Data::Ptr);
+      void UpcomingItems(Playlist::Item::Collection::Ptr);
       void Deactivated();
     };
   }  // namespace UI
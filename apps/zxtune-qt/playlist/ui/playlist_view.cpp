@@ -351,6 +351,9 @@ namespace
       Require(connect(Controller.get(), SIGNAL(Renamed(const QString&)), SIGNAL(Renamed(const QString&))));
       Require(connect(iter, SIGNAL(ItemActivated(Playlist::Item::Data::Ptr)),
                       SIGNAL(ItemActivated(Playlist::Item::Data::Ptr))));
+      Require(connect(iter, SIGNAL(UpcomingItems(Playlist::Item::Collection::Ptr)),
+                      SIGNAL(UpcomingItems(Playlist::Item::Collection::Ptr))));
+      iter->SetPlayorderMode(Options.GetPlayorderMode());
 
       const Playlist::Model::Ptr model = Controller->GetModel();
       Require(connect(model, SIGNAL(OperationStarted()), SLOT(LongOperationStart())));
@@ -427,6 +430,12 @@ namespace
       {}
     }
 
+    void UpdatePlayorder() override
+    {
+      const Playlist::Item::Iterator::Ptr iter = Controller->GetIterator();
+      iter->SetPlayorderMode(Options.GetPlayorderMode());
+    }
+
     void Clear() override
     {
       const Playlist::Model::Ptr model = Controller->GetModel();
@@ -44,6 +44,7 @@ namespace Playlist
       virtual void Finish() = 0;
       virtual void Next() = 0;
       virtual void Prev() = 0;
+      virtual void UpdatePlayorder() = 0;
       virtual void Clear() = 0;
       virtual void AddFiles() = 0;
       virtual void AddFolder() = 0;
@@ -57,6 +58,7 @@ namespace Playlist
     signals:
       void Renamed(const QString&);
       void ItemActivated(Playlist::Item::Data::Ptr);
+      void UpcomingItems(Playlist::Item::Collection::Ptr);
     };
   }  // namespace UI
 }  // namespace Playlist
@@ -10,20 +10,29 @@
 
 // local includes
 #include "playback_supp.h"
+#include "playlist/parameters.h"
 #include "playlist/supp/data.h"
+#include "prefetcher.h"
 #include "ui/utils.h"
 // common includes
 #include <contract.h>
 #include <error.h>
 #include <pointers.h>
 // library includes
+#include <debug/log.h>
 #include <parameters/merged_accessor.h>
 #include <sound/service.h>
+#include <sound/sound_parameters.h>
 // qt includes
 #include <QtCore/QTimer>
 
 namespace
 {
+  const Debug::Stream Dbg("Playback::Support");
+
+  // Next item is passed to backend when current one is about to end, so it's already prefetched to this moment
+  const Time::Milliseconds TRANSITION_SCHEDULE_AHEAD(5000);
+
   class StubControl : public Sound::PlaybackControl
   {
   public:
@@ -54,7 +63,9 @@ namespace
   public:
     PlaybackSupportImpl(QObject& parent, Parameters::Accessor::Ptr sndOptions)
       : PlaybackSupport(parent)
+      , Options(sndOptions)
       , Service(Sound::CreateSystemService(sndOptions))
+      , Prefetch(Prefetcher::Create(sndOptions))
       , Control(StubControl::Instance())
     {
       const unsigned UI_UPDATE_FPS = 5;
@@ -63,6 +74,7 @@ namespace
           Timer.connect(this, SIGNAL(OnStartModule(Sound::Backend::Ptr, Playlist::Item::Data::Ptr)), SLOT(start())));
       Require(Timer.connect(this, SIGNAL(OnStopModule()), SLOT(stop())));
       Require(connect(&Timer, SIGNAL(timeout()), SIGNAL(OnUpdateState())));
+      Require(connect(&Timer, SIGNAL(timeout()), SLOT(ScheduleTransition())));
     }
 
     void SetDefaultItem(Playlist::Item::Data::Ptr item) override
@@ -76,6 +88,15 @@ namespace
 
     void SetItem(Playlist::Item::Data::Ptr item) override
     {
+      if (TransitedItem && TransitedItem == item)
+      {
+        // playlist followed the gapless transition, backend already plays the item
+        Dbg("Continue playback with transited item");
+        TransitedItem.reset();
+        Item = std::move(item);
+        emit OnStartModule(Backend, Item);
+        return;
+      }
       try
       {
         if (LoadItem(item))
@@ -89,10 +110,41 @@ namespace
       }
     }
 
+    void PrefetchItems(Playlist::Item::Collection::Ptr items) override
+    {
+      using namespace Parameters::ZXTuneQT::Playlist::Cache;
+      Parameters::IntType limit = PREFETCH_ITEMS_DEFAULT;
+      Options->FindValue(PREFETCH_ITEMS, limit);
+      std::vector<Playlist::Item::Data::Ptr> upcoming;
+      Playlist::Item::Data::Ptr next;
+      for (; items->IsValid(); items->Next())
+      {
+        auto item = items->Get();
+        if (item->GetState())
+        {
+          continue;
+        }
+        if (!next)
+        {
+          next = item;
+        }
+        if (Parameters::IntType(upcoming.size()) >= limit)
+        {
+          break;
+        }
+        upcoming.push_back(std::move(item));
+      }
+      Prefetch->Prefetch(std::move(upcoming));
+      SetNextItem(std::move(next));
+    }
+
     void ResetItem() override
     {
       Stop();
       Item.reset();
+      NextItem.reset();
+      ScheduledItem.reset();
+      TransitedItem.reset();
       Control = StubControl::Instance();
       Backend.reset();
     }
@@ -153,6 +205,58 @@ namespace
       }
     }
 
+    void ScheduleTransition() override
+    {
+      if (!Backend || !NextItem || ScheduledItem == NextItem)
+      {
+        return;
+      }
+      using namespace Parameters::ZXTune::Sound;
+      Parameters::IntType crossfade = CROSSFADE_DEFAULT;
+      Options->FindValue(CROSSFADE, crossfade);
+      const auto ahead = TRANSITION_SCHEDULE_AHEAD + Time::Milliseconds::FromRatio(crossfade, CROSSFADE_PRECISION);
+      const auto pos = Backend->GetState()->At();
+      if (pos + ahead < Time::AtMillisecond() + Duration)
+      {
+        return;
+      }
+      // retry on the next update, preparing is never performed on UI thread here
+      Module::Holder::Ptr module;
+      if (!Prefetch->FindPrepared(NextItem, module))
+      {
+        return;
+      }
+      // do not retry in case of error, item is played regular way after the current one
+      ScheduledItem = NextItem;
+      try
+      {
+        if (module)
+        {
+          Backend->GetTransitionControl()->SetNext(module);
+          ScheduledDuration = module->GetModuleInformation()->Duration();
+          Dbg("Scheduled transition to '%1%'", NextItem->GetFullPath());
+        }
+      }
+      catch (const Error& e)
+      {
+        emit ErrorOccurred(e);
+      }
+    }
+
+    void CompleteTransition() override
+    {
+      if (!ScheduledItem)
+      {
+        // backend was changed after transition
+        return;
+      }
+      TransitedItem = std::move(ScheduledItem);
+      NextItem.reset();
+      Duration = ScheduledDuration;
+      // playlist moves to the next item as if the previous one was finished
+      emit OnFinishModule();
+    }
+
     // BackendCallback
     void OnStart() override
     {
@@ -181,10 +285,16 @@ namespace
       emit OnFinishModule();
     }
 
+    // called from playback thread
+    void OnTransition() override
+    {
+      QMetaObject::invokeMethod(this, "CompleteTransition", Qt::QueuedConnection);
+    }
+
   private:
     bool LoadItem(Playlist::Item::Data::Ptr item)
     {
-      const Module::Holder::Ptr module = item->GetModule();
+      const Module::Holder::Ptr module = Prefetch->GetModule(item);
       if (!module)
       {
         return false;
@@ -197,6 +307,7 @@ namespace
         {
           Control = Backend->GetPlaybackControl();
           Item = item;
+          Duration = module->GetModuleInformation()->Duration();
           return true;
         }
       }
@@ -229,6 +340,29 @@ namespace
       return Sound::Backend::Ptr();
     }
 
+    void SetNextItem(Playlist::Item::Data::Ptr item)
+    {
+      if (NextItem == item)
+      {
+        return;
+      }
+      NextItem = std::move(item);
+      if (ScheduledItem)
+      {
+        // backend keeps single pending module
+        ScheduledItem.reset();
+        try
+        {
+          Backend->GetTransitionControl()->SetNext({});
+        }
+        catch (const Error& e)
+        {
+          emit ErrorOccurred(e);
+        }
+      }
+      ScheduleTransition();
+    }
+
     void ReportErrors(const std::list<Error>& errors)
     {
       for (const auto& err : errors)
@@ -238,11 +372,19 @@ namespace
     }
 
   private:
+    const Parameters::Accessor::Ptr Options;
     const Sound::Service::Ptr Service;
+    const Prefetcher::Ptr Prefetch;
     QTimer Timer;
     Playlist::Item::Data::Ptr Item;
     Sound::Backend::Ptr Backend;
     Sound::PlaybackControl::Ptr Control;
+    Time::Milliseconds Duration;
+    // gapless transition support
+    Playlist::Item::Data::Ptr NextItem;
+    Playlist::Item::Data::Ptr ScheduledItem;
+    Time::Milliseconds ScheduledDuration;
+    Playlist::Item::Data::Ptr TransitedItem;
   };
 }  // namespace
 
@@ -29,11 +29,15 @@ public:
 public slots:
   virtual void SetDefaultItem(Playlist::Item::Data::Ptr item) = 0;
   virtual void SetItem(Playlist::Item::Data::Ptr item) = 0;
+  virtual void PrefetchItems(Playlist::Item::Collection::Ptr items) = 0;
   virtual void ResetItem() = 0;
   virtual void Play() = 0;
   virtual void Stop() = 0;
   virtual void Pause() = 0;
   virtual void Seek(Time::AtMillisecond request) = 0;
+private slots:
+  virtual void ScheduleTransition() = 0;
+  virtual void CompleteTransition() = 0;
 signals:
   void OnStartModule(Sound::Backend::Ptr, Playlist::Item::Data::Ptr);
   void OnUpdateState();
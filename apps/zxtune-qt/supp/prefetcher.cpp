@@ -0,0 +1,312 @@
+/**
+ *
+ * @file
+ *
+ * @brief Playback items prefetching implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "prefetcher.h"
+// common includes
+#include <error.h>
+#include <make_ptr.h>
+// library includes
+#include <async/scheduler.h>
+#include <debug/log.h>
+#include <module/players/delayed_state.h>
+#include <parameters/merged_accessor.h>
+#include <sound/loop.h>
+#include <sound/render_params.h>
+// std includes
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace
+{
+  const Debug::Stream Dbg("Playback::Prefetcher");
+
+  // Frames rendered in advance to warm up emulation
+  const uint_t PRERENDERED_FRAMES = 1;
+
+  // Sound rendered but not delivered yet
+  class PrerenderedSound : public Module::StateDelay
+  {
+  public:
+    typedef std::shared_ptr<PrerenderedSound> Ptr;
+
+    explicit PrerenderedSound(uint_t samplerate)
+      : Samplerate(samplerate)
+    {}
+
+    Time::Milliseconds Get() const override
+    {
+      return Time::Milliseconds::FromRatio(Samples.load(), Samplerate);
+    }
+
+    std::atomic<std::size_t> Samples = {0};
+
+  private:
+    const uint_t Samplerate;
+  };
+
+  class PrerenderedRenderer : public Module::Renderer
+  {
+  public:
+    PrerenderedRenderer(Module::Renderer::Ptr delegate, uint_t samplerate, uint_t frames)
+      : Delegate(std::move(delegate))
+      , Ahead(MakePtr<PrerenderedSound>(samplerate))
+      , State(Module::CreateDelayedState(Delegate->GetState(), Ahead))
+    {
+      const Sound::LoopParameters noLoop;
+      for (uint_t frame = 0; frame != frames; ++frame)
+      {
+        auto data = Delegate->Render(noLoop);
+        if (data.empty())
+        {
+          break;
+        }
+        Ahead->Samples += data.size();
+        Frames.push_back(std::move(data));
+      }
+    }
+
+    Module::State::Ptr GetState() const override
+    {
+      return State;
+    }
+
+    Sound::Chunk Render(const Sound::LoopParameters& looped) override
+    {
+      if (Frames.empty())
+      {
+        return Delegate->Render(looped);
+      }
+      auto result = std::move(Frames.front());
+      Frames.pop_front();
+      Ahead->Samples -= result.size();
+      return result;
+    }
+
+    void Reset() override
+    {
+      Drop();
+      Delegate->Reset();
+    }
+
+    void SetPosition(Time::AtMillisecond position) override
+    {
+      Drop();
+      Delegate->SetPosition(position);
+    }
+
+  private:
+    void Drop()
+    {
+      Frames.clear();
+      Ahead->Samples = 0;
+    }
+
+  private:
+    const Module::Renderer::Ptr Delegate;
+    const PrerenderedSound::Ptr Ahead;
+    const Module::State::Ptr State;
+    std::deque<Sound::Chunk> Frames;
+  };
+
+  // Gives prepared renderer to the first request with matched samplerate
+  class PreparedHolder : public Module::Holder
+  {
+  public:
+    PreparedHolder(Module::Holder::Ptr delegate, uint_t samplerate, Module::Renderer::Ptr renderer)
+      : Delegate(std::move(delegate))
+      , Samplerate(samplerate)
+      , Prepared(std::move(renderer))
+    {}
+
+    Module::Information::Ptr GetModuleInformation() const override
+    {
+      return Delegate->GetModuleInformation();
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Delegate->GetModuleProperties();
+    }
+
+    Module::Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr params) const override
+    {
+      if (samplerate == Samplerate)
+      {
+        // prepared renderer uses the same parameters chain as sound backend does
+        const std::lock_guard<std::mutex> lock(Guard);
+        if (Prepared)
+        {
+          Dbg("Use prepared renderer");
+          return std::move(Prepared);
+        }
+      }
+      return Delegate->CreateRenderer(samplerate, std::move(params));
+    }
+
+  private:
+    const Module::Holder::Ptr Delegate;
+    const uint_t Samplerate;
+    mutable std::mutex Guard;
+    mutable Module::Renderer::Ptr Prepared;
+  };
+
+  class PrefetchedItem
+  {
+  public:
+    typedef std::shared_ptr<PrefetchedItem> Ptr;
+
+    PrefetchedItem(Playlist::Item::Data::Ptr item, Parameters::Accessor::Ptr sndOptions)
+      : Item(std::move(item))
+      , SoundOptions(std::move(sndOptions))
+    {}
+
+    const Playlist::Item::Data::Ptr& GetItem() const
+    {
+      return Item;
+    }
+
+    //! @note Performs preparing in caller's thread or waits for background one
+    Module::Holder::Ptr GetModule()
+    {
+      std::call_once(Done, [this]() {
+        Result = Prepare();
+        Ready = true;
+      });
+      return Result;
+    }
+
+    bool IsReady() const
+    {
+      return Ready;
+    }
+
+  private:
+    Module::Holder::Ptr Prepare() const
+    {
+      auto holder = Item->GetModule();
+      if (!holder)
+      {
+        return {};
+      }
+      try
+      {
+        const auto samplerate = Sound::GetSoundFrequency(*SoundOptions);
+        auto props = Parameters::CreateMergedAccessor(holder->GetModuleProperties(), SoundOptions);
+        auto renderer = MakePtr<PrerenderedRenderer>(holder->CreateRenderer(samplerate, std::move(props)), samplerate,
+                                                     PRERENDERED_FRAMES);
+        Dbg("Prepared '%1%'", Item->GetFullPath());
+        return MakePtr<PreparedHolder>(std::move(holder), samplerate, std::move(renderer));
+      }
+      catch (const Error& e)
+      {
+        Dbg("Failed to prepare renderer for '%1%': %2%", Item->GetFullPath(), e.ToString());
+        return holder;
+      }
+    }
+
+  private:
+    const Playlist::Item::Data::Ptr Item;
+    const Parameters::Accessor::Ptr SoundOptions;
+    std::once_flag Done;
+    std::atomic<bool> Ready = false;
+    Module::Holder::Ptr Result;
+  };
+
+  class PrefetcherImpl : public Prefetcher
+  {
+  public:
+    explicit PrefetcherImpl(Parameters::Accessor::Ptr sndOptions)
+      : SoundOptions(std::move(sndOptions))
+      , Scheduler(Async::Scheduler::GetShared())
+    {}
+
+    void Prefetch(std::vector<Playlist::Item::Data::Ptr> items) override
+    {
+      std::vector<PrefetchedItem::Ptr> entries;
+      entries.reserve(items.size());
+      for (auto& item : items)
+      {
+        auto entry = Find(item);
+        if (!entry)
+        {
+          entry = Schedule(std::move(item));
+        }
+        entries.push_back(std::move(entry));
+      }
+      Entries.swap(entries);
+    }
+
+    Module::Holder::Ptr GetModule(Playlist::Item::Data::Ptr item) override
+    {
+      if (const auto entry = Find(item))
+      {
+        Entries.erase(std::find(Entries.begin(), Entries.end(), entry));
+        if (auto module = entry->GetModule())
+        {
+          return module;
+        }
+      }
+      return item->GetModule();
+    }
+
+    bool FindPrepared(Playlist::Item::Data::Ptr item, Module::Holder::Ptr& module) override
+    {
+      const auto entry = Find(item);
+      if (!entry)
+      {
+        Entries.push_back(Schedule(std::move(item)));
+        return false;
+      }
+      else if (!entry->IsReady())
+      {
+        return false;
+      }
+      Entries.erase(std::find(Entries.begin(), Entries.end(), entry));
+      module = entry->GetModule();
+      return true;
+    }
+
+  private:
+    PrefetchedItem::Ptr Schedule(Playlist::Item::Data::Ptr item) const
+    {
+      auto entry = MakePtr<PrefetchedItem>(std::move(item), SoundOptions);
+      // dropped entries are not prepared
+      Scheduler->Post(
+          [weak = std::weak_ptr<PrefetchedItem>(entry)]() {
+            if (const auto entry = weak.lock())
+            {
+              entry->GetModule();
+            }
+          },
+          Async::Scheduler::Priority::LOW);
+      return entry;
+    }
+
+    PrefetchedItem::Ptr Find(const Playlist::Item::Data::Ptr& item) const
+    {
+      const auto it = std::find_if(Entries.begin(), Entries.end(),
+                                   [&item](const PrefetchedItem::Ptr& entry) { return entry->GetItem() == item; });
+      return it != Entries.end() ? *it : PrefetchedItem::Ptr();
+    }
+
+  private:
+    const Parameters::Accessor::Ptr SoundOptions;
+    const Async::Scheduler::Ptr Scheduler;
+    std::vector<PrefetchedItem::Ptr> Entries;
+  };
+}  // namespace
+
+Prefetcher::Ptr Prefetcher::Create(Parameters::Accessor::Ptr sndOptions)
+{
+  return MakePtr<PrefetcherImpl>(std::move(sndOptions));
+}
@@ -0,0 +1,39 @@
+/**
+ *
+ * @file
+ *
+ * @brief Playback items prefetching interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// local includes
+#include "playlist/supp/data.h"
+// library includes
+#include <parameters/accessor.h>
+// std includes
+#include <vector>
+
+//! @brief Prepares modules and renderers for upcoming playlist items in background
+//! @note Not thread-safe, should be used from the single (UI) thread
+class Prefetcher
+{
+public:
+  typedef std::shared_ptr<Prefetcher> Ptr;
+
+  virtual ~Prefetcher() = default;
+
+  //! @brief Schedule preparing of specified items, previously prefetched items not in list are dropped
+  virtual void Prefetch(std::vector<Playlist::Item::Data::Ptr> items) = 0;
+  //! @brief Get module for playback using prepared data if available
+  //! @return empty pointer in case of error, same as Playlist::Item::Data::GetModule
+  virtual Module::Holder::Ptr GetModule(Playlist::Item::Data::Ptr item) = 0;
+  //! @brief Get module for playback without waiting, schedules preparing of not prefetched item
+  //! @return false if item is not prepared yet, module is empty in case of error
+  virtual bool FindPrepared(Playlist::Item::Data::Ptr item, Module::Holder::Ptr& module) = 0;
+
+  static Ptr Create(Parameters::Accessor::Ptr sndOptions);
+};
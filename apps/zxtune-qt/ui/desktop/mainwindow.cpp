@@ -128,6 +128,8 @@ namespace
                                 SLOT(SetDefaultItem(Playlist::Item::Data::Ptr))));
       Require(Playback->connect(MultiPlaylist, SIGNAL(ItemActivated(Playlist::Item::Data::Ptr)),
                                 SLOT(SetItem(Playlist::Item::Data::Ptr))));
+      Require(Playback->connect(MultiPlaylist, SIGNAL(UpcomingItems(Playlist::Item::Collection::Ptr)),
+                                SLOT(PrefetchItems(Playlist::Item::Collection::Ptr))));
       Require(Playback->connect(MultiPlaylist, SIGNAL(Deactivated()), SLOT(ResetItem())));
       Require(connect(Playback, SIGNAL(OnStartModule(Sound::Backend::Ptr, Playlist::Item::Data::Ptr)),
                       SLOT(StartModule(Sound::Backend::Ptr, Playlist::Item::Data::Ptr))));
@@ -15,36 +15,50 @@
 #include "information.h"
 #include "sound.h"
 #include "source.h"
+#include <apps/benchmark/core/memory.h>
+#include <apps/benchmark/core/report.h>
 // common includes
 #include <error_tools.h>
 #include <progress_callback.h>
 // library includes
 #include <async/data_receiver.h>
+#include <async/ordered_receiver.h>
 #include <async/src/event.h>
 #include <binary/container_factories.h>
 #include <binary/crc.h>
 #include <core/core_parameters.h>
 #include <core/plugin.h>
 #include <core/plugin_attrs.h>
+#include <core/plugins_parameters.h>
 #include <io/api.h>
 #include <io/template.h>
 #include <module/attributes.h>
 #include <module/conversion/api.h>
 #include <module/conversion/types.h>
+#include <module/players/duration.h>
+#include <module/players/duration_probe.h>
 #include <parameters/merged_accessor.h>
 #include <parameters/template.h>
 #include <platform/application.h>
 #include <platform/version/api.h>
 #include <sound/loop.h>
 #include <sound/sound_parameters.h>
+#include <strings/template.h>
 #include <time/duration.h>
+#include <time/serialize.h>
 #include <time/timer.h>
 // std includes
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <deque>
+#include <fstream>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <numeric>
+#include <thread>
 // boost includes
 #include <boost/program_options.hpp>
 
@@ -69,10 +83,12 @@ namespace
     return nameTemplate;
   }
 
+  // empty Data means item skipped by conversion, Index is sequence number of item
   struct HolderAndData
   {
     Module::Holder::Ptr Holder;
     Binary::Data::Ptr Data;
+    std::size_t Index = 0;
 
     typedef DataReceiver<HolderAndData> Receiver;
   };
@@ -88,28 +104,52 @@ namespace
 
     void ApplyData(HolderAndData data) override
     {
+      const Parameters::Accessor::Ptr props = data.Holder->GetModuleProperties();
+      const String& id = GetModuleId(*props);
+      if (!data.Data)
+      {
+        Parameters::StringType type;
+        props->FindValue(Module::ATTR_TYPE, type);
+        Display.Message(Strings::Format("Skipping '%1%' (type '%2%') due to convert impossibility.", id, type));
+        ++Skipped;
+        return;
+      }
       try
       {
-        const Parameters::Accessor::Ptr props = data.Holder->GetModuleProperties();
-        const String& id = GetModuleId(*props);
         const String& filename =
             FileNameTemplate->Instantiate(Parameters::FieldsSourceAdapter<Strings::SkipFieldsSource>(*props));
         const Binary::OutputStream::Ptr stream = IO::CreateStream(filename, Params, Log::ProgressCallback::Stub());
         stream->ApplyData(*data.Data);
         Display.Message(Strings::Format("Converted '%1%' => '%2%'", id, filename));
+        ++Converted;
+        ConvertedSize += data.Data->Size();
       }
       catch (const Error& e)
       {
         StdOut << e.ToString();
+        ++Failed;
       }
     }
 
     void Flush() override {}
 
+    void ShowStatistic(std::chrono::steady_clock::duration spent) const
+    {
+      const auto seconds = std::chrono::duration<double>(spent).count();
+      const auto total = Converted + Skipped + Failed;
+      Display.Message(Strings::Format(
+          "Converted %1% (%2% bytes), skipped %3%, failed %4% of %5% modules in %6$.2fs (%7$.1f modules/s)",
+          Converted, ConvertedSize, Skipped, Failed, total, seconds, seconds > 0 ? total / seconds : 0.0));
+    }
+
   private:
     DisplayComponent& Display;
     const Parameters::Accessor& Params;
     const Strings::Template::Ptr FileNameTemplate;
+    std::size_t Converted = 0;
+    std::size_t Skipped = 0;
+    std::size_t Failed = 0;
+    uint64_t ConvertedSize = 0;
   };
 
   std::unique_ptr<Module::Conversion::Parameter> CreateConversionParameters(const String& mode,
@@ -181,27 +221,16 @@ namespace
   class ConvertEndpoint : public HolderAndData::Receiver
   {
   public:
-    ConvertEndpoint(DisplayComponent& display, const String& mode, const Parameters::Accessor& modeParams, Ptr saver)
-      : Display(display)
-      , ConversionParameter(CreateConversionParameters(mode, modeParams))
+    ConvertEndpoint(const String& mode, const Parameters::Accessor& modeParams, Ptr saver)
+      : ConversionParameter(CreateConversionParameters(mode, modeParams))
       , Saver(std::move(saver))
     {}
 
     void ApplyData(HolderAndData data) override
     {
-      const Module::Holder::Ptr holder = data.Holder;
-      const Parameters::Accessor::Ptr props = holder->GetModuleProperties();
-      if (const Binary::Data::Ptr result = Module::Convert(*holder, *ConversionParameter, props))
-      {
-        Saver->ApplyData({holder, result});
-      }
-      else
-      {
-        Parameters::StringType type;
-        props->FindValue(Module::ATTR_TYPE, type);
-        const String& id = GetModuleId(*props);
-        Display.Message(Strings::Format("Skipping '%1%' (type '%2%') due to convert impossibility.", id, type));
-      }
+      const Parameters::Accessor::Ptr props = data.Holder->GetModuleProperties();
+      data.Data = Module::Convert(*data.Holder, *ConversionParameter, props);
+      Saver->ApplyData(std::move(data));
     }
 
     void Flush() override
@@ -210,51 +239,88 @@ namespace
     }
 
   private:
-    DisplayComponent& Display;
     const std::unique_ptr<Module::Conversion::Parameter> ConversionParameter;
     const Ptr Saver;
   };
 
+  /*
+    Modules are converted by specified count of parallel jobs. Results are saved sequentially in order of detection,
+    so output names and messages do not depend on jobs count.
+  */
   class Convertor : public OnItemCallback
   {
   public:
-    Convertor(const Parameters::Accessor& params, DisplayComponent& display)
+    Convertor(const Parameters::Accessor& params, DisplayComponent& display, uint_t jobs)
       : Pipe(HolderAndData::Receiver::CreateStub())
+      , Start(std::chrono::steady_clock::now())
     {
       Parameters::StringType mode;
       if (!params.FindValue(String("mode"), mode))
       {
         throw Error(THIS_LINE, "Conversion mode is not specified.");
       }
-      const HolderAndData::Receiver::Ptr saver(new SaveEndpoint(display, params));
+      Saver = std::make_shared<SaveEndpoint>(display, params);
+      const HolderAndData::Receiver::Ptr saver =
+          jobs > 1 ? HolderAndData::Receiver::Ptr(std::make_shared<Async::OrderedReceiver<HolderAndData>>(Saver)) : Saver;
       const HolderAndData::Receiver::Ptr target =
-          mode == "raw" ? MakePtr<TruncateDataEndpoint>(saver) : MakePtr<ConvertEndpoint>(display, mode, params, saver);
-      Pipe = Async::DataReceiver<HolderAndData>::Create(1, 1000, target);
+          mode == "raw" ? MakePtr<TruncateDataEndpoint>(saver) : MakePtr<ConvertEndpoint>(mode, params, saver);
+      Pipe = Async::DataReceiver<HolderAndData>::Create(std::max<uint_t>(jobs, 1), 1000, target);
     }
 
     ~Convertor() override
     {
       Pipe->Flush();
+      Saver->ShowStatistic(std::chrono::steady_clock::now() - Start);
     }
 
     void ProcessItem(Binary::Data::Ptr data, Module::Holder::Ptr holder) override
     {
-      Pipe->ApplyData({std::move(holder), std::move(data)});
+      Pipe->ApplyData({std::move(holder), std::move(data), Items++});
     }
 
   private:
+    std::shared_ptr<SaveEndpoint> Saver;
     HolderAndData::Receiver::Ptr Pipe;
+    const std::chrono::steady_clock::time_point Start;
+    std::size_t Items = 0;
   };
 
-  class Benchmark : public OnItemCallback
+  Benchmark::Report::Ptr CreateBenchmarkReport(const String& filename, std::ostream& out)
+  {
+    const auto extPos = filename.find_last_of('.');
+    const auto ext = extPos != String::npos ? filename.substr(extPos + 1) : String();
+    return Benchmark::CreateReport(ext == "json" || ext == "csv" ? ext : "text", out);
+  }
+
+  // per-module results are grouped by module type to compare plugins over whole corpus
+  class ModulesBenchmark : public OnItemCallback
   {
   public:
-    Benchmark(unsigned iterations, SoundComponent& sound, DisplayComponent& display)
+    ModulesBenchmark(unsigned iterations, SoundComponent& sound, DisplayComponent& display,
+                     Benchmark::Report::Ptr report)
       : Iterations(iterations)
       , Sounder(sound)
       , Display(display)
+      , Report(std::move(report))
     {}
 
+    ~ModulesBenchmark() override
+    {
+      if (Report)
+      {
+        for (auto& type : Types)
+        {
+          Benchmark::Result res;
+          res.Category = "Module types";
+          res.Name = type.first;
+          type.second.Store(res);
+          res.Speed = Benchmark::Statistics(std::move(type.second.Speeds));
+          Report->Add(res);
+        }
+        Report->Finish();
+      }
+    }
+
     void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
     {
       const Module::Information::Ptr info = holder->GetModuleInformation();
@@ -265,12 +331,16 @@ namespace
 
       try
       {
-        const auto total = info->Duration() * Iterations;
+        const auto duration = info->Duration();
+        const auto total = duration * Iterations;
         BenchmarkSoundReceiver receiver;
         const auto renderer = holder->CreateRenderer(Sounder.GetSamplerate(), props);
+        std::vector<double> speeds;
+        const Benchmark::AllocationsCounter allocations;
         const Time::Timer timer;
         for (unsigned i = 0; i != Iterations; ++i)
         {
+          const Time::Timer iterationTimer;
           renderer->SetPosition({});
           for (;;)
           {
@@ -284,11 +354,23 @@ namespace
               receiver.ApplyData(std::move(data));
             }
           }
+          speeds.push_back(duration.Divide<double>(iterationTimer.Elapsed<>()));
         }
         const auto real = timer.Elapsed<>();
         const auto relSpeed = total.Divide<double>(real);
         Display.Message(Strings::Format("x%|3$.2f|\t(%2%)\t%1%\t[0x%4$08x]\t{%5%..%6%}", path, type, relSpeed,
                                         receiver.GetHash(), receiver.GetMinSample(), receiver.GetMaxSample()));
+        if (Report)
+        {
+          const Usage usage{allocations.Get(), total.Get() / double(decltype(total)::PER_SECOND)};
+          Benchmark::Result res;
+          res.Category = type;
+          res.Name = path;
+          usage.Store(res);
+          res.Speed = Benchmark::Statistics(std::move(speeds));
+          Report->Add(res);
+          Types[type].Add(res.Speed.Median(), usage);
+        }
       }
       catch (const std::exception& e)
       {
@@ -351,10 +433,219 @@ namespace
       Sound::Sample::Type MaxSample = Sound::Sample::MIN;
     };
 
+    struct Usage
+    {
+      Benchmark::MemoryUsage Memory;
+      double EmulatedSeconds = 0;
+
+      void Store(Benchmark::Result& res) const
+      {
+        if (EmulatedSeconds > 0)
+        {
+          res.AllocationsPerSecond = Memory.Allocations / EmulatedSeconds;
+          res.BytesPerSecond = Memory.Bytes / EmulatedSeconds;
+        }
+      }
+    };
+
+    struct TypeStatistics : Usage
+    {
+      std::vector<double> Speeds;
+
+      void Add(double speed, const Usage& usage)
+      {
+        Speeds.push_back(speed);
+        Memory.Allocations += usage.Memory.Allocations;
+        Memory.Bytes += usage.Memory.Bytes;
+        EmulatedSeconds += usage.EmulatedSeconds;
+      }
+    };
+
   private:
     const unsigned Iterations;
     SoundComponent& Sounder;
     DisplayComponent& Display;
+    const Benchmark::Report::Ptr Report;
+    std::map<String, TypeStatistics> Types;
+  };
+
+  class ProbeDurationEndpoint : public DataReceiver<Module::Holder::Ptr>
+  {
+  public:
+    ProbeDurationEndpoint(Time::Milliseconds defaultDuration, DisplayComponent& display)
+      : DefaultDuration(defaultDuration)
+      , Display(display)
+      , ResultTemplate(Strings::Template::Create("[Duration]\t([Type])\t[Fullpath]"))
+    {}
+
+    void ApplyData(Module::Holder::Ptr holder) override
+    {
+      try
+      {
+        if (!IsDefaultDuration(holder->GetModuleInformation()->Duration()))
+        {
+          // plugin already knows exact duration
+          Report(*holder->GetModuleProperties());
+          return;
+        }
+        // source holder is used to report failed probing
+        holder = Module::StoreProbedDuration(holder, holder->GetModuleProperties());
+        Report(*holder->GetModuleProperties());
+      }
+      catch (const std::exception&)
+      {
+        Report(*holder->GetModuleProperties());
+      }
+      catch (const Error&)
+      {
+        Report(*holder->GetModuleProperties());
+      }
+    }
+
+    void Flush() override {}
+
+  private:
+    // plugins without length info report default duration rounded to own frame period
+    bool IsDefaultDuration(Time::Milliseconds duration) const
+    {
+      const auto value = duration.Get();
+      const auto limit = DefaultDuration.Get();
+      return (value > limit ? value - limit : limit - value) < Time::Milliseconds::PER_SECOND;
+    }
+
+    void Report(const Parameters::Accessor& props)
+    {
+      const auto msg = ResultTemplate->Instantiate(Parameters::FieldsSourceAdapter<Strings::SkipFieldsSource>(props));
+      const std::lock_guard<std::mutex> lock(Guard);
+      Display.Message(msg);
+    }
+
+  private:
+    const Time::Milliseconds DefaultDuration;
+    DisplayComponent& Display;
+    const Strings::Template::Ptr ResultTemplate;
+    std::mutex Guard;
+  };
+
+  class DurationProber : public OnItemCallback
+  {
+  public:
+    DurationProber(uint_t jobs, Time::Milliseconds defaultDuration, DisplayComponent& display)
+      : Pipe(Async::DataReceiver<Module::Holder::Ptr>::Create(
+          jobs, 100, MakePtr<ProbeDurationEndpoint>(defaultDuration, display)))
+    {}
+
+    ~DurationProber() override
+    {
+      Pipe->Flush();
+    }
+
+    void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
+    {
+      Pipe->ApplyData(std::move(holder));
+    }
+
+  private:
+    const DataReceiver<Module::Holder::Ptr>::Ptr Pipe;
+  };
+
+  // renders modules to files using specified count of simultaneously playing backends
+  class FilesRenderer : public OnItemCallback
+  {
+  public:
+    FilesRenderer(uint_t jobs, SoundComponent& sound, DisplayComponent& display)
+      : Jobs(jobs)
+      , Sounder(sound)
+      , Display(display)
+      , Start(std::chrono::steady_clock::now())
+    {}
+
+    void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
+    {
+      while (Active.size() >= Jobs)
+      {
+        WaitOldest();
+      }
+      const String& id = GetModuleId(*holder->GetModuleProperties());
+      Display.Message(Strings::Format("Rendering '%1%'", id));
+      const auto duration = holder->GetModuleInformation()->Duration();
+      const Sound::Backend::Ptr backend = Sounder.CreateBackend(std::move(holder));
+      backend->GetPlaybackControl()->Play();
+      Active.push_back(backend);
+      ++Modules;
+      Rendered += duration;
+    }
+
+    void Finish()
+    {
+      while (!Active.empty())
+      {
+        WaitOldest();
+      }
+      const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+      const auto sound = Rendered.Divide<double>(Time::Milliseconds(1000));
+      Display.Message(Strings::Format("Rendered %1% modules (%2%) in %3$.2fs (x%4$.1f realtime)", Modules,
+                                      Time::ToString(Rendered), seconds, seconds > 0 ? sound / seconds : 0.0));
+    }
+
+  private:
+    void WaitOldest()
+    {
+      const Sound::PlaybackControl::Ptr control = Active.front()->GetPlaybackControl();
+      while (Sound::PlaybackControl::STOPPED != control->GetCurrentState())
+      {
+        const uint_t key = Console::Self().GetPressedKey();
+        if (key == Console::INPUT_KEY_CANCEL || key == 'Q')
+        {
+          throw CancelError();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      Active.pop_front();
+    }
+
+  private:
+    const std::size_t Jobs;
+    SoundComponent& Sounder;
+    DisplayComponent& Display;
+    const std::chrono::steady_clock::time_point Start;
+    std::deque<Sound::Backend::Ptr> Active;
+    std::size_t Modules = 0;
+    Time::Milliseconds Rendered;
+  };
+
+  class TransitionsCallback : public Sound::BackendCallback
+  {
+  public:
+    void OnStart() override {}
+
+    void OnFrame(const Module::State& /*state*/) override {}
+
+    void OnStop() override {}
+
+    void OnPause() override {}
+
+    void OnResume() override {}
+
+    void OnFinish() override {}
+
+    void OnTransition() override
+    {
+      Transited = true;
+    }
+
+    bool Happened() const
+    {
+      return Transited;
+    }
+
+    void Reset()
+    {
+      Transited = false;
+    }
+
+  private:
+    std::atomic<bool> Transited = false;
   };
 
   class CLIApplication
@@ -370,6 +661,10 @@ namespace
       , Display(DisplayComponent::Create())
       , SeekStep(10)
       , BenchmarkIterations(0)
+      , ProbeDuration(false)
+      , Jobs(1)
+      , Gapless(false)
+      , Transitions(std::make_shared<TransitionsCallback>())
     {}
 
     int Run(Strings::Array args) override
@@ -388,18 +683,50 @@ namespace
           const Parameters::Container::Ptr cnvParams = Parameters::Container::Create();
           ParseParametersString("", ConvertParams, *cnvParams);
           const Parameters::Accessor::Ptr mergedParams = Parameters::CreateMergedAccessor(cnvParams, ConfigParams);
-          Convertor cnv(*mergedParams, *Display);
-          Sourcer->ProcessItems(cnv);
+          Convertor cnv(*mergedParams, *Display, Jobs);
+          Sourcer->ProcessItems(cnv, Jobs);
         }
         else if (0 != BenchmarkIterations)
         {
-          Benchmark benchmark(BenchmarkIterations, *Sounder, *Display);
-          Sourcer->ProcessItems(benchmark);
+          std::ofstream reportFile;
+          Benchmark::Report::Ptr report;
+          if (!BenchmarkReport.empty())
+          {
+            reportFile.open(BenchmarkReport.c_str());
+            if (!reportFile)
+            {
+              throw MakeFormattedError(THIS_LINE, "Failed to open benchmark report '%1%'.", BenchmarkReport);
+            }
+            report = CreateBenchmarkReport(BenchmarkReport, reportFile);
+          }
+          ModulesBenchmark benchmark(BenchmarkIterations, *Sounder, *Display, std::move(report));
+          // concurrent detection affects measurements
+          Sourcer->ProcessItems(benchmark, 1);
+        }
+        else if (ProbeDuration)
+        {
+          SetProbeDurationLimit();
+          DurationProber prober(std::max<uint_t>(Jobs, 1), Module::GetDefaultDuration(*ConfigParams), *Display);
+          Sourcer->ProcessItems(prober, Jobs);
         }
         else
         {
           Sounder->Initialize();
-          Sourcer->ProcessItems(*this);
+          if (Jobs > 1 && !Gapless && Sounder->IsFileOutput())
+          {
+            FilesRenderer renderer(Jobs, *Sounder, *Display);
+            Sourcer->ProcessItems(renderer, Jobs);
+            renderer.Finish();
+          }
+          else
+          {
+            Sourcer->ProcessItems(*this, 1);
+            // last module in gapless mode
+            if (Player)
+            {
+              Play(false);
+            }
+          }
         }
       }
       catch (const CancelError&)
@@ -436,6 +763,16 @@ namespace
               ".");
           opt("benchmark", value<uint_t>(&BenchmarkIterations),
               "Switch on benchmark mode with specified iterations count.\n");
+          opt("benchmark-report", value<String>(&BenchmarkReport),
+              "Write per-module and per-type benchmark statistics to specified file.\n"
+              "Format is selected by extension: json, csv (suitable as baseline for benchmark tool) or text.\n"
+              "Heap usage is reported only by builds made with benchmark.allocations=1.\n");
+          opt("probe-duration", bool_switch(&ProbeDuration),
+              "Detect actual duration of modules without length info using '--jobs' parallel jobs count.\n"
+              "Probing is limited by 'plugins.default_duration' core option (20 minutes if not specified).\n");
+          opt("jobs", value<uint_t>(&Jobs),
+              "Count of modules processed in parallel in conversion, duration probing and rendering to files modes.\n"
+              "Input files are detected concurrently as well. Output names and messages order do not depend on it.\n");
         }
         options.add(Informer->GetOptionsDescription());
         options.add(Sourcer->GetOptionsDescription());
@@ -448,6 +785,9 @@ namespace
         // cli options
         options_description cliOptions("Other options");
         cliOptions.add_options()("seekstep", value<uint_t>(&SeekStep), "seeking step in percents");
+        cliOptions.add_options()("gapless", bool_switch(&Gapless),
+                                 "play modules sequence without gaps keeping sound device opened. "
+                                 "Use 'crossfade' sound option to specify modules crossfade duration in ms");
         options.add(cliOptions);
 
         variables_map vars;
@@ -485,22 +825,63 @@ namespace
       }
     }
 
+    void SetProbeDurationLimit()
+    {
+      using namespace Parameters::ZXTune::Core::Plugins;
+      const Parameters::IntType PROBE_DURATION_LIMIT = 20 * 60;
+      Parameters::IntType limit = 0;
+      if (!ConfigParams->FindValue(DEFAULT_DURATION, limit))
+      {
+        ConfigParams->SetValue(DEFAULT_DURATION, PROBE_DURATION_LIMIT);
+      }
+    }
+
     void ProcessItem(Binary::Data::Ptr /*data*/, Module::Holder::Ptr holder) override
     {
-      const Sound::Backend::Ptr backend = Sounder->CreateBackend(holder);
-      const Sound::PlaybackControl::Ptr control = backend->GetPlaybackControl();
+      if (Player && Transit(holder))
+      {
+        return;
+      }
+      Player = Sounder->CreateBackend(holder, String(), Transitions);
+      Player->GetPlaybackControl()->Play();
+      SetModule(std::move(holder));
+      if (!Gapless)
+      {
+        Play(false);
+        Player.reset();
+      }
+    }
 
-      const Module::Information::Ptr info = holder->GetModuleInformation();
-      const auto seekStep = Time::Milliseconds(info->Duration().Get() * SeekStep / 100);
-      control->Play();
+    // @return true if module is played right after the current one
+    bool Transit(Module::Holder::Ptr holder)
+    {
+      Transitions->Reset();
+      Player->GetTransitionControl()->SetNext(holder);
+      if (Play(true))
+      {
+        SetModule(std::move(holder));
+        return true;
+      }
+      Player.reset();
+      return false;
+    }
+
+    void SetModule(Module::Holder::Ptr holder)
+    {
+      Display->SetModule(holder, Player);
+      Playing = std::move(holder);
+    }
 
-      Display->SetModule(holder, backend);
+    // @return true if stopped waiting for transition to the next module
+    bool Play(bool tillTransition)
+    {
+      const Sound::PlaybackControl::Ptr control = Player->GetPlaybackControl();
 
       const Sound::Gain::Type minVol(0);
       const Sound::Gain::Type maxVol(1);
       const Sound::Gain::Type volStep(5, 100);
       Sound::Gain::Type curVolume;
-      const Sound::VolumeControl::Ptr volCtrl = backend->GetVolumeControl();
+      const Sound::VolumeControl::Ptr volCtrl = Player->GetVolumeControl();
       if (volCtrl)
       {
         const Sound::Gain allVolume = volCtrl->GetVolume();
@@ -509,11 +890,16 @@ namespace
 
       for (;;)
       {
+        if (tillTransition && Transitions->Happened())
+        {
+          return true;
+        }
         Sound::PlaybackControl::State state = control->GetCurrentState();
 
         const auto pos = Display->BeginFrame(state);
 
         const auto START = Time::AtMillisecond();
+        const auto seekStep = Time::Milliseconds(Playing->GetModuleInformation()->Duration().Get() * SeekStep / 100);
         if (const uint_t key = Console::Self().GetPressedKey())
         {
           switch (key)
@@ -567,7 +953,7 @@ namespace
 
         if (Sound::PlaybackControl::STOPPED == state)
         {
-          break;
+          return false;
         }
         Display->EndFrame();
       }
@@ -582,6 +968,13 @@ namespace
     std::unique_ptr<DisplayComponent> Display;
     uint_t SeekStep;
     uint_t BenchmarkIterations;
+    String BenchmarkReport;
+    bool ProbeDuration;
+    uint_t Jobs;
+    bool Gapless;
+    const std::shared_ptr<TransitionsCallback> Transitions;
+    Sound::Backend::Ptr Player;
+    Module::Holder::Ptr Playing;
   };
 }  // namespace
 
@@ -317,6 +317,13 @@ namespace
         {Parameters::ZXTune::IO::Providers::File::OVERWRITE_EXISTING,
          "overwrite target file if already exists (applicable for for file-based backends)",
          Parameters::ZXTune::IO::Providers::File::OVERWRITE_EXISTING_DEFAULT},
+        {Parameters::ZXTune::IO::Providers::Network::Cache::DIRECTORY,
+         "directory to cache remote resources downloaded by ranges (empty to disable)", EMPTY},
+        {Parameters::ZXTune::IO::Providers::Network::Cache::BLOCK_SIZE, "remote resources cache block size",
+         Parameters::ZXTune::IO::Providers::Network::Cache::BLOCK_SIZE_DEFAULT},
+        {Parameters::ZXTune::IO::Providers::Network::Cache::READAHEAD,
+         "maximal size of single ranged request for remote resources",
+         Parameters::ZXTune::IO::Providers::Network::Cache::READAHEAD_DEFAULT},
         // Sound parameters
         {" Sound options:"},
         {Parameters::ZXTune::Sound::FREQUENCY, "sound frequency in Hz", Parameters::ZXTune::Sound::FREQUENCY_DEFAULT},
@@ -329,6 +336,9 @@ namespace
          EMPTY},
         // Sound backend parameters
         {" Sound backends options:"},
+        {Parameters::ZXTune::Sound::Backends::RENDER_AHEAD,
+         "duration in ms of sound rendered in advance for system playback backends",
+         Parameters::ZXTune::Sound::Backends::RENDER_AHEAD_DEFAULT},
         {Parameters::ZXTune::Sound::Backends::File::FILENAME,
          "filename template for file-based backends (see --list-attributes command). Also duplicated in "
          "backend-specific namespace",
@@ -351,6 +361,10 @@ namespace
          "mixer for ALSA backend (taking the first one if not specified)", EMPTY},
         {Parameters::ZXTune::Sound::Backends::Alsa::LATENCY, "latency in ms for ALSA backend",
          Parameters::ZXTune::Sound::Backends::Alsa::LATENCY_DEFAULT},
+        {Parameters::ZXTune::Sound::Backends::Alsa::MMAP, "use period-driven mmap output for ALSA backend",
+         Parameters::ZXTune::Sound::Backends::Alsa::MMAP_DEFAULT},
+        {Parameters::ZXTune::Sound::Backends::Alsa::PERIOD, "period size in ms for ALSA backend in mmap mode",
+         Parameters::ZXTune::Sound::Backends::Alsa::PERIOD_DEFAULT},
         {Parameters::ZXTune::Sound::Backends::Sdl::BUFFERS, "buffers count for SDL backend",
          Parameters::ZXTune::Sound::Backends::Sdl::BUFFERS_DEFAULT},
         {Parameters::ZXTune::Sound::Backends::DirectSound::LATENCY, "latency in ms for DirectSound backend",
@@ -392,6 +406,8 @@ namespace
          "frequency table name to use in AY-based players. Can be name (--list-freqtables) or dump (#..). Use '~' to "
          "revert",
          EMPTY},
+        {Parameters::ZXTune::Core::AYM::COMPILED_STREAM,
+         "play AY-based tracked modules from registers stream compiled on demand and shared by renderers", EMPTY},
         {Parameters::ZXTune::Core::AYM::DUTY_CYCLE, "chip duty cycle value in percent. Should be in range 1..99",
          Parameters::ZXTune::Core::AYM::DUTY_CYCLE_DEFAULT},
         {Parameters::ZXTune::Core::AYM::DUTY_CYCLE_MASK,
@@ -400,7 +416,7 @@ namespace
         {Parameters::ZXTune::Core::AYM::LAYOUT,
          "chip channels layout. Set of letters or numeric (0-ABC, 1-ACB, 2-BAC, 3-BCA, 4-CBA, 5-CAB)",
          Parameters::ZXTune::Core::AYM::LAYOUT_DEFAULT},
-        {Parameters::ZXTune::Core::DAC::INTERPOLATION, "use interpolation for DAC rendering",
+        {Parameters::ZXTune::Core::DAC::INTERPOLATION, "interpolation mode for DAC rendering (0-none, 1-cosine, 2-windowed sinc)",
          Parameters::ZXTune::Core::DAC::INTERPOLATION_DEFAULT},
         {Parameters::ZXTune::Core::Z80::INT_TICKS, "Z80 processor INT signal duration in ticks",
          Parameters::ZXTune::Core::Z80::INT_TICKS_DEFAULT},
@@ -20,6 +20,7 @@
 #include <parameters/merged_accessor.h>
 #include <parameters/serialize.h>
 #include <platform/application.h>
+#include <sound/backend_attrs.h>
 #include <sound/backends_parameters.h>
 #include <sound/render_params.h>
 #include <sound/service.h>
@@ -205,6 +206,25 @@ namespace
       return Service->EnumerateBackends();
     }
 
+    bool IsFileOutput() const override
+    {
+      if (BackendOptions.empty())
+      {
+        return false;
+      }
+      for (Sound::BackendInformation::Iterator::Ptr backends = Service->EnumerateBackends(); backends->IsValid();
+           backends->Next())
+      {
+        const Sound::BackendInformation::Ptr info = backends->Get();
+        if (BackendOptions.count(info->Id())
+            && 0 == (info->Capabilities() & (Sound::CAP_TYPE_FILE | Sound::CAP_TYPE_STUB)))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
     uint_t GetSamplerate() const
     {
       return Sound::GetSoundFrequency(*Params->GetDefaultParameters());
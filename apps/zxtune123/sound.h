@@ -41,6 +41,9 @@ public:
 
   virtual Sound::BackendInformation::Iterator::Ptr EnumerateBackends() const = 0;
 
+  //! @return true if all the selected backends write to files, so several modules may be rendered simultaneously
+  virtual bool IsFileOutput() const = 0;
+
   virtual uint_t GetSamplerate() const = 0;
 
   static std::unique_ptr<SoundComponent> Create(Parameters::Container::Ptr configParams);
@@ -15,8 +15,11 @@
 // common includes
 #include <contract.h>
 #include <error_tools.h>
+#include <make_ptr.h>
 #include <progress_callback.h>
 // library includes
+#include <async/data_receiver.h>
+#include <async/ordered_receiver.h>
 #include <core/additional_files_resolve.h>
 #include <core/core_parameters.h>
 #include <core/module_detect.h>
@@ -33,6 +36,7 @@
 // std includes
 #include <iomanip>
 #include <iostream>
+#include <vector>
 // boost includes
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -179,6 +183,68 @@ namespace
     const Log::ProgressCallback::Ptr ProgressCallback;
   };
 
+  // modules found in input file with index of the file
+  struct FileModules
+  {
+    std::size_t Index = 0;
+    std::vector<std::pair<Binary::Data::Ptr, Module::Holder::Ptr>> Modules;
+    String ErrorText;
+  };
+
+  /*
+    Passes modules of the input file to callback, errors are reported the same way as in sequential mode. Other
+    exceptions from callback stop delivery.
+  */
+  class DeliveryEndpoint : public DataReceiver<FileModules>
+  {
+  public:
+    explicit DeliveryEndpoint(OnItemCallback& callback)
+      : Callback(callback)
+    {}
+
+    void ApplyData(FileModules file) override
+    {
+      for (auto& mod : file.Modules)
+      {
+        try
+        {
+          Callback.ProcessItem(std::move(mod.first), std::move(mod.second));
+        }
+        catch (const Error& e)
+        {
+          // the rest of modules of the file are skipped on error like in sequential mode
+          Console::Self().Write(e.ToString());
+          return;
+        }
+      }
+      if (!file.ErrorText.empty())
+      {
+        Console::Self().Write(file.ErrorText);
+      }
+    }
+
+    void Flush() override {}
+
+  private:
+    OnItemCallback& Callback;
+  };
+
+  class CollectItemsCallback : public OnItemCallback
+  {
+  public:
+    explicit CollectItemsCallback(FileModules& target)
+      : Target(target)
+    {}
+
+    void ProcessItem(Binary::Data::Ptr data, Module::Holder::Ptr holder) override
+    {
+      Target.Modules.emplace_back(std::move(data), std::move(holder));
+    }
+
+  private:
+    FileModules& Target;
+  };
+
   class Source : public SourceComponent
   {
   public:
@@ -237,38 +303,95 @@ namespace
       }
     }
 
-    void ProcessItems(OnItemCallback& callback) override
+    void ProcessItems(OnItemCallback& callback, uint_t jobs) override
     {
-      for (Strings::Array::const_iterator it = Files.begin(), lim = Files.end(); it != lim; ++it)
+      if (jobs < 2 || Files.size() < 2)
       {
-        ProcessItem(*it, callback);
+        for (Strings::Array::const_iterator it = Files.begin(), lim = Files.end(); it != lim; ++it)
+        {
+          try
+          {
+            ProcessItem(*it, callback, ShowProgress);
+          }
+          catch (const Error& e)
+          {
+            Console::Self().Write(e.ToString());
+          }
+        }
+      }
+      else
+      {
+        ProcessItemsConcurrently(callback, jobs);
       }
     }
 
   private:
-    void ProcessItem(const String& uri, OnItemCallback& callback) const
+    void ProcessItem(const String& uri, OnItemCallback& callback, bool showProgress) const
     {
-      try
+      const IO::Identifier::Ptr id = IO::ResolveUri(uri);
+
+      DetectCallback detectCallback(Params, id, callback, showProgress);
+      auto data = IO::OpenData(id->Path(), *Params, Log::ProgressCallback::Stub());
+
+      const String subpath = id->Subpath();
+      if (subpath.empty())
       {
-        const IO::Identifier::Ptr id = IO::ResolveUri(uri);
+        Module::Detect(*Params, std::move(data), detectCallback);
+      }
+      else
+      {
+        Module::Open(*Params, std::move(data), subpath, detectCallback);
+      }
+    }
 
-        DetectCallback detectCallback(Params, id, callback, ShowProgress);
-        auto data = IO::OpenData(id->Path(), *Params, Log::ProgressCallback::Stub());
+    class DetectEndpoint : public DataReceiver<std::size_t>
+    {
+    public:
+      DetectEndpoint(const Source& source, Async::OrderedReceiver<FileModules>& target)
+        : Self(source)
+        , Target(target)
+      {}
 
-        const String subpath = id->Subpath();
-        if (subpath.empty())
+      void ApplyData(std::size_t index) override
+      {
+        FileModules result;
+        result.Index = index;
+        try
         {
-          Module::Detect(*Params, std::move(data), detectCallback);
+          CollectItemsCallback collect(result);
+          Self.ProcessItem(Self.Files[index], collect, false);
         }
-        else
+        catch (const Error& e)
         {
-          Module::Open(*Params, std::move(data), subpath, detectCallback);
+          result.ErrorText = e.ToString();
         }
+        Target.ApplyData(std::move(result));
       }
-      catch (const Error& e)
+
+      void Flush() override {}
+
+    private:
+      const Source& Self;
+      Async::OrderedReceiver<FileModules>& Target;
+    };
+
+    // files are detected in parallel, but modules are passed to callback sequentially in the same order
+    void ProcessItemsConcurrently(OnItemCallback& callback, uint_t jobs) const
+    {
+      // limit files buffered while waiting for a slow one
+      const std::size_t maxPending = jobs * 16;
+      Async::OrderedReceiver<FileModules> ordered(MakePtr<DeliveryEndpoint>(callback));
+      const auto pipe = Async::DataReceiver<std::size_t>::Create(jobs, jobs * 2, MakePtr<DetectEndpoint>(*this, ordered));
+      for (std::size_t idx = 0, lim = Files.size(); idx != lim; ++idx)
       {
-        Console::Self().Write(e.ToString());
+        if (idx >= maxPending && !ordered.WaitDelivered(idx - maxPending))
+        {
+          break;
+        }
+        pipe->ApplyData(idx);
       }
+      pipe->Flush();
+      ordered.Flush();
     }
 
   private:
@@ -47,7 +47,9 @@ public:
   virtual void ParseParameters() = 0;
   // throw
   virtual void Initialize() = 0;
-  virtual void ProcessItems(OnItemCallback& callback) = 0;
+  //! @param jobs Count of input files detected concurrently. Callback is never called concurrently, modules are passed
+  //! in the same order as in sequential mode
+  virtual void ProcessItems(OnItemCallback& callback, uint_t jobs) = 0;
 
   static std::unique_ptr<SourceComponent> Create(Parameters::Container::Ptr configParams);
 };
@@ -15,20 +15,21 @@
 
 namespace Async
 {
-  class Scheduler
-  {
-  public:
-    virtual ~Scheduler() = default;
-
-    virtual void Yield() = 0;
-  };
-
   class Coroutine
   {
   public:
     typedef std::shared_ptr<Coroutine> Ptr;
     virtual ~Coroutine() = default;
 
+    // nested to not clash with Async::Scheduler tasks executor
+    class Scheduler
+    {
+    public:
+      virtual ~Scheduler() = default;
+
+      virtual void Yield() = 0;
+    };
+
     virtual void Initialize() = 0;
     virtual void Finalize() = 0;
 
@@ -13,130 +13,275 @@
 // common includes
 #include <contract.h>
 #include <data_streaming.h>
+#include <error.h>
 #include <make_ptr.h>
 // library includes
-#include <async/activity.h>
-#include <async/progress.h>
-#include <async/sized_queue.h>
+#include <async/ring_queue.h>
+#include <async/scheduler.h>
 // std includes
-#include <algorithm>
-#include <list>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace Async
 {
+  /*
+    Bounded queue processed by at most workersCount tasks running on scheduler.
+    Items are passed through lock-free ring: single-producer/single-consumer one for single worker (producers are
+    serialized between themselves only, worker takes items by batches), multi-producer/multi-consumer one otherwise.
+    Scheduler's workers never block for long on full queue or on flushing- they execute other pending tasks instead,
+    so nested stages sharing the same scheduler cannot starve each other.
+  */
   template<class T>
   class DataReceiver : public ::DataReceiver<T>
   {
   public:
-    DataReceiver(std::size_t workersCount, std::size_t queueSize, typename ::DataReceiver<T>::Ptr delegate)
-      : QueueObject(SizedQueue<T>::Create(queueSize))
-      , Statistic(Progress::Create())
-      , Delegate(std::move(delegate))
-    {
-      StartAll(workersCount);
-    }
+    DataReceiver(std::size_t workersCount, std::size_t queueSize, typename ::DataReceiver<T>::Ptr delegate,
+                 Scheduler::Ptr scheduler)
+      : State(std::make_shared<Pipe>(workersCount, queueSize, std::move(delegate), std::move(scheduler)))
+    {}
 
     ~DataReceiver() override
     {
-      QueueObject->Reset();
-      WaitAll();
+      State->Stop();
     }
 
     void ApplyData(T data) override
     {
-      CheckWorkersAvailable();
-      Statistic->Produce(1);
-      QueueObject->Add(std::move(data));
+      State->Add(std::move(data));
     }
 
     void Flush() override
     {
-      CheckWorkersAvailable();
-      // may not flush queue
-      Statistic->WaitForComplete();
-      Delegate->Flush();
+      State->Flush();
     }
 
     static typename ::DataReceiver<T>::Ptr Create(std::size_t workersCount, std::size_t queueSize,
-                                                  typename ::DataReceiver<T>::Ptr delegate)
+                                                  typename ::DataReceiver<T>::Ptr delegate,
+                                                  Scheduler::Ptr scheduler = Scheduler::GetShared())
     {
-      return workersCount ? MakePtr<DataReceiver>(workersCount, queueSize, delegate) : delegate;
+      return workersCount ? MakePtr<DataReceiver>(workersCount, queueSize, std::move(delegate), std::move(scheduler))
+                          : delegate;
     }
 
   private:
-    void StartAll(std::size_t count)
+    // shared with scheduled tasks, so they can safely finish after receiver's destruction
+    class Pipe : public std::enable_shared_from_this<Pipe>
     {
-      const typename Operation::Ptr op = MakePtr<TransceiveOperation>(QueueObject, Statistic, Delegate);
-      while (Activities.size() < count)
+    public:
+      Pipe(std::size_t workersCount, std::size_t queueSize, typename ::DataReceiver<T>::Ptr delegate,
+           Scheduler::Ptr scheduler)
+        : MaxWorkers(workersCount)
+        , Single(MaxWorkers == 1 ? new SpscQueue<T>(queueSize) : nullptr)
+        , Multi(MaxWorkers == 1 ? nullptr : new MpmcQueue<T>(queueSize))
+        , Delegate(std::move(delegate))
+        , Sched(std::move(scheduler))
       {
-        const Activity::Ptr act = Activity::Create(op);
-        Activities.push_back(act);
+        Require(MaxWorkers != 0);
       }
-    }
 
-    std::list<Error> WaitAll()
-    {
-      std::list<Error> result;
-      while (!Activities.empty())
+      void Add(T data)
       {
-        const Activity::Ptr act = Activities.front();
-        try
+        ThrowIfFailed();
+        Produced.fetch_add(1);
+        while (!TryAdd(data))
         {
-          act->Wait();
+          Wait(NotFull, [this]() { return Failed || !IsFull(); });
+          ThrowIfFailed();
         }
-        catch (const Error& err)
+        // pairs with worker's release before queue check
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (AcquireWorker())
         {
-          result.push_back(err);
+          Sched->Post([self = this->shared_from_this()]() { self->Transceive(); });
         }
-        Activities.pop_front();
       }
-      return result;
-    }
 
-    void CheckWorkersAvailable()
-    {
-      if (std::none_of(Activities.begin(), Activities.end(),
-                       [](const Activity::Ptr& activity) { return activity->IsExecuted(); }))
+      void Flush()
       {
-        const auto& errors = WaitAll();
-        throw errors.empty() ? Error()  // TODO
-                             : *errors.begin();
+        Wait(StateChanged, [this]() { return Failed || Consumed == Produced; });
+        ThrowIfFailed();
+        Delegate->Flush();
       }
-    }
 
-  private:
-    class TransceiveOperation : public Operation
-    {
-    public:
-      TransceiveOperation(typename Queue<T>::Ptr queue, Progress::Ptr stat, typename DataReceiver<T>::Ptr target)
-        : QueueObject(std::move(queue))
-        , Statistic(std::move(stat))
-        , Target(std::move(target))
-      {}
+      void Stop()
+      {
+        Active = false;
+        Notify(NotFull);
+        Wait(StateChanged, [this]() { return Workers == 0; });
+        // release pending items right now
+        Single ? Single->Reset() : Multi->Reset();
+      }
+
+    private:
+      bool TryAdd(T& data)
+      {
+        if (Single)
+        {
+          // producers are serialized only between themselves
+          while (Producing.test_and_set(std::memory_order_acquire))
+          {
+            std::this_thread::yield();
+          }
+          const auto added = Single->TryAddMany(&data, 1);
+          Producing.clear(std::memory_order_release);
+          return added != 0;
+        }
+        return Multi->TryAddMany(&data, 1) != 0;
+      }
+
+      std::size_t TryGet(T* res, std::size_t limit)
+      {
+        return Single ? Single->TryGetMany(res, limit) : Multi->TryGetMany(res, 1);
+      }
+
+      bool IsFull() const
+      {
+        return Single ? Single->IsFull() : Multi->IsFull();
+      }
+
+      bool IsEmpty() const
+      {
+        return Single ? Single->IsEmpty() : Multi->IsEmpty();
+      }
+
+      bool AcquireWorker()
+      {
+        auto workers = Workers.load();
+        while (workers < MaxWorkers)
+        {
+          if (Workers.compare_exchange_weak(workers, workers + 1))
+          {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      // process limited batch and reschedule to give a chance to other tasks
+      void Transceive()
+      {
+        // single worker takes items by batches, else one by one to not starve other workers on heavy items
+        std::array<T, BATCH_SIZE> items;
+        for (std::size_t processed = 0;;)
+        {
+          const auto got = Active && !Failed ? TryGet(items.data(), BATCH_SIZE - processed) : 0;
+          if (!got)
+          {
+            Workers.fetch_sub(1);
+            Notify(StateChanged);
+            // item may be added after queue check but before worker release
+            if (Active && !Failed && !IsEmpty() && AcquireWorker())
+            {
+              continue;
+            }
+            return;
+          }
+          Notify(NotFull);
+          for (std::size_t idx = 0; idx < got; ++idx)
+          {
+            Process(std::move(items[idx]));
+          }
+          if (Consumed.fetch_add(got) + got == Produced)
+          {
+            Notify(StateChanged);
+          }
+          processed += got;
+          if (processed == BATCH_SIZE)
+          {
+            Sched->Post([self = this->shared_from_this()]() { self->Transceive(); }, Scheduler::Priority::LOW);
+            return;
+          }
+        }
+      }
+
+      void Process(T item)
+      {
+        if (Failed)
+        {
+          return;
+        }
+        try
+        {
+          Delegate->ApplyData(std::move(item));
+        }
+        catch (...)
+        {
+          // any exception should be delivered to producer, else it waits for this item forever
+          {
+            const std::lock_guard<std::mutex> lock(FailureGuard);
+            if (Failed)
+            {
+              return;
+            }
+            Failure = std::current_exception();
+            Failed = true;
+          }
+          Notify(NotFull);
+          Notify(StateChanged);
+        }
+      }
 
-      void Prepare() override {}
+      template<class Predicate>
+      void Wait(ParkingLot& event, Predicate pred)
+      {
+        if (Sched->IsWorkerThread())
+        {
+          // worker executes other tasks meanwhile, so it's woken up by scheduler
+          SchedulerWaiters.fetch_add(1);
+          Sched->WaitUntil(pred);
+          SchedulerWaiters.fetch_sub(1);
+        }
+        else
+        {
+          event.Wait(pred);
+        }
+      }
+
+      // wakes up waiters in both plain and scheduler's worker threads
+      void Notify(ParkingLot& event)
+      {
+        // orders the check after state change
+        event.NotifyAll();
+        if (SchedulerWaiters.load() != 0)
+        {
+          Sched->Notify();
+        }
+      }
 
-      void Execute() override
+      void ThrowIfFailed()
       {
-        T val;
-        while (QueueObject->Get(val))
+        if (Failed)
         {
-          Target->ApplyData(std::move(val));
-          Statistic->Consume(1);
+          const std::lock_guard<std::mutex> lock(FailureGuard);
+          std::rethrow_exception(Failure);
         }
       }
 
     private:
-      const typename Queue<T>::Ptr QueueObject;
-      const Progress::Ptr Statistic;
-      const typename DataReceiver<T>::Ptr Target;
+      static const std::size_t BATCH_SIZE = 16;
+      const std::size_t MaxWorkers;
+      const std::unique_ptr<SpscQueue<T> > Single;
+      const std::unique_ptr<MpmcQueue<T> > Multi;
+      const typename ::DataReceiver<T>::Ptr Delegate;
+      const Scheduler::Ptr Sched;
+      std::atomic_flag Producing = ATOMIC_FLAG_INIT;
+      std::atomic<std::size_t> Workers = 0;
+      std::atomic<uint64_t> Produced = 0;
+      std::atomic<uint64_t> Consumed = 0;
+      std::atomic<bool> Active = true;
+      std::atomic<bool> Failed = false;
+      std::atomic<std::size_t> SchedulerWaiters = 0;
+      ParkingLot NotFull;
+      ParkingLot StateChanged;
+      std::mutex FailureGuard;
+      std::exception_ptr Failure;
     };
 
   private:
-    const typename Queue<T>::Ptr QueueObject;
-    const Progress::Ptr Statistic;
-    const typename ::DataReceiver<T>::Ptr Delegate;
-    typedef std::list<typename Activity::Ptr> ActivitiesList;
-    ActivitiesList Activities;
+    const std::shared_ptr<Pipe> State;
   };
 }  // namespace Async
@@ -0,0 +1,105 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Ordered delivery of concurrently produced items
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// common includes
+#include <data_streaming.h>
+// std includes
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+
+namespace Async
+{
+  /*
+    Passes items to delegate in order of their Index field starting from 0, items received out of order are buffered.
+    Delegate is called by single thread at once (possibly reentrantly producing the next items), so it may be not
+    thread-safe. Every index should be passed exactly once. Exceptions from delegate are not propagated to producers:
+    delivery is stopped and the exception is rethrown from Flush.
+  */
+  template<class T>
+  class OrderedReceiver : public ::DataReceiver<T>
+  {
+  public:
+    explicit OrderedReceiver(typename ::DataReceiver<T>::Ptr delegate)
+      : Delegate(std::move(delegate))
+    {}
+
+    void ApplyData(T data) override
+    {
+      std::unique_lock<std::mutex> lock(Guard);
+      if (Failure)
+      {
+        return;
+      }
+      const auto idx = data.Index;
+      Pending.emplace(idx, std::move(data));
+      if (Delivering)
+      {
+        // current delivering thread will pick it up
+        return;
+      }
+      Delivering = true;
+      while (!Failure && !Pending.empty() && Pending.begin()->first == Delivered)
+      {
+        auto item = std::move(Pending.begin()->second);
+        Pending.erase(Pending.begin());
+        lock.unlock();
+        try
+        {
+          Delegate->ApplyData(std::move(item));
+        }
+        catch (...)
+        {
+          lock.lock();
+          Failure = std::current_exception();
+          break;
+        }
+        lock.lock();
+        ++Delivered;
+        Progress.notify_all();
+      }
+      Delivering = false;
+      Progress.notify_all();
+    }
+
+    void Flush() override
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        if (Failure)
+        {
+          std::rethrow_exception(Failure);
+        }
+      }
+      Delegate->Flush();
+    }
+
+    //! @brief Blocks until specified count of items are delivered
+    //! @return false if delivery is failed
+    bool WaitDelivered(std::size_t count)
+    {
+      std::unique_lock<std::mutex> lock(Guard);
+      Progress.wait(lock, [this, count]() { return Failure || Delivered >= count; });
+      return !Failure;
+    }
+
+  private:
+    const typename ::DataReceiver<T>::Ptr Delegate;
+    std::mutex Guard;
+    std::condition_variable Progress;
+    std::map<std::size_t, T> Pending;
+    std::size_t Delivered = 0;
+    bool Delivering = false;
+    std::exception_ptr Failure;
+  };
+}  // namespace Async
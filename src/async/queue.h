@@ -25,10 +25,15 @@ namespace Async
 
     //! @brief Enqueue object
     virtual void Add(T val) = 0;
+    //! @brief Enqueue several objects moving them from vals, block while there's no space
+    virtual void AddMany(T* vals, std::size_t count) = 0;
     //! @brief Get last available object, block until arrives or break
     //! @return true if object is acquired, else otherwise
     //! @invariant In case of false return res will keep intact
     virtual bool Get(T& res) = 0;
+    //! @brief Get up to limit available objects, block until at least one arrives or break
+    //! @return acquired objects count, 0 in case of break
+    virtual std::size_t GetMany(T* res, std::size_t limit) = 0;
     //! @brief Clear queue and release all the waiters
     virtual void Reset() = 0;
     //! @brief Wait until queue become empty
@@ -0,0 +1,433 @@
+/**
+ *
+ * @file
+ *
+ * @brief Lock-free bounded queues
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// common includes
+#include <make_ptr.h>
+#include <types.h>
+// library includes
+#include <async/queue.h>
+// std includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Async
+{
+  /*
+    Waiting point for lock-free structures. Notifiers do not touch mutex if there are no waiters.
+    std::atomic::wait is not used since it's missing in some of the supported toolchains (Android NDK r21, gcc8).
+  */
+  class ParkingLot
+  {
+  public:
+    template<class Predicate>
+    void Wait(Predicate ready)
+    {
+      if (Spin(ready))
+      {
+        return;
+      }
+      std::unique_lock<std::mutex> lock(Guard);
+      Waiters.fetch_add(1);
+      Event.wait(lock, ready);
+      Waiters.fetch_sub(1);
+    }
+
+    //! @note Should be called after state change visible to Wait's predicate
+    void NotifyOne()
+    {
+      if (HasWaiters())
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        Event.notify_one();
+      }
+    }
+
+    void NotifyAll()
+    {
+      if (HasWaiters())
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        Event.notify_all();
+      }
+    }
+
+  private:
+    // short spinning avoids locking on both sides for quickly changing state
+    template<class Predicate>
+    static bool Spin(Predicate ready)
+    {
+      for (uint_t spin = 0; spin < SPIN_COUNT; ++spin)
+      {
+        if (ready())
+        {
+          return true;
+        }
+        std::this_thread::yield();
+      }
+      return false;
+    }
+
+    bool HasWaiters() const
+    {
+      // pairs with waiter's counter increment before predicate check
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return Waiters.load(std::memory_order_relaxed) != 0;
+    }
+
+  private:
+    static const uint_t SPIN_COUNT = 16;
+    std::atomic<uint_t> Waiters = 0;
+    std::mutex Guard;
+    std::condition_variable Event;
+  };
+
+  inline std::size_t GetRingCapacity(std::size_t minSize)
+  {
+    std::size_t result = 2;
+    while (result < minSize)
+    {
+      result *= 2;
+    }
+    return result;
+  }
+
+  /*
+    Common part of ring-based queues. Implementation should provide non-blocking methods:
+      std::size_t TryAddMany(T* vals, std::size_t count);
+      std::size_t TryGetMany(T* res, std::size_t limit);
+      bool IsEmpty() const;
+      bool IsFull() const;
+    and SINGLE_CONSUMER constant to serialize getting with dropping on Reset.
+  */
+  template<class T, class Impl>
+  class RingQueueBase : public Queue<T>
+  {
+  public:
+    void Add(T val) override
+    {
+      AddMany(&val, 1);
+    }
+
+    void AddMany(T* vals, std::size_t count) override
+    {
+      while (count != 0 && Active)
+      {
+        if (const auto added = Self().TryAddMany(vals, count))
+        {
+          vals += added;
+          count -= added;
+          NotEmpty.NotifyOne();
+          // NotifyOne orders check after adding, so item added concurrently with Reset is dropped by either side
+          if (!Active)
+          {
+            Drop();
+          }
+        }
+        else
+        {
+          NotFull.Wait([this]() { return !Active || !Self().IsFull(); });
+        }
+      }
+    }
+
+    bool Get(T& res) override
+    {
+      return GetMany(&res, 1) != 0;
+    }
+
+    std::size_t GetMany(T* res, std::size_t limit) override
+    {
+      while (Active)
+      {
+        if (const auto got = Take(res, limit))
+        {
+          NotFull.NotifyOne();
+          if (Self().IsEmpty())
+          {
+            Drained.NotifyAll();
+          }
+          return got;
+        }
+        NotEmpty.Wait([this]() { return !Active || !Self().IsEmpty(); });
+      }
+      return 0;
+    }
+
+    void Reset() override
+    {
+      Active = false;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      Drop();
+      NotEmpty.NotifyAll();
+      NotFull.NotifyAll();
+      Drained.NotifyAll();
+    }
+
+    void Flush() override
+    {
+      Drained.Wait([this]() { return !Active || Self().IsEmpty(); });
+    }
+
+  private:
+    Impl& Self()
+    {
+      return static_cast<Impl&>(*this);
+    }
+
+    std::size_t Take(T* res, std::size_t limit)
+    {
+      const ConsumerLock lock(*this);
+      return Active ? Self().TryGetMany(res, limit) : 0;
+    }
+
+    void Drop()
+    {
+      const ConsumerLock lock(*this);
+      for (T dropped; Self().TryGetMany(&dropped, 1);)
+      {
+        dropped = T();
+      }
+    }
+
+    // getters are short, so spinning is enough
+    class ConsumerLock
+    {
+    public:
+      explicit ConsumerLock(RingQueueBase& queue)
+        : Flag(Impl::SINGLE_CONSUMER ? &queue.Consuming : nullptr)
+      {
+        while (Flag && Flag->test_and_set(std::memory_order_acquire))
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      ~ConsumerLock()
+      {
+        if (Flag)
+        {
+          Flag->clear(std::memory_order_release);
+        }
+      }
+
+    private:
+      std::atomic_flag* const Flag;
+    };
+
+  private:
+    std::atomic<bool> Active = true;
+    std::atomic_flag Consuming = ATOMIC_FLAG_INIT;
+    ParkingLot NotEmpty;
+    ParkingLot NotFull;
+    // flushers are waiting separately from producers, so all of them are woken up
+    ParkingLot Drained;
+  };
+
+  //! @brief Single producer single consumer queue
+  template<class T>
+  class SpscQueue : public RingQueueBase<T, SpscQueue<T> >
+  {
+  public:
+    explicit SpscQueue(std::size_t minSize)
+      : Mask(GetRingCapacity(minSize) - 1)
+      , Buffer(Mask + 1)
+    {}
+
+    std::size_t TryAddMany(T* vals, std::size_t count)
+    {
+      const auto tail = Tail.load(std::memory_order_relaxed);
+      if (tail - CachedHead + count > Buffer.size())
+      {
+        CachedHead = Head.load(std::memory_order_acquire);
+      }
+      const auto toAdd = std::min(count, Buffer.size() - (tail - CachedHead));
+      for (std::size_t idx = 0; idx < toAdd; ++idx)
+      {
+        Buffer[(tail + idx) & Mask] = std::move(vals[idx]);
+      }
+      Tail.store(tail + toAdd, std::memory_order_release);
+      return toAdd;
+    }
+
+    std::size_t TryGetMany(T* res, std::size_t limit)
+    {
+      const auto head = Head.load(std::memory_order_relaxed);
+      if (CachedTail - head < limit)
+      {
+        CachedTail = Tail.load(std::memory_order_acquire);
+      }
+      const auto toGet = std::min(limit, CachedTail - head);
+      for (std::size_t idx = 0; idx < toGet; ++idx)
+      {
+        res[idx] = std::move(Buffer[(head + idx) & Mask]);
+      }
+      Head.store(head + toGet, std::memory_order_release);
+      return toGet;
+    }
+
+    bool IsEmpty() const
+    {
+      return Head.load() == Tail.load();
+    }
+
+    bool IsFull() const
+    {
+      return Tail.load() - Head.load() == Buffer.size();
+    }
+
+    static typename Queue<T>::Ptr Create(std::size_t size)
+    {
+      return MakePtr<SpscQueue<T> >(size);
+    }
+
+    static const bool SINGLE_CONSUMER = true;
+
+  private:
+    const std::size_t Mask;
+    std::vector<T> Buffer;
+    // consumer side
+    alignas(64) std::atomic<std::size_t> Head = 0;
+    std::size_t CachedTail = 0;
+    // producer side
+    alignas(64) std::atomic<std::size_t> Tail = 0;
+    std::size_t CachedHead = 0;
+  };
+
+  //! @brief Multiple producers multiple consumers queue (D.Vyukov's bounded queue)
+  template<class T>
+  class MpmcQueue : public RingQueueBase<T, MpmcQueue<T> >
+  {
+  public:
+    explicit MpmcQueue(std::size_t minSize)
+      : Mask(GetRingCapacity(minSize) - 1)
+      , Cells(new Cell[Mask + 1])
+    {
+      for (std::size_t idx = 0; idx <= Mask; ++idx)
+      {
+        Cells[idx].Sequence.store(idx, std::memory_order_relaxed);
+      }
+    }
+
+    std::size_t TryAddMany(T* vals, std::size_t count)
+    {
+      std::size_t added = 0;
+      while (added < count && TryAdd(vals[added]))
+      {
+        ++added;
+      }
+      return added;
+    }
+
+    std::size_t TryGetMany(T* res, std::size_t limit)
+    {
+      std::size_t got = 0;
+      while (got < limit && TryGet(res[got]))
+      {
+        ++got;
+      }
+      return got;
+    }
+
+    bool IsEmpty() const
+    {
+      const auto pos = DequeuePos.load();
+      return static_cast<std::ptrdiff_t>(Cells[pos & Mask].Sequence.load() - (pos + 1)) < 0;
+    }
+
+    bool IsFull() const
+    {
+      const auto pos = EnqueuePos.load();
+      return static_cast<std::ptrdiff_t>(Cells[pos & Mask].Sequence.load() - pos) < 0;
+    }
+
+    static typename Queue<T>::Ptr Create(std::size_t size)
+    {
+      return MakePtr<MpmcQueue<T> >(size);
+    }
+
+    static const bool SINGLE_CONSUMER = false;
+
+  private:
+    bool TryAdd(T& val)
+    {
+      auto pos = EnqueuePos.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        auto& cell = Cells[pos & Mask];
+        const auto seq = cell.Sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+        if (diff == 0)
+        {
+          if (EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          {
+            cell.Data = std::move(val);
+            cell.Sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (diff < 0)
+        {
+          return false;
+        }
+        else
+        {
+          pos = EnqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    bool TryGet(T& res)
+    {
+      auto pos = DequeuePos.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        auto& cell = Cells[pos & Mask];
+        const auto seq = cell.Sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+        if (diff == 0)
+        {
+          if (DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          {
+            res = std::move(cell.Data);
+            cell.Sequence.store(pos + Mask + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (diff < 0)
+        {
+          return false;
+        }
+        else
+        {
+          pos = DequeuePos.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      T Data;
+    };
+
+    const std::size_t Mask;
+    const std::unique_ptr<Cell[]> Cells;
+    alignas(64) std::atomic<std::size_t> EnqueuePos = 0;
+    alignas(64) std::atomic<std::size_t> DequeuePos = 0;
+  };
+}  // namespace Async
@@ -0,0 +1,77 @@
+/**
+ *
+ * @file
+ *
+ * @brief Shared work-stealing tasks scheduler
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// common includes
+#include <types.h>
+// std includes
+#include <functional>
+#include <memory>
+
+namespace Async
+{
+  class Scheduler
+  {
+  public:
+    typedef std::shared_ptr<Scheduler> Ptr;
+    typedef std::function<void()> Task;
+
+    enum class Priority
+    {
+      //! Executed before any queued tasks
+      HIGH,
+      //! Tasks posted from worker threads are executed by the same worker in LIFO order unless stolen
+      NORMAL,
+      //! Executed only when there's nothing else to do
+      LOW
+    };
+
+    struct Statistic
+    {
+      std::size_t Workers = 0;
+      //! Tasks posted but not started yet
+      std::size_t QueueDepth = 0;
+      uint64_t Executed = 0;
+      //! Tasks executed by worker other than owner of local queue
+      uint64_t Stolen = 0;
+      //! Tasks finished by exception
+      uint64_t Failed = 0;
+    };
+
+    virtual ~Scheduler() = default;
+
+    //! @brief Enqueue task for execution
+    //! @note Tasks should deliver their results and errors by themselves. Escaped exceptions are just logged and
+    //!       counted in Statistic::Failed
+    virtual void Post(Task task, Priority priority = Priority::NORMAL) = 0;
+
+    //! @return true if called from one of the worker threads of this scheduler
+    virtual bool IsWorkerThread() const = 0;
+
+    //! @brief Execute single pending task in caller's thread
+    //! @return false if there's nothing to execute
+    //! @note Used to help instead of blocking on waiting for tasks results
+    virtual bool RunPending() = 0;
+
+    //! @brief Execute pending tasks in caller's thread until condition is met
+    //! @param ready Checked after each executed task and on each Post(), task completion or Notify() in any thread
+    virtual void WaitUntil(const std::function<bool()>& ready) = 0;
+
+    //! @brief Wake up all the WaitUntil callers to recheck their conditions
+    virtual void Notify() = 0;
+
+    virtual Statistic GetStatistic() const = 0;
+
+    static Ptr Create(std::size_t workersCount);
+    //! @brief Process-wide scheduler with hardware concurrency workers
+    static Ptr GetShared();
+  };
+}  // namespace Async
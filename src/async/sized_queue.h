@@ -16,6 +16,7 @@
 // library includes
 #include <async/queue.h>
 // std includes
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -43,6 +44,20 @@ namespace Async
       }
     }
 
+    void AddMany(T* vals, std::size_t count) override
+    {
+      std::unique_lock<std::mutex> lock(Locker);
+      for (auto* const end = vals + count; vals != end && Active;)
+      {
+        CanPutDataEvent.wait(lock, [this]() { return CanPutData(); });
+        for (; vals != end && Active && Container.size() < MaxSize; ++vals)
+        {
+          Container.emplace_back(std::move(*vals));
+        }
+        CanGetDataEvent.notify_all();
+      }
+    }
+
     bool Get(T& res) override
     {
       std::unique_lock<std::mutex> lock(Locker);
@@ -58,6 +73,21 @@ namespace Async
       return false;
     }
 
+    std::size_t GetMany(T* res, std::size_t limit) override
+    {
+      std::unique_lock<std::mutex> lock(Locker);
+      CanGetDataEvent.wait(lock, [this]() { return CanGetData(); });
+      if (!Active)
+      {
+        return 0;
+      }
+      const auto count = std::min(limit, Container.size());
+      std::move(Container.begin(), Container.begin() + count, res);
+      Container.erase(Container.begin(), Container.begin() + count);
+      CanPutDataEvent.notify_all();
+      return count;
+    }
+
     void Reset() override
     {
       const std::lock_guard<std::mutex> lock(Locker);
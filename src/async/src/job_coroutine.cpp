@@ -43,7 +43,7 @@ namespace Async
 
   class CoroutineOperation
     : public Operation
-    , private Scheduler
+    , private Coroutine::Scheduler
   {
   public:
     CoroutineOperation(Coroutine::Ptr routine, Event<JobState>& state)
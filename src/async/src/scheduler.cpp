@@ -0,0 +1,390 @@
+/**
+ *
+ * @file
+ *
+ * @brief Shared work-stealing tasks scheduler implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// common includes
+#include <contract.h>
+#include <error.h>
+#include <make_ptr.h>
+// library includes
+#include <async/scheduler.h>
+#include <debug/log.h>
+// std includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Async
+{
+  const Debug::Stream Dbg("Async::Scheduler");
+
+  /*
+    Chase-Lev deque with fixed capacity (see "Correct and Efficient Work-Stealing for Weak Memory Models").
+    Owner pushes and pops at the bottom, thieves take from the top.
+  */
+  template<class T>
+  class WorkStealingDeque
+  {
+  public:
+    WorkStealingDeque()
+      : Top(0)
+      , Bottom(0)
+    {
+      for (auto& slot : Slots)
+      {
+        slot.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    //! @return false if deque is full
+    bool Push(T* item)
+    {
+      const auto bottom = Bottom.load(std::memory_order_relaxed);
+      const auto top = Top.load(std::memory_order_acquire);
+      if (bottom - top >= static_cast<int64_t>(CAPACITY))
+      {
+        return false;
+      }
+      Slots[bottom & MASK].store(item, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      Bottom.store(bottom + 1, std::memory_order_relaxed);
+      return true;
+    }
+
+    T* Pop()
+    {
+      const auto bottom = Bottom.load(std::memory_order_relaxed) - 1;
+      Bottom.store(bottom, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto top = Top.load(std::memory_order_relaxed);
+      if (top > bottom)
+      {
+        Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      auto* result = Slots[bottom & MASK].load(std::memory_order_relaxed);
+      if (top == bottom)
+      {
+        // last item, race with thieves
+        if (!Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+          result = nullptr;
+        }
+        Bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+      return result;
+    }
+
+    T* Steal()
+    {
+      auto top = Top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const auto bottom = Bottom.load(std::memory_order_acquire);
+      if (top >= bottom)
+      {
+        return nullptr;
+      }
+      auto* result = Slots[top & MASK].load(std::memory_order_relaxed);
+      return Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)
+                 ? result
+                 : nullptr;
+    }
+
+  private:
+    static const std::size_t CAPACITY = 1024;
+    static const std::size_t MASK = CAPACITY - 1;
+    std::atomic<int64_t> Top;
+    std::atomic<int64_t> Bottom;
+    std::array<std::atomic<T*>, CAPACITY> Slots;
+  };
+
+  class WorkStealingScheduler : public Scheduler
+  {
+  public:
+    explicit WorkStealingScheduler(std::size_t workersCount)
+      : Deques(workersCount)
+    {
+      Require(workersCount != 0);
+      Threads.reserve(workersCount);
+      for (std::size_t idx = 0; idx < workersCount; ++idx)
+      {
+        Threads.emplace_back(&WorkStealingScheduler::WorkProc, this, idx);
+      }
+    }
+
+    ~WorkStealingScheduler() override
+    {
+      {
+        const std::lock_guard<std::mutex> lock(SleepGuard);
+        Stopping = true;
+      }
+      Wakeup.notify_all();
+      for (auto& thread : Threads)
+      {
+        thread.join();
+      }
+      for (auto& deque : Deques)
+      {
+        while (auto* task = deque.Pop())
+        {
+          delete task;
+        }
+      }
+    }
+
+    void Post(Task task, Priority priority) override
+    {
+      auto holder = std::make_unique<Task>(std::move(task));
+      Pending.fetch_add(1);
+      if (priority == Priority::NORMAL && CurrentScheduler == this && Deques[CurrentWorker].Push(holder.get()))
+      {
+        holder.release();
+      }
+      else
+      {
+        const std::lock_guard<std::mutex> lock(QueuesGuard);
+        Queues[static_cast<std::size_t>(priority)].push_back(std::move(holder));
+        Queued.fetch_add(1);
+      }
+      if (Sleeping.load() != 0)
+      {
+        {
+          const std::lock_guard<std::mutex> lock(SleepGuard);
+        }
+        Wakeup.notify_one();
+      }
+      // helpers may execute it
+      Notify();
+    }
+
+    bool IsWorkerThread() const override
+    {
+      return CurrentScheduler == this;
+    }
+
+    bool RunPending() override
+    {
+      if (auto* task = FindTask(IsWorkerThread() ? CurrentWorker : NO_WORKER))
+      {
+        Execute(task);
+        return true;
+      }
+      return false;
+    }
+
+    void WaitUntil(const std::function<bool()>& ready) override
+    {
+      for (;;)
+      {
+        // taken before condition check to not miss notification between check and waiting
+        const auto epoch = Epoch.load();
+        if (ready())
+        {
+          return;
+        }
+        if (RunPending())
+        {
+          continue;
+        }
+        std::unique_lock<std::mutex> lock(HelpGuard);
+        Helping.fetch_add(1);
+        Changed.wait(lock, [this, epoch]() { return Epoch.load() != epoch; });
+        Helping.fetch_sub(1);
+      }
+    }
+
+    void Notify() override
+    {
+      Epoch.fetch_add(1);
+      if (Helping.load() != 0)
+      {
+        {
+          const std::lock_guard<std::mutex> lock(HelpGuard);
+        }
+        Changed.notify_all();
+      }
+    }
+
+    Statistic GetStatistic() const override
+    {
+      Statistic result;
+      result.Workers = Threads.size();
+      result.QueueDepth = Pending.load();
+      result.Executed = Executed.load();
+      result.Stolen = Stolen.load();
+      result.Failed = Failed.load();
+      return result;
+    }
+
+  private:
+    void WorkProc(std::size_t idx)
+    {
+      CurrentScheduler = this;
+      CurrentWorker = idx;
+      for (;;)
+      {
+        if (auto* task = FindTask(idx))
+        {
+          Execute(task);
+        }
+        else if (Stopping)
+        {
+          break;
+        }
+        else if (Pending.load() != 0)
+        {
+          // task is being posted right now
+          std::this_thread::yield();
+        }
+        else
+        {
+          Park();
+        }
+      }
+      CurrentScheduler = nullptr;
+    }
+
+    Task* FindTask(std::size_t self)
+    {
+      if (self != NO_WORKER)
+      {
+        if (auto* task = Deques[self].Pop())
+        {
+          return task;
+        }
+      }
+      if (auto* task = Dequeue(Priority::HIGH))
+      {
+        return task;
+      }
+      if (auto* task = Dequeue(Priority::NORMAL))
+      {
+        return task;
+      }
+      const auto count = Deques.size();
+      for (std::size_t offset = 1; offset <= count; ++offset)
+      {
+        const auto victim = (self + offset) % count;
+        if (victim == self)
+        {
+          continue;
+        }
+        if (auto* task = Deques[victim].Steal())
+        {
+          Stolen.fetch_add(1, std::memory_order_relaxed);
+          return task;
+        }
+      }
+      return Dequeue(Priority::LOW);
+    }
+
+    Task* Dequeue(Priority priority)
+    {
+      if (Queued.load() == 0)
+      {
+        return nullptr;
+      }
+      const std::lock_guard<std::mutex> lock(QueuesGuard);
+      auto& queue = Queues[static_cast<std::size_t>(priority)];
+      if (queue.empty())
+      {
+        return nullptr;
+      }
+      auto* result = queue.front().release();
+      queue.pop_front();
+      Queued.fetch_sub(1);
+      return result;
+    }
+
+    void Execute(Task* task)
+    {
+      const std::unique_ptr<Task> holder(task);
+      Pending.fetch_sub(1);
+      try
+      {
+        (*holder)();
+      }
+      catch (const std::exception& e)
+      {
+        Failed.fetch_add(1, std::memory_order_relaxed);
+        Dbg("Task failed: %1%", e.what());
+      }
+      catch (const Error& e)
+      {
+        Failed.fetch_add(1, std::memory_order_relaxed);
+        Dbg("Task failed: %1%", e.ToString());
+      }
+      catch (...)
+      {
+        Failed.fetch_add(1, std::memory_order_relaxed);
+        Dbg("Task failed with unknown exception");
+      }
+      Executed.fetch_add(1, std::memory_order_relaxed);
+      // task may change state someone is waiting for
+      Notify();
+    }
+
+    void Park()
+    {
+      std::unique_lock<std::mutex> lock(SleepGuard);
+      Sleeping.fetch_add(1);
+      Wakeup.wait(lock, [this]() { return Stopping || Pending.load() != 0; });
+      Sleeping.fetch_sub(1);
+    }
+
+  private:
+    static const std::size_t NO_WORKER = ~std::size_t(0);
+    static thread_local const WorkStealingScheduler* CurrentScheduler;
+    static thread_local std::size_t CurrentWorker;
+
+    std::vector<WorkStealingDeque<Task>> Deques;
+    std::vector<std::thread> Threads;
+    // global queues per priority
+    std::mutex QueuesGuard;
+    std::array<std::deque<std::unique_ptr<Task>>, 3> Queues;
+    std::atomic<std::size_t> Queued = 0;
+    // parking
+    std::mutex SleepGuard;
+    std::condition_variable Wakeup;
+    std::atomic<std::size_t> Sleeping = 0;
+    std::atomic<bool> Stopping = false;
+    // helpers waiting in WaitUntil
+    std::mutex HelpGuard;
+    std::condition_variable Changed;
+    std::atomic<uint64_t> Epoch = 0;
+    std::atomic<std::size_t> Helping = 0;
+    // statistic
+    std::atomic<std::size_t> Pending = 0;
+    std::atomic<uint64_t> Executed = 0;
+    std::atomic<uint64_t> Stolen = 0;
+    std::atomic<uint64_t> Failed = 0;
+  };
+
+  thread_local const WorkStealingScheduler* WorkStealingScheduler::CurrentScheduler = nullptr;
+  thread_local std::size_t WorkStealingScheduler::CurrentWorker = 0;
+}  // namespace Async
+
+namespace Async
+{
+  Scheduler::Ptr Scheduler::Create(std::size_t workersCount)
+  {
+    return MakePtr<WorkStealingScheduler>(workersCount);
+  }
+
+  Scheduler::Ptr Scheduler::GetShared()
+  {
+    static const auto instance = Create(std::max<std::size_t>(std::thread::hardware_concurrency(), 2));
+    return instance;
+  }
+}  // namespace Async
@@ -0,0 +1,182 @@
+/**
+ *
+ * @file
+ *
+ * @brief Asynchronous queues test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <async/ring_queue.h>
+#include <async/sized_queue.h>
+#include <error.h>
+#include <types.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define FILE_TAG 7C41D0E8
+
+namespace
+{
+  using namespace Async;
+
+  const uint_t ITEMS = 1000000;
+  const std::size_t BATCH = 64;
+
+  struct Result
+  {
+    uint64_t Sum = 0;
+    uint_t Count = 0;
+  };
+
+  Result Consume(Queue<uint_t>& queue, bool batched)
+  {
+    Result res;
+    uint_t buf[BATCH];
+    while (const auto got = batched ? queue.GetMany(buf, BATCH) : queue.Get(buf[0]))
+    {
+      for (std::size_t idx = 0; idx < got; ++idx)
+      {
+        res.Sum += buf[idx];
+        ++res.Count;
+      }
+    }
+    return res;
+  }
+
+  void Produce(Queue<uint_t>& queue, uint_t first, uint_t count, bool batched)
+  {
+    uint_t buf[BATCH];
+    for (uint_t val = first, lim = first + count; val < lim;)
+    {
+      if (batched)
+      {
+        std::size_t size = 0;
+        for (; size < BATCH && val < lim; ++size, ++val)
+        {
+          buf[size] = val;
+        }
+        queue.AddMany(buf, size);
+      }
+      else
+      {
+        queue.Add(val++);
+      }
+    }
+  }
+
+  void TestQueue(const char* name, Queue<uint_t>::Ptr queue, uint_t producers, uint_t consumers, bool batched)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    std::vector<Result> results(consumers);
+    for (uint_t idx = 0; idx < consumers; ++idx)
+    {
+      threads.emplace_back([&queue, &results, idx, batched]() { results[idx] = Consume(*queue, batched); });
+    }
+    const uint_t perProducer = ITEMS / producers;
+    std::vector<std::thread> producing;
+    for (uint_t idx = 0; idx < producers; ++idx)
+    {
+      producing.emplace_back([&queue, idx, perProducer, batched]() {
+        Produce(*queue, 1 + idx * perProducer, perProducer, batched);
+      });
+    }
+    for (auto& thr : producing)
+    {
+      thr.join();
+    }
+    queue->Flush();
+    queue->Reset();
+    for (auto& thr : threads)
+    {
+      thr.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Result total;
+    for (const auto& res : results)
+    {
+      total.Sum += res.Sum;
+      total.Count += res.Count;
+    }
+    const uint_t count = perProducer * producers;
+    const uint64_t sum = uint64_t(count) * (count + 1) / 2;
+    std::cout << name << (batched ? " (batched)" : "") << " " << producers << "x" << consumers << ": "
+              << uint_t(count / elapsed / 1000) << "k items/s" << std::endl;
+    if (total.Count != count || total.Sum != sum)
+    {
+      throw Error(THIS_LINE, "Invalid result");
+    }
+  }
+
+  void TestReset()
+  {
+    std::cout << "Test for reset" << std::endl;
+    const auto queue = SpscQueue<uint_t>::Create(4);
+    std::thread consumer([&queue]() {
+      uint_t val = 0;
+      while (queue->Get(val))
+      {}
+    });
+    queue->Add(1);
+    queue->Flush();
+    queue->Reset();
+    consumer.join();
+    uint_t val = 0;
+    if (queue->Get(val))
+    {
+      throw Error(THIS_LINE, "Should not get after reset");
+    }
+    std::cout << "Succeed\n";
+  }
+
+  void TestResetDropsItems(const char* name, Queue<std::shared_ptr<uint_t> >::Ptr queue)
+  {
+    std::cout << "Test for items dropping on reset of " << name << std::endl;
+    const auto item = std::make_shared<uint_t>(1);
+    for (uint_t idx = 0; idx < 3; ++idx)
+    {
+      queue->Add(item);
+    }
+    queue->Reset();
+    if (item.use_count() != 1)
+    {
+      throw Error(THIS_LINE, "Pending items should be released on reset");
+    }
+    queue->Add(item);
+    if (item.use_count() != 1)
+    {
+      throw Error(THIS_LINE, "Items should not be added after reset");
+    }
+    std::cout << "Succeed\n";
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    const std::size_t SIZE = 1024;
+    for (const bool batched : {false, true})
+    {
+      TestQueue("SizedQueue", SizedQueue<uint_t>::Create(SIZE), 1, 1, batched);
+      TestQueue("SpscQueue", SpscQueue<uint_t>::Create(SIZE), 1, 1, batched);
+      TestQueue("MpmcQueue", MpmcQueue<uint_t>::Create(SIZE), 1, 1, batched);
+      TestQueue("SizedQueue", SizedQueue<uint_t>::Create(SIZE), 4, 4, batched);
+      TestQueue("MpmcQueue", MpmcQueue<uint_t>::Create(SIZE), 4, 4, batched);
+    }
+    TestReset();
+    TestResetDropsItems("SizedQueue", SizedQueue<std::shared_ptr<uint_t> >::Create(4));
+    TestResetDropsItems("SpscQueue", SpscQueue<std::shared_ptr<uint_t> >::Create(4));
+    TestResetDropsItems("MpmcQueue", MpmcQueue<std::shared_ptr<uint_t> >::Create(4));
+  }
+  catch (const Error& err)
+  {
+    std::cout << "Failed: \n";
+    std::cerr << err.ToString();
+  }
+}
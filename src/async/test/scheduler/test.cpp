@@ -0,0 +1,290 @@
+/**
+ *
+ * @file
+ *
+ * @brief Asynchronous scheduler test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <async/data_receiver.h>
+#include <async/scheduler.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <make_ptr.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define FILE_TAG 5E3A91C2
+
+namespace
+{
+  using namespace Async;
+
+  Error FailedToProcessError()
+  {
+    return Error(THIS_LINE, "Failed to process");
+  }
+
+  class CountingReceiver : public ::DataReceiver<uint_t>
+  {
+  public:
+    void ApplyData(uint_t data) override
+    {
+      if (data == FAILING_VALUE)
+      {
+        throw FailedToProcessError();
+      }
+      else if (data == THROWING_VALUE)
+      {
+        throw std::runtime_error("Unexpected exception");
+      }
+      Sum += data;
+      ++Count;
+    }
+
+    void Flush() override
+    {
+      ++Flushes;
+    }
+
+    static const uint_t FAILING_VALUE = ~uint_t(0);
+    static const uint_t THROWING_VALUE = FAILING_VALUE - 1;
+    std::atomic<uint_t> Sum = 0;
+    std::atomic<uint_t> Count = 0;
+    std::atomic<uint_t> Flushes = 0;
+  };
+
+  // splits every value to several ones and passes them to nested stage
+  class SplittingReceiver : public ::DataReceiver<uint_t>
+  {
+  public:
+    explicit SplittingReceiver(::DataReceiver<uint_t>::Ptr target)
+      : Target(std::move(target))
+    {}
+
+    void ApplyData(uint_t data) override
+    {
+      for (uint_t idx = 0; idx < SPLIT; ++idx)
+      {
+        Target->ApplyData(data);
+      }
+    }
+
+    void Flush() override
+    {
+      Target->Flush();
+    }
+
+    static const uint_t SPLIT = 10;
+
+  private:
+    const ::DataReceiver<uint_t>::Ptr Target;
+  };
+
+  // slowly processes items keeping them
+  class HoldingReceiver : public ::DataReceiver<std::shared_ptr<uint_t> >
+  {
+  public:
+    void ApplyData(std::shared_ptr<uint_t> data) override
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      Items.push_back(std::move(data));
+    }
+
+    void Flush() override {}
+
+  private:
+    std::vector<std::shared_ptr<uint_t> > Items;
+  };
+
+  void CheckEqual(uint_t actual, uint_t expected, const char* msg)
+  {
+    if (actual != expected)
+    {
+      throw Error(THIS_LINE, msg);
+    }
+  }
+
+  void TestTasks()
+  {
+    std::cout << "Test for tasks execution" << std::endl;
+    const auto sched = Scheduler::Create(4);
+    const uint_t TASKS = 10000;
+    std::atomic<uint_t> done = 0;
+    for (uint_t idx = 0; idx < TASKS; ++idx)
+    {
+      const auto prio = static_cast<Scheduler::Priority>(idx % 3);
+      sched->Post(
+          [&done, &sched]() {
+            // nested tasks are put to local queues
+            sched->Post([&done]() { ++done; });
+          },
+          prio);
+    }
+    while (done != TASKS)
+    {
+      if (!sched->RunPending())
+      {
+        std::this_thread::yield();
+      }
+    }
+    const auto stat = sched->GetStatistic();
+    CheckEqual(stat.Workers, 4, "Invalid workers count");
+    CheckEqual(stat.QueueDepth, 0, "Queue should be empty");
+    std::cout << "Executed " << stat.Executed << " stolen " << stat.Stolen << "\nSucceed\n";
+  }
+
+  void TestWaiting()
+  {
+    std::cout << "Test for waiting and failed tasks" << std::endl;
+    const auto sched = Scheduler::Create(2);
+    sched->Post([]() { throw std::runtime_error("Task failure"); });
+    // woken up by task completion
+    sched->WaitUntil([&sched]() { return sched->GetStatistic().Failed == 1; });
+    std::atomic<bool> ready = false;
+    std::thread notifier([&ready, &sched]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      ready = true;
+      sched->Notify();
+    });
+    sched->WaitUntil([&ready]() { return ready.load(); });
+    notifier.join();
+    CheckEqual(sched->GetStatistic().QueueDepth, 0, "Queue should be empty");
+    std::cout << "Succeed\n";
+  }
+
+  void TestNestedPipeline()
+  {
+    std::cout << "Test for nested pipeline on single worker" << std::endl;
+    // every stage's worker blocks on full queue of the next one, should not deadlock
+    const auto sched = Scheduler::Create(1);
+    const auto target = std::make_shared<CountingReceiver>();
+    const auto stage2 = Async::DataReceiver<uint_t>::Create(2, 2, target, sched);
+    const auto split = MakePtr<SplittingReceiver>(stage2);
+    const auto stage1 = Async::DataReceiver<uint_t>::Create(1, 2, split, sched);
+    const uint_t VALUES = 1000;
+    for (uint_t idx = 1; idx <= VALUES; ++idx)
+    {
+      stage1->ApplyData(idx);
+    }
+    stage1->Flush();
+    CheckEqual(target->Count, VALUES * SplittingReceiver::SPLIT, "Invalid processed count");
+    CheckEqual(target->Sum, SplittingReceiver::SPLIT * VALUES * (VALUES + 1) / 2, "Invalid processed sum");
+    CheckEqual(target->Flushes, 1, "Invalid flushes count");
+    std::cout << "Succeed\n";
+  }
+
+  // single worker receiver keeps items in single consumer queue
+  void TestConcurrentProducers()
+  {
+    std::cout << "Test for concurrent producers" << std::endl;
+    for (const std::size_t workers : {1, 3})
+    {
+      const auto target = std::make_shared<CountingReceiver>();
+      const auto stage = Async::DataReceiver<uint_t>::Create(workers, 4, target);
+      const uint_t PRODUCERS = 4;
+      const uint_t VALUES = 10000;
+      std::vector<std::thread> producers;
+      for (uint_t idx = 0; idx < PRODUCERS; ++idx)
+      {
+        producers.emplace_back([&stage]() {
+          for (uint_t val = 1; val <= VALUES; ++val)
+          {
+            stage->ApplyData(val);
+          }
+        });
+      }
+      for (auto& thr : producers)
+      {
+        thr.join();
+      }
+      stage->Flush();
+      CheckEqual(target->Count, PRODUCERS * VALUES, "Invalid processed count");
+      CheckEqual(target->Sum, PRODUCERS * VALUES * (VALUES + 1) / 2, "Invalid processed sum");
+    }
+    std::cout << "Succeed\n";
+  }
+
+  // receiver is destroyed with pending items
+  void TestStop()
+  {
+    std::cout << "Test for stop" << std::endl;
+    const auto item = std::make_shared<uint_t>(0);
+    {
+      const auto target = std::make_shared<HoldingReceiver>();
+      const auto stage = Async::DataReceiver<std::shared_ptr<uint_t> >::Create(1, 100, target);
+      for (uint_t idx = 0; idx < 100; ++idx)
+      {
+        stage->ApplyData(item);
+      }
+    }
+    CheckEqual(item.use_count(), 1, "Pending items should be released");
+    std::cout << "Succeed\n";
+  }
+
+  void TestError()
+  {
+    std::cout << "Test for error propagation" << std::endl;
+    const auto target = std::make_shared<CountingReceiver>();
+    const auto stage = Async::DataReceiver<uint_t>::Create(2, 10, target);
+    stage->ApplyData(1);
+    stage->ApplyData(CountingReceiver::FAILING_VALUE);
+    try
+    {
+      for (uint_t idx = 0; idx < 1000; ++idx)
+      {
+        stage->ApplyData(1);
+      }
+      stage->Flush();
+      throw Error(THIS_LINE, "Should not finish successfully");
+    }
+    catch (const Error& err)
+    {
+      if (err != FailedToProcessError())
+      {
+        throw Error(THIS_LINE, "Invalid error returned").AddSuberror(err);
+      }
+    }
+    std::cout << "Succeed\n";
+  }
+
+  void TestException()
+  {
+    std::cout << "Test for exception propagation" << std::endl;
+    const auto target = std::make_shared<CountingReceiver>();
+    const auto stage = Async::DataReceiver<uint_t>::Create(2, 10, target);
+    stage->ApplyData(1);
+    stage->ApplyData(CountingReceiver::THROWING_VALUE);
+    try
+    {
+      stage->Flush();
+      throw Error(THIS_LINE, "Should not finish successfully");
+    }
+    catch (const std::runtime_error&)
+    {}
+    std::cout << "Succeed\n";
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    TestTasks();
+    TestWaiting();
+    TestNestedPipeline();
+    TestConcurrentProducers();
+    TestStop();
+    TestError();
+    TestException();
+  }
+  catch (const Error& err)
+  {
+    std::cout << "Failed: \n";
+    std::cerr << err.ToString();
+  }
+}
@@ -0,0 +1,41 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Non-cryptographic hash functions
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// library includes
+#include <binary/view.h>
+
+namespace Binary
+{
+  struct Hash128
+  {
+    uint64_t Low = 0;
+    uint64_t High = 0;
+
+    bool operator==(const Hash128& rh) const
+    {
+      return Low == rh.Low && High == rh.High;
+    }
+
+    bool operator!=(const Hash128& rh) const
+    {
+      return !(*this == rh);
+    }
+
+    bool operator<(const Hash128& rh) const
+    {
+      return High != rh.High ? High < rh.High : Low < rh.Low;
+    }
+  };
+
+  //! @brief MurmurHash3 x64 128-bit variant
+  Hash128 Murmur3(View data, uint32_t seed = 0);
+}  // namespace Binary
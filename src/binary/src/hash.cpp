@@ -0,0 +1,107 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Hash functions implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// library includes
+#include <binary/hash.h>
+// std includes
+#include <algorithm>
+
+namespace Binary
+{
+  namespace Murmur
+  {
+    const uint64_t C1 = 0x87c37b91114253d5ull;
+    const uint64_t C2 = 0x4cf5ad432745937full;
+
+    inline uint64_t Rotate(uint64_t val, uint_t bits)
+    {
+      return (val << bits) | (val >> (64 - bits));
+    }
+
+    inline uint64_t Mix(uint64_t val)
+    {
+      val ^= val >> 33;
+      val *= 0xff51afd7ed558ccdull;
+      val ^= val >> 33;
+      val *= 0xc4ceb9fe1a85ec53ull;
+      val ^= val >> 33;
+      return val;
+    }
+
+    // little-endian order regardless of platform to get stable results
+    inline uint64_t Load(const uint8_t* data, std::size_t size)
+    {
+      uint64_t res = 0;
+      for (std::size_t idx = size; idx != 0; --idx)
+      {
+        res = (res << 8) | data[idx - 1];
+      }
+      return res;
+    }
+  }  // namespace Murmur
+
+  Hash128 Murmur3(View data, uint32_t seed)
+  {
+    using namespace Murmur;
+    const auto* const start = static_cast<const uint8_t*>(data.Start());
+    const std::size_t size = data.Size();
+    const std::size_t blocks = size / 16;
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+    for (std::size_t idx = 0; idx != blocks; ++idx)
+    {
+      uint64_t k1 = Load(start + idx * 16, 8);
+      uint64_t k2 = Load(start + idx * 16 + 8, 8);
+
+      k1 *= C1;
+      k1 = Rotate(k1, 31);
+      k1 *= C2;
+      h1 ^= k1;
+      h1 = Rotate(h1, 27);
+      h1 += h2;
+      h1 = h1 * 5 + 0x52dce729;
+
+      k2 *= C2;
+      k2 = Rotate(k2, 33);
+      k2 *= C1;
+      h2 ^= k2;
+      h2 = Rotate(h2, 31);
+      h2 += h1;
+      h2 = h2 * 5 + 0x38495ab5;
+    }
+    const auto* const tail = start + blocks * 16;
+    const std::size_t tailSize = size & 15;
+    if (tailSize > 8)
+    {
+      uint64_t k2 = Load(tail + 8, tailSize - 8);
+      k2 *= C2;
+      k2 = Rotate(k2, 33);
+      k2 *= C1;
+      h2 ^= k2;
+    }
+    if (tailSize != 0)
+    {
+      uint64_t k1 = Load(tail, std::min<std::size_t>(tailSize, 8));
+      k1 *= C1;
+      k1 = Rotate(k1, 31);
+      k1 *= C2;
+      h1 ^= k1;
+    }
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = Mix(h1);
+    h2 = Mix(h2);
+    h1 += h2;
+    h2 += h1;
+    return Hash128{h1, h2};
+  }
+}  // namespace Binary
@@ -0,0 +1,63 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Hash functions test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <binary/hash.h>
+#include <contract.h>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+namespace
+{
+  void Test(const char* testCase, bool condition)
+  {
+    std::cout << " " << testCase << ": " << (condition ? "ok" : "failed") << std::endl;
+    Require(condition);
+  }
+
+  void TestMurmur3(const char* testCase, Binary::View data, uint32_t seed, uint64_t low, uint64_t high)
+  {
+    const auto hash = Binary::Murmur3(data, seed);
+    Test(testCase, hash.Low == low && hash.High == high);
+  }
+
+  // reference values are produced by original MurmurHash3_x64_128 implementation
+  void TestMurmur3()
+  {
+    std::cout << "Test for Murmur3" << std::endl;
+    TestMurmur3("empty", Binary::View(nullptr, 0), 0, 0, 0);
+    TestMurmur3("empty seeded", Binary::View(nullptr, 0), 1, 0x4610abe56eff5cb5, 0x51622daa78f83583);
+    TestMurmur3("single byte", Binary::View("a", 1), 0, 0x85555565f6597889, 0xe6b53a48510e895a);
+    TestMurmur3("tail only", Binary::View("abc", 3), 0, 0xb4963f3f3fad7867, 0x3ba2744126ca2d52);
+    const char FOX[] = "The quick brown fox jumps over the lazy dog";
+    TestMurmur3("text", Binary::View(FOX, std::strlen(FOX)), 0, 0xe34bbc7bbc071b6c, 0x7a433ca9c49a9347);
+    TestMurmur3("text seeded", Binary::View(FOX, std::strlen(FOX)), 0x9747b28c, 0x738a7f3bd2633121,
+                0xf94573727ec016e5);
+    uint8_t sequence[33];
+    std::iota(sequence, sequence + 33, 0);
+    TestMurmur3("block with max tail", Binary::View(sequence, 31), 0, 0x053dd3e1a32cd094, 0x9ee59aefb4005490);
+    TestMurmur3("blocks", Binary::View(sequence, 32), 0, 0xc66d9022b62f500f, 0x1c050a6e34c31151);
+    TestMurmur3("blocks with tail", Binary::View(sequence, 33), 42, 0xd693141f9e1df25e, 0xaf456193ea9735c8);
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    TestMurmur3();
+  }
+  catch (...)
+  {
+    return 1;
+  }
+
+  return 0;
+}
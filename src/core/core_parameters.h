@@ -66,6 +66,10 @@ namespace Parameters
         //! @details String- table name or dump @see freq_tables.h
         const auto TABLE = PREFIX + "table"_id;
 
+        //! @brief Play tracked ay-based modules from registers stream compiled on demand and shared between renderers
+        //! @details 1 if do so
+        const auto COMPILED_STREAM = PREFIX + "compiled_stream"_id;
+
         //@{
         //! @name Duty cycle in percents
         const IntType DUTY_CYCLE_MIN = 1;
@@ -110,8 +114,11 @@ namespace Parameters
         //@{
         //! @name Interpolation mode
         const IntType INTERPOLATION_NO = 0;
+        //! Cosine interpolation
         const IntType INTERPOLATION_YES = 1;
-        //! Default is LQ
+        //! Windowed sinc interpolation
+        const IntType INTERPOLATION_HQ = 2;
+        //! Default is none
         const IntType INTERPOLATION_DEFAULT = INTERPOLATION_NO;
         //! Parameter name
         const auto INTERPOLATION = PREFIX + "interpolation"_id;
@@ -35,6 +35,7 @@
 #include <array>
 #include <list>
 #include <map>
+#include <mutex>
 
 #define FILE_TAG 7E0CBD98
 
@@ -138,22 +139,26 @@ namespace ZXTune
 
     void Enqueue(std::size_t size)
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       TotalData += size;
     }
 
     void AddArchived(std::size_t size)
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       ArchivedData += size;
     }
 
     void AddModule(std::size_t size)
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       ModulesData += size;
     }
 
     template<class PluginType>
     void AddAimed(const PluginType& plug, const Time::Timer& scanTimer)
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       StatItem& item = GetStat(plug);
       ++item.Aimed;
       item.AimedTime += scanTimer.Elapsed() + item.ScanTime;
@@ -163,6 +168,7 @@ namespace ZXTune
     template<class PluginType>
     void AddMissed(const PluginType& plug, const Time::Timer& scanTimer)
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       StatItem& item = GetStat(plug);
       ++item.Missed;
       item.MissedTime += scanTimer.Elapsed() + item.ScanTime;
@@ -172,6 +178,7 @@ namespace ZXTune
     template<class PluginType>
     void AddScanned(const PluginType& plug, const Time::Timer& scanTimer)
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       StatItem& item = GetStat(plug);
       item.ScanTime += scanTimer.Elapsed();
     }
@@ -264,6 +271,8 @@ namespace ZXTune
     }
 
   private:
+    // detection may be performed from several threads
+    std::mutex Guard;
     const Time::Timer Timer;
     uint64_t TotalData;
     uint64_t ArchivedData;
@@ -567,6 +576,19 @@ namespace ZXTune::Raw
       }
     }
 
+    // plugins may be decorated while registration, so identify them by id
+    void DisablePlugin(const String& id)
+    {
+      const auto it = std::find_if(Plugins.begin(), Plugins.end(), [&id](const PluginEntry& entry) {
+        return entry.Plugin->GetDescription()->Id() == id;
+      });
+      if (it != Plugins.end())
+      {
+        Dbg("Disabling check of %1%", id);
+        it->Offset = ~std::size_t(0);
+      }
+    }
+
   private:
     std::size_t Offset;
     PluginsList Plugins;
@@ -656,7 +678,7 @@ namespace ZXTune::Raw
       , Archives(archives)
       , Offset()
     {
-      Archives.SetPluginLookahead(denied, denied.GetDescription()->Id(), ~std::size_t(0));
+      Archives.DisablePlugin(denied.GetDescription()->Id());
     }
 
     std::size_t Detect(DataLocation::Ptr input, Module::DetectCallback& callback)
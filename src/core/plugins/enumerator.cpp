@@ -24,6 +24,7 @@
 #include <core/module_detect.h>
 #include <core/module_open.h>
 #include <debug/log.h>
+#include <debug/metrics.h>
 #include <module/attributes.h>
 #include <time/timer.h>
 // std includes
@@ -37,6 +38,95 @@ namespace ZXTune
   const Debug::Stream EnumeratorDbg("Core::Enumerator");
   using Module::translate;
 
+  // collects inclusive time spent in plugin's calls, so nested detection is accounted in container's plugin too
+  class MeasuredArchivePlugin : public ArchivePlugin
+  {
+  public:
+    explicit MeasuredArchivePlugin(ArchivePlugin::Ptr delegate)
+      : Delegate(std::move(delegate))
+      , DetectTime(Debug::Metrics::GetHistogram("core.detect." + Delegate->GetDescription()->Id()))
+      , OpenTime(Debug::Metrics::GetHistogram("core.open." + Delegate->GetDescription()->Id()))
+    {}
+
+    Plugin::Ptr GetDescription() const override
+    {
+      return Delegate->GetDescription();
+    }
+
+    Binary::Format::Ptr GetFormat() const override
+    {
+      return Delegate->GetFormat();
+    }
+
+    Analysis::Result::Ptr Detect(const Parameters::Accessor& params, DataLocation::Ptr inputData,
+                                 Module::DetectCallback& callback) const override
+    {
+      const Debug::Metrics::ScopedTimer timer(DetectTime);
+      return Delegate->Detect(params, std::move(inputData), callback);
+    }
+
+    DataLocation::Ptr Open(const Parameters::Accessor& params, DataLocation::Ptr inputData,
+                           const Analysis::Path& pathToOpen) const override
+    {
+      const Debug::Metrics::ScopedTimer timer(OpenTime);
+      return Delegate->Open(params, std::move(inputData), pathToOpen);
+    }
+
+  private:
+    const ArchivePlugin::Ptr Delegate;
+    Debug::Metrics::Histogram& DetectTime;
+    Debug::Metrics::Histogram& OpenTime;
+  };
+
+  class MeasuredPlayerPlugin : public PlayerPlugin
+  {
+  public:
+    explicit MeasuredPlayerPlugin(PlayerPlugin::Ptr delegate)
+      : Delegate(std::move(delegate))
+      , DetectTime(Debug::Metrics::GetHistogram("core.detect." + Delegate->GetDescription()->Id()))
+      , OpenTime(Debug::Metrics::GetHistogram("core.open." + Delegate->GetDescription()->Id()))
+    {}
+
+    Plugin::Ptr GetDescription() const override
+    {
+      return Delegate->GetDescription();
+    }
+
+    Binary::Format::Ptr GetFormat() const override
+    {
+      return Delegate->GetFormat();
+    }
+
+    Analysis::Result::Ptr Detect(const Parameters::Accessor& params, DataLocation::Ptr inputData,
+                                 Module::DetectCallback& callback) const override
+    {
+      const Debug::Metrics::ScopedTimer timer(DetectTime);
+      return Delegate->Detect(params, std::move(inputData), callback);
+    }
+
+    Module::Holder::Ptr TryOpen(const Parameters::Accessor& params, const Binary::Container& data,
+                                Parameters::Container::Ptr initialProperties) const override
+    {
+      const Debug::Metrics::ScopedTimer timer(OpenTime);
+      return Delegate->TryOpen(params, data, std::move(initialProperties));
+    }
+
+  private:
+    const PlayerPlugin::Ptr Delegate;
+    Debug::Metrics::Histogram& DetectTime;
+    Debug::Metrics::Histogram& OpenTime;
+  };
+
+  inline ArchivePlugin::Ptr CreateMeasuredPlugin(ArchivePlugin::Ptr plugin)
+  {
+    return MakePtr<MeasuredArchivePlugin>(std::move(plugin));
+  }
+
+  inline PlayerPlugin::Ptr CreateMeasuredPlugin(PlayerPlugin::Ptr plugin)
+  {
+    return MakePtr<MeasuredPlayerPlugin>(std::move(plugin));
+  }
+
   template<class PluginType>
   class PluginsContainer
     : public PluginsRegistrator<PluginType>
@@ -46,7 +136,7 @@ namespace ZXTune
     void RegisterPlugin(typename PluginType::Ptr plugin) override
     {
       const Plugin::Ptr description = plugin->GetDescription();
-      Plugins.push_back(plugin);
+      Plugins.push_back(CreateMeasuredPlugin(std::move(plugin)));
       EnumeratorDbg("Registered %1%", description->Id());
     }
 
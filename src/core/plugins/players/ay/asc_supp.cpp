@@ -23,7 +23,8 @@ namespace ZXTune
       const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder =
           Formats::Chiptune::ASCSoundMaster::Ver0::CreateDecoder();
       const Module::AYM::Factory::Ptr factory = Module::ASCSoundMaster::CreateFactory(decoder);
-      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+      const Module::MetadataFactory::Ptr metadata = Module::ASCSoundMaster::CreateMetadataFactory(decoder);
+      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
       registrator.RegisterPlugin(plugin);
     }
     {
@@ -31,7 +32,8 @@ namespace ZXTune
       const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder =
           Formats::Chiptune::ASCSoundMaster::Ver1::CreateDecoder();
       const Module::AYM::Factory::Ptr factory = Module::ASCSoundMaster::CreateFactory(decoder);
-      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+      const Module::MetadataFactory::Ptr metadata = Module::ASCSoundMaster::CreateMetadataFactory(decoder);
+      const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
       registrator.RegisterPlugin(plugin);
     }
   }
@@ -13,14 +13,20 @@
 #include "core/plugins/players/ay/aym_conversion.h"
 #include "core/plugins/players/plugin.h"
 // common includes
+#include <error.h>
 #include <make_ptr.h>
 // library includes
 #include <core/plugin_attrs.h>
+#include <l10n/api.h>
+#include <module/attributes.h>
 #include <module/players/aym/aym_base.h>
 #include <module/players/aym/aym_parameters.h>
 // std includes
+#include <mutex>
 #include <utility>
 
+#define FILE_TAG 7905BA74
+
 namespace Module
 {
   class AYMFactory : public Factory
@@ -46,22 +52,122 @@ namespace Module
   private:
     const AYM::Factory::Ptr Delegate;
   };
+
+  const L10n::TranslateFunctor translate = L10n::TranslateFunctor("core_players");
+
+  // holds metadata only, chiptune is built from retained data on first demand
+  class AYMMetadataHolder : public AYM::Holder
+  {
+  public:
+    AYMMetadataHolder(Information::Ptr info, Parameters::Accessor::Ptr properties, Binary::Container::Ptr data,
+                      AYM::Factory::Ptr factory)
+      : Info(std::move(info))
+      , Properties(std::move(properties))
+      , Data(std::move(data))
+      , Factory(std::move(factory))
+    {}
+
+    Information::Ptr GetModuleInformation() const override
+    {
+      return Info;
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Properties;
+    }
+
+    Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr params) const override
+    {
+      return GetDelegate().CreateRenderer(samplerate, std::move(params));
+    }
+
+    AYM::Chiptune::Ptr GetChiptune() const override
+    {
+      return GetDelegate().GetChiptune();
+    }
+
+    void Dump(Devices::AYM::Device& dev) const override
+    {
+      GetDelegate().Dump(dev);
+    }
+
+  private:
+    const AYM::Holder& GetDelegate() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      if (!Delegate)
+      {
+        // chiptune keeps properties, so pass the snapshot of already collected ones
+        auto properties = Parameters::Container::Create();
+        Properties->Process(*properties);
+        if (auto chiptune = Factory->CreateChiptune(*Data, std::move(properties)))
+        {
+          Delegate = AYM::CreateHolder(std::move(chiptune));
+        }
+        else
+        {
+          throw Error(THIS_LINE, translate("Failed to create module."));
+        }
+      }
+      return *Delegate;
+    }
+
+  private:
+    const Information::Ptr Info;
+    const Parameters::Accessor::Ptr Properties;
+    const Binary::Container::Ptr Data;
+    const AYM::Factory::Ptr Factory;
+    mutable std::mutex Guard;
+    mutable AYM::Holder::Ptr Delegate;
+  };
+
+  class AYMMetadataFactory : public Factory
+  {
+  public:
+    AYMMetadataFactory(MetadataFactory::Ptr metadata, AYM::Factory::Ptr delegate)
+      : Metadata(std::move(metadata))
+      , Delegate(std::move(delegate))
+    {}
+
+    Holder::Ptr CreateModule(const Parameters::Accessor& params, const Binary::Container& data,
+                             Parameters::Container::Ptr properties) const override
+    {
+      if (auto info = Metadata->ProbeModule(params, data, properties))
+      {
+        Parameters::IntType usedSize = 0;
+        properties->FindValue(ATTR_SIZE, usedSize);
+        auto usedData = data.GetSubcontainer(0, static_cast<std::size_t>(usedSize));
+        return MakePtr<AYMMetadataHolder>(std::move(info), std::move(properties), std::move(usedData), Delegate);
+      }
+      else
+      {
+        return {};
+      }
+    }
+
+  private:
+    const MetadataFactory::Ptr Metadata;
+    const AYM::Factory::Ptr Delegate;
+  };
 }  // namespace Module
 
 namespace ZXTune
 {
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder,
-                                       Module::AYM::Factory::Ptr factory)
+                                       Module::AYM::Factory::Ptr factory, Module::MetadataFactory::Ptr metadata)
   {
     const Module::Factory::Ptr modFactory = MakePtr<Module::AYMFactory>(factory);
+    const Module::Factory::Ptr metaFactory =
+        metadata ? MakePtr<Module::AYMMetadataFactory>(std::move(metadata), factory) : Module::Factory::Ptr();
     const uint_t ayCaps = Capabilities::Module::Device::AY38910 | Module::AYM::GetSupportedFormatConvertors();
-    return CreatePlayerPlugin(id, caps | ayCaps, decoder, modFactory);
+    return CreatePlayerPlugin(id, caps | ayCaps, decoder, modFactory, metaFactory);
   }
 
   PlayerPlugin::Ptr CreateTrackPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder,
-                                            Module::AYM::Factory::Ptr factory)
+                                            Module::AYM::Factory::Ptr factory, Module::MetadataFactory::Ptr metadata)
   {
-    return CreatePlayerPlugin(id, Capabilities::Module::Type::TRACK, decoder, factory);
+    return CreatePlayerPlugin(id, Capabilities::Module::Type::TRACK, decoder, factory, std::move(metadata));
   }
 
   PlayerPlugin::Ptr CreateStreamPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder,
@@ -15,13 +15,17 @@
 // library includes
 #include <formats/chiptune.h>
 #include <module/players/aym/aym_factory.h>
+#include <module/players/factory.h>
 
 namespace ZXTune
 {
+  //! @param metadata Optional factory used in metadata-only detection mode, currently provided by PT1, PT2, STC,
+  //! ST1, ST3, STP, ASC, AS0 and GTR plugins only
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder,
-                                       Module::AYM::Factory::Ptr factory);
+                                       Module::AYM::Factory::Ptr factory, Module::MetadataFactory::Ptr metadata = {});
   PlayerPlugin::Ptr CreateTrackPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder,
-                                            Module::AYM::Factory::Ptr factory);
+                                            Module::AYM::Factory::Ptr factory,
+                                            Module::MetadataFactory::Ptr metadata = {});
   PlayerPlugin::Ptr CreateStreamPlayerPlugin(const String& id, Formats::Chiptune::Decoder::Ptr decoder,
                                              Module::AYM::Factory::Ptr factory);
 }  // namespace ZXTune
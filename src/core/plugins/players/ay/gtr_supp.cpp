@@ -24,7 +24,8 @@ namespace ZXTune
 
     const Formats::Chiptune::Decoder::Ptr decoder = Formats::Chiptune::CreateGlobalTrackerDecoder();
     const Module::AYM::Factory::Ptr factory = Module::GlobalTracker::CreateFactory();
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+    const Module::MetadataFactory::Ptr metadata = Module::GlobalTracker::CreateMetadataFactory();
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
     registrator.RegisterPlugin(plugin);
   }
 }  // namespace ZXTune
@@ -24,8 +24,8 @@ namespace ZXTune
 
     const Formats::Chiptune::Decoder::Ptr decoder = Formats::Chiptune::CreateProTracker1Decoder();
     const Module::AYM::Factory::Ptr factory = Module::ProTracker1::CreateFactory();
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
-    ;
+    const Module::MetadataFactory::Ptr metadata = Module::ProTracker1::CreateMetadataFactory();
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
     registrator.RegisterPlugin(plugin);
   }
 }  // namespace ZXTune
@@ -24,8 +24,8 @@ namespace ZXTune
 
     const Formats::Chiptune::Decoder::Ptr decoder = Formats::Chiptune::CreateProTracker2Decoder();
     const Module::AYM::Factory::Ptr factory = Module::ProTracker2::CreateFactory();
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
-    ;
+    const Module::MetadataFactory::Ptr metadata = Module::ProTracker2::CreateMetadataFactory();
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
     registrator.RegisterPlugin(plugin);
   }
 }  // namespace ZXTune
@@ -25,7 +25,8 @@ namespace ZXTune
     const Formats::Chiptune::SoundTracker::Decoder::Ptr decoder =
         Formats::Chiptune::SoundTracker::Ver3::CreateDecoder();
     const Module::AYM::Factory::Ptr factory = Module::SoundTracker::CreateFactory(decoder);
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+    const Module::MetadataFactory::Ptr metadata = Module::SoundTracker::CreateMetadataFactory(decoder);
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
     registrator.RegisterPlugin(plugin);
   }
 }  // namespace ZXTune
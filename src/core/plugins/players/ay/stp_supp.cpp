@@ -25,7 +25,8 @@ namespace ZXTune
     const Formats::Chiptune::SoundTrackerPro::Decoder::Ptr decoder =
         Formats::Chiptune::SoundTrackerPro::CreateCompiledModulesDecoder();
     const Module::AYM::Factory::Ptr factory = Module::SoundTrackerPro::CreateFactory(decoder);
-    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory);
+    const Module::MetadataFactory::Ptr metadata = Module::SoundTrackerPro::CreateMetadataFactory(decoder);
+    const PlayerPlugin::Ptr plugin = CreateTrackPlayerPlugin(ID, decoder, factory, metadata);
     registrator.RegisterPlugin(plugin);
   }
 }  // namespace ZXTune
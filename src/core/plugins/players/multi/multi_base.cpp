@@ -14,11 +14,21 @@
 #include <contract.h>
 #include <make_ptr.h>
 // library includes
+#include <async/scheduler.h>
+#include <core/plugins_parameters.h>
+#include <debug/metrics.h>
 #include <parameters/merged_accessor.h>
+#include <parameters/snapshot.h>
 #include <parameters/visitor.h>
 #include <sound/loop.h>
 // std includes
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace Module
 {
@@ -135,12 +145,142 @@ namespace Module
     uint_t DoneStreams = 0;
   };
 
+  // Single portion of several streams rendered concurrently by shared scheduler's workers and caller's thread
+  class ParallelPortion : public std::enable_shared_from_this<ParallelPortion>
+  {
+  public:
+    using Ptr = std::shared_ptr<ParallelPortion>;
+
+    explicit ParallelPortion(std::size_t streams)
+      : Streams(streams)
+    {}
+
+    void Add(std::size_t idx, Renderer::Ptr source, const Sound::LoopParameters& looped)
+    {
+      auto& stream = Streams[Added++];
+      stream.Index = idx;
+      stream.Source = std::move(source);
+      stream.Looped = looped;
+    }
+
+    void Execute(Async::Scheduler& sched)
+    {
+      for (std::size_t idx = 1; idx < Added; ++idx)
+      {
+        sched.Post([self = shared_from_this(), idx]() { self->TryRender(idx); }, Async::Scheduler::Priority::HIGH);
+      }
+      // do not rely on workers availability, render everything not started yet in place
+      for (std::size_t idx = 0; idx < Added; ++idx)
+      {
+        TryRender(idx);
+      }
+      std::unique_lock<std::mutex> lock(Guard);
+      Done.wait(lock, [this]() { return Finished == Added; });
+    }
+
+    //! @return Total rendering time of all the streams
+    std::chrono::nanoseconds GetCost() const
+    {
+      return std::chrono::nanoseconds(Cost.load());
+    }
+
+    // in order of addition to keep mixing deterministic
+    template<class Callback>
+    void ForEachResult(Callback&& cb)
+    {
+      for (std::size_t idx = 0; idx < Added; ++idx)
+      {
+        auto& stream = Streams[idx];
+        if (stream.Failure)
+        {
+          std::rethrow_exception(stream.Failure);
+        }
+        cb(stream.Index, stream.Result);
+      }
+    }
+
+  private:
+    void TryRender(std::size_t idx)
+    {
+      auto& stream = Streams[idx];
+      if (stream.Taken.exchange(true))
+      {
+        return;
+      }
+      const auto start = std::chrono::steady_clock::now();
+      try
+      {
+        stream.Result = stream.Source->Render(stream.Looped);
+      }
+      catch (...)
+      {
+        stream.Failure = std::current_exception();
+      }
+      const auto cost = std::chrono::steady_clock::now() - start;
+      Cost.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(cost).count());
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        ++Finished;
+      }
+      Done.notify_one();
+    }
+
+  private:
+    struct Stream
+    {
+      std::size_t Index = 0;
+      Renderer::Ptr Source;
+      Sound::LoopParameters Looped;
+      std::atomic<bool> Taken = false;
+      Sound::Chunk Result;
+      std::exception_ptr Failure;
+    };
+    std::vector<Stream> Streams;
+    std::size_t Added = 0;
+    std::atomic<int64_t> Cost = 0;
+    std::mutex Guard;
+    std::condition_variable Done;
+    std::size_t Finished = 0;
+  };
+
+  // Sequential rendering is kept for lightweight streams since thread switching costs more than mixing itself
+  class RenderingCostEstimator
+  {
+  public:
+    explicit RenderingCostEstimator(std::chrono::nanoseconds threshold)
+      : Threshold(threshold)
+      // caller's thread renders all the streams not taken by workers, so forced mode works on single core too
+      , Enabled(threshold.count() == 0 || std::thread::hardware_concurrency() > 1)
+    {
+      Update({});
+    }
+
+    bool IsParallel() const
+    {
+      return Parallel;
+    }
+
+    void Update(std::chrono::nanoseconds cost)
+    {
+      // exponential moving average with hysteresis to avoid mode switching on each frame
+      Average += (cost - Average) / 8;
+      Parallel = Enabled && Average >= (Parallel ? Threshold / 2 : Threshold);
+    }
+
+  private:
+    const std::chrono::nanoseconds Threshold;
+    const bool Enabled;
+    std::chrono::nanoseconds Average = {};
+    bool Parallel = false;
+  };
+
   class MultiRenderer : public Renderer
   {
   public:
-    explicit MultiRenderer(RenderersArray delegates)
+    MultiRenderer(RenderersArray delegates, std::chrono::nanoseconds parallelThreshold)
       : Delegates(std::move(delegates))
       , Target(Delegates.size())
+      , Cost(parallelThreshold)
     {}
 
     State::Ptr GetState() const override
@@ -150,14 +290,13 @@ namespace Module
 
     Sound::Chunk Render(const Sound::LoopParameters& looped) override
     {
-      static const Sound::LoopParameters INFINITE_LOOP{true, 0};
-      for (std::size_t idx = 0, lim = Delegates.size(); idx != lim; ++idx)
+      if (Cost.IsParallel())
       {
-        if (Target.NeedStream(idx))
-        {
-          auto data = Delegates[idx]->Render(idx == 0 ? looped : INFINITE_LOOP);
-          Target.MixStream(idx, data);
-        }
+        RenderParallel(looped);
+      }
+      else
+      {
+        RenderSequential(looped);
       }
       return Target.Convert();
     }
@@ -188,15 +327,63 @@ namespace Module
       for (std::size_t idx = 0; idx != count; ++idx)
       {
         const auto& holder = holders[idx];
-        delegates[idx] =
-            holder->CreateRenderer(samplerate, Parameters::CreateMergedAccessor(holder->GetModuleProperties(), params));
+        auto props = Parameters::CreateMergedAccessor(holder->GetModuleProperties(), params);
+        delegates[idx] = holder->CreateRenderer(samplerate, Parameters::CreateSnapshotAccessor(std::move(props)));
+      }
+      using namespace Parameters::ZXTune::Core::Plugins::Multi;
+      Parameters::IntType threshold = PARALLEL_THRESHOLD_DEFAULT;
+      params->FindValue(PARALLEL_THRESHOLD, threshold);
+      return MakePtr<MultiRenderer>(std::move(delegates), std::chrono::microseconds(threshold));
+    }
+
+  private:
+    static const Sound::LoopParameters& GetLoopParameters(std::size_t idx, const Sound::LoopParameters& looped)
+    {
+      static const Sound::LoopParameters INFINITE_LOOP{true, 0};
+      return idx == 0 ? looped : INFINITE_LOOP;
+    }
+
+    void RenderSequential(const Sound::LoopParameters& looped)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for (std::size_t idx = 0, lim = Delegates.size(); idx != lim; ++idx)
+      {
+        if (Target.NeedStream(idx))
+        {
+          auto data = Delegates[idx]->Render(GetLoopParameters(idx, looped));
+          Target.MixStream(idx, data);
+        }
+      }
+      Cost.Update(std::chrono::steady_clock::now() - start);
+    }
+
+    void RenderParallel(const Sound::LoopParameters& looped)
+    {
+      static auto& portions = Debug::Metrics::GetCounter("core.multi.parallel");
+      const auto portion = std::make_shared<ParallelPortion>(Delegates.size());
+      for (std::size_t idx = 0, lim = Delegates.size(); idx != lim; ++idx)
+      {
+        if (Target.NeedStream(idx))
+        {
+          portion->Add(idx, Delegates[idx], GetLoopParameters(idx, looped));
+        }
+      }
+      if (!Scheduler)
+      {
+        Scheduler = Async::Scheduler::GetShared();
       }
-      return MakePtr<MultiRenderer>(std::move(delegates));
+      portion->Execute(*Scheduler);
+      portion->ForEachResult([this](std::size_t idx, const Sound::Chunk& data) { Target.MixStream(idx, data); });
+      Cost.Update(portion->GetCost());
+      portions.Add();
     }
 
   private:
     const RenderersArray Delegates;
+    // acquired on demand
+    Async::Scheduler::Ptr Scheduler;
     CumulativeChunk Target;
+    RenderingCostEstimator Cost;
   };
 
   class MultiHolder : public Holder
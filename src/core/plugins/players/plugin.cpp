@@ -16,6 +16,7 @@
 #include <make_ptr.h>
 // library includes
 #include <core/plugin_attrs.h>
+#include <core/plugins_parameters.h>
 #include <module/attributes.h>
 #include <module/players/properties_helper.h>
 // std includes
@@ -26,10 +27,12 @@ namespace ZXTune
   class CommonPlayerPlugin : public PlayerPlugin
   {
   public:
-    CommonPlayerPlugin(Plugin::Ptr descr, Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory)
+    CommonPlayerPlugin(Plugin::Ptr descr, Formats::Chiptune::Decoder::Ptr decoder, Module::Factory::Ptr factory,
+                       Module::Factory::Ptr metadata)
       : Description(std::move(descr))
       , Decoder(std::move(decoder))
       , Factory(std::move(factory))
+      , Metadata(std::move(metadata))
     {}
 
     Plugin::Ptr GetDescription() const override
@@ -51,7 +54,7 @@ namespace ZXTune
         auto properties = callback.CreateInitialProperties(inputData->GetPath()->AsString());
         Module::PropertiesHelper props(*properties);
         props.SetContainer(inputData->GetPluginsChain()->AsString());
-        if (auto holder = Factory->CreateModule(params, *data, properties))
+        if (auto holder = CreateModule(params, *data, properties))
         {
           props.SetType(Description->Id());
           callback.ProcessModule(*inputData, *Description, std::move(holder));
@@ -77,16 +80,34 @@ namespace ZXTune
       return {};
     }
 
+  private:
+    Module::Holder::Ptr CreateModule(const Parameters::Accessor& params, const Binary::Container& data,
+                                     Parameters::Container::Ptr properties) const
+    {
+      const auto& factory = Metadata && IsMetadataOnly(params) ? *Metadata : *Factory;
+      return factory.CreateModule(params, data, std::move(properties));
+    }
+
+    static bool IsMetadataOnly(const Parameters::Accessor& params)
+    {
+      using namespace Parameters::ZXTune::Core::Plugins;
+      Parameters::IntType value = METADATA_ONLY_DEFAULT;
+      params.FindValue(METADATA_ONLY, value);
+      return value != 0;
+    }
+
   private:
     const Plugin::Ptr Description;
     const Formats::Chiptune::Decoder::Ptr Decoder;
     const Module::Factory::Ptr Factory;
+    const Module::Factory::Ptr Metadata;
   };
 
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder,
-                                       Module::Factory::Ptr factory)
+                                       Module::Factory::Ptr factory, Module::Factory::Ptr metadata)
   {
     auto description = CreatePluginDescription(id, decoder->GetDescription(), caps | Capabilities::Category::MODULE);
-    return MakePtr<CommonPlayerPlugin>(std::move(description), std::move(decoder), std::move(factory));
+    return MakePtr<CommonPlayerPlugin>(std::move(description), std::move(decoder), std::move(factory),
+                                       std::move(metadata));
   }
 }  // namespace ZXTune
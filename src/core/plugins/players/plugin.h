@@ -18,6 +18,8 @@
 
 namespace ZXTune
 {
+  //! @param metadata Optional factory used in metadata-only detection mode, should create holders with the same
+  //! capabilities as the main factory does
   PlayerPlugin::Ptr CreatePlayerPlugin(const String& id, uint_t caps, Formats::Chiptune::Decoder::Ptr decoder,
-                                       Module::Factory::Ptr factory);
+                                       Module::Factory::Ptr factory, Module::Factory::Ptr metadata = {});
 }
@@ -1,14 +1,44 @@
 #!/usr/bin/python
 
+'''
+Converts HVSC Songlengths.txt/Songlengths.md5 to compact database format.
+
+Format (all the integers are little-endian):
+  header:
+    'SLDB' signature
+    u8 version
+    u8 log2 of songs count in block
+    u16 reserved
+    u32 songs count
+    u32 blocks count
+  blocks index (sorted by crc):
+    u32 crc32 of first song's md5 string in block
+    u32 block data offset from the end of index
+  blocks data, per song:
+    varint crc delta to previous song in block (0 for the first one)
+    varint subsongs count
+    varint subsong duration in milliseconds (for every subsong)
+
+Varints are LEB128-encoded (7 bits per byte, least significant first, high bit means continuation).
+
+Usage:
+  mksonglength.py < Songlengths.md5 > songlengths.db
+  mksonglength.py --include < Songlengths.md5 > songlengths_db.inc
+'''
+
 import binascii
 import math
 import re
+import struct
 import sys
 
 class SongLengths:
   LINEFORMAT = re.compile(r'([\da-f]{32})=(.*)')
-  TIMEFORMAT = re.compile(r'(\d+):(\d+)')
-  
+  TIMEFORMAT = re.compile(r'(\d+):(\d+)(?:\.(\d{1,3}))?')
+  SIGNATURE = b'SLDB'
+  VERSION = 1
+  BLOCK_SIZE_LOG = 6
+
   def __init__(self, stream):
     self._songs = []
     self._durations = []
@@ -20,9 +50,12 @@ class SongLengths:
         md5 = props.group(1)
         if md5 in md5s:
           raise Exception('Duplicated song with md5=' + md5)
+        md5s.add(md5)
         crc = binascii.crc32(md5.encode('utf-8')) & 0xffffffff
         if crc in crcs:
-          raise Exception('Collision for md5=' + md5 + ' crc=' + crc)
+          print('Skip md5=%s due to crc=%08x collision' % (md5, crc), file = sys.stderr)
+          continue
+        crcs.add(crc)
         times = [SongLengths._timeFromString(strTime) for strTime in props.group(2).split() if len(strTime) != 0]
         self._songs.append({'crc': crc, 'md5': md5, 'duration': times})
         self._durations.extend(times)
@@ -30,33 +63,65 @@ class SongLengths:
     self._durations.sort()
 
   def dumpDatabase(self, stream):
-    for song in self._songs:
-      crc = song['crc']
-      md5 = song['md5']
-      print('//' + md5, file = stream)
-      for duration in song['duration']:
-        print('{0x%08x, %d},' % (crc, duration), file = stream)
+    blockSize = 1 << SongLengths.BLOCK_SIZE_LOG
+    index = bytearray()
+    data = bytearray()
+    for blockStart in range(0, len(self._songs), blockSize):
+      block = self._songs[blockStart:blockStart + blockSize]
+      index += struct.pack('<II', block[0]['crc'], len(data))
+      prevCrc = block[0]['crc']
+      for song in block:
+        data += SongLengths._varint(song['crc'] - prevCrc)
+        data += SongLengths._varint(len(song['duration']))
+        for duration in song['duration']:
+          data += SongLengths._varint(duration)
+        prevCrc = song['crc']
+    blocksCount = len(index) // 8
+    header = SongLengths.SIGNATURE + struct.pack('<BBHII', SongLengths.VERSION, SongLengths.BLOCK_SIZE_LOG, 0,
+      len(self._songs), blocksCount)
+    stream.write(header + index + data)
 
   def dumpStatistic(self, stream):
     totalCount = len(self._durations)
     totalDuration = sum(self._durations)
-    print('Average=%d (%d/%d)' % (totalDuration / totalCount, totalDuration, totalCount), file = stream)
+    print('Average=%dms (%d/%d)' % (totalDuration / totalCount, totalDuration, totalCount), file = stream)
     for percent in (50, 60, 75, 80, 90, 95):
       pos = float(percent * totalCount) / 100
       percentile = self._durations[math.ceil(pos)]
-      print('%dth percentile=%d' % (percent, percentile), file = stream)
+      print('%dth percentile=%dms' % (percent, percentile), file = stream)
 
   @staticmethod
   def _timeFromString(timeStr):
     fmt = SongLengths.TIMEFORMAT.match(timeStr)
     if not fmt:
       raise Exception('Invalid time value: ', timeStr)
-    res = 60 * int(fmt.group(1)) + int(fmt.group(2))
-    return res if res != 0 else 1
+    ms = fmt.group(3) or '0'
+    res = 1000 * (60 * int(fmt.group(1)) + int(fmt.group(2))) + int(ms.ljust(3, '0'))
+    return res if res != 0 else 1000
+
+  @staticmethod
+  def _varint(value):
+    res = bytearray()
+    while value >= 0x80:
+      res.append((value & 0x7f) | 0x80)
+      value >>= 7
+    res.append(value)
+    return res
+
+class IncludeWriter:
+  LINE_SIZE = 32
+
+  def __init__(self, stream):
+    self._stream = stream
+
+  def write(self, data):
+    for pos in range(0, len(data), IncludeWriter.LINE_SIZE):
+      print(''.join('%d,' % b for b in data[pos:pos + IncludeWriter.LINE_SIZE]), file = self._stream)
 
 def main():
   songs = SongLengths(sys.stdin)
-  songs.dumpDatabase(sys.stdout)
+  target = IncludeWriter(sys.stdout) if '--include' in sys.argv[1:] else sys.stdout.buffer
+  songs.dumpDatabase(target)
   songs.dumpStatistic(sys.stderr)
 
 if __name__ == '__main__':
@@ -64,7 +64,7 @@ namespace Module::Sid
     void FillDuration(const Parameters::Accessor& params)
     {
       const auto* md5 = createMD5();
-      Duration = GetSongLength(md5, Index - 1);
+      Duration = GetSongLength(params, md5, Index - 1);
       if (!Duration)
       {
         Duration = GetDefaultDuration(params);
@@ -11,43 +11,252 @@
 // local includes
 #include "core/plugins/players/sid/songlengths.h"
 // common includes
+#include <byteorder.h>
 #include <contract.h>
+#include <error.h>
+#include <make_ptr.h>
 #include <pointers.h>
 // library includes
 #include <binary/crc.h>
+#include <core/plugins_parameters.h>
+#include <debug/log.h>
+#include <parameters/accessor.h>
 // std includes
 #include <algorithm>
+#include <cstring>
+#include <mutex>
+// boost includes
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 namespace Module::Sid
 {
-  struct SongEntry
+  const Debug::Stream Dbg("Core::SIDSupp::SongLengths");
+
+  const uint8_t BUILTIN_DATABASE[] = {
+#include "core/plugins/players/sid/songlengths_db.inc"
+  };
+
+  // Compact database accessor, see mksonglength.py for format description
+  class Database
   {
-    const uint32_t HashCrc32;
-    const uint32_t Seconds;
+  public:
+    using Ptr = std::shared_ptr<const Database>;
 
-    bool operator<(uint32_t hashCrc32) const
+    explicit Database(Binary::View data)
     {
-      return HashCrc32 < hashCrc32;
+      const auto* const start = data.As<uint8_t>();
+      const auto size = data.Size();
+      Require(start && size >= sizeof(RawHeader));
+      const auto& header = *data.As<RawHeader>();
+      Require(0 == std::memcmp(header.Signature, SIGNATURE, sizeof(SIGNATURE)));
+      Require(header.Version == VERSION);
+      Require(header.BlockSizeLog < 16);
+      const std::size_t blocks = header.BlocksCount;
+      const std::size_t dataOffset = sizeof(header) + blocks * sizeof(RawBlock);
+      Require(dataOffset <= size);
+      Blocks = safe_ptr_cast<const RawBlock*>(start + sizeof(header));
+      BlocksCount = blocks;
+      BlockSize = std::size_t(1) << header.BlockSizeLog;
+      DataStart = start + dataOffset;
+      DataEnd = start + size;
+      Dbg("Database with %1% songs in %2% blocks", uint32_t(header.SongsCount), blocks);
+    }
+
+    TimeType Find(uint32_t crc, uint_t idx) const
+    {
+      const auto block = FindBlock(crc);
+      if (block >= BlocksCount)
+      {
+        return {};
+      }
+      auto* cursor = DataStart + Blocks[block].Offset;
+      const auto* const limit = block + 1 < BlocksCount ? DataStart + Blocks[block + 1].Offset : DataEnd;
+      if (cursor > limit || limit > DataEnd)
+      {
+        return {};
+      }
+      uint32_t songCrc = Blocks[block].FirstCrc;
+      for (std::size_t song = 0; song < BlockSize && cursor < limit; ++song)
+      {
+        uint_t delta = 0;
+        uint_t subsongs = 0;
+        if (!ReadVarInt(cursor, limit, delta) || !ReadVarInt(cursor, limit, subsongs))
+        {
+          break;
+        }
+        songCrc += delta;
+        if (songCrc > crc)
+        {
+          break;
+        }
+        for (uint_t subsong = 0; subsong < subsongs; ++subsong)
+        {
+          uint_t duration = 0;
+          if (!ReadVarInt(cursor, limit, duration))
+          {
+            return {};
+          }
+          else if (songCrc == crc && subsong == idx)
+          {
+            return TimeType(duration);
+          }
+        }
+        if (songCrc == crc)
+        {
+          break;
+        }
+      }
+      return {};
     }
+
+  private:
+    // Keys are crc32 values, so they are distributed uniformly enough to use interpolation search
+    std::size_t FindBlock(uint32_t crc) const
+    {
+      if (!BlocksCount || crc < GetBlockCrc(0))
+      {
+        return BlocksCount;
+      }
+      std::size_t lower = 0;
+      std::size_t upper = BlocksCount - 1;
+      if (crc >= GetBlockCrc(upper))
+      {
+        return upper;
+      }
+      // GetBlockCrc(lower) <= crc < GetBlockCrc(upper)
+      while (upper - lower > 1)
+      {
+        const uint64_t lowerCrc = GetBlockCrc(lower);
+        const uint64_t range = GetBlockCrc(upper) - lowerCrc;
+        const auto guess = range ? lower + (crc - lowerCrc) * (upper - lower) / range : lower;
+        const auto mid = std::clamp<std::size_t>(guess, lower + 1, upper - 1);
+        if (GetBlockCrc(mid) <= crc)
+        {
+          lower = mid;
+        }
+        else
+        {
+          upper = mid;
+        }
+      }
+      return lower;
+    }
+
+    uint32_t GetBlockCrc(std::size_t idx) const
+    {
+      return Blocks[idx].FirstCrc;
+    }
+
+    static bool ReadVarInt(const uint8_t*& cursor, const uint8_t* limit, uint_t& result)
+    {
+      result = 0;
+      for (uint_t shift = 0; cursor < limit && shift < 32; shift += 7)
+      {
+        const auto byte = *cursor++;
+        result |= uint_t(byte & 0x7f) << shift;
+        if (0 == (byte & 0x80))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    struct RawHeader
+    {
+      uint8_t Signature[4];
+      uint8_t Version;
+      uint8_t BlockSizeLog;
+      le_uint16_t Reserved;
+      le_uint32_t SongsCount;
+      le_uint32_t BlocksCount;
+    };
+
+    struct RawBlock
+    {
+      le_uint32_t FirstCrc;
+      le_uint32_t Offset;
+    };
+
+    static_assert(sizeof(RawHeader) == 16 && alignof(RawHeader) == 1, "Invalid layout");
+    static_assert(sizeof(RawBlock) == 8 && alignof(RawBlock) == 1, "Invalid layout");
+
+    static const uint8_t SIGNATURE[4];
+    static const uint8_t VERSION = 1;
+
+    const RawBlock* Blocks = nullptr;
+    std::size_t BlocksCount = 0;
+    std::size_t BlockSize = 0;
+    const uint8_t* DataStart = nullptr;
+    const uint8_t* DataEnd = nullptr;
   };
 
-  const SongEntry SONGS[] = {
-#include "core/plugins/players/sid/songlengths_db.inc"
+  const uint8_t Database::SIGNATURE[4] = {'S', 'L', 'D', 'B'};
+
+  class MappedDatabase
+  {
+  public:
+    explicit MappedDatabase(const String& path)
+      : File(path.c_str(), boost::interprocess::read_only)
+      , Region(File, boost::interprocess::read_only)
+      , Db(Binary::View(Region.get_address(), Region.get_size()))
+    {}
+
+    const Database& Get() const
+    {
+      return Db;
+    }
+
+  private:
+    const boost::interprocess::file_mapping File;
+    const boost::interprocess::mapped_region Region;
+    const Database Db;
   };
 
-  TimeType GetSongLength(const char* md5digest, uint_t idx)
+  Database::Ptr OpenExternalDatabase(const String& path)
   {
-    const uint32_t hashCrc32 = Binary::Crc32(Binary::View(md5digest, 32));
-    const SongEntry* const end = std::end(SONGS);
-    const SongEntry* const lower = std::lower_bound(SONGS, end, hashCrc32);
-    if (lower + idx < end && lower->HashCrc32 == hashCrc32)
+    try
     {
-      const SongEntry* const entry = lower + idx;
-      if (lower->HashCrc32 == entry->HashCrc32)
-      {
-        return Time::Seconds(entry->Seconds);
-      }
+      const auto mapped = std::make_shared<MappedDatabase>(path);
+      return Database::Ptr(mapped, &mapped->Get());
     }
-    return TimeType();
+    catch (const std::exception& e)
+    {
+      Dbg("Failed to open '%1%': %2%", path, e.what());
+    }
+    catch (const Error& e)
+    {
+      Dbg("Invalid database '%1%': %2%", path, e.ToString());
+    }
+    return {};
+  }
+
+  Database::Ptr GetDatabase(const Parameters::Accessor& params)
+  {
+    static const auto builtin = MakePtr<Database>(Binary::View(BUILTIN_DATABASE, sizeof(BUILTIN_DATABASE)));
+    Parameters::StringType path;
+    if (!params.FindValue(Parameters::ZXTune::Core::Plugins::SID::SONGLENGTHS_DATABASE, path) || path.empty())
+    {
+      return builtin;
+    }
+    // mapping is cached to be shared between all the tunes
+    static std::mutex guard;
+    static String cachedPath;
+    static Database::Ptr cached;
+    const std::lock_guard<std::mutex> lock(guard);
+    if (path != cachedPath)
+    {
+      cached = OpenExternalDatabase(path);
+      cachedPath = path;
+    }
+    return cached ? cached : builtin;
+  }
+
+  TimeType GetSongLength(const Parameters::Accessor& params, const char* md5digest, uint_t idx)
+  {
+    const uint32_t hashCrc32 = Binary::Crc32(Binary::View(md5digest, 32));
+    return GetDatabase(params)->Find(hashCrc32, idx);
   }
 }  // namespace Module::Sid
@@ -11,9 +11,15 @@
 // library includes
 #include <time/duration.h>
 
+namespace Parameters
+{
+  class Accessor;
+}
+
 namespace Module::Sid
 {
   typedef Time::Milliseconds TimeType;
 
-  TimeType GetSongLength(const char* md5digest, uint_t idx);
+  //! @return subsong duration from external database specified in parameters or from built-in one, empty if not found
+  TimeType GetSongLength(const Parameters::Accessor& params, const char* md5digest, uint_t idx);
 }  // namespace Module::Sid
@@ -34,6 +34,17 @@ namespace Parameters
         const auto DEFAULT_DURATION = PREFIX + "default_duration"_id;
         //@}
 
+        //@{
+        //! @name Detect modules metadata only (properties and duration) if supported. Playable model of created
+        //! module is built on first demand (renderer creation, conversion). Supported by PT1, PT2, STC, ST1, ST3,
+        //! STP, ASC, AS0 and GTR player plugins, others ignore the option and always build full model
+
+        //! Default value
+        const IntType METADATA_ONLY_DEFAULT = 0;
+        //! Parameter name
+        const auto METADATA_ONLY = PREFIX + "metadata_only"_id;
+        //@}
+
         //! @brief RAW scaner parameters namespace
         namespace Raw
         {
@@ -84,8 +95,33 @@ namespace Parameters
           //! 4096 bytes
           const auto CHARGEN = PREFIX + "chargen"_id;
           //@}
+
+          //@{
+          //! @name Path to songlengths database in compact format (see sid/mksonglength.py)
+          //! @details Built-in database is used if not specified or failed to load
+
+          //! Parameter name
+          const auto SONGLENGTHS_DATABASE = PREFIX + "songlengths_database"_id;
+          //@}
         }  // namespace SID
 
+        //! @brief Multidevice modules player parameters namespace
+        namespace Multi
+        {
+          //! @brief Parameters#ZXTune#Core#Plugins#Multi namespace prefix
+          const auto PREFIX = Plugins::PREFIX + "multi"_id;
+
+          //@{
+          //! @name Average rendering time of all the streams portion in microseconds to render streams concurrently
+          //! @details Zero value forces concurrent rendering
+
+          //! Default value
+          const IntType PARALLEL_THRESHOLD_DEFAULT = 500;
+          //! Parameter name
+          const auto PARALLEL_THRESHOLD = PREFIX + "parallel_threshold"_id;
+          //@}
+        }  // namespace Multi
+
         //! @brief ZIP container parameters namespace
         namespace Zip
         {
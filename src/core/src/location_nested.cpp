@@ -12,6 +12,8 @@
 #include "core/src/location.h"
 // common includes
 #include <make_ptr.h>
+// library includes
+#include <debug/metrics.h>
 // std includes
 #include <utility>
 
@@ -56,6 +58,10 @@ namespace ZXTune
                                          const String& subPlugin, const String& subPath)
   {
     assert(subData);
+    const auto size = subData->Size();
+    static auto& decoded = Debug::Metrics::GetCounter("core.decoded");
+    decoded.Add(size);
+    Debug::Metrics::GetCounter("core.decoded." + subPlugin).Add(size);
     return MakePtr<NestedLocation>(parent, subPlugin, subData, subPath);
   }
 }  // namespace ZXTune
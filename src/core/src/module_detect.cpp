@@ -24,6 +24,7 @@
 #include <module/players/aym/aym_base.h>
 #include <parameters/container.h>
 #include <parameters/merged_accessor.h>
+#include <parameters/snapshot.h>
 // std includes
 #include <map>
 
@@ -175,7 +176,8 @@ namespace Module
 
     Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr params) const override
     {
-      return Delegate->CreateRenderer(samplerate, Parameters::CreateMergedAccessor(params, Properties));
+      return Delegate->CreateRenderer(
+          samplerate, Parameters::CreateSnapshotAccessor(Parameters::CreateMergedAccessor(params, Properties)));
     }
 
   private:
@@ -203,7 +205,8 @@ namespace Module
 
     Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr params) const override
     {
-      return Delegate->CreateRenderer(samplerate, Parameters::CreateMergedAccessor(params, Properties));
+      return Delegate->CreateRenderer(
+          samplerate, Parameters::CreateSnapshotAccessor(Parameters::CreateMergedAccessor(params, Properties)));
     }
 
     AYM::Chiptune::Ptr GetChiptune() const override
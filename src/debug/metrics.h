@@ -0,0 +1,162 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Performance metrics interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// common includes
+#include <types.h>
+// library includes
+#include <debug/trace.h>
+// std includes
+#include <array>
+#include <atomic>
+#include <utility>
+
+namespace Debug
+{
+  /*
+     @brief Process-wide registry of named metrics. Names are dot-separated with subsystem as first component.
+     Registered objects live till the program exit, so references may be cached. Updates are lock-free.
+     Durations are measured only if ZXTUNE_METRICS environment variable is set, timing is enabled explicitly or
+     trace is active, so disabled timers cost single flag check.
+     @code
+       static auto& processed = Debug::Metrics::GetCounter("sound.frames");
+       processed.Add();
+     @endcode
+  */
+  namespace Metrics
+  {
+    //! @brief Monotonic counter, e.g. processed bytes
+    class Counter
+    {
+    public:
+      void Add(uint64_t delta = 1)
+      {
+        Value.fetch_add(delta, std::memory_order_relaxed);
+      }
+
+      uint64_t Get() const
+      {
+        return Value.load(std::memory_order_relaxed);
+      }
+
+      void Reset()
+      {
+        Value.store(0, std::memory_order_relaxed);
+      }
+
+    private:
+      std::atomic<uint64_t> Value = 0;
+    };
+
+    //! @brief Values distribution stored in power of two buckets, e.g. durations in nanoseconds
+    class Histogram
+    {
+    public:
+      // bucket N contains values in range [2^(N-1), 2^N)
+      static const uint_t BUCKETS_COUNT = 65;
+
+      struct Snapshot
+      {
+        uint64_t Count = 0;
+        uint64_t Sum = 0;
+        uint64_t Max = 0;
+        std::array<uint64_t, BUCKETS_COUNT> Buckets = {};
+
+        uint64_t GetAverage() const
+        {
+          return Count ? Sum / Count : 0;
+        }
+
+        //! @return Upper estimation of value for specified percentile in range [0..100]
+        uint64_t GetPercentile(uint_t percent) const;
+      };
+
+      explicit Histogram(String name)
+        : Name(std::move(name))
+      {}
+
+      const String& GetName() const
+      {
+        return Name;
+      }
+
+      void Add(uint64_t value);
+
+      Snapshot GetSnapshot() const;
+
+      void Reset();
+
+    private:
+      const String Name;
+      std::atomic<uint64_t> Count = 0;
+      std::atomic<uint64_t> Sum = 0;
+      std::atomic<uint64_t> Max = 0;
+      std::array<std::atomic<uint64_t>, BUCKETS_COUNT> Buckets = {};
+    };
+
+    //! @brief Returns counter with specified name, registering it if required
+    Counter& GetCounter(const String& name);
+
+    //! @brief Returns histogram with specified name, registering it if required
+    Histogram& GetHistogram(const String& name);
+
+    class Visitor
+    {
+    public:
+      virtual ~Visitor() = default;
+
+      virtual void OnCounter(const String& name, uint64_t value) = 0;
+      virtual void OnHistogram(const String& name, const Histogram::Snapshot& value) = 0;
+    };
+
+    //! @brief Visits all the registered metrics in names order
+    void Enumerate(Visitor& visitor);
+
+    //! @brief Zeroes all the registered metrics
+    void Reset();
+
+    //! @brief Enables or disables durations measurement regardless of environment
+    void EnableTiming(bool enabled);
+
+    bool IsTimingEnabled();
+
+    //! @brief Measures scope duration in nanoseconds and reports it as a trace event if required
+    class ScopedTimer
+    {
+    public:
+      explicit ScopedTimer(Histogram& target)
+        : Target(IsTimingEnabled() ? &target : nullptr)
+        , Start(Target ? Trace::Clock::now() : Trace::Clock::time_point())
+      {}
+
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+      ~ScopedTimer()
+      {
+        if (!Target)
+        {
+          return;
+        }
+        const auto stop = Trace::Clock::now();
+        Target->Add(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - Start).count());
+        if (Trace::IsActive())
+        {
+          Trace::AddEvent(Target->GetName(), Start, stop);
+        }
+      }
+
+    private:
+      Histogram* const Target;
+      const Trace::Clock::time_point Start;
+    };
+  }  // namespace Metrics
+}  // namespace Debug
@@ -0,0 +1,226 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Performance metrics implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// library includes
+#include <debug/log.h>
+#include <debug/metrics.h>
+// std includes
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Debug
+{
+  namespace Metrics
+  {
+    // environment variable used to enable durations measurement
+    const char METRICS_VARIABLE[] = "ZXTUNE_METRICS";
+
+    std::atomic<bool>& GetTimingFlag()
+    {
+      static std::atomic<bool> enabled(::getenv(METRICS_VARIABLE) != nullptr);
+      return enabled;
+    }
+
+    uint64_t Histogram::Snapshot::GetPercentile(uint_t percent) const
+    {
+      const uint64_t limit = (Count * percent + 99) / 100;
+      uint64_t accumulated = 0;
+      for (uint_t idx = 0; idx != BUCKETS_COUNT; ++idx)
+      {
+        accumulated += Buckets[idx];
+        if (accumulated >= limit && accumulated != 0)
+        {
+          const uint64_t upper = idx < 64 ? (uint64_t(1) << idx) - 1 : ~uint64_t(0);
+          return std::min(upper, Max);
+        }
+      }
+      return Max;
+    }
+
+    void Histogram::Add(uint64_t value)
+    {
+      Buckets[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+      Count.fetch_add(1, std::memory_order_relaxed);
+      Sum.fetch_add(value, std::memory_order_relaxed);
+      auto max = Max.load(std::memory_order_relaxed);
+      while (max < value && !Max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+      {}
+    }
+
+    Histogram::Snapshot Histogram::GetSnapshot() const
+    {
+      Snapshot res;
+      res.Count = Count.load(std::memory_order_relaxed);
+      res.Sum = Sum.load(std::memory_order_relaxed);
+      res.Max = Max.load(std::memory_order_relaxed);
+      for (uint_t idx = 0; idx != BUCKETS_COUNT; ++idx)
+      {
+        res.Buckets[idx] = Buckets[idx].load(std::memory_order_relaxed);
+      }
+      return res;
+    }
+
+    void Histogram::Reset()
+    {
+      Count.store(0, std::memory_order_relaxed);
+      Sum.store(0, std::memory_order_relaxed);
+      Max.store(0, std::memory_order_relaxed);
+      for (auto& bucket : Buckets)
+      {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    class DumpVisitor : public Visitor
+    {
+    public:
+      explicit DumpVisitor(const Debug::Stream& dbg)
+        : Dbg(dbg)
+      {}
+
+      void OnCounter(const String& name, uint64_t value) override
+      {
+        Dbg("%1%: %2%", name, value);
+      }
+
+      void OnHistogram(const String& name, const Histogram::Snapshot& value) override
+      {
+        if (value.Count)
+        {
+          Dbg("%1%: count=%2% avg=%3% p50=%4% p99=%5% max=%6%", name, value.Count, value.GetAverage(),
+              value.GetPercentile(50), value.GetPercentile(99), value.Max);
+        }
+      }
+
+    private:
+      const Debug::Stream& Dbg;
+    };
+
+    class Registry
+    {
+    public:
+      Counter& GetCounter(const String& name)
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        auto& res = Counters[name];
+        if (!res)
+        {
+          res = std::make_unique<Counter>();
+        }
+        return *res;
+      }
+
+      Histogram& GetHistogram(const String& name)
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        auto& res = Histograms[name];
+        if (!res)
+        {
+          res = std::make_unique<Histogram>(name);
+        }
+        return *res;
+      }
+
+      void Enumerate(Visitor& visitor) const
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        for (const auto& counter : Counters)
+        {
+          visitor.OnCounter(counter.first, counter.second->Get());
+        }
+        for (const auto& histogram : Histograms)
+        {
+          visitor.OnHistogram(histogram.first, histogram.second->GetSnapshot());
+        }
+      }
+
+      void Reset()
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        for (const auto& counter : Counters)
+        {
+          counter.second->Reset();
+        }
+        for (const auto& histogram : Histograms)
+        {
+          histogram.second->Reset();
+        }
+      }
+
+      static Registry& Instance();
+
+    private:
+      mutable std::mutex Guard;
+      std::map<String, std::unique_ptr<Counter>> Counters;
+      std::map<String, std::unique_ptr<Histogram>> Histograms;
+    };
+
+    // dumps collected metrics at exit if logging is enabled
+    class ExitDumper
+    {
+    public:
+      explicit ExitDumper(const Registry& registry)
+        : Target(registry)
+      {}
+
+      ~ExitDumper()
+      {
+        const Debug::Stream Dbg("Debug::Metrics");
+        DumpVisitor visitor(Dbg);
+        Target.Enumerate(visitor);
+      }
+
+    private:
+      const Registry& Target;
+    };
+
+    // never destroyed to allow metrics usage from any thread at any time
+    Registry& Registry::Instance()
+    {
+      static auto* const self = new Registry();
+      static const ExitDumper dumper(*self);
+      return *self;
+    }
+
+    Counter& GetCounter(const String& name)
+    {
+      return Registry::Instance().GetCounter(name);
+    }
+
+    Histogram& GetHistogram(const String& name)
+    {
+      return Registry::Instance().GetHistogram(name);
+    }
+
+    void Enumerate(Visitor& visitor)
+    {
+      Registry::Instance().Enumerate(visitor);
+    }
+
+    void Reset()
+    {
+      Registry::Instance().Reset();
+    }
+
+    void EnableTiming(bool enabled)
+    {
+      GetTimingFlag().store(enabled, std::memory_order_relaxed);
+    }
+
+    bool IsTimingEnabled()
+    {
+      return GetTimingFlag().load(std::memory_order_relaxed) || Trace::IsActive();
+    }
+  }  // namespace Metrics
+}  // namespace Debug
@@ -0,0 +1,206 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Timeline events tracing implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// library includes
+#include <debug/trace.h>
+// std includes
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  // environment variable used to specify output file
+  const char TRACE_FILE_VARIABLE[] = "ZXTUNE_TRACE";
+
+  uint_t GetThreadId()
+  {
+    static std::atomic<uint_t> lastId = 0;
+    thread_local const uint_t id = ++lastId;
+    return id;
+  }
+
+  void WriteString(const String& str, std::ostream& out)
+  {
+    out << '\"';
+    for (const auto sym : str)
+    {
+      if (sym == '\"' || sym == '\\')
+      {
+        out << '\\';
+      }
+      out << sym;
+    }
+    out << '\"';
+  }
+
+  class Tracer
+  {
+  public:
+    Tracer()
+    {
+      if (const auto* filename = ::getenv(TRACE_FILE_VARIABLE))
+      {
+        Start(filename, Debug::Trace::DEFAULT_CAPACITY);
+      }
+    }
+
+    void Start(const String& filename, std::size_t capacity)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Filename = filename;
+      Events.clear();
+      Capacity = std::max<std::size_t>(capacity, 1);
+      Next = 0;
+      Active = true;
+    }
+
+    void Stop()
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      if (Active)
+      {
+        Active = false;
+        Write();
+        Events.clear();
+        Events.shrink_to_fit();
+      }
+    }
+
+    bool IsActive() const
+    {
+      return Active.load(std::memory_order_relaxed);
+    }
+
+    void AddEvent(const String& name, Debug::Trace::Clock::time_point start, Debug::Trace::Clock::time_point stop)
+    {
+      const auto tid = GetThreadId();
+      const std::lock_guard<std::mutex> lock(Guard);
+      if (!Active)
+      {
+        return;
+      }
+      if (Events.size() < Capacity)
+      {
+        Events.push_back({name, tid, start, stop});
+      }
+      else
+      {
+        // ring buffer, overwrite the oldest one
+        auto& evt = Events[Next];
+        evt.Name = name;
+        evt.ThreadId = tid;
+        evt.Start = start;
+        evt.Stop = stop;
+        Next = (Next + 1) % Capacity;
+      }
+    }
+
+    static Tracer& Instance();
+
+  private:
+    struct Event
+    {
+      String Name;
+      uint_t ThreadId;
+      Debug::Trace::Clock::time_point Start;
+      Debug::Trace::Clock::time_point Stop;
+    };
+
+    void Write() const
+    {
+      std::ofstream out(Filename.c_str());
+      out.setf(std::ios::fixed);
+      out.precision(3);
+      out << "{\"traceEvents\":[";
+      bool first = true;
+      // chronological order, Next points to the oldest event of the full buffer
+      for (std::size_t idx = 0, lim = Events.size(); idx != lim; ++idx)
+      {
+        const auto& evt = Events[(Next + idx) % lim];
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        WriteString(evt.Name, out);
+        out << ",\"cat\":";
+        WriteString(evt.Name.substr(0, evt.Name.find('.')), out);
+        out << ",\"ph\":\"X\",\"ts\":" << ToMicroseconds(evt.Start.time_since_epoch())
+            << ",\"dur\":" << ToMicroseconds(evt.Stop - evt.Start) << ",\"pid\":1,\"tid\":" << evt.ThreadId << '}';
+        first = false;
+      }
+      out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    static double ToMicroseconds(Debug::Trace::Clock::duration val)
+    {
+      return std::chrono::duration<double, std::micro>(val).count();
+    }
+
+  private:
+    std::atomic<bool> Active = false;
+    std::mutex Guard;
+    String Filename;
+    std::size_t Capacity = 0;
+    std::size_t Next = 0;
+    std::vector<Event> Events;
+  };
+
+  // writes collected events at exit
+  class ExitWriter
+  {
+  public:
+    explicit ExitWriter(Tracer& tracer)
+      : Target(tracer)
+    {}
+
+    ~ExitWriter()
+    {
+      Target.Stop();
+    }
+
+  private:
+    Tracer& Target;
+  };
+
+  // never destroyed to allow tracing from any thread at any time, the same as metrics registry
+  Tracer& Tracer::Instance()
+  {
+    static auto* const self = new Tracer();
+    static const ExitWriter writer(*self);
+    return *self;
+  }
+}  // namespace
+
+namespace Debug
+{
+  namespace Trace
+  {
+    void Start(const String& filename, std::size_t capacity)
+    {
+      Tracer::Instance().Start(filename, capacity);
+    }
+
+    void Stop()
+    {
+      Tracer::Instance().Stop();
+    }
+
+    bool IsActive()
+    {
+      return Tracer::Instance().IsActive();
+    }
+
+    void AddEvent(const String& name, Clock::time_point start, Clock::time_point stop)
+    {
+      Tracer::Instance().AddEvent(name, start, stop);
+    }
+  }  // namespace Trace
+}  // namespace Debug
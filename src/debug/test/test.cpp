@@ -0,0 +1,165 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Metrics and trace test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <debug/metrics.h>
+#include <debug/trace.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+
+namespace
+{
+  void Test(const std::string& msg, bool val)
+  {
+    if (val)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << std::endl;
+      throw 1;
+    }
+  }
+
+  template<class T>
+  void Test(const std::string& msg, T result, T reference)
+  {
+    if (result == reference)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << " (got: " << result << " expected: " << reference << ")" << std::endl;
+      throw 1;
+    }
+  }
+
+  class CollectVisitor : public Debug::Metrics::Visitor
+  {
+  public:
+    void OnCounter(const String& name, uint64_t value) override
+    {
+      Counters[name] = value;
+    }
+
+    void OnHistogram(const String& name, const Debug::Metrics::Histogram::Snapshot& value) override
+    {
+      Histograms[name] = value.Count;
+    }
+
+    std::map<String, uint64_t> Counters;
+    std::map<String, uint64_t> Histograms;
+  };
+
+  void TestCounter()
+  {
+    std::cout << "---- Test for counter ----" << std::endl;
+    auto& counter = Debug::Metrics::GetCounter("test.counter");
+    Test("same object", &counter == &Debug::Metrics::GetCounter("test.counter"));
+    counter.Add();
+    counter.Add(10);
+    Test<uint64_t>("value", counter.Get(), 11);
+    CollectVisitor visitor;
+    Debug::Metrics::Enumerate(visitor);
+    Test<uint64_t>("enumerated", visitor.Counters["test.counter"], 11);
+    Debug::Metrics::Reset();
+    Test<uint64_t>("reset", counter.Get(), 0);
+  }
+
+  void TestHistogram()
+  {
+    std::cout << "---- Test for histogram ----" << std::endl;
+    auto& histogram = Debug::Metrics::GetHistogram("test.histogram");
+    Test<String>("name", histogram.GetName(), "test.histogram");
+    for (const uint64_t val : {1, 2, 3, 100})
+    {
+      histogram.Add(val);
+    }
+    const auto snapshot = histogram.GetSnapshot();
+    Test<uint64_t>("count", snapshot.Count, 4);
+    Test<uint64_t>("sum", snapshot.Sum, 106);
+    Test<uint64_t>("max", snapshot.Max, 100);
+    Test<uint64_t>("average", snapshot.GetAverage(), 26);
+    Test<uint64_t>("bucket [1,2)", snapshot.Buckets[1], 1);
+    Test<uint64_t>("bucket [2,4)", snapshot.Buckets[2], 2);
+    Test<uint64_t>("bucket [64,128)", snapshot.Buckets[7], 1);
+    Test<uint64_t>("p50", snapshot.GetPercentile(50), 3);
+    Test<uint64_t>("p100", snapshot.GetPercentile(100), 100);
+    histogram.Reset();
+    Test<uint64_t>("reset", histogram.GetSnapshot().Count, 0);
+  }
+
+  void TestTimer()
+  {
+    std::cout << "---- Test for timer ----" << std::endl;
+    auto& histogram = Debug::Metrics::GetHistogram("test.timer");
+    Debug::Metrics::EnableTiming(false);
+    Test("timing disabled", !Debug::Metrics::IsTimingEnabled());
+    {
+      const Debug::Metrics::ScopedTimer timer(histogram);
+    }
+    Test<uint64_t>("disabled timer", histogram.GetSnapshot().Count, 0);
+    Debug::Metrics::EnableTiming(true);
+    {
+      const Debug::Metrics::ScopedTimer timer(histogram);
+    }
+    Test<uint64_t>("enabled timer", histogram.GetSnapshot().Count, 1);
+    Debug::Metrics::EnableTiming(false);
+  }
+
+  void TestTrace()
+  {
+    std::cout << "---- Test for trace ----" << std::endl;
+    const String filename = "debug_test_trace.json";
+    Debug::Trace::Start(filename, 3);
+    Test("trace active", Debug::Trace::IsActive());
+    Test("timing enabled by trace", Debug::Metrics::IsTimingEnabled());
+    for (const auto* name : {"test.trace.0", "test.trace.1", "test.trace.2", "test.trace.3", "test.trace.4"})
+    {
+      const Debug::Metrics::ScopedTimer timer(Debug::Metrics::GetHistogram(name));
+    }
+    Debug::Trace::Stop();
+    Test("trace stopped", !Debug::Trace::IsActive());
+    std::ifstream stream(filename.c_str());
+    const std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    stream.close();
+    std::remove(filename.c_str());
+    Test("trace written", content.find("\"traceEvents\"") != std::string::npos);
+    Test("oldest events dropped", content.find("test.trace.0") == std::string::npos
+                                      && content.find("test.trace.1") == std::string::npos);
+    const auto second = content.find("test.trace.2");
+    const auto third = content.find("test.trace.3");
+    const auto fourth = content.find("test.trace.4");
+    Test("latest events kept", second != std::string::npos && third != std::string::npos
+                                   && fourth != std::string::npos);
+    Test("chronological order", second < third && third < fourth);
+    Test("category", content.find("\"cat\":\"test\"") != std::string::npos);
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    TestCounter();
+    TestHistogram();
+    TestTimer();
+    TestTrace();
+  }
+  catch (int code)
+  {
+    return code;
+  }
+}
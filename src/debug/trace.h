@@ -0,0 +1,44 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Timeline events tracing interface
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// common includes
+#include <types.h>
+// std includes
+#include <chrono>
+
+namespace Debug
+{
+  /*
+    Events are collected in memory and written as JSON in Chrome trace event format, suitable for chrome://tracing
+    and ui.perfetto.dev. Collecting is started automatically if ZXTUNE_TRACE environment variable contains output
+    file name, collected data is written at program exit. Only the latest events are kept in a bounded buffer.
+  */
+  namespace Trace
+  {
+    using Clock = std::chrono::steady_clock;
+
+    //! @brief Default limit of kept events
+    const std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+    //! @brief Starts events collecting to specified file
+    //! @param capacity Limit of kept events, the oldest ones are overwritten
+    void Start(const String& filename, std::size_t capacity = DEFAULT_CAPACITY);
+
+    //! @brief Stops collecting and writes all the events
+    void Stop();
+
+    bool IsActive();
+
+    //! @brief Records completed event. Category is taken from name prefix delimited by '.'
+    void AddEvent(const String& name, Clock::time_point start, Clock::time_point stop);
+  }  // namespace Trace
+}  // namespace Debug
@@ -14,6 +14,7 @@
 #include "renderers.h"
 #include "volume_table.h"
 // library includes
+#include <debug/metrics.h>
 #include <parameters/tracking_helper.h>
 
 namespace Devices::AYM
@@ -50,6 +51,7 @@ namespace Devices::AYM
       const Stamp end = src.back().TimeStamp;
       if (Clock.HasSamplesBefore(end))
       {
+        const Debug::Metrics::ScopedTimer timer(GetRenderTime());
         RenderedData.reserve(RenderedData.size() + Clock.SamplesTill(end));
         for (const auto& chunk : src)
         {
@@ -76,6 +78,7 @@ namespace Devices::AYM
 
     Sound::Chunk RenderTill(Stamp stamp) override
     {
+      const Debug::Metrics::ScopedTimer timer(GetRenderTime());
       Sound::Chunk result;
       if (RenderedData.empty())
       {
@@ -91,7 +94,30 @@ namespace Devices::AYM
       return result;
     }
 
+    void RenderTill(Stamp stamp, Sound::Chunk& target) override
+    {
+      const Debug::Metrics::ScopedTimer timer(GetRenderTime());
+      if (RenderedData.empty())
+      {
+        target.clear();
+        target.reserve(Clock.SamplesTill(stamp));
+      }
+      else
+      {
+        target.swap(RenderedData);
+        RenderedData.clear();
+      }
+      Renderers.Render(stamp, &target);
+      SynchronizeParameters();
+    }
+
   private:
+    static Debug::Metrics::Histogram& GetRenderTime()
+    {
+      static auto& result = Debug::Metrics::GetHistogram("devices.aym.render");
+      return result;
+    }
+
     void SynchronizeParameters()
     {
       const uint_t AYM_CLOCK_DIVISOR = 8;
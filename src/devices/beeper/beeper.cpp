@@ -11,6 +11,7 @@
 // common includes
 #include <make_ptr.h>
 // local includes
+#include <debug/metrics.h>
 #include <devices/beeper.h>
 #include <devices/details/renderers.h>
 #include <parameters/tracking_helper.h>
@@ -92,6 +93,8 @@ namespace Devices::Beeper
 
     Sound::Chunk RenderTill(Stamp stamp) override
     {
+      static auto& renderTime = Debug::Metrics::GetHistogram("devices.beeper.render");
+      const Debug::Metrics::ScopedTimer timer(renderTime);
       Sound::Chunk result;
       if (RenderedData.empty())
       {
@@ -130,6 +130,13 @@ namespace Devices
       virtual Sound::Chunk RenderTill(Stamp stamp) = 0;
     };
 
+    enum InterpolationType
+    {
+      INTERPOLATION_NONE = 0,
+      INTERPOLATION_LQ = 1,
+      INTERPOLATION_HQ = 2
+    };
+
     class ChipParameters
     {
     public:
@@ -140,7 +147,7 @@ namespace Devices
       virtual uint_t Version() const = 0;
       virtual uint_t BaseSampleFreq() const = 0;
       virtual uint_t SoundFreq() const = 0;
-      virtual bool Interpolate() const = 0;
+      virtual InterpolationType Interpolation() const = 0;
     };
 
     /// Virtual constructors
@@ -16,9 +16,11 @@
 #include <make_ptr.h>
 #include <pointers.h>
 // library includes
+#include <debug/metrics.h>
 #include <math/numeric.h>
 #include <parameters/tracking_helper.h>
 // std includes
+#include <algorithm>
 #include <array>
 #include <cmath>
 
@@ -31,27 +33,33 @@ namespace Devices::DAC
   public:
     typedef std::shared_ptr<const FastSample> Ptr;
 
-    // use additional sample for interpolation
+    // use additional samples around for interpolation
+    static const std::size_t PADDING_BEFORE = 3;
+    static const std::size_t PADDING_AFTER = 4;
+
     explicit FastSample(std::size_t idx, Sample::Ptr in)
       : Index(static_cast<uint_t>(idx))
-      , Data(new Sound::Sample::Type[in->Size() + 1])
+      , Storage(new Sound::Sample::Type[PADDING_BEFORE + in->Size() + PADDING_AFTER])
+      , Data(Storage.get() + PADDING_BEFORE)
       , Size(in->Size())
       , Loop(std::min(Size, in->Loop()))
     {
+      std::fill_n(Storage.get(), PADDING_BEFORE, Sound::Sample::MID);
       for (std::size_t pos = 0; pos != Size; ++pos)
       {
         Data[pos] = in->Get(pos);
       }
-      Data[Size] = Data[Size - 1];
+      std::fill_n(Data + Size, PADDING_AFTER, Data[Size - 1]);
     }
 
     FastSample()
       : Index(NO_INDEX)
-      , Data(new Sound::Sample::Type[2])
+      , Storage(new Sound::Sample::Type[PADDING_BEFORE + 1 + PADDING_AFTER])
+      , Data(Storage.get() + PADDING_BEFORE)
       , Size(1)
       , Loop(1)
     {
-      Data[0] = Data[1] = 0;
+      std::fill_n(Storage.get(), PADDING_BEFORE + 1 + PADDING_AFTER, Sound::Sample::MID);
     }
 
     uint_t GetIndex() const
@@ -88,6 +96,18 @@ namespace Devices::DAC
         return Data[Pos.Integer()];
       }
 
+      //! @return current sample pointer, neighbours are available according to padding
+      const Sound::Sample::Type* GetCurrent() const
+      {
+        assert(IsValid());
+        return Data + Pos.Integer();
+      }
+
+      uint_t GetFraction() const
+      {
+        return Pos.Fraction();
+      }
+
       Sound::Sample::Type GetInterpolated(const uint_t* lookup) const
       {
         assert(IsValid());
@@ -131,7 +151,7 @@ namespace Devices::DAC
 
       void SetSample(const FastSample& sample)
       {
-        Data = sample.Data.get();
+        Data = sample.Data;
         Limit = sample.Size;
         Loop = sample.Loop;
         Pos = std::min(Pos, Limit);
@@ -155,7 +175,8 @@ namespace Devices::DAC
   private:
     friend class Iterator;
     const uint_t Index;
-    const std::unique_ptr<Sound::Sample::Type[]> Data;
+    const std::unique_ptr<Sound::Sample::Type[]> Storage;
+    Sound::Sample::Type* const Data;
     const std::size_t Size;
     const std::size_t Loop;
   };
@@ -314,14 +335,17 @@ namespace Devices::DAC
       }
     }
 
-    Sound::Sample::Type GetNearest() const
-    {
-      return Enabled ? Amplify(Iterator.GetNearest()) : Sound::Sample::MID;
-    }
-
-    Sound::Sample::Type GetInterpolated(const uint_t* lookup) const
+    //! @brief Renders continuous run of channel's output
+    template<class Interpolator>
+    void Render(const Interpolator& interpolator, Sound::Sample::Type* out, uint_t count)
     {
-      return Enabled ? Amplify(Iterator.GetInterpolated(lookup)) : Sound::Sample::MID;
+      uint_t done = 0;
+      for (; Enabled && done != count; ++done)
+      {
+        out[done] = Amplify(interpolator.Get(Iterator));
+        Next();
+      }
+      std::fill(out + done, out + count, Sound::Sample::MID);
     }
 
     void Next()
@@ -348,91 +372,145 @@ namespace Devices::DAC
     virtual Sound::Chunk RenderData(uint_t samples) = 0;
   };
 
-  template<unsigned Channels>
-  class LQRenderer : public Renderer
+  class NearestInterpolator
   {
   public:
-    LQRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
-      : Mixer(mixer)
-      , State(state)
-    {}
+    Sound::Sample::Type Get(const FastSample::Iterator& it) const
+    {
+      return it.GetNearest();
+    }
+  };
 
-    Sound::Chunk RenderData(uint_t samples) override
+  class CosineInterpolator
+  {
+  public:
+    CosineInterpolator()
     {
-      Sound::Chunk chunk;
-      chunk.reserve(samples);
-      typename Sound::MultichannelSample<Channels>::Type result;
-      for (uint_t counter = samples; counter != 0; --counter)
+      for (uint_t idx = 0; idx != FastSample::Position::PRECISION; ++idx)
       {
-        for (uint_t chan = 0; chan != Channels; ++chan)
-        {
-          ChannelState& state = State[chan];
-          result[chan] = state.GetNearest();
-          state.Next();
-        }
-        chunk.push_back(Mixer.ApplyData(result));
+        const double rad = 3.14159265358 * idx / FastSample::Position::PRECISION;
+        Table[idx] = static_cast<uint_t>(FastSample::Position::PRECISION * (1.0 - cos(rad)) / 2.0);
       }
-      return chunk;
+    }
+
+    Sound::Sample::Type Get(const FastSample::Iterator& it) const
+    {
+      return it.GetInterpolated(Table.data());
     }
 
   private:
-    const Sound::FixedChannelsMixer<Channels>& Mixer;
-    ChannelState* const State;
+    std::array<uint_t, FastSample::Position::PRECISION> Table;
   };
 
-  template<unsigned Channels>
-  class MQRenderer : public Renderer
+  // Lanczos-windowed sinc with 8 taps, coefficients are precalculated for each position fraction
+  class SincInterpolator
   {
   public:
-    MQRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
-      : Mixer(mixer)
-      , State(state)
-    {}
-
-    Sound::Chunk RenderData(uint_t samples) override
+    SincInterpolator()
     {
-      static const CosineTable COSTABLE;
-      Sound::Chunk chunk;
-      chunk.reserve(samples);
-      typename Sound::MultichannelSample<Channels>::Type result;
-      for (uint_t counter = samples; counter != 0; --counter)
+      for (uint_t fract = 0; fract != FastSample::Position::PRECISION; ++fract)
       {
-        for (uint_t chan = 0; chan != Channels; ++chan)
+        std::array<double, TAPS> weights;
+        double sum = 0;
+        for (uint_t tap = 0; tap != TAPS; ++tap)
         {
-          ChannelState& state = State[chan];
-          result[chan] = state.GetInterpolated(COSTABLE.Get());
-          state.Next();
+          const double x = int_t(tap) - int_t(TAPS_BEFORE) - double(fract) / FastSample::Position::PRECISION;
+          weights[tap] = Lanczos(x);
+          sum += weights[tap];
         }
-        chunk.push_back(Mixer.ApplyData(result));
+        auto& coeffs = Table[fract];
+        int_t total = 0;
+        for (uint_t tap = 0; tap != TAPS; ++tap)
+        {
+          coeffs[tap] = static_cast<int_t>(std::lround(weights[tap] * ONE / sum));
+          total += coeffs[tap];
+        }
+        // compensate rounding error to keep unity gain
+        coeffs[TAPS_BEFORE] += ONE - total;
       }
-      return chunk;
+    }
+
+    Sound::Sample::Type Get(const FastSample::Iterator& it) const
+    {
+      const Sound::Sample::Type* const data = it.GetCurrent() - TAPS_BEFORE;
+      const auto& coeffs = Table[it.GetFraction()];
+      int_t sum = 0;
+      for (uint_t tap = 0; tap != TAPS; ++tap)
+      {
+        sum += coeffs[tap] * data[tap];
+      }
+      return static_cast<Sound::Sample::Type>(
+          Math::Clamp<int_t>(sum / ONE, Sound::Sample::MIN, Sound::Sample::MAX));
     }
 
   private:
-    class CosineTable
+    static double Lanczos(double x)
     {
-    public:
-      CosineTable()
+      const double PI = 3.14159265358;
+      if (x == 0)
       {
-        for (uint_t idx = 0; idx != FastSample::Position::PRECISION; ++idx)
-        {
-          const double rad = 3.14159265358 * idx / FastSample::Position::PRECISION;
-          Table[idx] = static_cast<uint_t>(FastSample::Position::PRECISION * (1.0 - cos(rad)) / 2.0);
-        }
+        return 1;
+      }
+      else if (std::abs(x) >= TAPS / 2)
+      {
+        return 0;
       }
+      const double arg = PI * x;
+      return (TAPS / 2) * std::sin(arg) * std::sin(arg / (TAPS / 2)) / (arg * arg);
+    }
 
-      const uint_t* Get() const
+  private:
+    static const uint_t TAPS = 8;
+    static const uint_t TAPS_BEFORE = 3;
+    static const int_t ONE = 1 << 14;
+    static_assert(TAPS_BEFORE <= FastSample::PADDING_BEFORE && TAPS - TAPS_BEFORE - 1 <= FastSample::PADDING_AFTER,
+                  "Not enough padding");
+
+    std::array<std::array<int_t, TAPS>, FastSample::Position::PRECISION> Table;
+  };
+
+  /*
+    Renders each channel's run for the whole block into separate buffer and then mixes them all at once,
+    so per-sample virtual calls and channels switching are avoided and loops are simple enough for vectorization.
+  */
+  template<unsigned Channels, class Interpolator>
+  class ChannelMajorRenderer : public Renderer
+  {
+  public:
+    ChannelMajorRenderer(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
+      : Mixer(mixer)
+      , State(state)
+    {
+      for (uint_t chan = 0; chan != Channels; ++chan)
       {
-        return Table.data();
+        Inputs[chan] = Buffers[chan].data();
       }
+    }
 
-    private:
-      std::array<uint_t, FastSample::Position::PRECISION> Table;
-    };
+    Sound::Chunk RenderData(uint_t samples) override
+    {
+      static const Interpolator INTERPOLATOR;
+      Sound::Chunk chunk(samples);
+      for (uint_t done = 0; done != samples;)
+      {
+        const uint_t todo = std::min<uint_t>(samples - done, BLOCK_SIZE);
+        for (uint_t chan = 0; chan != Channels; ++chan)
+        {
+          State[chan].Render(INTERPOLATOR, Buffers[chan].data(), todo);
+        }
+        Mixer.ApplyData(Inputs, todo, chunk.data() + done);
+        done += todo;
+      }
+      return chunk;
+    }
 
   private:
+    static const uint_t BLOCK_SIZE = 1024;
+
     const Sound::FixedChannelsMixer<Channels>& Mixer;
     ChannelState* const State;
+    alignas(32) std::array<std::array<Sound::Sample::Type, BLOCK_SIZE>, Channels> Buffers;
+    typename Sound::FixedChannelsMixer<Channels>::InBlockType Inputs;
   };
 
   template<unsigned Channels>
@@ -442,6 +520,7 @@ namespace Devices::DAC
     RenderersSet(const Sound::FixedChannelsMixer<Channels>& mixer, ChannelState* state)
       : LQ(mixer, state)
       , MQ(mixer, state)
+      , HQ(mixer, state)
       , Current()
       , State(state)
     {}
@@ -451,14 +530,17 @@ namespace Devices::DAC
       Current = nullptr;
     }
 
-    void SetInterpolation(bool type)
+    void SetInterpolation(InterpolationType type)
     {
-      if (type)
+      switch (type)
       {
+      case INTERPOLATION_LQ:
         Current = &MQ;
-      }
-      else
-      {
+        break;
+      case INTERPOLATION_HQ:
+        Current = &HQ;
+        break;
+      default:
         Current = &LQ;
       }
     }
@@ -480,8 +562,9 @@ namespace Devices::DAC
     }
 
   private:
-    LQRenderer<Channels> LQ;
-    MQRenderer<Channels> MQ;
+    ChannelMajorRenderer<Channels, NearestInterpolator> LQ;
+    ChannelMajorRenderer<Channels, CosineInterpolator> MQ;
+    ChannelMajorRenderer<Channels, SincInterpolator> HQ;
     Renderer* Current;
     ChannelState* const State;
   };
@@ -523,6 +606,8 @@ namespace Devices::DAC
 
     Sound::Chunk RenderTill(Stamp stamp) override
     {
+      static auto& renderTime = Debug::Metrics::GetHistogram("devices.dac.render");
+      const Debug::Metrics::ScopedTimer timer(renderTime);
       const uint_t samples = Clock.Advance(stamp);
       Require(samples);
       auto result = Renderers.RenderData(samples);
@@ -546,7 +631,7 @@ namespace Devices::DAC
       if (Params.IsChanged())
       {
         Clock.SetFreq(Params->BaseSampleFreq(), Params->SoundFreq());
-        Renderers.SetInterpolation(Params->Interpolate());
+        Renderers.SetInterpolation(Params->Interpolation());
       }
     }
 
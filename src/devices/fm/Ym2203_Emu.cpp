@@ -1222,10 +1222,59 @@ typedef struct
 	FM_CH CH[3];			/* channel state     */
 } YM2203;
 
-/* Generate samples for one of the YM2203s */
-void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
+/* refresh PG and EG of all the channels */
+static void refresh_chip(YM2203 *F2203)
+{
+	FM_OPN *OPN = &F2203->OPN;
+	FM_CH *cch = F2203->CH;
+
+	refresh_fc_eg_chan( &cch[0] );
+	refresh_fc_eg_chan( &cch[1] );
+	if( (OPN->ST.mode & 0xc0) )
+	{
+		/* 3SLOT MODE */
+		if( cch[2].SLOT[SLOT1].Incr==-1)
+		{
+			refresh_fc_eg_slot(&cch[2].SLOT[SLOT1] , OPN->SL3.fc[1] , OPN->SL3.kcode[1] );
+			refresh_fc_eg_slot(&cch[2].SLOT[SLOT2] , OPN->SL3.fc[2] , OPN->SL3.kcode[2] );
+			refresh_fc_eg_slot(&cch[2].SLOT[SLOT3] , OPN->SL3.fc[0] , OPN->SL3.kcode[0] );
+			refresh_fc_eg_slot(&cch[2].SLOT[SLOT4] , cch[2].fc , cch[2].kcode );
+		}
+	}else refresh_fc_eg_chan( &cch[2] );
+}
+
+/* channel without audible operators and feedback history does not produce any output */
+inline bool chan_is_quiet(const FM_CH *CH)
+{
+	return CH->SLOT[SLOT1].vol_out >= ENV_QUIET && CH->SLOT[SLOT2].vol_out >= ENV_QUIET
+	    && CH->SLOT[SLOT3].vol_out >= ENV_QUIET && CH->SLOT[SLOT4].vol_out >= ENV_QUIET
+	    && !(CH->op1_out[0] | CH->op1_out[1]);
+}
+
+/* same as chan_calc for quiet channel */
+inline void chan_skip(FM_STATE* state, FM_CH *CH)
+{
+	/* unused MEM keeps its value */
+	if (CH->mem_connect != &state->mem)
+		CH->mem_value = 0;
+
+	CH->SLOT[SLOT1].phase += CH->SLOT[SLOT1].Incr;
+	CH->SLOT[SLOT2].phase += CH->SLOT[SLOT2].Incr;
+	CH->SLOT[SLOT3].phase += CH->SLOT[SLOT3].Incr;
+	CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
+}
+
+inline void chan_update(FM_STATE* state, FM_CH *CH)
+{
+	if (chan_is_quiet(CH))
+		chan_skip(state, CH);
+	else
+		chan_calc(state, CH);
+}
+
+/* Render chip output, store it to buffer or mix with the buffer content */
+static void render_chip(YM2203 *F2203, int32_t *buffer, int length, bool mix)
 {
-	YM2203 *F2203 = (YM2203*)chip;
 	FM_OPN *OPN =   &F2203->OPN;
 	FM_STATE *state = &F2203->State;
 	FM_CH	*cch[3];
@@ -1234,20 +1283,7 @@ void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
 	cch[1]   = &F2203->CH[1];
 	cch[2]   = &F2203->CH[2];
 
-	/* refresh PG and EG */
-	refresh_fc_eg_chan( cch[0] );
-	refresh_fc_eg_chan( cch[1] );
-	if( (F2203->OPN.ST.mode & 0xc0) )
-	{
-		/* 3SLOT MODE */
-		if( cch[2]->SLOT[SLOT1].Incr==-1)
-		{
-			refresh_fc_eg_slot(&cch[2]->SLOT[SLOT1] , OPN->SL3.fc[1] , OPN->SL3.kcode[1] );
-			refresh_fc_eg_slot(&cch[2]->SLOT[SLOT2] , OPN->SL3.fc[2] , OPN->SL3.kcode[2] );
-			refresh_fc_eg_slot(&cch[2]->SLOT[SLOT3] , OPN->SL3.fc[0] , OPN->SL3.kcode[0] );
-			refresh_fc_eg_slot(&cch[2]->SLOT[SLOT4] , cch[2]->fc , cch[2]->kcode );
-		}
-	}else refresh_fc_eg_chan( cch[2] );
+	refresh_chip(F2203);
 
 	/* buffering */
 	for (int32_t* buf = buffer, *lim = buffer + length; buf != lim; ++buf)
@@ -1267,14 +1303,27 @@ void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
 		}
 
 		/* calculate FM */
-		chan_calc(state, cch[0] );
-		chan_calc(state, cch[1] );
-		chan_calc(state, cch[2] );
+		chan_update(state, cch[0] );
+		chan_update(state, cch[1] );
+		chan_update(state, cch[2] );
 
-		*buf += state->out_fm[0] + state->out_fm[1] + state->out_fm[2];
+		const int32_t out = state->out_fm[0] + state->out_fm[1] + state->out_fm[2];
+		*buf = mix ? *buf + out : out;
 	}
 }
 
+/* Generate samples for one of the YM2203s */
+void YM2203UpdateOne(void *chip, int32_t *buffer, int length)
+{
+	render_chip((YM2203*)chip, buffer, length, true);
+}
+
+void YM2203UpdateMany(void* const* chips, int count, int32_t *buffer, int length)
+{
+	for (int chip = 0; chip < count; ++chip)
+		render_chip((YM2203*)chips[chip], buffer, length, chip != 0);
+}
+
 /* ---------- reset one of chip ---------- */
 void YM2203ResetChip(void *chip)
 {
@@ -29,6 +29,11 @@ void YM2203ResetChip(void *chip);
 */
 void YM2203UpdateOne(void *chip, int32_t *buffer, int length);
 
+/*
+** render sum of several chips output
+*/
+void YM2203UpdateMany(void* const* chips, int count, int32_t *buffer, int length);
+
 void YM2203WriteRegs(void *chip, int reg, unsigned char val);
 
 void YM2203GetState(void *chip, uint_t *attenuations, uint_t *periods);
@@ -15,6 +15,7 @@
 // common includes
 #include <contract.h>
 // library includes
+#include <debug/metrics.h>
 #include <devices/fm.h>
 #include <math/fixedpoint.h>
 #include <math/numeric.h>
@@ -88,9 +89,12 @@ namespace Devices::FM
         return ChipPtr(::YM2203Init(LastClockrate, LastSoundFreq), &::YM2203Shutdown);
       }
 
+      //! @param Chips count of chips mixed in input samples
+      template<uint_t Chips = 1>
       static void ConvertSamples(const YM2203SampleType* inBegin, const YM2203SampleType* inEnd, Sound::Sample* out)
       {
-        std::transform(inBegin, inEnd, out, &ConvertToSample);
+        std::transform(inBegin, inEnd, out,
+                       [](YM2203SampleType level) { return ConvertToSample(level / YM2203SampleType(Chips)); });
       }
 
     private:
@@ -132,6 +136,8 @@ namespace Devices::FM
 
       Sound::Chunk RenderTill(typename ChipTraits::StampType stamp) override
       {
+        static auto& renderTime = Debug::Metrics::GetHistogram("devices.fm.render");
+        const Debug::Metrics::ScopedTimer timer(renderTime);
         const auto samples = Clock.AdvanceTo(stamp);
         Require(samples);
         auto result = Adapter.RenderSamples(samples);
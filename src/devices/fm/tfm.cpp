@@ -52,10 +52,9 @@ namespace Devices::TFM
     {
       Sound::Chunk result(count);
       auto* const outRaw = safe_ptr_cast<FM::Details::YM2203SampleType*>(result.data());
-      ::YM2203UpdateOne(Chips[0].get(), outRaw, count);
-      ::YM2203UpdateOne(Chips[1].get(), outRaw, count);
-      std::transform(outRaw, outRaw + count, outRaw, [](FM::Details::YM2203SampleType s) { return s / 2; });
-      Helper.ConvertSamples(outRaw, outRaw + count, result.data());
+      void* const chips[TFM::CHIPS] = {Chips[0].get(), Chips[1].get()};
+      ::YM2203UpdateMany(chips, TFM::CHIPS, outRaw, count);
+      Helper.ConvertSamples<TFM::CHIPS>(outRaw, outRaw + count, result.data());
       return result;
     }
 
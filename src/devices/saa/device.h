@@ -12,6 +12,8 @@
 
 // local includes
 #include "generators.h"
+// std includes
+#include <algorithm>
 
 namespace Devices
 {
@@ -116,6 +118,14 @@ namespace Devices
         return out;
       }
 
+      //! @return ticks count while GetLevels result is not changed
+      uint_t GetTicksToChange() const
+      {
+        const uint_t tones = std::min({Tones[0].GetTicksToChange(), Tones[1].GetTicksToChange(),
+                                       Tones[2].GetTicksToChange()});
+        return std::min({tones, Noise.GetTicksToChange(), Envelope.GetTicksToChange()});
+      }
+
     private:
       void UpdateLinkedGenerators(uint_t generator)
       {
@@ -221,6 +231,11 @@ namespace Devices
         return out.Convert();
       }
 
+      uint_t GetTicksToChange() const
+      {
+        return std::min(Subdevices[0].GetTicksToChange(), Subdevices[1].GetTicksToChange());
+      }
+
     private:
       SAASubDevice Subdevices[2];
     };
@@ -18,6 +18,7 @@
 #include <types.h>
 // std includes
 #include <array>
+#include <limits>
 
 namespace Devices
 {
@@ -26,6 +27,8 @@ namespace Devices
     const uint_t LOW_LEVEL = 0;
     const uint_t HIGH_LEVEL = 15;
     const uint_t MAX_VALUE = HIGH_LEVEL + 1;
+    // ticks count for generators which output is not changed until registers update
+    const uint_t INFINITE_TICKS = std::numeric_limits<uint_t>::max();
 
     class FastSample
     {
@@ -132,6 +135,17 @@ namespace Devices
         return Masked;
       }
 
+      //! @return ticks count till the next level change
+      uint_t GetTicksToChange() const
+      {
+        if (Masked)
+        {
+          return INFINITE_TICKS;
+        }
+        WrapCounter();
+        return Counter < HalfPeriod ? HalfPeriod - Counter : FullPeriod - Counter;
+      }
+
     private:
       void UpdatePeriod()
       {
@@ -304,6 +318,20 @@ namespace Devices
         return Mixer;
       }
 
+      //! @return ticks count till the next shift of used generator
+      uint_t GetTicksToChange() const
+      {
+        if (Mixer)
+        {
+          Update();
+          return Period - Counter;
+        }
+        else
+        {
+          return INFINITE_TICKS;
+        }
+      }
+
       uint_t GetPeriod() const
       {
         return Period;
@@ -408,6 +436,21 @@ namespace Devices
         }
       }
 
+      //! @return ticks count till the next level step
+      uint_t GetTicksToChange() const
+      {
+        if (Enabled && Decay)
+        {
+          Update();
+          // envelope may be stopped at the last step
+          return Decay ? Period - Counter : INFINITE_TICKS;
+        }
+        else
+        {
+          return INFINITE_TICKS;
+        }
+      }
+
       uint_t GetRepetitionPeriod() const
       {
         if (Enabled)
@@ -16,10 +16,12 @@
 #include <contract.h>
 #include <make_ptr.h>
 // library includes
+#include <debug/metrics.h>
 #include <devices/details/renderers.h>
 #include <parameters/tracking_helper.h>
 #include <sound/lpfilter.h>
 // std includes
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <functional>
@@ -33,16 +35,22 @@ namespace Devices::SAA
   static_assert(Registers::TOTAL <= 8 * sizeof(uint_t), "Too many registers for mask");
   static_assert(sizeof(Registers) == 32, "Invalid layout");
 
+  /*
+    Output is constant till the next generator's change, so levels are evaluated once per such a span and reused by all
+    the renderers sampling within it.
+  */
   class SAARenderer
   {
   public:
     void Reset()
     {
       Device.Reset();
+      Stable = 0;
     }
 
     void SetNewData(const Registers& data)
     {
+      Stable = 0;
       for (uint_t idx = 0, mask = 1; idx != data.Data.size(); ++idx, mask <<= 1)
       {
         if (0 == (data.Mask & mask))
@@ -101,15 +109,36 @@ namespace Devices::SAA
     void Tick(uint_t ticks)
     {
       Device.Tick(ticks);
+      Stable = Stable > ticks ? Stable - ticks : 0;
     }
 
     Sound::Sample GetLevels() const
     {
-      return Device.GetLevels();
+      UpdateLevels();
+      return Levels;
+    }
+
+    //! @return ticks count while GetLevels result is not changed
+    uint_t GetTicksToChange() const
+    {
+      UpdateLevels();
+      return Stable;
+    }
+
+  private:
+    void UpdateLevels() const
+    {
+      if (!Stable)
+      {
+        Levels = Device.GetLevels();
+        Stable = Device.GetTicksToChange();
+      }
     }
 
   private:
     SAADevice Device;
+    mutable Sound::Sample Levels;
+    mutable uint_t Stable = 0;
   };
 
   typedef Details::ClockSource<Stamp> ClockSource;
@@ -137,9 +166,16 @@ namespace Devices::SAA
     {
       while (ticksPassed >= FREQ_DIVIDER)
       {
-        Filter.Feed(Delegate.GetLevels());
-        Delegate.Tick(FREQ_DIVIDER);
-        ticksPassed -= FREQ_DIVIDER;
+        // output is constant till the next generator's change, so feed the whole span at once
+        const auto level = Delegate.GetLevels();
+        const uint_t stable = Delegate.GetTicksToChange();
+        const uint_t steps = std::min(ticksPassed / FREQ_DIVIDER, 1 + (stable - 1) / FREQ_DIVIDER);
+        for (uint_t step = 0; step != steps; ++step)
+        {
+          Filter.Feed(level);
+        }
+        Delegate.Tick(steps * FREQ_DIVIDER);
+        ticksPassed -= steps * FREQ_DIVIDER;
       }
       if (ticksPassed)
       {
@@ -263,6 +299,8 @@ namespace Devices::SAA
 
     Sound::Chunk RenderTill(Stamp stamp) override
     {
+      static auto& renderTime = Debug::Metrics::GetHistogram("devices.saa.render");
+      const Debug::Metrics::ScopedTimer timer(renderTime);
       const uint_t samples = Clock.SamplesTill(stamp);
       Require(samples);
       auto result = Renderers.Render(stamp, samples);
@@ -53,6 +53,8 @@ namespace Devices
       using Ptr = std::shared_ptr<Chip>;
 
       virtual Sound::Chunk RenderTill(Stamp till) = 0;
+      //! @brief Same as above, but replaces content of target reusing its memory
+      virtual void RenderTill(Stamp till, Sound::Chunk& target) = 0;
     };
 
     using AYM::ChipParameters;
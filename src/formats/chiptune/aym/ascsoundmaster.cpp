@@ -340,43 +340,6 @@ namespace Formats::Chiptune
                                             ""_sv,
                                             &HeaderTraits::Create<RawHeaderVer1>};
 
-    class StubBuilder : public Builder
-    {
-    public:
-      MetaBuilder& GetMetaBuilder() override
-      {
-        return GetStubMetaBuilder();
-      }
-
-      void SetInitialTempo(uint_t /*tempo*/) override {}
-      void SetSample(uint_t /*index*/, Sample /*sample*/) override {}
-      void SetOrnament(uint_t /*index*/, Ornament /*ornament*/) override {}
-      void SetPositions(Positions /*positions*/) override {}
-
-      PatternBuilder& StartPattern(uint_t /*index*/) override
-      {
-        return GetStubPatternBuilder();
-      }
-
-      void StartChannel(uint_t /*index*/) override {}
-      void SetRest() override {}
-      void SetNote(uint_t /*note*/) override {}
-      void SetSample(uint_t /*sample*/) override {}
-      void SetOrnament(uint_t /*ornament*/) override {}
-      void SetVolume(uint_t /*vol*/) override {}
-      void SetEnvelopeType(uint_t /*type*/) override {}
-      void SetEnvelopeTone(uint_t /*tone*/) override {}
-      void SetEnvelope() override {}
-      void SetNoEnvelope() override {}
-      void SetNoise(uint_t /*val*/) override {}
-      void SetContinueSample() override {}
-      void SetContinueOrnament() override {}
-      void SetGlissade(int_t /*val*/) override {}
-      void SetSlide(int_t /*steps*/, bool /*useToneSliding*/) override {}
-      void SetVolumeSlide(uint_t /*period*/, int_t /*delta*/) override {}
-      void SetBreakSample() override {}
-    };
-
     Builder& GetStubBuilder()
     {
       static StubBuilder stub;
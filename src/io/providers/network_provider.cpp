@@ -10,6 +10,7 @@
 
 // local includes
 #include "io/providers/network_provider.h"
+#include "io/impl/boost_filesystem_path.h"
 #include "io/impl/l10n.h"
 #include "io/providers/enumerator.h"
 #include "io/providers/gates/curl_api.h"
@@ -17,14 +18,29 @@
 #include <contract.h>
 #include <error_tools.h>
 #include <make_ptr.h>
+#include <pointers.h>
 #include <progress_callback.h>
 // library includes
 #include <binary/container_factories.h>
+#include <binary/crc.h>
 #include <debug/log.h>
 #include <io/providers_parameters.h>
 #include <parameters/accessor.h>
+#include <strings/format.h>
 // std includes
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+// boost includes
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
 
 #define FILE_TAG 18F46494
 
@@ -46,7 +62,29 @@ namespace IO::Network
       return res;
     }
 
+    String GetCacheDirectory() const
+    {
+      String res;
+      Accessor.FindValue(Parameters::ZXTune::IO::Providers::Network::Cache::DIRECTORY, res);
+      return res;
+    }
+
+    std::size_t GetCacheBlockSize() const
+    {
+      Parameters::IntType val = Parameters::ZXTune::IO::Providers::Network::Cache::BLOCK_SIZE_DEFAULT;
+      Accessor.FindValue(Parameters::ZXTune::IO::Providers::Network::Cache::BLOCK_SIZE, val);
+      return std::max<std::size_t>(MIN_BLOCK_SIZE, static_cast<std::size_t>(val));
+    }
+
+    std::size_t GetReadahead() const
+    {
+      Parameters::IntType val = Parameters::ZXTune::IO::Providers::Network::Cache::READAHEAD_DEFAULT;
+      Accessor.FindValue(Parameters::ZXTune::IO::Providers::Network::Cache::READAHEAD, val);
+      return static_cast<std::size_t>(std::max<Parameters::IntType>(val, 0));
+    }
+
   private:
+    static const std::size_t MIN_BLOCK_SIZE = 4096;
     const Parameters::Accessor& Accessor;
   };
 
@@ -107,6 +145,20 @@ namespace IO::Network
     return 2 != (code / 100);
   }
 
+  struct ResourceProperties
+  {
+    uint64_t Size = 0;
+    bool AcceptRanges = false;
+    String ETag;
+    String LastModified;
+
+    //! @return value identifying resource's content version, empty if not available
+    String GetValidator() const
+    {
+      return !ETag.empty() ? ETag : LastModified;
+    }
+  };
+
   class RemoteResource
   {
   public:
@@ -116,6 +168,8 @@ namespace IO::Network
       Object.SetOption(CURLOPT_DEBUGFUNCTION, reinterpret_cast<void*>(&DebugCallback), THIS_LINE);
       Object.SetOption(CURLOPT_VERBOSE, 1, THIS_LINE);
       Object.SetOption(CURLOPT_WRITEFUNCTION, reinterpret_cast<void*>(&WriteCallback), THIS_LINE);
+      Object.SetOption(CURLOPT_HEADERFUNCTION, reinterpret_cast<void*>(&HeaderCallback), THIS_LINE);
+      Object.SetOption<void*>(CURLOPT_HEADERDATA, &Properties, THIS_LINE);
     }
 
     void SetSource(const String& url)
@@ -147,16 +201,61 @@ namespace IO::Network
       result->reserve(INITIAL_SIZE);
       Object.SetOption<void*>(CURLOPT_WRITEDATA, result.get(), THIS_LINE);
       Object.Perform(THIS_LINE);
+      CheckResponseCode();
+      return Binary::CreateContainer(std::move(result));
+    }
+
+    //! @brief Request headers only
+    //! @return empty properties if not available
+    ResourceProperties Query()
+    {
+      ResourceProperties result;
+      Object.SetOption(CURLOPT_NOBODY, 1, THIS_LINE);
+      try
+      {
+        Object.Perform(THIS_LINE);
+        CheckResponseCode();
+        result = Properties;
+      }
+      catch (const Error& e)
+      {
+        Dbg("Failed to query properties: %1%", e.ToString());
+      }
+      Object.SetOption(CURLOPT_HTTPGET, 1, THIS_LINE);
+      return result;
+    }
+
+    //! @brief Download exactly size bytes starting from offset using Range request
+    Binary::Dump DownloadRange(uint64_t offset, std::size_t size)
+    {
+      Binary::Dump result;
+      result.reserve(size);
+      const auto range = Strings::Format("%1%-%2%", offset, offset + size - 1);
+      Object.SetOption(CURLOPT_RANGE, range.c_str(), THIS_LINE);
+      Object.SetOption<void*>(CURLOPT_WRITEDATA, &result, THIS_LINE);
+      Object.Perform(THIS_LINE);
+      Object.SetOption(CURLOPT_RANGE, static_cast<const char*>(nullptr), THIS_LINE);
+      CheckResponseCode();
+      // servers ignoring Range header respond with whole content
+      if (result.size() != size)
+      {
+        throw MakeFormattedError(THIS_LINE, translate("Invalid ranged response size %1% (expected %2%)."),
+                                 result.size(), size);
+      }
+      return result;
+    }
+
+  private:
+    void CheckResponseCode()
+    {
       long retCode = 0;
       Object.GetInfo(CURLINFO_RESPONSE_CODE, &retCode, THIS_LINE);
       if (IsHttpErrorCode(retCode))
       {
         throw MakeFormattedError(THIS_LINE, translate("Http error happends: %1%."), retCode);
       }
-      return Binary::CreateContainer(std::move(result));
     }
 
-  private:
     static int DebugCallback(CURL* obj, curl_infotype type, char* data, size_t size, void* /*param*/)
     {
       static const char SPACES[] = "\n\r\t ";
@@ -193,6 +292,42 @@ namespace IO::Network
       return toSave;
     }
 
+    static size_t HeaderCallback(const char* ptr, size_t size, size_t nitems, ResourceProperties* props)
+    {
+      const std::size_t total = size * nitems;
+      const String line(ptr, ptr + total);
+      if (boost::algorithm::starts_with(line, "HTTP/"))
+      {
+        // new response (e.g. after redirection)
+        *props = ResourceProperties();
+        return total;
+      }
+      const auto delim = line.find(':');
+      if (delim == String::npos)
+      {
+        return total;
+      }
+      const auto name = boost::algorithm::trim_copy(line.substr(0, delim));
+      const auto value = boost::algorithm::trim_copy(line.substr(delim + 1));
+      if (boost::algorithm::iequals(name, "Content-Length"))
+      {
+        props->Size = std::strtoull(value.c_str(), nullptr, 10);
+      }
+      else if (boost::algorithm::iequals(name, "Accept-Ranges"))
+      {
+        props->AcceptRanges = boost::algorithm::iequals(value, "bytes");
+      }
+      else if (boost::algorithm::iequals(name, "ETag"))
+      {
+        props->ETag = value;
+      }
+      else if (boost::algorithm::iequals(name, "Last-Modified"))
+      {
+        props->LastModified = value;
+      }
+      return total;
+    }
+
     static int ProgressCallback(void* data, double dlTotal, double dlNow, double /*ulTotal*/, double /*ulNow*/)
     {
       if (dlTotal)  // 0 for source files with unknown size
@@ -206,8 +341,442 @@ namespace IO::Network
 
   private:
     CurlObject Object;
+    ResourceProperties Properties;
+  };
+
+  /*
+    Exclusive access to cache entry. File locks are held by process, so threads of the current process
+    are serialized additionally by mutex associated with the lock file path.
+  */
+  class EntryLock
+  {
+  public:
+    typedef std::unique_ptr<EntryLock> Ptr;
+
+    //! @brief Wait until entry is released by other owners
+    static Ptr Acquire(const boost::filesystem::path& path)
+    {
+      Ptr result(new EntryLock(path));
+      result->LocalLock.lock();
+      result->FileLock.lock();
+      return result;
+    }
+
+    //! @return null if entry is used by other owner
+    static Ptr TryAcquire(const boost::filesystem::path& path)
+    {
+      Ptr result(new EntryLock(path));
+      if (result->LocalLock.try_lock() && result->FileLock.try_lock())
+      {
+        return result;
+      }
+      return {};
+    }
+
+  private:
+    explicit EntryLock(const boost::filesystem::path& path)
+      : Local(GetLocalMutex(path.string()))
+      , LocalLock(*Local, std::defer_lock)
+      , File(Open(path))
+      , FileLock(File, boost::interprocess::defer_lock)
+    {}
+
+    static std::shared_ptr<std::mutex> GetLocalMutex(const String& path)
+    {
+      static std::mutex guard;
+      static std::map<String, std::weak_ptr<std::mutex>> mutexes;
+      const std::lock_guard<std::mutex> lock(guard);
+      for (auto it = mutexes.begin(); it != mutexes.end();)
+      {
+        it = it->second.expired() ? mutexes.erase(it) : std::next(it);
+      }
+      auto& ref = mutexes[path];
+      auto result = ref.lock();
+      if (!result)
+      {
+        result = std::make_shared<std::mutex>();
+        ref = result;
+      }
+      return result;
+    }
+
+    static boost::interprocess::file_lock Open(const boost::filesystem::path& path)
+    {
+      // file should exist to be locked
+      boost::filesystem::ofstream create(path, std::ios::app);
+      create.close();
+      return boost::interprocess::file_lock(path.string().c_str());
+    }
+
+  private:
+    const std::shared_ptr<std::mutex> Local;
+    std::unique_lock<std::mutex> LocalLock;
+    boost::interprocess::file_lock File;
+    boost::interprocess::scoped_lock<boost::interprocess::file_lock> FileLock;
   };
 
+  /*
+    Persistent storage of remote resources split to fixed-size blocks.
+    Entry is keyed by url and validator (ETag or Last-Modified), so changed resource is downloaded again.
+    Layout: <key>.data is a full-sized file with blocks on their places, <key>.meta describes entry and contains
+    map of already downloaded blocks, so partially downloaded resource is completed on next access.
+    <key>.lock is locked while entry is accessed, so concurrent users of the same entry wait for each other and
+    take blocks already downloaded by others.
+  */
+  class BlockCache
+  {
+  public:
+    typedef std::unique_ptr<BlockCache> Ptr;
+
+    BlockCache(const String& directory, String url, String validator, std::size_t size, std::size_t blockSize)
+      : Url(std::move(url))
+      , Validator(std::move(validator))
+      , BlockSize(blockSize)
+      , Content(size)
+      , Blocks((size + blockSize - 1) / blockSize, false)
+    {
+      const auto urlHash = Binary::Crc32(Binary::View(Url.data(), Url.size()));
+      const auto fullHash = Binary::Crc32(Binary::View(Validator.data(), Validator.size()), urlHash);
+      const auto key = Strings::Format("%1$08x%2$08x", urlHash, fullHash);
+      const auto dir = Details::FromString(directory);
+      try
+      {
+        boost::filesystem::create_directories(dir);
+        LockPath = GetPath(dir, key, LOCK_SUFFIX);
+        DataPath = GetPath(dir, key, DATA_SUFFIX);
+        MetaPath = GetPath(dir, key, META_SUFFIX);
+        const auto lock = EntryLock::Acquire(LockPath);
+        RemoveOutdated(dir, key);
+        Load();
+      }
+      catch (const std::exception& e)
+      {
+        Dbg("Failed to use cache at %1%: %2%", directory, e.what());
+        Persistent = false;
+      }
+    }
+
+    std::size_t GetBlockSize() const
+    {
+      return BlockSize;
+    }
+
+    std::size_t GetBlocksCount() const
+    {
+      return Blocks.size();
+    }
+
+    bool HasBlock(std::size_t idx) const
+    {
+      return Blocks[idx];
+    }
+
+    const uint8_t* GetContent() const
+    {
+      return Content.data();
+    }
+
+    //! @brief Exclusive access to the persistent entry with blocks stored by other users loaded
+    //! @return null if entry is not persistent
+    EntryLock::Ptr Lock()
+    {
+      if (Persistent)
+      {
+        try
+        {
+          auto lock = EntryLock::Acquire(LockPath);
+          Load();
+          return lock;
+        }
+        catch (const std::exception& e)
+        {
+          Dbg("Failed to lock cache entry %1%: %2%", MetaPath.string(), e.what());
+          Persistent = false;
+        }
+      }
+      return {};
+    }
+
+    //! @brief Store data started from the specified block
+    void Store(std::size_t firstBlock, const Binary::Dump& data)
+    {
+      const auto offset = firstBlock * BlockSize;
+      std::copy(data.begin(), data.end(), Content.begin() + offset);
+      const auto lastBlock = (offset + data.size() + BlockSize - 1) / BlockSize;
+      std::fill(Blocks.begin() + firstBlock, Blocks.begin() + lastBlock, true);
+      if (Persistent)
+      {
+        Persistent = WriteData(offset, data) && WriteMeta();
+      }
+    }
+
+  private:
+    static boost::filesystem::path GetPath(const boost::filesystem::path& dir, const String& key, const char* suffix)
+    {
+      return dir / (key + suffix);
+    }
+
+    // entries for the same url with another validator are not valid anymore
+    void RemoveOutdated(const boost::filesystem::path& dir, const String& key) const
+    {
+      // urls are compared completely, prefix only reduces amount of files to read
+      const auto urlPrefix = key.substr(0, 8);
+      std::vector<String> outdated;
+      for (boost::filesystem::directory_iterator it(dir), lim; it != lim; ++it)
+      {
+        const auto& path = it->path();
+        const auto name = path.filename().string();
+        if (boost::algorithm::starts_with(name, urlPrefix) && boost::algorithm::ends_with(name, META_SUFFIX)
+            && !boost::algorithm::starts_with(name, key))
+        {
+          boost::filesystem::ifstream meta(path);
+          String url;
+          if (std::getline(meta, url) && url == Url)
+          {
+            outdated.push_back(name.substr(0, name.size() - std::strlen(META_SUFFIX)));
+          }
+        }
+      }
+      for (const auto& otherKey : outdated)
+      {
+        // entry in use is removed by next user
+        if (const auto lock = EntryLock::TryAcquire(GetPath(dir, otherKey, LOCK_SUFFIX)))
+        {
+          Dbg("Remove outdated cache entry %1%", otherKey);
+          for (const auto* suffix : {META_SUFFIX, DATA_SUFFIX, LOCK_SUFFIX})
+          {
+            boost::system::error_code err;
+            boost::filesystem::remove(GetPath(dir, otherKey, suffix), err);
+          }
+        }
+      }
+    }
+
+    // takes blocks stored on disk but missed in memory
+    void Load()
+    {
+      boost::filesystem::ifstream meta(MetaPath);
+      String url, validator, blocks;
+      std::size_t size = 0, blockSize = 0;
+      if (!std::getline(meta, url) || !std::getline(meta, validator) || !(meta >> size >> blockSize >> blocks))
+      {
+        return;
+      }
+      if (url != Url || validator != Validator || size != Content.size() || blockSize != BlockSize
+          || blocks.size() != Blocks.size())
+      {
+        Dbg("Cache entry %1% is outdated", MetaPath.string());
+        return;
+      }
+      boost::filesystem::ifstream data(DataPath, std::ios::binary);
+      std::size_t loaded = 0;
+      for (std::size_t idx = 0, lim = Blocks.size(); idx != lim; ++idx)
+      {
+        if (blocks[idx] != '1' || Blocks[idx])
+        {
+          continue;
+        }
+        const auto offset = idx * BlockSize;
+        const auto toRead = std::min(BlockSize, Content.size() - offset);
+        if (!data.seekg(offset).read(safe_ptr_cast<char*>(Content.data() + offset), toRead))
+        {
+          break;
+        }
+        Blocks[idx] = true;
+        ++loaded;
+      }
+      if (loaded)
+      {
+        Dbg("Loaded %1% blocks from cache entry %2% for %3%", loaded, MetaPath.string(), Url);
+      }
+    }
+
+    bool WriteData(std::size_t offset, const Binary::Dump& data)
+    {
+      if (!boost::filesystem::exists(DataPath) || boost::filesystem::file_size(DataPath) != Content.size())
+      {
+        boost::filesystem::ofstream create(DataPath, std::ios::binary | std::ios::trunc);
+        create.close();
+        boost::system::error_code err;
+        boost::filesystem::resize_file(DataPath, Content.size(), err);
+        if (err)
+        {
+          Dbg("Failed to create %1%: %2%", DataPath.string(), err.message());
+          return false;
+        }
+      }
+      boost::filesystem::fstream file(DataPath, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(offset);
+      return !!file.write(safe_ptr_cast<const char*>(data.data()), data.size()).flush();
+    }
+
+    bool WriteMeta() const
+    {
+      String blocks(Blocks.size(), '0');
+      std::transform(Blocks.begin(), Blocks.end(), blocks.begin(), [](bool present) { return present ? '1' : '0'; });
+      boost::filesystem::ofstream meta(MetaPath, std::ios::trunc);
+      meta << Url << '\n' << Validator << '\n' << Content.size() << ' ' << BlockSize << ' ' << blocks << '\n';
+      return !!meta.flush();
+    }
+
+  private:
+    static constexpr const char DATA_SUFFIX[] = ".data";
+    static constexpr const char META_SUFFIX[] = ".meta";
+    static constexpr const char LOCK_SUFFIX[] = ".lock";
+
+    const String Url;
+    const String Validator;
+    const std::size_t BlockSize;
+    Binary::Dump Content;
+    std::vector<bool> Blocks;
+    boost::filesystem::path LockPath;
+    boost::filesystem::path DataPath;
+    boost::filesystem::path MetaPath;
+    bool Persistent = true;
+  };
+
+  /*
+    Remote resource content downloaded by blocks on the first access to them.
+    Missed blocks are requested together with the subsequent ones up to readahead limit.
+  */
+  class LazyResource
+  {
+  public:
+    typedef std::shared_ptr<LazyResource> Ptr;
+
+    LazyResource(std::unique_ptr<RemoteResource> resource, BlockCache::Ptr cache, std::size_t size,
+                 std::size_t blocksPerRequest)
+      : Resource(std::move(resource))
+      , Cache(std::move(cache))
+      , Size(size)
+      , BlocksPerRequest(blocksPerRequest)
+    {}
+
+    std::size_t GetSize() const
+    {
+      return Size;
+    }
+
+    //! @brief Downloads missed blocks of the specified range
+    //! @return pointer to the range content
+    const uint8_t* Fetch(std::size_t offset, std::size_t size)
+    {
+      const std::lock_guard<std::mutex> guard(Guard);
+      const auto blockSize = Cache->GetBlockSize();
+      const auto first = offset / blockSize;
+      const auto last = (offset + size + blockSize - 1) / blockSize;
+      if (HasBlocks(first, last))
+      {
+        return Cache->GetContent() + offset;
+      }
+      const auto lock = Cache->Lock();
+      for (auto block = first, lim = Cache->GetBlocksCount(); block < last;)
+      {
+        if (Cache->HasBlock(block))
+        {
+          ++block;
+          continue;
+        }
+        // coalesce subsequent missed blocks into single request
+        auto end = block + 1;
+        while (end < lim && end - block < BlocksPerRequest && !Cache->HasBlock(end))
+        {
+          ++end;
+        }
+        const auto start = block * blockSize;
+        Cache->Store(block, Resource->DownloadRange(start, std::min(end * blockSize, Size) - start));
+        block = end;
+      }
+      return Cache->GetContent() + offset;
+    }
+
+  private:
+    bool HasBlocks(std::size_t first, std::size_t last) const
+    {
+      for (auto block = first; block < last; ++block)
+      {
+        if (!Cache->HasBlock(block))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  private:
+    const std::unique_ptr<RemoteResource> Resource;
+    const BlockCache::Ptr Cache;
+    const std::size_t Size;
+    const std::size_t BlocksPerRequest;
+    std::mutex Guard;
+  };
+
+  // content is fetched on the first Start call, subcontainers are created without fetching
+  class LazyContainer : public Binary::Container
+  {
+  public:
+    LazyContainer(LazyResource::Ptr resource, std::size_t offset, std::size_t size)
+      : Resource(std::move(resource))
+      , Offset(offset)
+      , Length(size)
+    {}
+
+    const void* Start() const override
+    {
+      if (const auto* data = Data.load())
+      {
+        return data;
+      }
+      const auto* data = Resource->Fetch(Offset, Length);
+      Data = data;
+      return data;
+    }
+
+    std::size_t Size() const override
+    {
+      return Length;
+    }
+
+    Ptr GetSubcontainer(std::size_t offset, std::size_t size) const override
+    {
+      if (size && offset < Length)
+      {
+        size = std::min(size, Length - offset);
+        return MakePtr<LazyContainer>(Resource, Offset + offset, size);
+      }
+      else
+      {
+        return Ptr();
+      }
+    }
+
+  private:
+    const LazyResource::Ptr Resource;
+    const std::size_t Offset;
+    const std::size_t Length;
+    mutable std::atomic<const uint8_t*> Data = {nullptr};
+  };
+
+  //! @return null if resource cannot be downloaded by ranges
+  Binary::Container::Ptr OpenCached(Curl::Api::Ptr api, const String& url, const ProviderParameters& params)
+  {
+    std::unique_ptr<RemoteResource> resource(new RemoteResource(std::move(api)));
+    resource->SetSource(url);
+    resource->SetOptions(params);
+    const auto props = resource->Query();
+    const auto validator = props.GetValidator();
+    if (!props.AcceptRanges || !props.Size || validator.empty())
+    {
+      Dbg("Ranged download is not available for %1%", url);
+      return {};
+    }
+    const auto size = static_cast<std::size_t>(props.Size);
+    BlockCache::Ptr cache(new BlockCache(params.GetCacheDirectory(), url, validator, size, params.GetCacheBlockSize()));
+    const auto blocksPerRequest = std::max<std::size_t>(1, params.GetReadahead() / cache->GetBlockSize());
+    auto content = MakePtr<LazyResource>(std::move(resource), std::move(cache), size, blocksPerRequest);
+    return MakePtr<LazyContainer>(std::move(content), 0, size);
+  }
+
   // uri-related constants
   const Char SCHEME_SIGN[] = {':', '/', '/', 0};
   const Char SCHEME_HTTP[] = {'h', 't', 't', 'p', 0};
@@ -349,6 +918,13 @@ namespace IO::Network
       try
       {
         const ProviderParameters options(params);
+        if (!options.GetCacheDirectory().empty())
+        {
+          if (auto cached = OpenCached(Api, path, options))
+          {
+            return cached;
+          }
+        }
         RemoteResource resource(Api);
         resource.SetSource(path);
         resource.SetOptions(options);
@@ -85,6 +85,38 @@ namespace Parameters
             //! Parameter full path
             const auto USERAGENT = PREFIX + "useragent"_id;
           }  // namespace Http
+
+          //! @brief Parameters for persistent cache of remote resources
+          namespace Cache
+          {
+            //! @brief Parameters#ZXTune#IO#Providers#Network#Cache namespace prefix
+            const auto PREFIX = Network::PREFIX + "cache"_id;
+
+            //@{
+            //! @name Cache directory. Empty value disables ranged downloading and caching
+
+            //! Parameter full path
+            const auto DIRECTORY = PREFIX + "directory"_id;
+            //@}
+
+            //@{
+            //! @name Cache block size in bytes
+
+            //! Default value
+            const IntType BLOCK_SIZE_DEFAULT = 65536;
+            //! Parameter full path
+            const auto BLOCK_SIZE = PREFIX + "block_size"_id;
+            //@}
+
+            //@{
+            //! @name Maximal size of single ranged request in bytes
+
+            //! Default value
+            const IntType READAHEAD_DEFAULT = 1048576;
+            //! Parameter full path
+            const auto READAHEAD = PREFIX + "readahead"_id;
+            //@}
+          }  // namespace Cache
         }    // namespace Network
       }      // namespace Providers
     }        // namespace IO
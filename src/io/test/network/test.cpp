@@ -0,0 +1,491 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Network provider cache test against local http server
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <binary/crc.h>
+#include <error.h>
+#include <io/providers/providers_factories.h>
+#include <io/providers_parameters.h>
+#include <parameters/container.h>
+#include <progress_callback.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  void Test(const std::string& msg, bool val)
+  {
+    if (val)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << std::endl;
+      throw 1;
+    }
+  }
+
+  template<class T>
+  void Test(const std::string& msg, T result, T reference)
+  {
+    if (result == reference)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << " (got: " << result << " expected: " << reference << ")" << std::endl;
+      throw 1;
+    }
+  }
+
+  struct Resource
+  {
+    Binary::Dump Content;
+    std::string ETag;
+  };
+
+  struct Statistic
+  {
+    std::size_t Heads = 0;
+    std::size_t Ranges = 0;
+    std::size_t Full = 0;
+    std::size_t BytesSent = 0;
+  };
+
+  // Minimal HTTP/1.1 server supporting HEAD, GET and single byte range requests. Connection per request.
+  class Server
+  {
+  public:
+    Server()
+      : Socket(::socket(AF_INET, SOCK_STREAM, 0))
+    {
+      sockaddr_in addr = {};
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      socklen_t len = sizeof(addr);
+      if (Socket < 0 || ::bind(Socket, reinterpret_cast<sockaddr*>(&addr), len) != 0 || ::listen(Socket, 16) != 0
+          || ::getsockname(Socket, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+      {
+        throw std::runtime_error("Failed to start server");
+      }
+      Port = ntohs(addr.sin_port);
+      Worker = std::thread([this]() { Serve(); });
+    }
+
+    ~Server()
+    {
+      Stopping = true;
+      // wake up accept
+      const int client = ::socket(AF_INET, SOCK_STREAM, 0);
+      const auto addr = GetAddress();
+      ::connect(client, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+      ::close(client);
+      Worker.join();
+      ::close(Socket);
+    }
+
+    std::string GetUrl(const std::string& path) const
+    {
+      return "http://127.0.0.1:" + std::to_string(Port) + path;
+    }
+
+    void SetResource(const std::string& path, Resource res)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Resources[path] = std::move(res);
+    }
+
+    //! @brief Respond with error to ranged requests after specified count
+    void FailRangesAfter(std::size_t count)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      RangesLimit = count;
+    }
+
+    void SetRangeDelay(std::chrono::milliseconds delay)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      RangeDelay = delay;
+    }
+
+    Statistic ResetStatistic()
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      const auto result = Stat;
+      Stat = Statistic();
+      return result;
+    }
+
+  private:
+    sockaddr_in GetAddress() const
+    {
+      sockaddr_in addr = {};
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr.sin_port = htons(Port);
+      return addr;
+    }
+
+    void Serve()
+    {
+      for (;;)
+      {
+        const int client = ::accept(Socket, nullptr, nullptr);
+        if (Stopping)
+        {
+          ::close(client);
+          break;
+        }
+        if (client >= 0)
+        {
+          std::thread([this, client]() {
+            Process(client);
+            ::close(client);
+          }).detach();
+        }
+      }
+    }
+
+    void Process(int client)
+    {
+      std::string request;
+      char buf[1024];
+      while (request.find("\r\n\r\n") == std::string::npos)
+      {
+        const auto got = ::recv(client, buf, sizeof(buf), 0);
+        if (got <= 0)
+        {
+          return;
+        }
+        request.append(buf, got);
+      }
+      std::istringstream str(request);
+      std::string method, path, line;
+      str >> method >> path;
+      std::size_t first = 0, last = 0;
+      bool ranged = false;
+      while (std::getline(str, line))
+      {
+        if (0 == line.compare(0, 13, "Range: bytes="))
+        {
+          ranged = 2 == std::sscanf(line.c_str() + 13, "%zu-%zu", &first, &last);
+        }
+      }
+      Respond(client, method, path, ranged, first, last);
+    }
+
+    void Respond(int client, const std::string& method, const std::string& path, bool ranged, std::size_t first,
+                 std::size_t last)
+    {
+      std::unique_lock<std::mutex> lock(Guard);
+      const auto it = Resources.find(path);
+      if (it == Resources.end())
+      {
+        Send(client, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        return;
+      }
+      const auto content = it->second.Content;
+      std::string headers = "Accept-Ranges: bytes\r\nETag: " + it->second.ETag + "\r\nConnection: close\r\n";
+      if (method == "HEAD")
+      {
+        ++Stat.Heads;
+        Send(client, "HTTP/1.1 200 OK\r\n" + headers + "Content-Length: " + std::to_string(content.size())
+                         + "\r\n\r\n");
+      }
+      else if (ranged)
+      {
+        if (Stat.Ranges++ >= RangesLimit)
+        {
+          Send(client, "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+          return;
+        }
+        last = std::min(last, content.size() - 1);
+        const auto size = last + 1 - first;
+        Stat.BytesSent += size;
+        const auto delay = RangeDelay;
+        lock.unlock();
+        std::this_thread::sleep_for(delay);
+        Send(client, "HTTP/1.1 206 Partial Content\r\n" + headers + "Content-Range: bytes " + std::to_string(first)
+                         + '-' + std::to_string(last) + '/' + std::to_string(content.size())
+                         + "\r\nContent-Length: " + std::to_string(size) + "\r\n\r\n"
+                         + std::string(content.begin() + first, content.begin() + last + 1));
+      }
+      else
+      {
+        ++Stat.Full;
+        Stat.BytesSent += content.size();
+        lock.unlock();
+        Send(client, "HTTP/1.1 200 OK\r\n" + headers + "Content-Length: " + std::to_string(content.size())
+                         + "\r\n\r\n" + std::string(content.begin(), content.end()));
+      }
+    }
+
+    static void Send(int client, const std::string& data)
+    {
+      for (std::size_t done = 0; done < data.size();)
+      {
+        const auto sent = ::send(client, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (sent <= 0)
+        {
+          break;
+        }
+        done += sent;
+      }
+    }
+
+  private:
+    const int Socket;
+    uint16_t Port = 0;
+    std::atomic<bool> Stopping = {false};
+    std::thread Worker;
+    std::mutex Guard;
+    std::map<std::string, Resource> Resources;
+    std::size_t RangesLimit = ~std::size_t(0);
+    std::chrono::milliseconds RangeDelay = {};
+    Statistic Stat;
+  };
+
+  Resource MakeResource(std::size_t size, uint8_t seed, const std::string& etag)
+  {
+    Resource res;
+    res.Content.resize(size);
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+      res.Content[idx] = static_cast<uint8_t>(idx * 7 + seed + (idx >> 8));
+    }
+    res.ETag = etag;
+    return res;
+  }
+
+  bool IsSame(const Binary::Container::Ptr& data, const Resource& res)
+  {
+    return data && data->Size() == res.Content.size()
+           && 0 == std::memcmp(data->Start(), res.Content.data(), res.Content.size());
+  }
+
+  std::size_t CountFiles(const boost::filesystem::path& dir, const std::string& suffix)
+  {
+    std::size_t result = 0;
+    for (boost::filesystem::directory_iterator it(dir), lim; it != lim; ++it)
+    {
+      result += it->path().extension() == suffix;
+    }
+    return result;
+  }
+
+  // find two paths with the same crc32 of url
+  std::pair<std::string, std::string> FindCollision(const Server& srv)
+  {
+    std::unordered_map<uint32_t, std::string> hashes;
+    for (uint_t idx = 0;; ++idx)
+    {
+      const auto path = "/collision" + std::to_string(idx);
+      const auto url = srv.GetUrl(path);
+      const auto hash = Binary::Crc32(Binary::View(url.data(), url.size()));
+      const auto res = hashes.emplace(hash, path);
+      if (!res.second)
+      {
+        return {res.first->second, path};
+      }
+    }
+  }
+
+  class Fixture
+  {
+  public:
+    Fixture()
+      : Dir(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+      , Params(Parameters::Container::Create())
+      , Provider(IO::CreateNetworkDataProvider(IO::Curl::LoadDynamicApi()))
+    {
+      using namespace Parameters::ZXTune::IO::Providers::Network::Cache;
+      Params->SetValue(DIRECTORY, Dir.string());
+      Params->SetValue(BLOCK_SIZE, 4096);
+      Params->SetValue(READAHEAD, 16384);
+    }
+
+    ~Fixture()
+    {
+      boost::system::error_code err;
+      boost::filesystem::remove_all(Dir, err);
+    }
+
+    Binary::Container::Ptr Open(const std::string& path) const
+    {
+      return Provider->Open(Srv.GetUrl(path), *Params, Log::ProgressCallback::Stub());
+    }
+
+    Server Srv;
+    const boost::filesystem::path Dir;
+    const Parameters::Container::Ptr Params;
+    const IO::DataProvider::Ptr Provider;
+  };
+
+  void TestDownloadAndReuse(Fixture& fix)
+  {
+    std::cout << "Test download and reuse" << std::endl;
+    const auto res = MakeResource(100000, 1, "\"v1\"");
+    fix.Srv.SetResource("/file", res);
+    Test("cold download", IsSame(fix.Open("/file"), res));
+    const auto cold = fix.Srv.ResetStatistic();
+    Test<std::size_t>("cold download ranges", cold.Ranges, 7);
+    Test<std::size_t>("cold download bytes", cold.BytesSent, res.Content.size());
+    Test<std::size_t>("cold download full requests", cold.Full, 0);
+    Test("cached open", IsSame(fix.Open("/file"), res));
+    const auto cached = fix.Srv.ResetStatistic();
+    Test<std::size_t>("cached open heads", cached.Heads, 1);
+    Test<std::size_t>("cached open bytes", cached.BytesSent, 0);
+  }
+
+  void TestLazyAccess(Fixture& fix)
+  {
+    std::cout << "Test lazy access" << std::endl;
+    const auto res = MakeResource(100000, 8, "\"v1\"");
+    fix.Srv.SetResource("/lazy", res);
+    const auto data = fix.Open("/lazy");
+    const auto opened = fix.Srv.ResetStatistic();
+    Test<std::size_t>("lazy open heads", opened.Heads, 1);
+    Test<std::size_t>("lazy open bytes", opened.BytesSent, 0);
+    Test<std::size_t>("lazy open size", data->Size(), res.Content.size());
+    const auto part = data->GetSubcontainer(50000, 100);
+    Test<std::size_t>("subcontainer bytes", fix.Srv.ResetStatistic().BytesSent, 0);
+    Test("subcontainer content", 0 == std::memcmp(part->Start(), res.Content.data() + 50000, 100));
+    const auto fetched = fix.Srv.ResetStatistic();
+    Test<std::size_t>("subcontainer fetch ranges", fetched.Ranges, 1);
+    // blocks 12..15 due to readahead
+    Test<std::size_t>("subcontainer fetch bytes", fetched.BytesSent, 16384);
+    Test("whole content", IsSame(data, res));
+    Test<std::size_t>("rest bytes", fix.Srv.ResetStatistic().BytesSent, res.Content.size() - 16384);
+  }
+
+  void TestResume(Fixture& fix)
+  {
+    std::cout << "Test resume" << std::endl;
+    const auto res = MakeResource(100000, 2, "\"v1\"");
+    fix.Srv.SetResource("/resumed", res);
+    fix.Srv.FailRangesAfter(3);
+    try
+    {
+      fix.Open("/resumed")->Start();
+      Test("interrupted download", false);
+    }
+    catch (const Error&)
+    {
+      Test("interrupted download", true);
+    }
+    const auto interrupted = fix.Srv.ResetStatistic();
+    Test<std::size_t>("interrupted download bytes", interrupted.BytesSent, 3 * 16384);
+    fix.Srv.FailRangesAfter(~std::size_t(0));
+    Test("resumed download", IsSame(fix.Open("/resumed"), res));
+    const auto resumed = fix.Srv.ResetStatistic();
+    Test<std::size_t>("resumed download bytes", resumed.BytesSent, res.Content.size() - 3 * 16384);
+  }
+
+  void TestInvalidation(Fixture& fix)
+  {
+    std::cout << "Test invalidation" << std::endl;
+    const auto first = MakeResource(50000, 3, "\"v1\"");
+    fix.Srv.SetResource("/changed", first);
+    Test("first version", IsSame(fix.Open("/changed"), first));
+    const auto entries = CountFiles(fix.Dir, ".meta");
+    const auto second = MakeResource(60000, 4, "\"v2\"");
+    fix.Srv.SetResource("/changed", second);
+    fix.Srv.ResetStatistic();
+    Test("second version", IsSame(fix.Open("/changed"), second));
+    Test<std::size_t>("second version bytes", fix.Srv.ResetStatistic().BytesSent, second.Content.size());
+    Test<std::size_t>("outdated entry removed", CountFiles(fix.Dir, ".meta"), entries);
+  }
+
+  void TestUrlHashCollision(Fixture& fix)
+  {
+    std::cout << "Test url hash collision" << std::endl;
+    const auto paths = FindCollision(fix.Srv);
+    const auto first = MakeResource(30000, 5, "\"first\"");
+    const auto second = MakeResource(40000, 6, "\"second\"");
+    fix.Srv.SetResource(paths.first, first);
+    fix.Srv.SetResource(paths.second, second);
+    Test("first url", IsSame(fix.Open(paths.first), first));
+    Test("second url", IsSame(fix.Open(paths.second), second));
+    fix.Srv.ResetStatistic();
+    Test("first url reopen", IsSame(fix.Open(paths.first), first));
+    Test<std::size_t>("first url kept in cache", fix.Srv.ResetStatistic().BytesSent, 0);
+  }
+
+  void TestConcurrentAccess(Fixture& fix)
+  {
+    std::cout << "Test concurrent access" << std::endl;
+    const auto res = MakeResource(100000, 7, "\"v1\"");
+    fix.Srv.SetResource("/concurrent", res);
+    fix.Srv.SetRangeDelay(std::chrono::milliseconds(50));
+    Binary::Container::Ptr results[4];
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+    {
+      threads.emplace_back([&fix, &result]() {
+        result = fix.Open("/concurrent");
+        result->Start();
+      });
+    }
+    for (auto& thr : threads)
+    {
+      thr.join();
+    }
+    fix.Srv.SetRangeDelay({});
+    for (const auto& result : results)
+    {
+      Test("concurrent open", IsSame(result, res));
+    }
+    Test<std::size_t>("concurrent open bytes", fix.Srv.ResetStatistic().BytesSent, res.Content.size());
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    std::unique_ptr<Fixture> fix;
+    try
+    {
+      fix.reset(new Fixture());
+    }
+    catch (const Error& e)
+    {
+      std::cout << "Skipped network tests: " << e.ToString() << std::endl;
+      return 0;
+    }
+    TestDownloadAndReuse(*fix);
+    TestLazyAccess(*fix);
+    TestResume(*fix);
+    TestInvalidation(*fix);
+    TestUrlHashCollision(*fix);
+    TestConcurrentAccess(*fix);
+  }
+  catch (int code)
+  {
+    return code;
+  }
+}
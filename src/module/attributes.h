@@ -48,6 +48,8 @@ namespace Module
   constexpr const auto ATTR_STRINGS = "Strings"_sv;
   //! Platform id
   constexpr const auto ATTR_PLATFORM = "Platform"_sv;
+  //! Playback duration in milliseconds detected by probing
+  constexpr const auto ATTR_DURATION = "Duration"_sv;
   //@}
 
   //@{
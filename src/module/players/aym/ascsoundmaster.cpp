@@ -12,6 +12,7 @@
 #include "module/players/aym/ascsoundmaster.h"
 #include "module/players/aym/aym_base.h"
 #include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_metadata.h"
 #include "module/players/aym/aym_properties_helper.h"
 // common includes
 #include <make_ptr.h>
@@ -228,6 +229,9 @@ namespace Module::ASCSoundMaster
     ModuleData::RWPtr Data;
   };
 
+  using MetadataBuilder = AYM::MetadataBuilder<Formats::Chiptune::ASCSoundMaster::StubBuilder,
+                                                Formats::Chiptune::ASCSoundMaster::Positions, SimpleOrderList>;
+
   const uint_t LIMITER(~uint_t(0));
 
   struct ChannelState
@@ -592,8 +596,41 @@ namespace Module::ASCSoundMaster
     const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr Decoder;
   };
 
+  class MetadataFactory : public Module::MetadataFactory
+  {
+  public:
+    explicit MetadataFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {}
+
+    Information::Ptr ProbeModule(const Parameters::Accessor& /*params*/, const Binary::Container& rawData,
+                                 Parameters::Container::Ptr properties) const override
+    {
+      AYM::PropertiesHelper props(*properties);
+      MetadataBuilder builder(props, TABLE_ASM);
+      if (const auto container = Decoder->Parse(rawData, builder))
+      {
+        props.SetSource(*container);
+        props.SetPlatform(Platforms::ZX_SPECTRUM);
+        return builder.CaptureResult();
+      }
+      else
+      {
+        return {};
+      }
+    }
+
+  private:
+    const Formats::Chiptune::ASCSoundMaster::Decoder::Ptr Decoder;
+  };
+
   AYM::Factory::Ptr CreateFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(std::move(decoder));
   }
+
+  Module::MetadataFactory::Ptr CreateMetadataFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder)
+  {
+    return MakePtr<MetadataFactory>(std::move(decoder));
+  }
 }  // namespace Module::ASCSoundMaster
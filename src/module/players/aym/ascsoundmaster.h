@@ -14,11 +14,13 @@
 #include "module/players/aym/aym_factory.h"
 // library includes
 #include <formats/chiptune/aym/ascsoundmaster.h>
+#include <module/players/factory.h>
 
 namespace Module
 {
   namespace ASCSoundMaster
   {
     AYM::Factory::Ptr CreateFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder);
+    MetadataFactory::Ptr CreateMetadataFactory(Formats::Chiptune::ASCSoundMaster::Decoder::Ptr decoder);
   }
 }  // namespace Module
@@ -24,7 +24,7 @@ namespace Module
 {
   const Debug::Stream Dbg("Core::AYBase");
 
-  class AYMRenderer : public Renderer
+  class AYMRenderer : public BufferRenderer
   {
   public:
     AYMRenderer(Time::Microseconds frameDuration, AYM::DataIterator::Ptr iterator, Devices::AYM::Chip::Ptr device)
@@ -50,6 +50,19 @@ namespace Module
       return Device->RenderTill(LastChunk.TimeStamp);
     }
 
+    void Render(const Sound::LoopParameters& looped, Sound::Chunk& target) override
+    {
+      if (!Iterator->IsValid())
+      {
+        target.clear();
+        return;
+      }
+      TransferChunk();
+      Iterator->NextFrame(looped);
+      LastChunk.TimeStamp += FrameDuration;
+      Device->RenderTill(LastChunk.TimeStamp, target);
+    }
+
     void Reset() override
     {
       Iterator->Reset();
@@ -15,8 +15,13 @@
 // library includes
 #include <math/numeric.h>
 #include <parameters/tracking_helper.h>
+#include <sound/loop.h>
 // std includes
+#include <algorithm>
+#include <array>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace Module
 {
@@ -84,6 +89,344 @@ namespace Module
       mutable FrequencyTable Table;
     };
 
+    /*
+      Registers stream of the track as it's played from the beginning with infinite looping, so channels state carried
+      over loop point is the same as in interpreted playback. Stream is compiled in steps on demand.
+
+      Compilation stops when loop iteration repeats the previous one (or after MAX_LOOPS iterations), further frames
+      are replayed from the last kept iteration, so stream size is limited for any playback time.
+
+      Every frame is stored as mask of written registers (envelope type write restarts envelope even if value is the
+      same) and mask of changed registers followed by new values. Full registers image is stored every
+      KEYFRAME_PERIOD frames to limit random access cost.
+    */
+    class CompiledTrack
+    {
+    private:
+      static const std::size_t KEYFRAME_PERIOD = 64;
+      // about 5 seconds for 50Hz tracks
+      static const std::size_t COMPILE_STEP = 256;
+      // carried channels state usually stabilizes after the first loop
+      static const std::size_t MAX_LOOPS = 4;
+      using ImageType = std::array<uint8_t, Devices::AYM::Registers::TOTAL>;
+
+      struct FrameMasks
+      {
+        uint16_t Written = 0;
+        uint16_t Changed = 0;
+      };
+
+      struct Keyframe
+      {
+        ImageType Image;
+        std::size_t Offset;
+      };
+
+      // start of loop iteration
+      struct LoopMark
+      {
+        std::size_t Frame;
+        std::size_t Offset;
+        ImageType Image;
+      };
+
+    public:
+      typedef std::shared_ptr<CompiledTrack> Ptr;
+
+      CompiledTrack(const FrequencyTable& table, uint_t loopPosition, TrackStateIterator::Ptr iterator,
+                    DataRenderer::Ptr renderer)
+        : Table(table)
+        , LoopPosition(loopPosition)
+        , Iterator(std::move(iterator))
+        , State(Iterator->GetStateObserver())
+        , Render(std::move(renderer))
+      {}
+
+      const FrequencyTable& GetTable() const
+      {
+        return Table;
+      }
+
+      class Reader
+      {
+      public:
+        //! @param frame Frames count since start including loops
+        Devices::AYM::Registers Get(CompiledTrack& track, std::size_t frame)
+        {
+          const std::lock_guard<std::mutex> lock(track.Guard);
+          Devices::AYM::Registers result;
+          if (!track.Compile(frame))
+          {
+            return result;
+          }
+          frame = track.GetStoredFrame(frame);
+          // start from the nearest keyframe if it's closer than current position
+          const auto keyframe = frame / KEYFRAME_PERIOD;
+          if (frame < Next || keyframe > Next / KEYFRAME_PERIOD)
+          {
+            const auto& key = track.Keyframes[keyframe];
+            Image = key.Image;
+            Offset = key.Offset;
+            Next = keyframe * KEYFRAME_PERIOD;
+          }
+          while (Next <= frame)
+          {
+            const auto changed = track.Frames[Next++].Changed;
+            for (uint_t reg = 0; reg != Image.size(); ++reg)
+            {
+              if (changed & (1 << reg))
+              {
+                Image[reg] = track.Values[Offset++];
+              }
+            }
+          }
+          const auto written = track.Frames[frame].Written;
+          for (uint_t reg = 0; reg != Image.size(); ++reg)
+          {
+            if (written & (1 << reg))
+            {
+              const auto idx = static_cast<Devices::AYM::Registers::Index>(reg);
+              result[idx] = Image[reg];
+            }
+          }
+          return result;
+        }
+
+        void Reset()
+        {
+          Next = ~std::size_t(0);
+        }
+
+      private:
+        ImageType Image;
+        std::size_t Offset = 0;
+        // frame to be applied to image
+        std::size_t Next = ~std::size_t(0);
+      };
+
+    private:
+      //! @return false if frame is out of track
+      bool Compile(std::size_t frame)
+      {
+        while (frame >= Frames.size() && LoopFrame == NO_LOOP)
+        {
+          if (!Iterator->IsValid())
+          {
+            return false;
+          }
+          // loop is processed as in playback, so renderer keeps its state
+          const Sound::LoopParameters infinite(true, 0);
+          for (std::size_t step = 0; step != COMPILE_STEP && Iterator->IsValid() && LoopFrame == NO_LOOP; ++step)
+          {
+            const auto loops = State->LoopCount();
+            if (0 == loops && Loops.empty() && State->Position() == LoopPosition && 0 == State->Line()
+                && 0 == State->Quirk())
+            {
+              AddLoop();
+            }
+            TrackBuilder builder(Table);
+            Render->SynthesizeData(*State, builder);
+            AddFrame(builder.GetResult());
+            Iterator->NextFrame(infinite);
+            if (State->LoopCount() != loops)
+            {
+              AddLoop();
+            }
+          }
+        }
+        return true;
+      }
+
+      std::size_t GetStoredFrame(std::size_t frame) const
+      {
+        return frame < Frames.size() ? frame : LoopFrame + (frame - Frames.size()) % (Frames.size() - LoopFrame);
+      }
+
+      void AddLoop()
+      {
+        Loops.push_back({Frames.size(), Values.size(), Image});
+        const auto count = Loops.size();
+        if (count >= 3 && IsSameIteration(Loops[count - 3], Loops[count - 2], Loops[count - 1]))
+        {
+          // drop the last iteration and replay the previous one instead
+          const auto& last = Loops[count - 2];
+          Frames.resize(last.Frame);
+          Values.resize(last.Offset);
+          Keyframes.resize((last.Frame + KEYFRAME_PERIOD - 1) / KEYFRAME_PERIOD);
+          LoopFrame = Loops[count - 3].Frame;
+        }
+        else if (count > MAX_LOOPS)
+        {
+          LoopFrame = Loops[count - 2].Frame;
+        }
+      }
+
+      bool IsSameIteration(const LoopMark& prev, const LoopMark& start, const LoopMark& end) const
+      {
+        if (start.Frame - prev.Frame != end.Frame - start.Frame
+            || start.Offset - prev.Offset != end.Offset - start.Offset || prev.Image != start.Image)
+        {
+          return false;
+        }
+        const auto isSameFrame = [](FrameMasks lh, FrameMasks rh) {
+          return lh.Written == rh.Written && lh.Changed == rh.Changed;
+        };
+        return std::equal(Frames.begin() + prev.Frame, Frames.begin() + start.Frame, Frames.begin() + start.Frame,
+                          isSameFrame)
+               && std::equal(Values.begin() + prev.Offset, Values.begin() + start.Offset,
+                             Values.begin() + start.Offset);
+      }
+
+      void AddFrame(const Devices::AYM::Registers& regs)
+      {
+        if (0 == Frames.size() % KEYFRAME_PERIOD)
+        {
+          Keyframes.push_back({Image, Values.size()});
+        }
+        FrameMasks frame;
+        for (Devices::AYM::Registers::IndicesIterator it(regs); it; ++it)
+        {
+          const auto reg = *it;
+          const uint16_t mask = 1 << reg;
+          frame.Written |= mask;
+          if (regs[reg] != Image[reg])
+          {
+            frame.Changed |= mask;
+            Image[reg] = regs[reg];
+            Values.push_back(regs[reg]);
+          }
+        }
+        Frames.push_back(frame);
+      }
+
+    private:
+      static const std::size_t NO_LOOP = ~std::size_t(0);
+
+      const FrequencyTable Table;
+      const uint_t LoopPosition;
+      std::mutex Guard;
+      std::vector<FrameMasks> Frames;
+      std::vector<Keyframe> Keyframes;
+      std::vector<uint8_t> Values;
+      // replay start after the last stored frame, set when compilation is finished
+      std::size_t LoopFrame = NO_LOOP;
+      // compilation state
+      std::vector<LoopMark> Loops;
+      const TrackStateIterator::Ptr Iterator;
+      const TrackModelState::Ptr State;
+      const DataRenderer::Ptr Render;
+      ImageType Image = {};
+    };
+
+    class CompiledTrackCacheImpl : public CompiledTrackCache
+    {
+    public:
+      CompiledTrackCacheImpl(Time::Microseconds frameDuration, TrackModel::Ptr model, RendererFactory factory)
+        : FrameDuration(frameDuration)
+        , Model(std::move(model))
+        , Factory(std::move(factory))
+      {}
+
+      CompiledTrack::Ptr Get(const FrequencyTable& table) const override
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        const auto it = std::find_if(Tracks.begin(), Tracks.end(),
+                                     [&table](const CompiledTrack::Ptr& track) { return track->GetTable() == table; });
+        if (it != Tracks.end())
+        {
+          return *it;
+        }
+        if (Tracks.size() == MAX_TRACKS)
+        {
+          Tracks.erase(Tracks.begin());
+        }
+        // actual compilation is performed on demand by readers
+        auto iterator = CreateTrackStateIterator(FrameDuration, Model);
+        Tracks.push_back(std::make_shared<CompiledTrack>(table, Model->GetOrder().GetLoopPosition(),
+                                                         std::move(iterator), Factory()));
+        return Tracks.back();
+      }
+
+    private:
+      static const std::size_t MAX_TRACKS = 2;
+      const Time::Microseconds FrameDuration;
+      const TrackModel::Ptr Model;
+      const RendererFactory Factory;
+      mutable std::mutex Guard;
+      mutable std::vector<CompiledTrack::Ptr> Tracks;
+    };
+
+    class CompiledDataIterator : public DataIterator
+    {
+    public:
+      CompiledDataIterator(TrackParameters::Ptr trackParams, TrackStateIterator::Ptr delegate,
+                           CompiledTrackCache::Ptr cache)
+        : Params(std::move(trackParams))
+        , Delegate(std::move(delegate))
+        , State(Delegate->GetStateObserver())
+        , Cache(std::move(cache))
+      {}
+
+      void Reset() override
+      {
+        Params.Reset();
+        Delegate->Reset();
+        Frame = 0;
+      }
+
+      bool IsValid() const override
+      {
+        return Delegate->IsValid();
+      }
+
+      void NextFrame(const Sound::LoopParameters& looped) override
+      {
+        Delegate->NextFrame(looped);
+        ++Frame;
+      }
+
+      Module::State::Ptr GetStateObserver() const override
+      {
+        return State;
+      }
+
+      Devices::AYM::Registers GetData() const override
+      {
+        if (!Delegate->IsValid())
+        {
+          return {};
+        }
+        SynchronizeParameters();
+        return Reader.Get(*Track, Frame);
+      }
+
+    private:
+      void SynchronizeParameters() const
+      {
+        if (Params.IsChanged())
+        {
+          FrequencyTable table;
+          Params->FreqTable(table);
+          auto track = Cache->Get(table);
+          if (track != Track)
+          {
+            Track = std::move(track);
+            Reader.Reset();
+          }
+        }
+      }
+
+    private:
+      Parameters::TrackingHelper<AYM::TrackParameters> Params;
+      const TrackStateIterator::Ptr Delegate;
+      const TrackModelState::Ptr State;
+      const CompiledTrackCache::Ptr Cache;
+      // frames since start including loops
+      std::size_t Frame = 0;
+      mutable CompiledTrack::Ptr Track;
+      mutable CompiledTrack::Reader Reader;
+    };
+
     void ChannelBuilder::SetTone(int_t halfTones, int_t offset)
     {
       const int_t halftone = Math::Clamp<int_t>(halfTones, 0, static_cast<int_t>(Table.size()) - 1);
@@ -158,5 +501,17 @@ namespace Module
     {
       return MakePtr<TrackDataIterator>(std::move(trackParams), std::move(iterator), std::move(renderer));
     }
+
+    CompiledTrackCache::Ptr CompiledTrackCache::Create(Time::Microseconds frameDuration, TrackModel::Ptr model,
+                                                       RendererFactory factory)
+    {
+      return MakePtr<CompiledTrackCacheImpl>(frameDuration, std::move(model), std::move(factory));
+    }
+
+    DataIterator::Ptr CreateCompiledDataIterator(AYM::TrackParameters::Ptr trackParams,
+                                                 TrackStateIterator::Ptr iterator, CompiledTrackCache::Ptr cache)
+    {
+      return MakePtr<CompiledDataIterator>(std::move(trackParams), std::move(iterator), std::move(cache));
+    }
   }  // namespace AYM
 }  // namespace Module
@@ -15,6 +15,8 @@
 // library includes
 #include <module/players/tracking.h>
 #include <module/renderer.h>
+// std includes
+#include <functional>
 
 namespace Module
 {
@@ -89,6 +91,25 @@ namespace Module
     DataIterator::Ptr CreateDataIterator(AYM::TrackParameters::Ptr trackParams, TrackStateIterator::Ptr iterator,
                                          DataRenderer::Ptr renderer);
 
+    class CompiledTrack;
+
+    //! @brief Registers streams of the track compiled per frequency table and shared between renderers
+    class CompiledTrackCache
+    {
+    public:
+      typedef std::shared_ptr<CompiledTrackCache> Ptr;
+      typedef std::function<DataRenderer::Ptr()> RendererFactory;
+
+      virtual ~CompiledTrackCache() = default;
+
+      virtual std::shared_ptr<CompiledTrack> Get(const FrequencyTable& table) const = 0;
+
+      static Ptr Create(Time::Microseconds frameDuration, TrackModel::Ptr model, RendererFactory factory);
+    };
+
+    DataIterator::Ptr CreateCompiledDataIterator(AYM::TrackParameters::Ptr trackParams,
+                                                 TrackStateIterator::Ptr iterator, CompiledTrackCache::Ptr cache);
+
     template<class OrderListType, class SampleType, class OrnamentType>
     class ModuleData : public TrackModel
     {
@@ -134,6 +155,8 @@ namespace Module
       TrackingChiptune(typename ModuleData::Ptr data, Parameters::Accessor::Ptr properties)
         : Data(std::move(data))
         , Properties(std::move(properties))
+        , Compiled(CompiledTrackCache::Create(BASE_FRAME_DURATION, Data,
+                                              [data = Data]() { return MakePtr<DataRenderer>(data); }))
       {}
 
       Time::Microseconds GetFrameDuration() const override
@@ -159,6 +182,10 @@ namespace Module
       AYM::DataIterator::Ptr CreateDataIterator(AYM::TrackParameters::Ptr trackParams) const override
       {
         auto iterator = CreateTrackStateIterator(GetFrameDuration(), Data);
+        if (trackParams->CompiledStream())
+        {
+          return AYM::CreateCompiledDataIterator(std::move(trackParams), std::move(iterator), Compiled);
+        }
         auto renderer = MakePtr<DataRenderer>(Data);
         return AYM::CreateDataIterator(std::move(trackParams), std::move(iterator), std::move(renderer));
       }
@@ -166,6 +193,7 @@ namespace Module
     private:
       const typename ModuleData::Ptr Data;
       const Parameters::Accessor::Ptr Properties;
+      const CompiledTrackCache::Ptr Compiled;
     };
   }  // namespace AYM
 }  // namespace Module
@@ -0,0 +1,106 @@
+/**
+ *
+ * @file
+ *
+ * @brief  AYM-based track chiptunes metadata probing
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// local includes
+#include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_properties_helper.h"
+// common includes
+#include <make_ptr.h>
+// library includes
+#include <module/players/properties_meta.h>
+
+namespace Module
+{
+  namespace AYM
+  {
+    //! @brief Track model with positions, lines and tempo only
+    template<class OrderListType>
+    class TrackTiming : public TrackModel
+    {
+    public:
+      typedef std::shared_ptr<TrackTiming> RWPtr;
+
+      uint_t GetChannelsCount() const override
+      {
+        return TRACK_CHANNELS;
+      }
+
+      uint_t GetInitialTempo() const override
+      {
+        return InitialTempo;
+      }
+
+      const OrderList& GetOrder() const override
+      {
+        return *Order;
+      }
+
+      const PatternsSet& GetPatterns() const override
+      {
+        return *Patterns;
+      }
+
+      uint_t InitialTempo = 0;
+      typename OrderListType::Ptr Order;
+      PatternsSet::Ptr Patterns;
+    };
+
+    /*
+      Collects metadata and track timing only. The rest of callbacks are handled by format-specific stub builder, so
+      samples, ornaments and channels data are not stored and duration is calculated without playable model.
+    */
+    template<class StubBuilderType, class PositionsType, class OrderListType>
+    class MetadataBuilder : public StubBuilderType
+    {
+    public:
+      MetadataBuilder(PropertiesHelper& props, const String& freqTable)
+        : Meta(props)
+        , Patterns(PatternsBuilder::Create<0>())
+        , Data(MakeRWPtr<TrackTiming<OrderListType>>())
+      {
+        props.SetFrequencyTable(freqTable);
+      }
+
+      Formats::Chiptune::MetaBuilder& GetMetaBuilder() override
+      {
+        return Meta;
+      }
+
+      void SetInitialTempo(uint_t tempo) override
+      {
+        Data->InitialTempo = tempo;
+      }
+
+      void SetPositions(PositionsType positions) override
+      {
+        Data->Order = MakePtr<OrderListType>(positions.Loop, std::move(positions.Lines));
+      }
+
+      Formats::Chiptune::PatternBuilder& StartPattern(uint_t index) override
+      {
+        Patterns.SetPattern(index);
+        return Patterns;
+      }
+
+      Information::Ptr CaptureResult()
+      {
+        Data->Patterns = Patterns.CaptureResult();
+        return CreateTrackInfo(BASE_FRAME_DURATION, std::move(Data));
+      }
+
+    private:
+      MetaProperties Meta;
+      PatternsBuilder Patterns;
+      typename TrackTiming<OrderListType>::RWPtr Data;
+    };
+  }  // namespace AYM
+}  // namespace Module
@@ -187,6 +187,12 @@ namespace Module::AYM
     const Parameters::Accessor::Ptr Params;
   };
 
+  bool IsCompiledStreamEnabled(const Parameters::Accessor& params)
+  {
+    Parameters::IntType val = 0;
+    return params.FindValue(Parameters::ZXTune::Core::AYM::COMPILED_STREAM, val) && val != 0;
+  }
+
   class AYTrackParameters : public TrackParameters
   {
   public:
@@ -220,6 +226,11 @@ namespace Module::AYM
       }
     }
 
+    bool CompiledStream() const override
+    {
+      return IsCompiledStreamEnabled(*Params);
+    }
+
   private:
     const Parameters::Accessor::Ptr Params;
   };
@@ -249,6 +260,11 @@ namespace Module::AYM
       }
     }
 
+    bool CompiledStream() const override
+    {
+      return IsCompiledStreamEnabled(*Params);
+    }
+
   private:
     /*
       ('a', 0) => 'a'
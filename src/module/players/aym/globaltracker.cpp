@@ -12,6 +12,7 @@
 #include "module/players/aym/globaltracker.h"
 #include "module/players/aym/aym_base.h"
 #include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_metadata.h"
 #include "module/players/aym/aym_properties_helper.h"
 // common includes
 #include <make_ptr.h>
@@ -133,6 +134,9 @@ namespace Module::GlobalTracker
     ModuleData::RWPtr Data;
   };
 
+  using MetadataBuilder = AYM::MetadataBuilder<Formats::Chiptune::GlobalTracker::StubBuilder,
+                                                Formats::Chiptune::GlobalTracker::Positions, SimpleOrderList>;
+
   struct ChannelState
   {
     ChannelState()
@@ -320,8 +324,34 @@ namespace Module::GlobalTracker
     }
   };
 
+  class MetadataFactory : public Module::MetadataFactory
+  {
+  public:
+    Information::Ptr ProbeModule(const Parameters::Accessor& /*params*/, const Binary::Container& rawData,
+                                 Parameters::Container::Ptr properties) const override
+    {
+      AYM::PropertiesHelper props(*properties);
+      MetadataBuilder builder(props, TABLE_PROTRACKER3_ST);
+      if (const auto container = Formats::Chiptune::GlobalTracker::Parse(rawData, builder))
+      {
+        props.SetSource(*container);
+        props.SetPlatform(Platforms::ZX_SPECTRUM);
+        return builder.CaptureResult();
+      }
+      else
+      {
+        return {};
+      }
+    }
+  };
+
   Factory::Ptr CreateFactory()
   {
     return MakePtr<Factory>();
   }
+
+  Module::MetadataFactory::Ptr CreateMetadataFactory()
+  {
+    return MakePtr<MetadataFactory>();
+  }
 }  // namespace Module::GlobalTracker
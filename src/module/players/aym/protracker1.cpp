@@ -12,6 +12,7 @@
 #include "module/players/aym/protracker1.h"
 #include "module/players/aym/aym_base.h"
 #include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_metadata.h"
 #include "module/players/aym/aym_properties_helper.h"
 // common includes
 #include <make_ptr.h>
@@ -137,6 +138,9 @@ namespace Module::ProTracker1
     ModuleData::RWPtr Data;
   };
 
+  using MetadataBuilder = AYM::MetadataBuilder<Formats::Chiptune::ProTracker1::StubBuilder,
+                                                Formats::Chiptune::ProTracker1::Positions, SimpleOrderList>;
+
   inline uint_t GetVolume(uint_t volume, uint_t level)
   {
     return ((volume * 17 + (volume > 7 ? 1 : 0)) * level + 128) / 256;
@@ -318,8 +322,34 @@ namespace Module::ProTracker1
     }
   };
 
+  class MetadataFactory : public Module::MetadataFactory
+  {
+  public:
+    Information::Ptr ProbeModule(const Parameters::Accessor& /*params*/, const Binary::Container& rawData,
+                                 Parameters::Container::Ptr properties) const override
+    {
+      AYM::PropertiesHelper props(*properties);
+      MetadataBuilder builder(props, TABLE_PROTRACKER3_ST);
+      if (const auto container = Formats::Chiptune::ProTracker1::Parse(rawData, builder))
+      {
+        props.SetSource(*container);
+        props.SetPlatform(Platforms::ZX_SPECTRUM);
+        return builder.CaptureResult();
+      }
+      else
+      {
+        return {};
+      }
+    }
+  };
+
   Factory::Ptr CreateFactory()
   {
     return MakePtr<Factory>();
   }
+
+  Module::MetadataFactory::Ptr CreateMetadataFactory()
+  {
+    return MakePtr<MetadataFactory>();
+  }
 }  // namespace Module::ProTracker1
@@ -12,11 +12,14 @@
 
 // local includes
 #include "module/players/aym/aym_factory.h"
+// library includes
+#include <module/players/factory.h>
 
 namespace Module
 {
   namespace ProTracker1
   {
     AYM::Factory::Ptr CreateFactory();
+    MetadataFactory::Ptr CreateMetadataFactory();
   }
 }  // namespace Module
@@ -12,6 +12,7 @@
 #include "module/players/aym/protracker2.h"
 #include "module/players/aym/aym_base.h"
 #include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_metadata.h"
 #include "module/players/aym/aym_properties_helper.h"
 // common includes
 #include <make_ptr.h>
@@ -172,6 +173,9 @@ namespace Module::ProTracker2
     ModuleData::RWPtr Data;
   };
 
+  using MetadataBuilder = AYM::MetadataBuilder<Formats::Chiptune::ProTracker2::StubBuilder,
+                                                Formats::Chiptune::ProTracker2::Positions, SimpleOrderList>;
+
   const uint_t LIMITER = ~uint_t(0);
 
   inline uint_t GetVolume(uint_t volume, uint_t level)
@@ -408,8 +412,34 @@ namespace Module::ProTracker2
     }
   };
 
+  class MetadataFactory : public Module::MetadataFactory
+  {
+  public:
+    Information::Ptr ProbeModule(const Parameters::Accessor& /*params*/, const Binary::Container& rawData,
+                                 Parameters::Container::Ptr properties) const override
+    {
+      AYM::PropertiesHelper props(*properties);
+      MetadataBuilder builder(props, TABLE_PROTRACKER2);
+      if (const auto container = Formats::Chiptune::ProTracker2::Parse(rawData, builder))
+      {
+        props.SetSource(*container);
+        props.SetPlatform(Platforms::ZX_SPECTRUM);
+        return builder.CaptureResult();
+      }
+      else
+      {
+        return {};
+      }
+    }
+  };
+
   Factory::Ptr CreateFactory()
   {
     return MakePtr<Factory>();
   }
+
+  Module::MetadataFactory::Ptr CreateMetadataFactory()
+  {
+    return MakePtr<MetadataFactory>();
+  }
 }  // namespace Module::ProTracker2
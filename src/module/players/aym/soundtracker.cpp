@@ -11,6 +11,7 @@
 // local includes
 #include "module/players/aym/soundtracker.h"
 #include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_metadata.h"
 #include "module/players/aym/aym_properties_helper.h"
 // common includes
 #include <make_ptr.h>
@@ -126,6 +127,9 @@ namespace Module::SoundTracker
     ModuleData::RWPtr Data;
   };
 
+  using MetadataBuilder = AYM::MetadataBuilder<Formats::Chiptune::SoundTracker::StubBuilder,
+                                                Formats::Chiptune::SoundTracker::Positions, OrderListWithTransposition>;
+
   class ChannelBuilder
   {
   public:
@@ -494,8 +498,41 @@ namespace Module::SoundTracker
     const Formats::Chiptune::SoundTracker::Decoder::Ptr Decoder;
   };
 
+  class MetadataFactory : public Module::MetadataFactory
+  {
+  public:
+    explicit MetadataFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {}
+
+    Information::Ptr ProbeModule(const Parameters::Accessor& /*params*/, const Binary::Container& rawData,
+                                 Parameters::Container::Ptr properties) const override
+    {
+      AYM::PropertiesHelper props(*properties);
+      MetadataBuilder builder(props, TABLE_SOUNDTRACKER);
+      if (const auto container = Decoder->Parse(rawData, builder))
+      {
+        props.SetSource(*container);
+        props.SetPlatform(Platforms::ZX_SPECTRUM);
+        return builder.CaptureResult();
+      }
+      else
+      {
+        return {};
+      }
+    }
+
+  private:
+    const Formats::Chiptune::SoundTracker::Decoder::Ptr Decoder;
+  };
+
   Factory::Ptr CreateFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(std::move(decoder));
   }
+
+  Module::MetadataFactory::Ptr CreateMetadataFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder)
+  {
+    return MakePtr<MetadataFactory>(std::move(decoder));
+  }
 }  // namespace Module::SoundTracker
@@ -14,11 +14,13 @@
 #include "module/players/aym/aym_factory.h"
 // library includes
 #include <formats/chiptune/aym/soundtracker.h>
+#include <module/players/factory.h>
 
 namespace Module
 {
   namespace SoundTracker
   {
     AYM::Factory::Ptr CreateFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder);
+    MetadataFactory::Ptr CreateMetadataFactory(Formats::Chiptune::SoundTracker::Decoder::Ptr decoder);
   }
 }  // namespace Module
@@ -11,6 +11,7 @@
 // local includes
 #include "module/players/aym/soundtrackerpro.h"
 #include "module/players/aym/aym_base_track.h"
+#include "module/players/aym/aym_metadata.h"
 #include "module/players/aym/aym_properties_helper.h"
 // common includes
 #include <make_ptr.h>
@@ -139,6 +140,10 @@ namespace Module::SoundTrackerPro
     ModuleData::RWPtr Data;
   };
 
+  using MetadataBuilder = AYM::MetadataBuilder<Formats::Chiptune::SoundTrackerPro::StubBuilder,
+                                                Formats::Chiptune::SoundTrackerPro::Positions,
+                                                OrderListWithTransposition>;
+
   struct ChannelState
   {
     ChannelState()
@@ -359,8 +364,41 @@ namespace Module::SoundTrackerPro
     const Formats::Chiptune::SoundTrackerPro::Decoder::Ptr Decoder;
   };
 
+  class MetadataFactory : public Module::MetadataFactory
+  {
+  public:
+    explicit MetadataFactory(Formats::Chiptune::SoundTrackerPro::Decoder::Ptr decoder)
+      : Decoder(std::move(decoder))
+    {}
+
+    Information::Ptr ProbeModule(const Parameters::Accessor& /*params*/, const Binary::Container& rawData,
+                                 Parameters::Container::Ptr properties) const override
+    {
+      AYM::PropertiesHelper props(*properties);
+      MetadataBuilder builder(props, TABLE_SOUNDTRACKER_PRO);
+      if (const auto container = Decoder->Parse(rawData, builder))
+      {
+        props.SetSource(*container);
+        props.SetPlatform(Platforms::ZX_SPECTRUM);
+        return builder.CaptureResult();
+      }
+      else
+      {
+        return {};
+      }
+    }
+
+  private:
+    const Formats::Chiptune::SoundTrackerPro::Decoder::Ptr Decoder;
+  };
+
   Factory::Ptr CreateFactory(Formats::Chiptune::SoundTrackerPro::Decoder::Ptr decoder)
   {
     return MakePtr<Factory>(std::move(decoder));
   }
+
+  Module::MetadataFactory::Ptr CreateMetadataFactory(Formats::Chiptune::SoundTrackerPro::Decoder::Ptr decoder)
+  {
+    return MakePtr<MetadataFactory>(std::move(decoder));
+  }
 }  // namespace Module::SoundTrackerPro
@@ -14,11 +14,13 @@
 #include "module/players/aym/aym_factory.h"
 // library includes
 #include <formats/chiptune/aym/soundtrackerpro.h>
+#include <module/players/factory.h>
 
 namespace Module
 {
   namespace SoundTrackerPro
   {
     AYM::Factory::Ptr CreateFactory(Formats::Chiptune::SoundTrackerPro::Decoder::Ptr decoder);
+    MetadataFactory::Ptr CreateMetadataFactory(Formats::Chiptune::SoundTrackerPro::Decoder::Ptr decoder);
   }
 }  // namespace Module
@@ -403,9 +403,7 @@ namespace Module::SQTracker
     static SingleChannelPatternsBuilder Create()
     {
       typedef MultichannelMutableLine<1> LineType;
-      typedef SparsedMutablePattern<LineType> PatternType;
-      typedef SparsedMutablePatternsSet<PatternType> PatternsSetType;
-      return SingleChannelPatternsBuilder(MakePtr<PatternsSetType>());
+      return SingleChannelPatternsBuilder(MakePtr<ArenaMutablePatternsSet<LineType>>());
     }
   };
 
@@ -268,7 +268,7 @@ namespace Module::TurboSound
     const AYM::DataIterator::Ptr Second;
   };
 
-  class Renderer : public Module::Renderer
+  class Renderer : public Module::BufferRenderer
   {
   public:
     Renderer(Time::Microseconds frameDuration, DataIterator::Ptr iterator, Devices::TurboSound::Chip::Ptr device)
@@ -294,6 +294,19 @@ namespace Module::TurboSound
       return Device->RenderTill(LastChunk.TimeStamp);
     }
 
+    void Render(const Sound::LoopParameters& looped, Sound::Chunk& target) override
+    {
+      if (!Iterator->IsValid())
+      {
+        target.clear();
+        return;
+      }
+      TransferChunk();
+      Iterator->NextFrame(looped);
+      LastChunk.TimeStamp += FrameDuration;
+      Device->RenderTill(LastChunk.TimeStamp, target);
+    }
+
     void Reset() override
     {
       Iterator->Reset();
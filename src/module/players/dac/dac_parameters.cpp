@@ -44,11 +44,20 @@ namespace Module
         return Samplerate;
       }
 
-      bool Interpolate() const override
+      Devices::DAC::InterpolationType Interpolation() const override
       {
-        Parameters::IntType intVal = Parameters::ZXTune::Core::DAC::INTERPOLATION_DEFAULT;
-        Params->FindValue(Parameters::ZXTune::Core::DAC::INTERPOLATION, intVal);
-        return intVal != 0;
+        using namespace Parameters::ZXTune::Core::DAC;
+        Parameters::IntType intVal = INTERPOLATION_DEFAULT;
+        Params->FindValue(INTERPOLATION, intVal);
+        switch (intVal)
+        {
+        case INTERPOLATION_NO:
+          return Devices::DAC::INTERPOLATION_NONE;
+        case INTERPOLATION_HQ:
+          return Devices::DAC::INTERPOLATION_HQ;
+        default:
+          return Devices::DAC::INTERPOLATION_LQ;
+        }
       }
 
     private:
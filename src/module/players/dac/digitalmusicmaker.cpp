@@ -72,6 +72,7 @@ namespace Module::DigitalMusicMaker
 
     ModuleData()
       : DAC::SimpleModuleData(CHANNELS_COUNT)
+      , Mixes(MIXES_COUNT, MixedChannel(MixinCommands))
     {}
 
     struct MixedChannel
@@ -79,12 +80,17 @@ namespace Module::DigitalMusicMaker
       MutableCell Mixin;
       uint_t Period;
 
-      MixedChannel()
-        : Period()
+      explicit MixedChannel(CommandsPool& commands)
+        : Mixin(commands)
+        , Period()
       {}
     };
 
-    std::array<MixedChannel, 64> Mixes;
+    static const std::size_t MIXES_COUNT = 64;
+
+    // mixins are not a part of patterns set, so they use own commands storage
+    CommandsPool MixinCommands;
+    std::vector<MixedChannel> Mixes;
   };
 
   class ChannelBuilder : public Formats::Chiptune::DigitalMusicMaker::ChannelBuilder
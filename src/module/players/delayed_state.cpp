@@ -0,0 +1,98 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Delayed state support implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// common includes
+#include <make_ptr.h>
+// library includes
+#include <module/players/delayed_state.h>
+#include <module/track_state.h>
+
+namespace Module
+{
+  template<class Base>
+  class DelayedStateBase : public Base
+  {
+  public:
+    DelayedStateBase(std::shared_ptr<const Base> delegate, StateDelay::Ptr delay)
+      : Delegate(std::move(delegate))
+      , Delay(std::move(delay))
+    {}
+
+    Time::AtMillisecond At() const override
+    {
+      const auto pos = Delegate->At().Get();
+      const auto delay = Delay->Get().Get();
+      return Time::AtMillisecond(pos > delay ? pos - delay : 0);
+    }
+
+    Time::Milliseconds Total() const override
+    {
+      const auto total = Delegate->Total().Get();
+      const auto delay = Delay->Get().Get();
+      return Time::Milliseconds(total > delay ? total - delay : 0);
+    }
+
+    uint_t LoopCount() const override
+    {
+      return Delegate->LoopCount();
+    }
+
+  protected:
+    const std::shared_ptr<const Base> Delegate;
+    const StateDelay::Ptr Delay;
+  };
+
+  using DelayedState = DelayedStateBase<State>;
+
+  class DelayedTrackState : public DelayedStateBase<TrackState>
+  {
+  public:
+    using DelayedStateBase::DelayedStateBase;
+
+    uint_t Position() const override
+    {
+      return Delegate->Position();
+    }
+
+    uint_t Pattern() const override
+    {
+      return Delegate->Pattern();
+    }
+
+    uint_t Line() const override
+    {
+      return Delegate->Line();
+    }
+
+    uint_t Tempo() const override
+    {
+      return Delegate->Tempo();
+    }
+
+    uint_t Quirk() const override
+    {
+      return Delegate->Quirk();
+    }
+
+    uint_t Channels() const override
+    {
+      return Delegate->Channels();
+    }
+  };
+
+  State::Ptr CreateDelayedState(State::Ptr state, StateDelay::Ptr delay)
+  {
+    if (auto track = std::dynamic_pointer_cast<const TrackState>(state))
+    {
+      return MakePtr<DelayedTrackState>(std::move(track), std::move(delay));
+    }
+    return MakePtr<DelayedState>(std::move(state), std::move(delay));
+  }
+}  // namespace Module
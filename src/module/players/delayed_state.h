@@ -0,0 +1,33 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Delayed state support
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// library includes
+#include <module/state.h>
+
+namespace Module
+{
+  //! @brief Amount of sound already rendered but not heard yet
+  class StateDelay
+  {
+  public:
+    //! Pointer type
+    typedef std::shared_ptr<const StateDelay> Ptr;
+
+    virtual ~StateDelay() = default;
+
+    virtual Time::Milliseconds Get() const = 0;
+  };
+
+  //! @brief Creates wrapper reporting position of the sound being heard
+  //! @note Tracking properties of Module::TrackState are not compensated
+  State::Ptr CreateDelayedState(State::Ptr state, StateDelay::Ptr delay);
+}  // namespace Module
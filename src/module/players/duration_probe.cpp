@@ -0,0 +1,282 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Duration probing implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// local includes
+#include "module/players/duration_probe.h"
+// common includes
+#include <make_ptr.h>
+// library includes
+#include <core/core_parameters.h>
+#include <debug/log.h>
+#include <module/attributes.h>
+#include <parameters/container.h>
+#include <parameters/merged_accessor.h>
+#include <sound/loop.h>
+#include <sound/render_params.h>
+// std includes
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Module::DurationProbe
+{
+  const Debug::Stream Dbg("Module::DurationProbe");
+
+  /*
+    Sound is analyzed by 100ms blocks. Each block is reduced to mono peak (for silence detection) and coarse average
+    level (for loop detection).
+  */
+  const uint_t BLOCKS_PER_SECOND = 10;
+  const uint_t SILENCE_LEVEL = Sound::Sample::MAX / 256;
+  const uint_t LEVEL_QUANTIZATION_SHIFT = 9;
+
+  // Minimal trailing silence duration
+  const std::size_t SILENCE_BLOCKS = 5 * BLOCKS_PER_SECOND;
+  // Minimal repeated fragment duration and the minimal loop period
+  const std::size_t LOOP_BLOCKS = 30 * BLOCKS_PER_SECOND;
+  // Fragments without enough level changes (e.g. sustained tones) are not taken into account
+  const std::size_t LOOP_MIN_CHANGES = LOOP_BLOCKS / 10;
+
+  class DurationDetector
+  {
+  public:
+    explicit DurationDetector(uint_t samplerate)
+      : SamplesPerBlock(samplerate / BLOCKS_PER_SECOND)
+    {
+      for (std::size_t idx = 0; idx < LOOP_BLOCKS; ++idx)
+      {
+        HashPower *= HASH_BASE;
+      }
+    }
+
+    void Feed(const Sound::Chunk& chunk)
+    {
+      static_assert(Sound::Sample::MID == 0, "Incompatible sample type");
+      for (const auto smp : chunk)
+      {
+        const uint_t level = std::abs(smp.Left() + smp.Right()) / 2;
+        Peak = std::max(Peak, level);
+        Sum += level;
+        if (++Samples == SamplesPerBlock)
+        {
+          AddBlock(Peak, (Sum / SamplesPerBlock) >> LEVEL_QUANTIZATION_SHIFT);
+          Peak = Sum = Samples = 0;
+          if (IsDetected())
+          {
+            break;
+          }
+        }
+      }
+    }
+
+    bool IsDetected() const
+    {
+      return Result != NOT_DETECTED;
+    }
+
+    Time::Milliseconds GetResult() const
+    {
+      return IsDetected() ? Time::Milliseconds(Result * 1000 / BLOCKS_PER_SECOND) : Time::Milliseconds();
+    }
+
+  private:
+    void AddBlock(uint_t peak, uint_t level)
+    {
+      const auto idx = Levels.size();
+      Changes += !Levels.empty() && Levels.back() != level;
+      Levels.push_back(static_cast<uint8_t>(std::min<uint_t>(level, std::numeric_limits<uint8_t>::max())));
+      CheckSilence(idx, peak < SILENCE_LEVEL);
+      if (!IsDetected())
+      {
+        CheckLoop();
+      }
+    }
+
+    void CheckSilence(std::size_t idx, bool silent)
+    {
+      if (!silent)
+      {
+        SilenceStart = NOT_DETECTED;
+      }
+      else if (SilenceStart == NOT_DETECTED)
+      {
+        SilenceStart = idx;
+      }
+      // leading silence does not mean end of tune
+      else if (SilenceStart != 0 && idx + 1 - SilenceStart >= SILENCE_BLOCKS)
+      {
+        Dbg("Silence detected at %1% block", SilenceStart);
+        Result = SilenceStart;
+      }
+    }
+
+    // Rolling hash of the latest LOOP_BLOCKS levels compared to all the previous non-overlapping fragments
+    void CheckLoop()
+    {
+      const auto size = Levels.size();
+      Hash = Hash * HASH_BASE + Levels.back();
+      if (size <= LOOP_BLOCKS)
+      {
+        Hashes.push_back(Hash);
+        return;
+      }
+      const auto removed = size - 1 - LOOP_BLOCKS;
+      Hash -= HashPower * Levels[removed];
+      Changes -= Levels[removed] != Levels[removed + 1];
+      Hashes.push_back(Hash);
+      // register fragment ending exactly one fragment size ago
+      const auto prevEnd = size - 1 - LOOP_BLOCKS;
+      if (prevEnd + 1 >= LOOP_BLOCKS)
+      {
+        Fragments.emplace(Hashes[prevEnd], prevEnd);
+      }
+      if (Changes < LOOP_MIN_CHANGES)
+      {
+        return;
+      }
+      const auto range = Fragments.equal_range(Hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        auto first = it->second + 1 - LOOP_BLOCKS;
+        auto second = size - LOOP_BLOCKS;
+        if (std::equal(Levels.begin() + first, Levels.begin() + first + LOOP_BLOCKS, Levels.begin() + second))
+        {
+          // extend repeated part backward to find out start of the first repetition
+          while (first != 0 && Levels[first - 1] == Levels[second - 1])
+          {
+            --first;
+            --second;
+          }
+          Dbg("Loop detected at %1% block (repeated from %2%)", second, first);
+          Result = second;
+          return;
+        }
+      }
+    }
+
+  private:
+    static const std::size_t NOT_DETECTED = ~std::size_t(0);
+    static const uint64_t HASH_BASE = 1000003;
+
+    const uint_t SamplesPerBlock;
+    // current block
+    uint_t Peak = 0;
+    uint_t Sum = 0;
+    uint_t Samples = 0;
+    // per-block data
+    std::vector<uint8_t> Levels;
+    std::vector<uint64_t> Hashes;
+    std::unordered_multimap<uint64_t, std::size_t> Fragments;
+    uint64_t HashPower = 1;
+    uint64_t Hash = 0;
+    std::size_t Changes = 0;
+    std::size_t SilenceStart = NOT_DETECTED;
+    std::size_t Result = NOT_DETECTED;
+  };
+
+  Parameters::Accessor::Ptr CreateProbeParameters(Parameters::Accessor::Ptr params)
+  {
+    using namespace Parameters::ZXTune::Core;
+    auto overrides = Parameters::Container::Create();
+    overrides->SetValue(AYM::INTERPOLATION, AYM::INTERPOLATION_NONE);
+    overrides->SetValue(DAC::INTERPOLATION, DAC::INTERPOLATION_NO);
+    overrides->SetValue(SAA::INTERPOLATION, SAA::INTERPOLATION_NONE);
+    overrides->SetValue(SID::INTERPOLATION, SID::INTERPOLATION_NONE);
+    return Parameters::CreateMergedAccessor(std::move(overrides), std::move(params));
+  }
+
+  class ProbedInformation : public Information
+  {
+  public:
+    ProbedInformation(Information::Ptr delegate, Time::Milliseconds duration)
+      : Delegate(std::move(delegate))
+      , Probed(duration)
+    {}
+
+    Time::Milliseconds Duration() const override
+    {
+      return Probed;
+    }
+
+    Time::Milliseconds LoopDuration() const override
+    {
+      return std::min(Delegate->LoopDuration(), Probed);
+    }
+
+  private:
+    const Information::Ptr Delegate;
+    const Time::Milliseconds Probed;
+  };
+
+  class ProbedHolder : public Holder
+  {
+  public:
+    ProbedHolder(Holder::Ptr delegate, Time::Milliseconds duration)
+      : Delegate(std::move(delegate))
+      , Probed(duration)
+      , Properties(Parameters::Container::Create())
+    {
+      Properties->SetValue(ATTR_DURATION, Probed.Get());
+    }
+
+    Information::Ptr GetModuleInformation() const override
+    {
+      return MakePtr<ProbedInformation>(Delegate->GetModuleInformation(), Probed);
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Parameters::CreateMergedAccessor(Properties, Delegate->GetModuleProperties());
+    }
+
+    Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr params) const override
+    {
+      return Delegate->CreateRenderer(samplerate, std::move(params));
+    }
+
+  private:
+    const Holder::Ptr Delegate;
+    const Time::Milliseconds Probed;
+    const Parameters::Container::Ptr Properties;
+  };
+}  // namespace Module::DurationProbe
+
+namespace Module
+{
+  Time::Milliseconds ProbeDuration(const Holder& holder, Parameters::Accessor::Ptr params)
+  {
+    using namespace DurationProbe;
+    // default output frequency is native for resampling cores like ASAP or PSF, so no extra resampling is performed
+    const auto samplerate = Sound::GetSoundFrequency(*params);
+    const auto renderer = holder.CreateRenderer(samplerate, CreateProbeParameters(std::move(params)));
+    const Sound::LoopParameters noLoop;
+    DurationDetector detector(samplerate);
+    while (!detector.IsDetected())
+    {
+      const auto chunk = renderer->Render(noLoop);
+      if (chunk.empty())
+      {
+        break;
+      }
+      detector.Feed(chunk);
+    }
+    return detector.GetResult();
+  }
+
+  Holder::Ptr StoreProbedDuration(Holder::Ptr holder, Parameters::Accessor::Ptr params)
+  {
+    if (const auto duration = ProbeDuration(*holder, std::move(params)))
+    {
+      return MakePtr<DurationProbe::ProbedHolder>(std::move(holder), duration);
+    }
+    return holder;
+  }
+}  // namespace Module
@@ -0,0 +1,31 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Duration probing
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// library includes
+#include <module/holder.h>
+#include <time/duration.h>
+
+namespace Module
+{
+  //! @brief Renders module as fast as possible using reduced quality to find out actual playback duration
+  //! @param holder Module to probe. Rendering is limited by its own duration, so module should be opened with big
+  //!        enough default duration (@see Parameters::ZXTune::Core::Plugins::DEFAULT_DURATION)
+  //! @param params Rendering parameters. Sound frequency is taken from them (@see Sound::GetSoundFrequency)
+  //! @return Position of trailing silence or repeated part start, empty value if nothing detected
+  //! @note Thread-safe for different holders
+  Time::Milliseconds ProbeDuration(const Holder& holder, Parameters::Accessor::Ptr params);
+
+  //! @brief Probes duration and stores result for later use
+  //! @return Holder reporting probed duration via information and ATTR_DURATION property, source holder if nothing
+  //!         detected
+  Holder::Ptr StoreProbedDuration(Holder::Ptr holder, Parameters::Accessor::Ptr params);
+}  // namespace Module
@@ -26,4 +26,17 @@ namespace Module
     virtual Holder::Ptr CreateModule(const Parameters::Accessor& params, const Binary::Container& data,
                                      Parameters::Container::Ptr properties) const = 0;
   };
+
+  //! @brief Optional factory extension used to get properties and duration of module without building playable model
+  class MetadataFactory
+  {
+  public:
+    typedef std::shared_ptr<const MetadataFactory> Ptr;
+    virtual ~MetadataFactory() = default;
+
+    //! @brief Fills properties the same way as Factory::CreateModule does
+    //! @return Empty pointer if data is not valid module
+    virtual Information::Ptr ProbeModule(const Parameters::Accessor& params, const Binary::Container& data,
+                                         Parameters::Container::Ptr properties) const = 0;
+  };
 }  // namespace Module
@@ -14,13 +14,16 @@
 #include <debug/log.h>
 #include <module/holder.h>
 #include <module/players/pipeline.h>
+#include <module/track_state.h>
 #include <parameters/merged_accessor.h>
+#include <parameters/snapshot.h>
 #include <parameters/tracking_helper.h>
 #include <sound/gainer.h>
 #include <sound/render_params.h>
 #include <sound/sound_parameters.h>
 // std includes
 #include <algorithm>
+#include <atomic>
 
 namespace Module
 {
@@ -133,16 +136,180 @@ namespace Module
     Sound::Sample LastSample;
   };
 
-  class PipelinedRenderer : public Renderer
+  // Samples rendered but not delivered yet
+  struct PendingSound
+  {
+    using Ptr = std::shared_ptr<PendingSound>;
+
+    explicit PendingSound(uint_t samplerate)
+      : Samplerate(samplerate)
+    {}
+
+    uint_t GetDuration() const
+    {
+      return static_cast<uint_t>(uint64_t(Samples) * Time::Milliseconds::PER_SECOND / Samplerate);
+    }
+
+    const uint_t Samplerate;
+    std::atomic<std::size_t> Samples = {0};
+  };
+
+  // Position of the delivered sound
+  template<class Base>
+  class DeliveredStateBase : public Base
+  {
+  public:
+    DeliveredStateBase(std::shared_ptr<const Base> delegate, PendingSound::Ptr pending)
+      : Delegate(std::move(delegate))
+      , Pending(std::move(pending))
+    {}
+
+    Time::AtMillisecond At() const override
+    {
+      const auto pos = Delegate->At().Get();
+      const auto pending = Pending->GetDuration();
+      return Time::AtMillisecond(pos > pending ? pos - pending : 0);
+    }
+
+    Time::Milliseconds Total() const override
+    {
+      const auto total = Delegate->Total().Get();
+      const auto pending = Pending->GetDuration();
+      return Time::Milliseconds(total > pending ? total - pending : 0);
+    }
+
+    uint_t LoopCount() const override
+    {
+      return Delegate->LoopCount();
+    }
+
+  protected:
+    const std::shared_ptr<const Base> Delegate;
+    const PendingSound::Ptr Pending;
+  };
+
+  using DeliveredState = DeliveredStateBase<State>;
+
+  // tracking properties are not compensated
+  class DeliveredTrackState : public DeliveredStateBase<TrackState>
   {
   public:
-    PipelinedRenderer(const Holder& holder, uint_t samplerate, Parameters::Accessor::Ptr params)
+    using DeliveredStateBase::DeliveredStateBase;
+
+    uint_t Position() const override
+    {
+      return Delegate->Position();
+    }
+
+    uint_t Pattern() const override
+    {
+      return Delegate->Pattern();
+    }
+
+    uint_t Line() const override
+    {
+      return Delegate->Line();
+    }
+
+    uint_t Tempo() const override
+    {
+      return Delegate->Tempo();
+    }
+
+    uint_t Quirk() const override
+    {
+      return Delegate->Quirk();
+    }
+
+    uint_t Channels() const override
+    {
+      return Delegate->Channels();
+    }
+  };
+
+  State::Ptr CreateDeliveredState(State::Ptr state, PendingSound::Ptr pending)
+  {
+    if (auto track = std::dynamic_pointer_cast<const TrackState>(state))
+    {
+      return MakePtr<DeliveredTrackState>(std::move(track), std::move(pending));
+    }
+    return MakePtr<DeliveredState>(std::move(state), std::move(pending));
+  }
+
+  // Rest of partially consumed frame
+  class PendingFrame
+  {
+  public:
+    explicit PendingFrame(PendingSound::Ptr pending)
+      : Pending(std::move(pending))
+    {}
+
+    bool IsEmpty() const
+    {
+      return Position == Data.size();
+    }
+
+    //! @return buffer for the next frame, memory of the previous one is reused
+    Sound::Chunk& Prepare()
+    {
+      Reset();
+      return Data;
+    }
+
+    void Commit()
+    {
+      Pending->Samples = Data.size();
+    }
+
+    std::size_t Get(Sound::Sample* target, std::size_t samples)
+    {
+      const auto toCopy = std::min(samples, Data.size() - Position);
+      std::copy_n(Data.data() + Position, toCopy, target);
+      Position += toCopy;
+      Pending->Samples -= toCopy;
+      return toCopy;
+    }
+
+    Sound::Chunk Capture()
+    {
+      if (Position != 0)
+      {
+        const auto rest = Data.size() - Position;
+        std::copy_n(Data.data() + Position, rest, Data.data());
+        Data.resize(rest);
+      }
+      auto result = std::move(Data);
+      Reset();
+      return result;
+    }
+
+    void Reset()
+    {
+      Data.clear();
+      Position = 0;
+      Pending->Samples = 0;
+    }
+
+  private:
+    const PendingSound::Ptr Pending;
+    Sound::Chunk Data;
+    std::size_t Position = 0;
+  };
+
+  class PipelinedRendererImpl : public PipelinedRenderer
+  {
+  public:
+    PipelinedRendererImpl(const Holder& holder, uint_t samplerate, Parameters::Accessor::Ptr params)
       : Delegate(holder.CreateRenderer(samplerate, params))
-      , State(Delegate->GetState())
+      , BufferDelegate(dynamic_cast<BufferRenderer*>(Delegate.get()))
+      , Tracking(Delegate->GetState())
       , Params(std::move(params))
       , Fading(FadeInfo::Create(holder.GetModuleInformation()->Duration(), *Params))
       , Gainer(Sound::CreateGainer())
       , Silence(SilenceDetector::Create(samplerate, *Params))
+      , Pending(MakePtr<PendingSound>(samplerate))
+      , Rest(Pending)
+      , State(CreateDeliveredState(Tracking, Pending))
     {}
 
     Module::State::Ptr GetState() const override
@@ -152,14 +319,32 @@ namespace Module
 
     Sound::Chunk Render(const Sound::LoopParameters& loop) override
     {
-      auto data = Delegate->Render(loop);
-      if (Silence.Detected(data))
+      if (!Rest.IsEmpty())
       {
-        return {};
+        return Rest.Capture();
       }
-      // Apply fading at post-rendering position to avoid absolute silence at the beginning
-      Gainer->SetGain(CalculateGain(loop));
-      return Gainer->Apply(std::move(data));
+      Sound::Chunk result;
+      RenderFrame(loop, result);
+      return result;
+    }
+
+    std::size_t Render(const Sound::LoopParameters& loop, Sound::Sample* target, std::size_t samples) override
+    {
+      std::size_t done = 0;
+      while (done < samples)
+      {
+        if (Rest.IsEmpty())
+        {
+          RenderFrame(loop, Rest.Prepare());
+          Rest.Commit();
+          if (Rest.IsEmpty())
+          {
+            break;
+          }
+        }
+        done += Rest.Get(target + done, samples - done);
+      }
+      return done;
     }
 
     void Reset() override
@@ -167,15 +352,38 @@ namespace Module
       Delegate->Reset();
       Params.Reset();
       Silence.Reset();
+      Rest.Reset();
     }
 
     void SetPosition(Time::AtMillisecond position) override
     {
       Silence.Reset();
+      Rest.Reset();
       Delegate->SetPosition(position);
     }
 
   private:
+    // target is empty if there's no more data
+    void RenderFrame(const Sound::LoopParameters& loop, Sound::Chunk& target)
+    {
+      if (BufferDelegate)
+      {
+        BufferDelegate->Render(loop, target);
+      }
+      else
+      {
+        target = Delegate->Render(loop);
+      }
+      if (Silence.Detected(target))
+      {
+        target.clear();
+        return;
+      }
+      // Apply fading at post-rendering position to avoid absolute silence at the beginning
+      Gainer->SetGain(CalculateGain(loop));
+      target = Gainer->Apply(std::move(target));
+    }
+
     Sound::Gain::Type CalculateGain(const Sound::LoopParameters& loop)
     {
       if (Params.IsChanged())
@@ -190,8 +398,8 @@ namespace Module
       {
         return Preamp;
       }
-      const auto pos = State->At();
-      if (Fading.IsFadein(pos) && !State->LoopCount())
+      const auto pos = Tracking->At();
+      if (Fading.IsFadein(pos) && !Tracking->LoopCount())
       {
         return Fading.GetFadein(Preamp, pos);
       }
@@ -207,23 +415,30 @@ namespace Module
 
   private:
     const Renderer::Ptr Delegate;
-    const Module::State::Ptr State;
+    BufferRenderer* const BufferDelegate;
+    const Module::State::Ptr Tracking;
     Parameters::TrackingHelper<Parameters::Accessor> Params;
     const FadeInfo Fading;
     const Sound::Gainer::Ptr Gainer;
     SilenceDetector Silence;
     Sound::Gain::Type Preamp;
+    const PendingSound::Ptr Pending;
+    PendingFrame Rest;
+    const Module::State::Ptr State;
   };
 
-  Renderer::Ptr CreatePipelinedRenderer(const Holder& holder, Parameters::Accessor::Ptr globalParams)
+  PipelinedRenderer::Ptr CreatePipelinedRenderer(const Holder& holder, Parameters::Accessor::Ptr globalParams)
   {
     const auto samplerate = Sound::GetSoundFrequency(*globalParams);
     return CreatePipelinedRenderer(holder, samplerate, std::move(globalParams));
   }
 
-  Renderer::Ptr CreatePipelinedRenderer(const Holder& holder, uint_t samplerate, Parameters::Accessor::Ptr globalParams)
+  PipelinedRenderer::Ptr CreatePipelinedRenderer(const Holder& holder, uint_t samplerate,
+                                                 Parameters::Accessor::Ptr globalParams)
   {
-    auto props = Parameters::CreateMergedAccessor(holder.GetModuleProperties(), std::move(globalParams));
-    return MakePtr<PipelinedRenderer>(holder, samplerate, std::move(props));
+    // renderer and underlying chips lookup a lot of values through the chain
+    auto props = Parameters::CreateSnapshotAccessor(
+        Parameters::CreateMergedAccessor(holder.GetModuleProperties(), std::move(globalParams)));
+    return MakePtr<PipelinedRendererImpl>(holder, samplerate, std::move(props));
   }
 }  // namespace Module
@@ -18,6 +18,23 @@ namespace Module
 {
   class Holder;
 
+  //! @brief %Renderer with additional pull-mode interface
+  class PipelinedRenderer : public Renderer
+  {
+  public:
+    //! @brief Generic pointer type
+    using Ptr = std::shared_ptr<PipelinedRenderer>;
+
+    using Renderer::Render;
+
+    //! @brief Rendering exactly specified samples count directly into caller's memory crossing frames boundaries
+    //! @return count of rendered samples, less than requested only if there's no more data to render
+    //! @note Rest of the last rendered frame is kept and returned first by subsequent rendering calls of any kind
+    //! @note State reports position of the delivered sound, not including the kept rest
+    //! @note Frames are rendered into internal buffer reusing its memory if delegate is Module::BufferRenderer
+    virtual std::size_t Render(const Sound::LoopParameters& looped, Sound::Sample* target, std::size_t samples) = 0;
+  };
+
   /* Creates wrapper that applies:
    - gain
    - fadein/fadeout
@@ -26,8 +43,8 @@ namespace Module
    Samplerate is taken from globalParams.
    Other properties are taken from holder.Parameters, globalParams in specified order
   */
-  Renderer::Ptr CreatePipelinedRenderer(const Holder& holder, Parameters::Accessor::Ptr globalParams);
+  PipelinedRenderer::Ptr CreatePipelinedRenderer(const Holder& holder, Parameters::Accessor::Ptr globalParams);
 
-  Renderer::Ptr CreatePipelinedRenderer(const Holder& holder, uint_t samplerate,
-                                        Parameters::Accessor::Ptr globalParams);
+  PipelinedRenderer::Ptr CreatePipelinedRenderer(const Holder& holder, uint_t samplerate,
+                                                 Parameters::Accessor::Ptr globalParams);
 }  // namespace Module
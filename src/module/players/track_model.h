@@ -15,8 +15,6 @@
 #include <types.h>
 // library includes
 #include <module/track_state.h>
-// std includes
-#include <vector>
 
 namespace Module
 {
@@ -47,9 +45,9 @@ namespace Module
     int_t Param3;
   };
 
-  typedef std::vector<Command> CommandsArray;
-  typedef RangeIterator<CommandsArray::const_iterator> CommandsIterator;
+  typedef RangeIterator<const Command*> CommandsIterator;
 
+  //! @brief Channel's data in line. Commands are stored outside in the storage owned by patterns set
   class Cell
   {
   public:
@@ -60,12 +58,13 @@ namespace Module
       , SampleNum()
       , OrnamentNum()
       , Volume()
+      , CommandsCount()
       , Commands()
     {}
 
     bool HasData() const
     {
-      return 0 != Mask || !Commands.empty();
+      return 0 != Mask || 0 != CommandsCount;
     }
 
     const bool* GetEnabled() const
@@ -95,7 +94,7 @@ namespace Module
 
     CommandsIterator GetCommands() const
     {
-      return CommandsIterator(Commands.begin(), Commands.end());
+      return CommandsIterator(Commands, Commands + CommandsCount);
     }
 
   protected:
@@ -108,13 +107,14 @@ namespace Module
       VOLUME = 16
     };
 
-    uint_t Mask;
+    uint8_t Mask;
     bool Enabled;
     uint_t Note;
     uint_t SampleNum;
     uint_t OrnamentNum;
     uint_t Volume;
-    CommandsArray Commands;
+    uint_t CommandsCount;
+    Command* Commands;
   };
 
   class Line
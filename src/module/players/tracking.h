@@ -22,12 +22,92 @@
 // std includes
 #include <algorithm>
 #include <array>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace Module
 {
+  //! @brief Blocks-based storage for objects with stable addresses
+  template<class T>
+  class ObjectsArena
+  {
+  public:
+    ObjectsArena() = default;
+    ObjectsArena(const ObjectsArena&) = delete;
+    ObjectsArena& operator=(const ObjectsArena&) = delete;
+
+    template<class... Args>
+    T& Add(Args&&... args)
+    {
+      if (Blocks.empty() || Blocks.back().size() == Blocks.back().capacity())
+      {
+        Blocks.emplace_back();
+        Blocks.back().reserve(NextBlockSize);
+        NextBlockSize = std::min(NextBlockSize * 2, MAX_BLOCK_SIZE);
+      }
+      return Blocks.back().emplace_back(std::forward<Args>(args)...);
+    }
+
+  private:
+    static const std::size_t MIN_BLOCK_SIZE = 16;
+    static const std::size_t MAX_BLOCK_SIZE = 256;
+    // blocks are never reallocated after reservation
+    std::vector<std::vector<T>> Blocks;
+    std::size_t NextBlockSize = MIN_BLOCK_SIZE;
+  };
+
+  //! @brief Commands storage shared by all the cells of patterns set
+  class CommandsPool
+  {
+  public:
+    CommandsPool() = default;
+    CommandsPool(const CommandsPool&) = delete;
+    CommandsPool& operator=(const CommandsPool&) = delete;
+
+    //! @brief Appends command to the range keeping it contiguous
+    //! @return New range start. Range is relocated to the free space if there's no room right after it
+    Command* Append(Command* first, uint_t count, const Command& cmd)
+    {
+      if (first + count != Free || Free == Limit)
+      {
+        if (static_cast<std::size_t>(Limit - Free) <= count)
+        {
+          AllocateBlock(count + 1);
+        }
+        first = std::copy(first, first + count, Free) - count;
+        Free = first + count;
+      }
+      *Free++ = cmd;
+      return first;
+    }
+
+  private:
+    void AllocateBlock(std::size_t minSize)
+    {
+      const auto size = std::max(minSize, NextBlockSize);
+      NextBlockSize = std::min(NextBlockSize * 2, MAX_BLOCK_SIZE);
+      Blocks.emplace_back(new Command[size]);
+      Free = Blocks.back().get();
+      Limit = Free + size;
+    }
+
+  private:
+    static const std::size_t MIN_BLOCK_SIZE = 64;
+    static const std::size_t MAX_BLOCK_SIZE = 4096;
+    std::vector<std::unique_ptr<Command[]>> Blocks;
+    std::size_t NextBlockSize = MIN_BLOCK_SIZE;
+    Command* Free = nullptr;
+    Command* Limit = nullptr;
+  };
+
   class MutableCell : public Cell
   {
   public:
+    explicit MutableCell(CommandsPool& pool)
+      : Pool(&pool)
+    {}
+
     void SetEnabled(bool val)
     {
       Mask |= ENABLED;
@@ -60,14 +140,19 @@ namespace Module
 
     void AddCommand(uint_t type, int_t p1 = 0, int_t p2 = 0, int_t p3 = 0)
     {
-      Commands.push_back(Command(type, p1, p2, p3));
+      Commands = Pool->Append(Commands, CommandsCount, Command(type, p1, p2, p3));
+      ++CommandsCount;
     }
 
     Command* FindCommand(uint_t type)
     {
-      const CommandsArray::iterator it = std::find(Commands.begin(), Commands.end(), type);
-      return it != Commands.end() ? &*it : nullptr;
+      Command* const end = Commands + CommandsCount;
+      Command* const it = std::find(Commands, end, type);
+      return it != end ? it : nullptr;
     }
+
+  private:
+    CommandsPool* Pool;
   };
 
   class MutableLine : public Line
@@ -100,8 +185,9 @@ namespace Module
   class MultichannelMutableLine : public MutableLine
   {
   public:
-    MultichannelMutableLine()
+    explicit MultichannelMutableLine(CommandsPool& commands)
       : Tempo()
+      , Channels(MakeChannels(commands, std::make_index_sequence<ChannelsCount>()))
     {}
 
     const Cell* GetChannel(uint_t idx) const override
@@ -131,8 +217,16 @@ namespace Module
     }
 
   private:
-    uint_t Tempo;
     typedef std::array<MutableCell, ChannelsCount> ChannelsArray;
+
+    template<std::size_t... Idx>
+    static ChannelsArray MakeChannels(CommandsPool& commands, std::index_sequence<Idx...>)
+    {
+      return {{(static_cast<void>(Idx), MutableCell(commands))...}};
+    }
+
+  private:
+    uint_t Tempo;
     ChannelsArray Channels;
   };
 
@@ -178,62 +272,79 @@ namespace Module
   };
 
   template<class MutableLineType>
-  class SparsedMutablePattern : public MutablePattern
+  class ArenaMutablePattern : public MutablePattern
   {
   public:
+    ArenaMutablePattern(ObjectsArena<MutableLineType>& lines, CommandsPool& commands)
+      : Lines(lines)
+      , Commands(commands)
+    {}
+
     const Line* GetLine(uint_t row) const override
     {
-      return Storage.Get(row).get();
+      return row < Rows.size() ? Rows[row] : nullptr;
     }
 
     uint_t GetSize() const override
     {
-      return Storage.Size();
+      return Rows.size();
     }
 
     MutableLine& AddLine(uint_t row) override
     {
-      return *Storage.Add(row, MakePtr<MutableLineType>());
+      if (row >= Rows.size())
+      {
+        Rows.resize(row + 1);
+      }
+      return *(Rows[row] = &Lines.Add(Commands));
     }
 
     void SetSize(uint_t newSize) override
     {
-      Storage.Resize(newSize);
+      // truncated lines are just unreferenced, memory is owned by arena
+      Rows.resize(newSize);
     }
 
   private:
-    SparsedObjectsStorage<MutableLine::Ptr> Storage;
+    ObjectsArena<MutableLineType>& Lines;
+    CommandsPool& Commands;
+    std::vector<MutableLineType*> Rows;
   };
 
-  template<class MutablePatternType>
-  class SparsedMutablePatternsSet : public MutablePatternsSet
+  /*
+    All the lines, patterns and commands are allocated by blocks owned by patterns set, so building of module
+    does not require allocation per each object and neighbour lines are close to each other during playback.
+  */
+  template<class MutableLineType>
+  class ArenaMutablePatternsSet : public MutablePatternsSet
   {
   public:
     const class Pattern* Get(uint_t idx) const override
     {
-      return Storage.Get(idx).get();
+      return idx < Slots.size() ? Slots[idx] : nullptr;
     }
 
     uint_t GetSize() const override
     {
-      uint_t res = 0;
-      for (uint_t idx = 0; idx != Storage.Size(); ++idx)
-      {
-        if (const auto pat = Storage.Get(idx).get())
-        {
-          res += pat->GetSize() != 0;
-        }
-      }
-      return res;
+      return static_cast<uint_t>(
+          std::count_if(Slots.begin(), Slots.end(), [](const PatternType* pat) { return pat && pat->GetSize(); }));
     }
 
     MutablePattern& AddPattern(uint_t idx) override
     {
-      return *Storage.Add(idx, MakePtr<MutablePatternType>());
+      if (idx >= Slots.size())
+      {
+        Slots.resize(idx + 1);
+      }
+      return *(Slots[idx] = &Patterns.Add(Lines, Commands));
     }
 
   private:
-    SparsedObjectsStorage<MutablePattern::Ptr> Storage;
+    typedef ArenaMutablePattern<MutableLineType> PatternType;
+    ObjectsArena<MutableLineType> Lines;
+    CommandsPool Commands;
+    ObjectsArena<PatternType> Patterns;
+    std::vector<PatternType*> Slots;
   };
 
   TrackInformation::Ptr CreateTrackInfoFixedChannels(Time::Microseconds frameDuration, TrackModel::Ptr model,
@@ -334,9 +445,7 @@ namespace Module
     static PatternsBuilder Create()
     {
       typedef MultichannelMutableLine<ChannelsCount> LineType;
-      typedef SparsedMutablePattern<LineType> PatternType;
-      typedef SparsedMutablePatternsSet<PatternType> PatternsSetType;
-      return PatternsBuilder(MakePtr<PatternsSetType>());
+      return PatternsBuilder(MakePtr<ArenaMutablePatternsSet<LineType>>());
     }
 
   private:
@@ -13,6 +13,7 @@
 #include "module/players/xsf/memory_region.h"
 #include "module/players/xsf/xsf.h"
 #include "module/players/xsf/xsf_factory.h"
+#include "module/players/xsf/xsf_image.h"
 // common includes
 #include <contract.h>
 #include <make_ptr.h>
@@ -35,6 +36,13 @@ namespace Module::TwoSF
 {
   const Debug::Stream Dbg("Module::2SF");
 
+  // Merged and unpacked sections content
+  struct ModuleImage
+  {
+    Binary::Dump Rom;
+    Binary::Dump State;
+  };
+
   struct ModuleData
   {
     using Ptr = std::shared_ptr<const ModuleData>;
@@ -47,6 +55,7 @@ namespace Module::TwoSF
     std::list<Binary::Container::Ptr> ReservedSections;
 
     XSF::MetaInformation::Ptr Meta;
+    XSF::CachedImage<ModuleImage> Image;
 
     uint_t GetRefreshRate() const
     {
@@ -71,13 +80,15 @@ namespace Module::TwoSF
       {
         SetupEnvironment(*data.Meta);
       }
+      // emulator state is not copyable, so cache only sections unpacking and merging results
+      const auto& image = data.Image.Get([&data]() { return CreateImage(data); });
       if (!data.PackedProgramSections.empty())
       {
-        SetupRom(data.PackedProgramSections);
+        SetupRom(image.Rom);
       }
       if (!data.ReservedSections.empty())
       {
-        SetupState(data.ReservedSections);
+        ::state_loadstate(&State, image.State.data(), image.State.size());
       }
     }
 
@@ -154,7 +165,28 @@ namespace Module::TwoSF
       }
     }
 
-    void SetupRom(const std::list<Binary::Container::Ptr>& blocks)
+    void SetupRom(const Binary::Dump& rom)
+    {
+      // possibly, emulation writes to ROM are, so copy it
+      Rom = rom;
+      ::state_setrom(&State, Rom.data(), Rom.size());
+    }
+
+    static ModuleImage CreateImage(const ModuleData& data)
+    {
+      ModuleImage result;
+      if (!data.PackedProgramSections.empty())
+      {
+        result.Rom = UnpackRom(data.PackedProgramSections);
+      }
+      if (!data.ReservedSections.empty())
+      {
+        result.State = MergeState(data.ReservedSections);
+      }
+      return result;
+    }
+
+    static Binary::Dump UnpackRom(const std::list<Binary::Container::Ptr>& blocks)
     {
       ChunkBuilder builder;
       for (const auto& block : blocks)
@@ -162,23 +194,21 @@ namespace Module::TwoSF
         const auto unpacked = Binary::Compression::Zlib::Decompress(*block);
         Formats::Chiptune::NintendoDSSoundFormat::ParseRom(*unpacked, builder);
       }
-      // possibly, emulation writes to ROM are, so copy it
-      Rom = builder.CaptureResult();
+      auto rom = builder.CaptureResult();
       // required power of 2 size
-      const auto alignedRomSize = uint32_t(1) << Math::Log2(Rom.Data.size());
-      Rom.Data.resize(alignedRomSize);
-      ::state_setrom(&State, Rom.Data.data(), alignedRomSize);
+      const auto alignedRomSize = uint32_t(1) << Math::Log2(rom.Data.size());
+      rom.Data.resize(alignedRomSize);
+      return std::move(rom.Data);
     }
 
-    void SetupState(const std::list<Binary::Container::Ptr>& blocks)
+    static Binary::Dump MergeState(const std::list<Binary::Container::Ptr>& blocks)
     {
       ChunkBuilder builder;
       for (const auto& block : blocks)
       {
         Formats::Chiptune::NintendoDSSoundFormat::ParseState(*block, builder);
       }
-      const auto& state = builder.CaptureResult();
-      ::state_loadstate(&State, state.Data.data(), state.Data.size());
+      return builder.CaptureResult().Data;
     }
 
   private:
@@ -201,7 +231,7 @@ namespace Module::TwoSF
 
   private:
     NDS_state State;
-    MemoryRegion Rom;
+    Binary::Dump Rom;
   };
 
   const auto FRAME_DURATION = Time::Milliseconds(100);
@@ -13,6 +13,7 @@
 #include "module/players/xsf/memory_region.h"
 #include "module/players/xsf/xsf.h"
 #include "module/players/xsf/xsf_factory.h"
+#include "module/players/xsf/xsf_image.h"
 // common includes
 #include <contract.h>
 #include <make_ptr.h>
@@ -35,6 +36,13 @@ namespace Module::NCSF
 {
   const Debug::Stream Dbg("Module::NCSF");
 
+  // Merged and unpacked sections content
+  struct ModuleImage
+  {
+    Binary::Dump Rom;
+    uint32_t SSeq = 0;
+  };
+
   struct ModuleData
   {
     using Ptr = std::shared_ptr<const ModuleData>;
@@ -47,6 +55,7 @@ namespace Module::NCSF
     std::list<Binary::Container::Ptr> ReservedSections;
 
     XSF::MetaInformation::Ptr Meta;
+    XSF::CachedImage<ModuleImage> Image;
   };
 
   class NCSFEngine
@@ -57,17 +66,13 @@ namespace Module::NCSF
     NCSFEngine(const ModuleData& data, uint32_t sampleRate)
       : SoundFrequency(sampleRate)
     {
-      if (!data.PackedProgramSections.empty())
-      {
-        SetupRom(data.PackedProgramSections);
-      }
-      if (!data.ReservedSections.empty())
-      {
-        SetupState(data.ReservedSections);
-      }
+      const auto& image = data.Image.Get([&data]() { return CreateImage(data); });
+      // possibly, emulation writes to ROM are, so copy it
+      Rom = image.Rom;
+      SSeq = image.SSeq;
 
       PseudoFile file;
-      file.data = &Rom.Data;
+      file.data = &Rom;
       SDat.reset(new SDAT(file, SSeq));
       NCSFPlayer.sampleRate = SoundFrequency;
       NCSFPlayer.interpolation = INTERPOLATION_SINC;
@@ -117,28 +122,33 @@ namespace Module::NCSF
     }
 
   private:
-    void SetupRom(const std::list<Binary::Container::Ptr>& blocks)
+    static ModuleImage CreateImage(const ModuleData& data)
     {
-      ChunkBuilder builder;
-      for (const auto& block : blocks)
+      ModuleImage result;
+      if (!data.PackedProgramSections.empty())
       {
-        const auto unpacked = Binary::Compression::Zlib::Decompress(*block);
-        Formats::Chiptune::NitroComposerSoundFormat::ParseRom(*unpacked, builder);
+        result.Rom = UnpackRom(data.PackedProgramSections);
       }
-      // possibly, emulation writes to ROM are, so copy it
-      Rom = builder.CaptureResult();
-      // required power of 2 size
-      const auto alignedRomSize = uint32_t(1) << Math::Log2(Rom.Data.size());
-      Rom.Data.resize(alignedRomSize);
+      for (const auto& block : data.ReservedSections)
+      {
+        result.SSeq = Formats::Chiptune::NitroComposerSoundFormat::ParseState(*block);
+      }
+      return result;
     }
 
-    void SetupState(const std::list<Binary::Container::Ptr>& blocks)
+    static Binary::Dump UnpackRom(const std::list<Binary::Container::Ptr>& blocks)
     {
       ChunkBuilder builder;
       for (const auto& block : blocks)
       {
-        SSeq = Formats::Chiptune::NitroComposerSoundFormat::ParseState(*block);
+        const auto unpacked = Binary::Compression::Zlib::Decompress(*block);
+        Formats::Chiptune::NitroComposerSoundFormat::ParseRom(*unpacked, builder);
       }
+      auto rom = builder.CaptureResult();
+      // required power of 2 size
+      const auto alignedRomSize = uint32_t(1) << Math::Log2(rom.Data.size());
+      rom.Data.resize(alignedRomSize);
+      return std::move(rom.Data);
     }
 
   private:
@@ -165,7 +175,7 @@ namespace Module::NCSF
     std::unique_ptr<SDAT> SDat;
     std::vector<uint8_t> SampleBuffer;
     uint32_t SSeq = 0;
-    MemoryRegion Rom;
+    Binary::Dump Rom;
   };
 
   const auto FRAME_DURATION = Time::Milliseconds(100);
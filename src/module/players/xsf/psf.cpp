@@ -15,6 +15,7 @@
 #include "module/players/xsf/psf_vfs.h"
 #include "module/players/xsf/xsf.h"
 #include "module/players/xsf/xsf_factory.h"
+#include "module/players/xsf/xsf_image.h"
 // common includes
 #include <contract.h>
 #include <make_ptr.h>
@@ -25,6 +26,8 @@
 #include <module/players/platforms.h>
 #include <module/players/streaming.h>
 #include <sound/resampler.h>
+// std includes
+#include <vector>
 // 3rdparty includes
 #include <3rdparty/he/Core/bios.h>
 #include <3rdparty/he/Core/iop.h>
@@ -116,6 +119,8 @@ namespace Module::PSF
     PsxExe::Ptr Exe;
     PsxVfs::Ptr Vfs;
     XSF::MetaInformation::Ptr Meta;
+    // initialized emulator state without io bindings
+    XSF::CachedImage<std::vector<uint8_t>> Image;
 
     uint_t GetRefreshRate() const
     {
@@ -145,10 +150,10 @@ namespace Module::PSF
     }
 
   public:
-    std::unique_ptr<uint8_t[]> CreatePSX(int version) const
+    std::vector<uint8_t> CreatePSX(int version) const
     {
-      std::unique_ptr<uint8_t[]> res(new uint8_t[::psx_get_state_size(version)]);
-      ::psx_clear_state(res.get(), version);
+      std::vector<uint8_t> res(::psx_get_state_size(version));
+      ::psx_clear_state(res.data(), version);
       return res;
     }
 
@@ -179,23 +184,22 @@ namespace Module::PSF
       Initialize(data);
     }
 
+    // Emulator state is location-invariant, so it's cheaper to clone prepared image than to upload all the data again
     void Initialize(const ModuleData& data)
     {
+      const auto& image = data.Image.Get([&data]() { return CreateImage(data); });
+      Emu.assign(image.begin(), image.end());
       if (data.Exe)
       {
-        Emu = HELibrary::Instance().CreatePSX(1);
-        SetupExe(*data.Exe);
         SoundFrequency = 44100;
         Spus.assign({SPU1});
       }
       else if (data.Vfs)
       {
-        Emu = HELibrary::Instance().CreatePSX(2);
         SetupIo(data.Vfs);
         SoundFrequency = 48000;
         Spus.assign({SPU1, SPU2});
       }
-      ::psx_set_refresh(Emu.get(), data.GetRefreshRate());
     }
 
     uint_t GetSoundFrequency() const
@@ -210,7 +214,7 @@ namespace Module::PSF
       {
         uint32_t toRender = samples - doneSamples;
         const auto res =
-            ::psx_execute(Emu.get(), 0x7fffffff, safe_ptr_cast<short int*>(&result[doneSamples]), &toRender, 0);
+            ::psx_execute(Emu.data(), 0x7fffffff, safe_ptr_cast<short int*>(&result[doneSamples]), &toRender, 0);
         Require(res >= 0);
         Require(toRender != 0);
         doneSamples += toRender;
@@ -223,7 +227,7 @@ namespace Module::PSF
       for (uint32_t skippedSamples = 0; skippedSamples < samples;)
       {
         uint32_t toSkip = samples - skippedSamples;
-        const auto res = ::psx_execute(Emu.get(), 0x7fffffff, nullptr, &toSkip, 0);
+        const auto res = ::psx_execute(Emu.data(), 0x7fffffff, nullptr, &toSkip, 0);
         Require(res >= 0);
         Require(toSkip != 0);
         skippedSamples += toSkip;
@@ -231,21 +235,32 @@ namespace Module::PSF
     }
 
   private:
-    void SetupExe(const PsxExe& exe)
+    static std::vector<uint8_t> CreateImage(const ModuleData& data)
     {
-      SetRAM(exe.RAM);
-      SetRegisters(exe.PC, exe.SP);
+      auto emu = HELibrary::Instance().CreatePSX(data.Exe ? 1 : 2);
+      if (data.Exe)
+      {
+        SetupExe(*data.Exe, emu.data());
+      }
+      ::psx_set_refresh(emu.data(), data.GetRefreshRate());
+      return emu;
+    }
+
+    static void SetupExe(const PsxExe& exe, void* emu)
+    {
+      SetRAM(exe.RAM, emu);
+      SetRegisters(exe.PC, exe.SP, emu);
     }
 
-    void SetRAM(const MemoryRegion& mem)
+    static void SetRAM(const MemoryRegion& mem, void* emu)
     {
-      const auto iop = ::psx_get_iop_state(Emu.get());
+      const auto iop = ::psx_get_iop_state(emu);
       ::iop_upload_to_ram(iop, mem.Start, mem.Data.data(), mem.Data.size());
     }
 
-    void SetRegisters(uint32_t pc, uint32_t sp)
+    static void SetRegisters(uint32_t pc, uint32_t sp, void* emu)
     {
-      const auto iop = ::psx_get_iop_state(Emu.get());
+      const auto iop = ::psx_get_iop_state(emu);
       const auto cpu = ::iop_get_r3000_state(iop);
       ::r3000_setreg(cpu, R3000_REG_PC, pc);
       ::r3000_setreg(cpu, R3000_REG_GEN + 29, sp);
@@ -253,8 +268,8 @@ namespace Module::PSF
 
     void SetupIo(PsxVfs::Ptr vfs)
     {
-      Io = VfsIO(vfs);
-      ::psx_set_readfile(Emu.get(), &ReadCallback, &Io);
+      Io = VfsIO(std::move(vfs));
+      ::psx_set_readfile(Emu.data(), &ReadCallback, &Io);
     }
 
     static sint32 ReadCallback(void* context, const char* path, sint32 offset, char* buffer, sint32 length)
@@ -266,7 +281,7 @@ namespace Module::PSF
   private:
     uint_t SoundFrequency = 0;
     std::vector<SpuTrait> Spus;
-    std::unique_ptr<uint8_t[]> Emu;
+    std::vector<uint8_t> Emu;
     VfsIO Io;
   };
 
@@ -12,6 +12,7 @@
 #include "module/players/xsf/sdsf.h"
 #include "module/players/xsf/xsf.h"
 #include "module/players/xsf/xsf_factory.h"
+#include "module/players/xsf/xsf_image.h"
 // common includes
 #include <byteorder.h>
 #include <contract.h>
@@ -25,6 +26,7 @@
 #include <sound/resampler.h>
 // std includes
 #include <list>
+#include <vector>
 // 3rdparty includes
 #include <3rdparty/ht/Core/sega.h>
 
@@ -43,6 +45,8 @@ namespace Module::SDSF
     uint_t Version = 0;
     std::list<Binary::Data::Ptr> Sections;
     XSF::MetaInformation::Ptr Meta;
+    // initialized emulator state with all the sections uploaded
+    XSF::CachedImage<std::vector<uint8_t>> Image;
 
     uint_t GetRefreshRate() const
     {
@@ -72,10 +76,10 @@ namespace Module::SDSF
       Dreamcast = 2,
     };
 
-    std::unique_ptr<uint8_t[]> CreateSega(Version version) const
+    std::vector<uint8_t> CreateSega(Version version) const
     {
-      std::unique_ptr<uint8_t[]> res(new uint8_t[::sega_get_state_size(static_cast<uint8>(version))]);
-      ::sega_clear_state(res.get(), static_cast<uint8>(version));
+      std::vector<uint8_t> res(::sega_get_state_size(static_cast<uint8>(version)));
+      ::sega_clear_state(res.data(), static_cast<uint8>(version));
       return res;
     }
 
@@ -106,17 +110,12 @@ namespace Module::SDSF
       SAMPLERATE = 44100
     };
 
+    // Emulator state is location-invariant, so it's cheaper to clone prepared image than to unpack and upload
+    // all the sections again
     void Initialize(const ModuleData& data)
     {
-      Vers = static_cast<HTLibrary::Version>(data.Version - 0x10);
-      Emu = HTLibrary::Instance().CreateSega(Vers);
-
-      const bool dry = true;
-      const bool dsp = true;
-      ::sega_enable_dry(Emu.get(), dry || !dsp);
-      ::sega_enable_dsp(Emu.get(), dsp);
-
-      SetupSections(data.Sections);
+      const auto& image = data.Image.Get([&data]() { return CreateImage(data); });
+      Emu.assign(image.begin(), image.end());
     }
 
     Sound::Chunk Render(uint_t samples)
@@ -126,7 +125,7 @@ namespace Module::SDSF
       {
         uint32_t toRender = samples - doneSamples;
         const auto res =
-            ::sega_execute(Emu.get(), 0x7fffffff, safe_ptr_cast<short int*>(&result[doneSamples]), &toRender);
+            ::sega_execute(Emu.data(), 0x7fffffff, safe_ptr_cast<short int*>(&result[doneSamples]), &toRender);
         Require(res >= 0);
         Require(toRender != 0);
         doneSamples += toRender;
@@ -139,7 +138,7 @@ namespace Module::SDSF
       for (uint32_t skippedSamples = 0; skippedSamples < samples;)
       {
         uint32_t toSkip = samples - skippedSamples;
-        const auto res = ::sega_execute(Emu.get(), 0x7fffffff, nullptr, &toSkip);
+        const auto res = ::sega_execute(Emu.data(), 0x7fffffff, nullptr, &toSkip);
         Require(res >= 0);
         Require(toSkip != 0);
         skippedSamples += toSkip;
@@ -147,7 +146,21 @@ namespace Module::SDSF
     }
 
   private:
-    void SetupSections(const std::list<Binary::Data::Ptr>& sections)
+    static std::vector<uint8_t> CreateImage(const ModuleData& data)
+    {
+      const auto vers = static_cast<HTLibrary::Version>(data.Version - 0x10);
+      auto emu = HTLibrary::Instance().CreateSega(vers);
+
+      const bool dry = true;
+      const bool dsp = true;
+      ::sega_enable_dry(emu.data(), dry || !dsp);
+      ::sega_enable_dsp(emu.data(), dsp);
+
+      SetupSections(data.Sections, vers, emu.data());
+      return emu;
+    }
+
+    static void SetupSections(const std::list<Binary::Data::Ptr>& sections, HTLibrary::Version vers, void* emu)
     {
       for (const auto& packed : sections)
       {
@@ -155,25 +168,24 @@ namespace Module::SDSF
         const auto rawSize = unpackedSection->Size();
         Require(rawSize > sizeof(le_uint32_t));
         const auto rawStart = static_cast<le_uint32_t*>(const_cast<void*>(unpackedSection->Start()));
-        const auto toCopy = FixupSection(rawStart, rawSize);
+        const auto toCopy = FixupSection(rawStart, rawSize, vers);
         // TODO: make input const
         Dbg("Section %1% -> %2%  @ 0x%3$08x", packed->Size(), toCopy, *rawStart);
-        Require(0 == ::sega_upload_program(Emu.get(), rawStart, toCopy));
+        Require(0 == ::sega_upload_program(emu, rawStart, toCopy));
       }
     }
 
-    std::size_t FixupSection(le_uint32_t* data, std::size_t size) const
+    static std::size_t FixupSection(le_uint32_t* data, std::size_t size, HTLibrary::Version vers)
     {
       const uint32_t start = *data & 0x7fffff;
       *data = start;
       const uint32_t end = start + (size - sizeof(start));
-      const uint32_t realEnd = std::min(end, HTLibrary::GetMemoryEnd(Vers));
+      const uint32_t realEnd = std::min(end, HTLibrary::GetMemoryEnd(vers));
       return sizeof(start) + (realEnd - start);
     }
 
   private:
-    HTLibrary::Version Vers;
-    std::unique_ptr<uint8_t[]> Emu;
+    std::vector<uint8_t> Emu;
   };
 
   const auto FRAME_DURATION = Time::Milliseconds(100);
@@ -0,0 +1,43 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Xsf-based files support. Cached post-initialization image
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// std includes
+#include <mutex>
+#include <optional>
+
+namespace Module
+{
+  namespace XSF
+  {
+    // Lazily created immutable snapshot of engine's state shared between all the renderers of the same tune.
+    // Creation is performed at most once on first demand, so detection-only usage does not pay for it.
+    template<class T>
+    class CachedImage
+    {
+    public:
+      CachedImage() = default;
+      CachedImage(const CachedImage&) = delete;
+      CachedImage& operator=(const CachedImage&) = delete;
+
+      template<class Factory>
+      const T& Get(Factory&& factory) const
+      {
+        std::call_once(Once, [&]() { Value.emplace(factory()); });
+        return *Value;
+      }
+
+    private:
+      mutable std::once_flag Once;
+      mutable std::optional<T> Value;
+    };
+  }  // namespace XSF
+}  // namespace Module
@@ -46,4 +46,15 @@ namespace Module
     //! @note It produces only the flush
     virtual void SetPosition(Time::AtMillisecond position) = 0;
   };
+
+  //! @brief Optional %Renderer extension to avoid allocation of each rendered frame
+  class BufferRenderer : public Renderer
+  {
+  public:
+    using Renderer::Render;
+
+    //! @brief Rendering single frame replacing content of target and reusing its memory
+    //! @note target is empty if there's no more data to render
+    virtual void Render(const Sound::LoopParameters& looped, Sound::Chunk& target) = 0;
+  };
 }  // namespace Module
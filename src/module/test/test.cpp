@@ -0,0 +1,583 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Module players test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <binary/container_factories.h>
+#include <core/core_parameters.h>
+#include <core/module_detect.h>
+#include <core/plugins/players/multi/multi_base.h>
+#include <core/plugins/players/plugins_list.h>
+#include <core/plugins_parameters.h>
+#include <core/src/location.h>
+#include <debug/metrics.h>
+#include <devices/dac.h>
+#include <make_ptr.h>
+#include <module/players/aym/aym_base.h>
+#include <module/players/aym/aym_parameters.h>
+#include <module/players/aym/protracker2.h>
+#include <module/players/aym/sqtracker.h>
+#include <module/attributes.h>
+#include <module/players/dac/digitalmusicmaker.h>
+#include <module/players/duration_probe.h>
+#include <module/players/pipeline.h>
+#include <module/players/tracking.h>
+#include <parameters/container.h>
+#include <parameters/convert.h>
+#include <parameters/merged_accessor.h>
+#include <parameters/visitor.h>
+#include <sound/loop.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+
+namespace
+{
+  void Test(const std::string& msg, bool val)
+  {
+    std::cout << (val ? "Passed" : "Failed") << " test for " << msg << std::endl;
+    if (!val)
+      throw 1;
+  }
+
+  template<class T>
+  void Test(const std::string& msg, T result, T reference)
+  {
+    if (result == reference)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << " (got: " << result << " expected: " << reference << ")" << std::endl;
+      throw 1;
+    }
+  }
+
+  Binary::Container::Ptr OpenFile(const std::string& name)
+  {
+    std::ifstream stream(name.c_str(), std::ios::binary);
+    if (!stream)
+    {
+      std::cout << "Failed to open " << name << std::endl;
+      throw 1;
+    }
+    Binary::Dump data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return Binary::CreateContainer(std::move(data));
+  }
+
+  void TestPatterns()
+  {
+    std::cout << "---- Test for patterns ----" << std::endl;
+    auto builder = Module::PatternsBuilder::Create<3>();
+    builder.SetPattern(0);
+    builder.SetLine(10);
+    builder.SetChannel(1);
+    builder.GetChannel().SetNote(5);
+    builder.GetChannel().AddCommand(1, 2);
+    builder.SetLine(1);
+    builder.SetChannel(2);
+    builder.GetChannel().AddCommand(3);
+    builder.GetChannel().AddCommand(4);
+    builder.Finish(4);
+    builder.SetPattern(2);
+    builder.SetLine(1);
+    builder.Finish(8);
+    const auto patterns = builder.CaptureResult();
+    Test<uint_t>("patterns count", patterns->GetSize(), 2);
+    Test("missed pattern", patterns->Get(1) == nullptr);
+    const auto& shrinked = *patterns->Get(0);
+    Test<uint_t>("shrinked pattern size", shrinked.GetSize(), 4);
+    Test("truncated line", shrinked.GetLine(10) == nullptr);
+    const auto* line = shrinked.GetLine(1);
+    Test("kept line", line != nullptr);
+    Test<uint_t>("kept line channels", line->CountActiveChannels(), 1);
+    uint_t commands = 0;
+    for (auto it = line->GetChannel(2)->GetCommands(); it; ++it)
+    {
+      commands += it->Type;
+    }
+    Test<uint_t>("kept line commands", commands, 3 + 4);
+    Test<uint_t>("expanded pattern size", patterns->Get(2)->GetSize(), 8);
+  }
+
+  void TestDigitalMusicMaker()
+  {
+    std::cout << "---- Test for DigitalMusicMaker ----" << std::endl;
+    // mixins of this module have effects
+    const auto data = OpenFile("../../../samples/chiptunes/DAC/ZX/dmm/popcorn.dmm");
+    const auto chiptune =
+        Module::DigitalMusicMaker::CreateFactory()->CreateChiptune(*data, Parameters::Container::Create());
+    Test("module created", !!chiptune);
+    const auto iterator = chiptune->CreateDataIterator();
+    const auto state = iterator->GetStateObserver();
+    const Sound::LoopParameters noLoop;
+    uint_t frames = 0;
+    for (; iterator->IsValid(); iterator->NextFrame(noLoop), ++frames)
+    {
+      Devices::DAC::Channels channels;
+      iterator->GetData(channels);
+    }
+    Test("module played", frames > 0);
+    Test<uint_t>("module finished", state->LoopCount(), 0);
+  }
+
+  bool IsEqual(const Devices::AYM::Registers& lh, const Devices::AYM::Registers& rh)
+  {
+    for (uint_t reg = 0; reg != Devices::AYM::Registers::TOTAL; ++reg)
+    {
+      const auto idx = static_cast<Devices::AYM::Registers::Index>(reg);
+      if (lh.Has(idx) != rh.Has(idx) || (lh.Has(idx) && lh[idx] != rh[idx]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void TestCompiledStream(const Module::AYM::Factory& factory, const std::string& name)
+  {
+    const auto chiptune = factory.CreateChiptune(*OpenFile(name), Parameters::Container::Create());
+    Test("module created", !!chiptune);
+    const auto properties = chiptune->GetProperties();
+    const auto compiledParams = Parameters::Container::Create();
+    compiledParams->SetValue(Parameters::ZXTune::Core::AYM::COMPILED_STREAM, 1);
+    const auto reference = chiptune->CreateDataIterator(Module::AYM::TrackParameters::Create(properties));
+    const auto compiled = chiptune->CreateDataIterator(
+        Module::AYM::TrackParameters::Create(Parameters::CreateMergedAccessor(compiledParams, properties)));
+    const auto state = reference->GetStateObserver();
+    // all the frames of six full loops, so replayed iterations are covered as well
+    const Sound::LoopParameters looped(true, 0);
+    uint_t frames = 0;
+    for (; state->LoopCount() < 6; reference->NextFrame(looped), compiled->NextFrame(looped), ++frames)
+    {
+      if (!IsEqual(reference->GetData(), compiled->GetData()))
+      {
+        Test<uint_t>(name + " compiled stream bit-exact at loop " + std::to_string(state->LoopCount()), frames, 0);
+      }
+    }
+    Test(name + " compiled stream bit-exact", true);
+    Test(name + " compiled stream looped", compiled->IsValid() && reference->IsValid());
+    // seek backward and play again
+    reference->Reset();
+    compiled->Reset();
+    for (uint_t frame = 0; frame != frames; ++frame, reference->NextFrame(looped), compiled->NextFrame(looped))
+    {
+      if (!IsEqual(reference->GetData(), compiled->GetData()))
+      {
+        Test<uint_t>(name + " compiled stream bit-exact after reset", frame, 0);
+      }
+    }
+    Test(name + " compiled stream bit-exact after reset", true);
+  }
+
+  void TestCompiledStream()
+  {
+    std::cout << "---- Test for AYM compiled stream ----" << std::endl;
+    const std::string samples = "../../../samples/chiptunes/AY-3-8910/";
+    TestCompiledStream(*Module::ProTracker2::CreateFactory(), samples + "pt2/PITON.pt2");
+    TestCompiledStream(*Module::ProTracker2::CreateFactory(), samples + "pt2/4jour#2.pt2");
+    TestCompiledStream(*Module::SQTracker::CreateFactory(), samples + "sqt/taiobyte.sqt");
+    TestCompiledStream(*Module::SQTracker::CreateFactory(), samples + "sqt/tsd.sqt");
+  }
+
+  void TestPullRendering()
+  {
+    std::cout << "---- Test for pipelined pull rendering ----" << std::endl;
+    const auto chiptune = Module::ProTracker2::CreateFactory()->CreateChiptune(
+        *OpenFile("../../../samples/chiptunes/AY-3-8910/pt2/PITON.pt2"), Parameters::Container::Create());
+    const auto holder = Module::AYM::CreateHolder(chiptune);
+    const uint_t samplerate = 44100;
+    const auto params = Parameters::Container::Create();
+    const auto reference = Module::CreatePipelinedRenderer(*holder, samplerate, params);
+    const auto pulled = Module::CreatePipelinedRenderer(*holder, samplerate, params);
+    Test("frames are rendered in place", !!dynamic_cast<Module::BufferRenderer*>(
+                                             holder->CreateRenderer(samplerate, params).get()));
+    const Sound::LoopParameters noLoop;
+    const auto state = pulled->GetState();
+    std::vector<Sound::Sample> expected;
+    std::vector<Sound::Sample> result;
+    // odd sizes to cross frames boundaries at different offsets
+    for (std::size_t size = 1; expected.size() < samplerate * 10; size = (size * 7 + 3) % 2000)
+    {
+      const auto frame = reference->Render(noLoop);
+      expected.insert(expected.end(), frame.begin(), frame.end());
+      const auto done = result.size();
+      result.resize(done + size);
+      const auto pulledSize = pulled->Render(noLoop, result.data() + done, size);
+      if (frame.empty() || pulledSize != size)
+      {
+        Test("pulled samples", pulledSize, size);
+      }
+      const auto deliveredMs = static_cast<uint_t>(uint64_t(result.size()) * 1000 / samplerate);
+      const auto reportedMs = state->At().Get();
+      if (reportedMs < deliveredMs || reportedMs > deliveredMs + 1)
+      {
+        Test("reported delivered position", reportedMs, deliveredMs);
+      }
+    }
+    Test("reported delivered position", true);
+    result.resize(std::min(result.size(), expected.size()));
+    Test("pulled data", result == std::vector<Sound::Sample>(expected.begin(), expected.begin() + result.size()));
+  }
+
+  // 100ms blocks of constant level, level 0 means silence
+  typedef std::vector<uint_t> Levels;
+
+  const uint_t BLOCK_DURATION_MS = 100;
+
+  Levels RandomLevels(uint_t seed, std::size_t count, uint_t minLevel, uint_t maxLevel)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<uint_t> distr(minLevel, maxLevel);
+    Levels result(count);
+    std::generate(result.begin(), result.end(), [&]() { return distr(gen); });
+    return result;
+  }
+
+  class LevelsState : public Module::State
+  {
+  public:
+    Time::AtMillisecond At() const override
+    {
+      return Time::AtMillisecond(Block * BLOCK_DURATION_MS);
+    }
+
+    Time::Milliseconds Total() const override
+    {
+      return Time::Milliseconds(Block * BLOCK_DURATION_MS);
+    }
+
+    uint_t LoopCount() const override
+    {
+      return 0;
+    }
+
+    std::size_t Block = 0;
+  };
+
+  class LevelsRenderer : public Module::Renderer
+  {
+  public:
+    LevelsRenderer(const Levels& levels, uint_t samplerate)
+      : Blocks(levels)
+      , BlockSamples(samplerate * BLOCK_DURATION_MS / 1000)
+      , State(std::make_shared<LevelsState>())
+    {}
+
+    Module::State::Ptr GetState() const override
+    {
+      return State;
+    }
+
+    Sound::Chunk Render(const Sound::LoopParameters& /*looped*/) override
+    {
+      if (State->Block >= Blocks.size())
+      {
+        return {};
+      }
+      // quantized by probing to 512 steps
+      const auto level = Blocks[State->Block++];
+      const auto val = static_cast<Sound::Sample::Type>(level ? level * 512 + 256 : 0);
+      Sound::Chunk result(BlockSamples);
+      std::fill(result.begin(), result.end(), Sound::Sample(val, val));
+      return result;
+    }
+
+    void Reset() override
+    {
+      State->Block = 0;
+    }
+
+    void SetPosition(Time::AtMillisecond position) override
+    {
+      State->Block = position.Get() / BLOCK_DURATION_MS;
+    }
+
+  private:
+    const Levels& Blocks;
+    const std::size_t BlockSamples;
+    const std::shared_ptr<LevelsState> State;
+  };
+
+  class LevelsInformation : public Module::Information
+  {
+  public:
+    explicit LevelsInformation(std::size_t blocks)
+      : Blocks(blocks)
+    {}
+
+    Time::Milliseconds Duration() const override
+    {
+      return Time::Milliseconds(Blocks * BLOCK_DURATION_MS);
+    }
+
+    Time::Milliseconds LoopDuration() const override
+    {
+      return Duration();
+    }
+
+  private:
+    const std::size_t Blocks;
+  };
+
+  class LevelsHolder : public Module::Holder
+  {
+  public:
+    explicit LevelsHolder(Levels levels)
+      : Blocks(std::move(levels))
+    {}
+
+    Module::Information::Ptr GetModuleInformation() const override
+    {
+      return MakePtr<LevelsInformation>(Blocks.size());
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Parameters::Container::Create();
+    }
+
+    Module::Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr /*params*/) const override
+    {
+      return MakePtr<LevelsRenderer>(Blocks, samplerate);
+    }
+
+  private:
+    const Levels Blocks;
+  };
+
+  Levels Concat(Levels lh, const Levels& rh)
+  {
+    lh.insert(lh.end(), rh.begin(), rh.end());
+    return lh;
+  }
+
+  uint_t ProbeDuration(Levels levels)
+  {
+    const LevelsHolder holder(std::move(levels));
+    return Module::ProbeDuration(holder, Parameters::Container::Create()).Get();
+  }
+
+  void TestProbeDuration()
+  {
+    std::cout << "---- Test for duration probing ----" << std::endl;
+    const auto sound = RandomLevels(1, 400, 1, 63);
+    Test<uint_t>("trailing silence", ProbeDuration(Concat(sound, Levels(100, 0))), 40000);
+    Test<uint_t>("short pause", ProbeDuration(Concat(Concat(sound, Levels(30, 0)), RandomLevels(5, 400, 1, 63))), 0);
+    Test<uint_t>("leading silence", ProbeDuration(Concat(Levels(100, 0), sound)), 0);
+    // intro levels do not intersect with looped part ones
+    const auto intro = RandomLevels(2, 100, 40, 63);
+    const auto loop = RandomLevels(3, 400, 1, 39);
+    Test<uint_t>("loop", ProbeDuration(Concat(intro, Concat(loop, Concat(loop, loop)))), 50000);
+    Test<uint_t>("short loop", ProbeDuration(Concat(loop, Levels(loop.begin(), loop.begin() + 200))), 0);
+    Test<uint_t>("steady tone", ProbeDuration(Levels(1000, 10)), 0);
+    Test<uint_t>("no repetitions", ProbeDuration(RandomLevels(4, 1000, 1, 63)), 0);
+
+    const auto holder = MakePtr<LevelsHolder>(Concat(sound, Levels(100, 0)));
+    const auto probed = Module::StoreProbedDuration(holder, Parameters::Container::Create());
+    Test<uint_t>("stored duration info", probed->GetModuleInformation()->Duration().Get(), 40000);
+    Parameters::IntType stored = 0;
+    Test("stored duration property", probed->GetModuleProperties()->FindValue(Module::ATTR_DURATION, stored));
+    Test<Parameters::IntType>("stored duration value", stored, 40000);
+    const auto unchanged = MakePtr<LevelsHolder>(RandomLevels(4, 1000, 1, 63));
+    Test("nothing to store", Module::StoreProbedDuration(unchanged, Parameters::Container::Create()) == unchanged);
+  }
+
+  class PluginsCollector : public ZXTune::PlayerPluginsRegistrator
+  {
+  public:
+    void RegisterPlugin(ZXTune::PlayerPlugin::Ptr plugin) override
+    {
+      Plugin = std::move(plugin);
+    }
+
+    ZXTune::PlayerPlugin::Ptr Plugin;
+  };
+
+  class HolderCollector : public Module::DetectCallback
+  {
+  public:
+    Parameters::Container::Ptr CreateInitialProperties(const String& /*subpath*/) const override
+    {
+      return Parameters::Container::Create();
+    }
+
+    void ProcessModule(const ZXTune::DataLocation& /*location*/, const ZXTune::Plugin& /*decoder*/,
+                       Module::Holder::Ptr holder) override
+    {
+      Holder = std::move(holder);
+    }
+
+    Log::ProgressCallback* GetProgress() const override
+    {
+      return nullptr;
+    }
+
+    Module::Holder::Ptr Holder;
+  };
+
+  class PropertiesCollector : public Parameters::Visitor
+  {
+  public:
+    void SetValue(Parameters::Identifier name, Parameters::IntType val) override
+    {
+      Values[name.AsString()] = Parameters::ConvertToString(val);
+    }
+
+    void SetValue(Parameters::Identifier name, StringView val) override
+    {
+      Values[name.AsString()] = Parameters::ConvertToString(val);
+    }
+
+    void SetValue(Parameters::Identifier name, Binary::View val) override
+    {
+      Values[name.AsString()] = Parameters::ConvertToString(val);
+    }
+
+    std::map<String, String> Values;
+  };
+
+  Module::Holder::Ptr Detect(const ZXTune::PlayerPlugin& plugin, const Parameters::Accessor& params,
+                             Binary::Container::Ptr data)
+  {
+    HolderCollector cb;
+    plugin.Detect(params, ZXTune::CreateLocation(std::move(data)), cb);
+    return cb.Holder;
+  }
+
+  std::map<String, String> GetProperties(const Module::Holder& holder)
+  {
+    PropertiesCollector props;
+    holder.GetModuleProperties()->Process(props);
+    return props.Values;
+  }
+
+  void TestMetadataOnly(void (*registrator)(ZXTune::PlayerPluginsRegistrator&), const std::string& name)
+  {
+    PluginsCollector plugins;
+    registrator(plugins);
+    const auto data = OpenFile(name);
+    const auto fullParams = Parameters::Container::Create();
+    const auto metaParams = Parameters::Container::Create();
+    metaParams->SetValue(Parameters::ZXTune::Core::Plugins::METADATA_ONLY, 1);
+    const auto full = Detect(*plugins.Plugin, *fullParams, data);
+    const auto meta = Detect(*plugins.Plugin, *metaParams, data);
+    Test(name + " detected", full && meta);
+    Test(name + " metadata duration", meta->GetModuleInformation()->Duration().Get(),
+         full->GetModuleInformation()->Duration().Get());
+    Test(name + " metadata properties", GetProperties(*meta) == GetProperties(*full));
+    const auto fullAym = std::dynamic_pointer_cast<const Module::AYM::Holder>(full);
+    const auto metaAym = std::dynamic_pointer_cast<const Module::AYM::Holder>(meta);
+    Test(name + " metadata AYM capabilities", fullAym && metaAym);
+    // chiptune is built on demand with the same properties
+    const auto fullChiptune = fullAym->GetChiptune();
+    const auto metaChiptune = metaAym->GetChiptune();
+    const auto reference = fullChiptune->CreateDataIterator(
+        Module::AYM::TrackParameters::Create(fullChiptune->GetProperties()));
+    const auto restored = metaChiptune->CreateDataIterator(
+        Module::AYM::TrackParameters::Create(metaChiptune->GetProperties()));
+    for (uint_t frame = 0; reference->IsValid(); ++frame, reference->NextFrame({}), restored->NextFrame({}))
+    {
+      if (!restored->IsValid() || !IsEqual(reference->GetData(), restored->GetData()))
+      {
+        Test<uint_t>(name + " metadata restored stream", frame, 0);
+      }
+    }
+    Test(name + " metadata restored stream", !restored->IsValid());
+  }
+
+  void TestMetadataOnly()
+  {
+    std::cout << "---- Test for metadata-only detection ----" << std::endl;
+    const std::string samples = "../../../samples/chiptunes/AY-3-8910/";
+    TestMetadataOnly(&ZXTune::RegisterPT2Support, samples + "pt2/PITON.pt2");
+    TestMetadataOnly(&ZXTune::RegisterPT2Support, samples + "pt2/4jour#2.pt2");
+    TestMetadataOnly(&ZXTune::RegisterSTCSupport, samples + "stc/TOXIC2.stc");
+    TestMetadataOnly(&ZXTune::RegisterSTCSupport, samples + "stc/stracker.stc");
+    TestMetadataOnly(&ZXTune::RegisterST1Support, samples + "st1/EPILOG.st1");
+    TestMetadataOnly(&ZXTune::RegisterST3Support, samples + "st3/Kvs_Joke.st3");
+    TestMetadataOnly(&ZXTune::RegisterSTPSupport, samples + "stp/ZXGuide3_07.stp");
+    TestMetadataOnly(&ZXTune::RegisterSTPSupport, samples + "stp/iris_setup.stp");
+    TestMetadataOnly(&ZXTune::RegisterASCSupport, samples + "asc/BLUEBIRD.asc");
+    TestMetadataOnly(&ZXTune::RegisterASCSupport, samples + "asc/SANDRA.asc");
+    TestMetadataOnly(&ZXTune::RegisterPT1Support, samples + "pt1/GoldenGift.pt1");
+    TestMetadataOnly(&ZXTune::RegisterGTRSupport, samples + "gtr/L.Boy.gtr");
+  }
+
+  Module::Holder::Ptr DetectSample(void (*registrator)(ZXTune::PlayerPluginsRegistrator&), const std::string& name)
+  {
+    PluginsCollector plugins;
+    registrator(plugins);
+    return Detect(*plugins.Plugin, *Parameters::Container::Create(), OpenFile(name));
+  }
+
+  std::vector<Sound::Sample> RenderMulti(const Module::Holder& holder, Parameters::IntType parallelThreshold)
+  {
+    const auto params = Parameters::Container::Create();
+    params->SetValue(Parameters::ZXTune::Core::Plugins::Multi::PARALLEL_THRESHOLD, parallelThreshold);
+    const auto renderer = holder.CreateRenderer(44100, params);
+    const Sound::LoopParameters noLoop;
+    std::vector<Sound::Sample> result;
+    // 60 seconds is enough to reach end of some of the streams
+    for (uint_t frame = 0; frame != 3000; ++frame)
+    {
+      const auto chunk = renderer->Render(noLoop);
+      if (chunk.empty())
+      {
+        break;
+      }
+      result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+    return result;
+  }
+
+  void TestMultiRendering()
+  {
+    std::cout << "---- Test for multidevice rendering ----" << std::endl;
+    const std::string samples = "../../../samples/chiptunes/AY-3-8910/";
+    // streams of different durations and formats
+    Module::Multi::HoldersArray holders;
+    holders.push_back(DetectSample(&ZXTune::RegisterPT2Support, samples + "pt2/PITON.pt2"));
+    holders.push_back(DetectSample(&ZXTune::RegisterSTCSupport, samples + "stc/stracker.stc"));
+    holders.push_back(DetectSample(&ZXTune::RegisterGTRSupport, samples + "gtr/L.Boy.gtr"));
+    Test("multi streams detected", std::all_of(holders.begin(), holders.end(), [](const auto& h) { return !!h; }));
+    const auto multi = Module::Multi::CreateHolder(Parameters::Container::Create(), std::move(holders));
+    auto& parallelPortions = Debug::Metrics::GetCounter("core.multi.parallel");
+    // 1 second per portion is never reached
+    const auto sequential = RenderMulti(*multi, 1000000);
+    Test<uint64_t>("sequential rendering", parallelPortions.Get(), 0);
+    Test("sequential output", !sequential.empty());
+    const auto parallel = RenderMulti(*multi, 0);
+    Test("forced parallel rendering", parallelPortions.Get() != 0);
+    Test<std::size_t>("parallel output size", parallel.size(), sequential.size());
+    Test("parallel output", parallel == sequential);
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    TestPatterns();
+    TestDigitalMusicMaker();
+    TestCompiledStream();
+    TestPullRendering();
+    TestProbeDuration();
+    TestMetadataOnly();
+    TestMultiRendering();
+  }
+  catch (int code)
+  {
+    return code;
+  }
+}
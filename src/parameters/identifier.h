@@ -77,6 +77,10 @@ namespace Parameters
 
     String Append(Identifier rh) const
     {
+      if (IsEmpty())
+      {
+        return rh.AsString();
+      }
       return rh.IsEmpty() ? AsString() : AsString() + NAMESPACE_DELIMITER + rh.AsString();
     }
 
@@ -0,0 +1,26 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Flattened accessors chain factory
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#pragma once
+
+// library includes
+#include <parameters/accessor.h>
+
+namespace Parameters
+{
+  /*
+    Values found in (usually long merged) accessors chain are stored in single open-addressing table, so repeated
+    lookups cost one name hashing instead of walking the chain with names comparison on each level.
+    Table is filled lazily. Lookups do not query chain's version, it's checked only by Version() call which drops
+    the table if chain is changed. So, as usual, changed values are visible after Version() reports the change.
+    Process() is delegated to the chain as is.
+  */
+  Accessor::Ptr CreateSnapshotAccessor(Accessor::Ptr chain);
+}  // namespace Parameters
@@ -0,0 +1,293 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Flattened accessors chain implementation
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+// common includes
+#include <make_ptr.h>
+// library includes
+#include <parameters/snapshot.h>
+// std includes
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Parameters
+{
+  // Found and missed values of all types, open addressing with linear probing
+  class FlatTable
+  {
+  public:
+    FlatTable()
+      : Entries(INITIAL_CAPACITY)
+    {}
+
+    void Clear()
+    {
+      Entries.assign(INITIAL_CAPACITY, Entry());
+      Used = 0;
+      Integers.clear();
+      Strings.clear();
+      Datas.clear();
+    }
+
+    static std::size_t Hash(StringView name)
+    {
+      // FNV-1a
+      uint64_t hash = 14695981039346656037ull;
+      for (const auto sym : name)
+      {
+        hash = (hash ^ static_cast<uint8_t>(sym)) * 1099511628211ull;
+      }
+      return static_cast<std::size_t>(hash);
+    }
+
+    //! @return nullptr if lookup was not performed yet
+    template<class T>
+    const bool* Find(std::size_t hash, StringView name, T& val) const
+    {
+      const auto type = GetType<T>();
+      for (auto idx = hash & (Entries.size() - 1);; idx = (idx + 1) & (Entries.size() - 1))
+      {
+        const auto& entry = Entries[idx];
+        if (!entry.Used)
+        {
+          return nullptr;
+        }
+        else if (entry.Hash == hash && entry.Type == type && entry.Name == name)
+        {
+          if (entry.Found)
+          {
+            Load(entry.Value, val);
+          }
+          return &entry.Found;
+        }
+      }
+    }
+
+    //! @param val nullptr if not found
+    template<class T>
+    void Add(std::size_t hash, StringView name, const T* val)
+    {
+      if (2 * (Used + 1) > Entries.size())
+      {
+        Grow();
+      }
+      auto& entry = Insert(hash);
+      entry.Used = true;
+      entry.Found = val != nullptr;
+      entry.Type = GetType<T>();
+      entry.Hash = hash;
+      entry.Name = name.to_string();
+      entry.Value = val ? Store(*val) : 0;
+      ++Used;
+    }
+
+  private:
+    enum ValueType : uint8_t
+    {
+      INTEGER,
+      STRING,
+      DATA
+    };
+
+    struct Entry
+    {
+      bool Used = false;
+      bool Found = false;
+      ValueType Type = INTEGER;
+      std::size_t Hash = 0;
+      std::size_t Value = 0;
+      String Name;
+    };
+
+    template<class T>
+    static ValueType GetType();
+
+    Entry& Insert(std::size_t hash)
+    {
+      for (auto idx = hash & (Entries.size() - 1);; idx = (idx + 1) & (Entries.size() - 1))
+      {
+        if (!Entries[idx].Used)
+        {
+          return Entries[idx];
+        }
+      }
+    }
+
+    void Grow()
+    {
+      std::vector<Entry> entries(Entries.size() * 2);
+      entries.swap(Entries);
+      for (auto& entry : entries)
+      {
+        if (entry.Used)
+        {
+          Insert(entry.Hash) = std::move(entry);
+        }
+      }
+    }
+
+    std::size_t Store(IntType val)
+    {
+      Integers.push_back(val);
+      return Integers.size() - 1;
+    }
+
+    std::size_t Store(const StringType& val)
+    {
+      Strings.push_back(val);
+      return Strings.size() - 1;
+    }
+
+    std::size_t Store(const DataType& val)
+    {
+      Datas.push_back(val);
+      return Datas.size() - 1;
+    }
+
+    void Load(std::size_t idx, IntType& val) const
+    {
+      val = Integers[idx];
+    }
+
+    void Load(std::size_t idx, StringType& val) const
+    {
+      val = Strings[idx];
+    }
+
+    void Load(std::size_t idx, DataType& val) const
+    {
+      val = Datas[idx];
+    }
+
+  private:
+    static const std::size_t INITIAL_CAPACITY = 64;
+    std::vector<Entry> Entries;
+    std::size_t Used = 0;
+    std::vector<IntType> Integers;
+    std::vector<StringType> Strings;
+    std::vector<DataType> Datas;
+  };
+
+  template<>
+  FlatTable::ValueType FlatTable::GetType<IntType>()
+  {
+    return INTEGER;
+  }
+
+  template<>
+  FlatTable::ValueType FlatTable::GetType<StringType>()
+  {
+    return STRING;
+  }
+
+  template<>
+  FlatTable::ValueType FlatTable::GetType<DataType>()
+  {
+    return DATA;
+  }
+
+  class SnapshotAccessor : public Accessor
+  {
+  public:
+    explicit SnapshotAccessor(Accessor::Ptr chain)
+      : Chain(std::move(chain))
+    {}
+
+    uint_t Version() const override
+    {
+      const auto version = Chain->Version();
+      const std::lock_guard<std::mutex> lock(Guard);
+      Validate(version);
+      return version;
+    }
+
+    bool FindValue(Identifier name, IntType& val) const override
+    {
+      return Find(name, val);
+    }
+
+    bool FindValue(Identifier name, StringType& val) const override
+    {
+      return Find(name, val);
+    }
+
+    bool FindValue(Identifier name, DataType& val) const override
+    {
+      return Find(name, val);
+    }
+
+    void Process(Visitor& visitor) const override
+    {
+      Chain->Process(visitor);
+    }
+
+  private:
+    void Validate(uint_t version) const
+    {
+      if (!Validated || version != CachedVersion)
+      {
+        Table.Clear();
+        CachedVersion = version;
+        Validated = true;
+        ++Generation;
+      }
+    }
+
+    template<class T>
+    bool Find(Identifier name, T& val) const
+    {
+      const auto hash = FlatTable::Hash(name);
+      uint_t generation = 0;
+      {
+        std::unique_lock<std::mutex> lock(Guard);
+        if (!Validated)
+        {
+          lock.unlock();
+          Version();
+          lock.lock();
+        }
+        if (const auto* found = Table.Find(hash, name, val))
+        {
+          return *found;
+        }
+        generation = Generation;
+      }
+      // lookup may be reentrant or change chain's version, so perform it unlocked
+      T result;
+      const bool found = Chain->FindValue(name, result);
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        if (generation == Generation)
+        {
+          Table.Add(hash, name, found ? &result : nullptr);
+        }
+      }
+      if (found)
+      {
+        val = std::move(result);
+      }
+      return found;
+    }
+
+  private:
+    const Accessor::Ptr Chain;
+    mutable std::mutex Guard;
+    mutable bool Validated = false;
+    mutable uint_t CachedVersion = 0;
+    // changed on each table drop to not store values looked up before it
+    mutable uint_t Generation = 0;
+    mutable FlatTable Table;
+  };
+
+  Accessor::Ptr CreateSnapshotAccessor(Accessor::Ptr chain)
+  {
+    return MakePtr<SnapshotAccessor>(std::move(chain));
+  }
+}  // namespace Parameters
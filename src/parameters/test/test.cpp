@@ -9,6 +9,8 @@
  **/
 
 #include <parameters/container.h>
+#include <parameters/merged_accessor.h>
+#include <parameters/snapshot.h>
 #include <parameters/types.h>
 
 #include <iostream>
@@ -61,6 +63,9 @@ namespace
       Test("zero.RelativeTo(one)", zeroId.RelativeTo(one), ""_sv);
       Test("zero.RelativeTo(two)", zeroId.RelativeTo(two), ""_sv);
       Test("zero.RelativeTo(three)", zeroId.RelativeTo(three), ""_sv);
+      Test<String>("zero.Append(zero)", zeroId.Append(zero), "");
+      Test<String>("zero.Append(one)", zeroId.Append(one), "one");
+      Test<String>("zero.Append(two)", zeroId.Append(two), "one.two");
     }
 
     {
@@ -75,6 +80,8 @@ namespace
       Test("one + one", one + one, "one.one"_sv);
       Test("one + two", one + two, "one.one.two"_sv);
       Test("one + three", one + three, "one.one.two.three"_sv);
+      Test<String>("one.Append(zero)", oneId.Append(zero), "one");
+      Test<String>("one.Append(two)", oneId.Append(two), "one.one.two");
     }
 
     {
@@ -134,6 +141,50 @@ namespace
     std::vector<Parameters::DataType> Datas;
   };
 
+  // Counts calls to check how often snapshot touches the chain
+  class CountingAccessor : public Parameters::Accessor
+  {
+  public:
+    explicit CountingAccessor(Parameters::Accessor::Ptr delegate)
+      : Delegate(std::move(delegate))
+    {}
+
+    uint_t Version() const override
+    {
+      ++Versions;
+      return Delegate->Version();
+    }
+
+    bool FindValue(Parameters::Identifier name, Parameters::IntType& val) const override
+    {
+      ++Lookups;
+      return Delegate->FindValue(name, val);
+    }
+
+    bool FindValue(Parameters::Identifier name, Parameters::StringType& val) const override
+    {
+      ++Lookups;
+      return Delegate->FindValue(name, val);
+    }
+
+    bool FindValue(Parameters::Identifier name, Parameters::DataType& val) const override
+    {
+      ++Lookups;
+      return Delegate->FindValue(name, val);
+    }
+
+    void Process(Parameters::Visitor& visitor) const override
+    {
+      Delegate->Process(visitor);
+    }
+
+    mutable uint_t Versions = 0;
+    mutable uint_t Lookups = 0;
+
+  private:
+    const Parameters::Accessor::Ptr Delegate;
+  };
+
   template<class T>
   void TestFind(const Parameters::Accessor& src, StringView name, const T* ref)
   {
@@ -286,6 +337,54 @@ namespace
     }
     Test("final version", cont->Version(), 14u);
   }
+
+  void TestSnapshot()
+  {
+    std::cout << "---- Test for Parameters::CreateSnapshotAccessor" << std::endl;
+    const auto first = Parameters::Container::Create();
+    const auto second = Parameters::Container::Create();
+    const Parameters::IntType int1 = 1, int2 = 2, int3 = 3, *noInt = nullptr;
+    const Parameters::StringType str1 = "str1", *noString = nullptr;
+    const Parameters::DataType data1(3, 1), *noData = nullptr;
+    first->SetValue("int", int1);
+    second->SetValue("int", int2);
+    second->SetValue("str", str1);
+    second->SetValue("bin", data1);
+    const auto chain = std::make_shared<CountingAccessor>(Parameters::CreateMergedAccessor(first, second));
+    const auto snapshot = Parameters::CreateSnapshotAccessor(chain);
+    for (uint_t pass = 0; pass != 2; ++pass)
+    {
+      std::cout << "Pass " << pass << std::endl;
+      TestFind(*snapshot, "int", &int1);
+      TestFind(*snapshot, "int", noString);
+      TestFind(*snapshot, "str", &str1);
+      TestFind(*snapshot, "str", noInt);
+      TestFind(*snapshot, "bin", &data1);
+      TestFind(*snapshot, "bin", noString);
+      TestFind(*snapshot, "none", noInt);
+      TestFind(*snapshot, "none", noData);
+    }
+    Test("chain version checks", chain->Versions, 1u);
+    Test("chain lookups", chain->Lookups, 8u);
+    Test("version", snapshot->Version(), first->Version() + second->Version());
+    TestFind(*snapshot, "int", &int1);
+    Test("unchanged chain lookups", chain->Lookups, 8u);
+    std::cout << "Changed underlying values" << std::endl;
+    first->RemoveValue("int");
+    second->SetValue("none", int3);
+    TestFind(*snapshot, "int", &int1);
+    Test("version", snapshot->Version(), first->Version() + second->Version());
+    TestFind(*snapshot, "int", &int2);
+    TestFind(*snapshot, "none", &int3);
+    TestFind(*snapshot, "none", noData);
+    Test("changed chain lookups", chain->Lookups, 11u);
+    {
+      CountingVisitor cnt;
+      snapshot->Process(cnt);
+      Test("integers", cnt.Integers, {int2, int3});
+      Test("strings", cnt.Strings, {str1});
+    }
+  }
 }  // namespace
 
 int main()
@@ -294,6 +393,7 @@ int main()
   {
     TestIdentifier();
     TestContainer();
+    TestSnapshot();
   }
   catch (int code)
   {
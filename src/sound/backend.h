@@ -14,6 +14,7 @@
 #include <error.h>
 #include <iterator.h>
 // library includes
+#include <module/holder.h>
 #include <module/state.h>
 #include <sound/analyzer.h>
 #include <sound/gain.h>
@@ -106,6 +107,24 @@ namespace Sound
     virtual State GetCurrentState() const = 0;
   };
 
+  //! @brief Seamless playback of modules sequence
+  class TransitionControl
+  {
+  public:
+    //! @brief Pointer type
+    typedef std::shared_ptr<TransitionControl> Ptr;
+
+    virtual ~TransitionControl() = default;
+
+    //! @brief Schedule module to be played right after the current one keeping output device opened
+    //! @param module Module to play next, empty pointer cancels pending transition
+    //! @throw Error in case of error
+    //! @note Modules are crossfaded according to Parameters::ZXTune::Sound::CROSSFADE value
+    //! @note No transition happens while current module is played in loop
+    //! @note Only single module may be pending, subsequent call replaces previously scheduled one
+    virtual void SetNext(Module::Holder::Ptr module) = 0;
+  };
+
   //! @brief %Sound backend interface
   class Backend
   {
@@ -127,6 +146,23 @@ namespace Sound
     //! @brief Getting volume controller
     //! @return Pointer to volume control object if supported, empty pointer if not
     virtual VolumeControl::Ptr GetVolumeControl() const = 0;
+
+    //! @brief Getting transitions controller
+    virtual TransitionControl::Ptr GetTransitionControl() const = 0;
+
+    //! @brief Render-ahead buffer state
+    //! @see Parameters::ZXTune::Sound::Backends::RENDER_AHEAD
+    struct Statistic
+    {
+      //! Sound rendered in advance and not passed to output yet
+      Time::Milliseconds Buffered;
+      //! Times output had to wait for rendering since playback start
+      uint_t Underruns = 0;
+    };
+
+    //! @brief Getting render-ahead buffer state
+    //! @return Empty statistic if render-ahead is not used
+    virtual Statistic GetStatistic() const = 0;
   };
 
   class BackendCallback
@@ -136,10 +172,14 @@ namespace Sound
     virtual ~BackendCallback() = default;
 
     virtual void OnStart() = 0;
+    //! @brief Called from playback thread before each frame is passed to output
+    //! @param state Position at the start of frame. With render-ahead, it's a snapshot taken while rendering
     virtual void OnFrame(const Module::State& state) = 0;
     virtual void OnStop() = 0;
     virtual void OnPause() = 0;
     virtual void OnResume() = 0;
     virtual void OnFinish() = 0;
+    //! @brief Called from playback thread when next module scheduled via TransitionControl is started
+    virtual void OnTransition() = 0;
   };
 }  // namespace Sound
@@ -21,6 +21,7 @@
 #include <error_tools.h>
 #include <make_ptr.h>
 // library includes
+#include <async/ring_queue.h>
 #include <debug/log.h>
 #include <math/numeric.h>
 #include <sound/backend_attrs.h>
@@ -28,7 +29,11 @@
 #include <sound/render_params.h>
 #include <sound/sound_parameters.h>
 // std includes
+#include <atomic>
+#include <cstring>
 #include <functional>
+#include <mutex>
+#include <thread>
 // boost includes
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -44,6 +49,12 @@ namespace Sound::Alsa
   const uint_t LATENCY_MIN = 20;
   const uint_t LATENCY_MAX = 10000;
 
+  const uint_t PERIOD_MIN = 1;
+  const uint_t PERIOD_MAX = 1000;
+
+  // render-ahead ring size in chunks for mmap mode
+  const std::size_t RING_CHUNKS = 4;
+
   inline void CheckResult(Api& api, int res, Error::LocationRef loc)
   {
     if (res < 0)
@@ -272,6 +283,61 @@ namespace Sound::Alsa
         size -= res;
       }
     }
+
+    //! @return frames written, 0 if no space available or stream was recovered
+    std::size_t TryWriteMmap(const Sample* data, std::size_t size)
+    {
+      const auto avail = AlsaApi->snd_pcm_avail_update(Handle);
+      if (avail <= 0)
+      {
+        Recover(avail);
+        return 0;
+      }
+      const snd_pcm_channel_area_t* areas = nullptr;
+      snd_pcm_uframes_t offset = 0;
+      snd_pcm_uframes_t frames = std::min<snd_pcm_uframes_t>(avail, size);
+      if (const auto res = AlsaApi->snd_pcm_mmap_begin(Handle, &areas, &offset, &frames))
+      {
+        Recover(res);
+        return 0;
+      }
+      // interleaved access- all the channels are in the first area
+      const auto& area = areas[0];
+      auto* const target = static_cast<uint8_t*>(area.addr) + (area.first + offset * area.step) / 8;
+      std::memcpy(target, data, frames * sizeof(*data));
+      const auto res = AlsaApi->snd_pcm_mmap_commit(Handle, offset, frames);
+      if (res < 0)
+      {
+        Recover(res);
+        return 0;
+      }
+      return res;
+    }
+
+    void Wait(Time::Milliseconds timeout)
+    {
+      const auto res = AlsaApi->snd_pcm_wait(Handle, timeout.Get());
+      if (res < 0)
+      {
+        Recover(res);
+      }
+    }
+
+    //! @return frames to be played before the last written one
+    std::size_t GetDelay() const
+    {
+      snd_pcm_sframes_t delay = 0;
+      return AlsaApi->snd_pcm_delay(Handle, &delay) >= 0 && delay > 0 ? delay : 0;
+    }
+
+  private:
+    void Recover(int err)
+    {
+      if (err < 0 && AlsaApi->snd_pcm_recover(Handle, err, 1) < 0)
+      {
+        CheckedCall(&Api::snd_pcm_prepare, THIS_LINE);
+      }
+    }
   };
 
   template<class T>
@@ -304,7 +370,8 @@ namespace Sound::Alsa
       {}
     }
 
-    void SetParameters(Time::Milliseconds lat, const RenderParameters& params)
+    //! @param period non-zero value enables period-driven mmap access
+    void SetParameters(Time::Milliseconds lat, Time::Milliseconds period, const RenderParameters& params)
     {
       const std::shared_ptr<snd_pcm_hw_params_t> hwParams =
           Allocate<snd_pcm_hw_params_t>(AlsaApi, &Api::snd_pcm_hw_params_malloc, &Api::snd_pcm_hw_params_free);
@@ -324,25 +391,35 @@ namespace Sound::Alsa
       }
 
       const unsigned freq = params.SoundFreq();
-      const unsigned latency = Time::Microseconds(lat).Get();
-      Dbg("Setting parameters: rate=%1%Hz latency=%2%uS", freq, latency);
-      Pcm.CheckedCall(&Api::snd_pcm_set_params, fmt.Get(), SND_PCM_ACCESS_RW_INTERLEAVED, unsigned(Sample::CHANNELS),
-                      freq, 1, latency, THIS_LINE);
+      if (period)
+      {
+        SetMmapParameters(*hwParams, fmt.Get(), freq, lat, period);
+      }
+      else
+      {
+        const unsigned latency = Time::Microseconds(lat).Get();
+        Dbg("Setting parameters: rate=%1%Hz latency=%2%uS", freq, latency);
+        Pcm.CheckedCall(&Api::snd_pcm_set_params, fmt.Get(), SND_PCM_ACCESS_RW_INTERLEAVED,
+                        unsigned(Sample::CHANNELS), freq, 1, latency, THIS_LINE);
+      }
 
       Pcm.CheckedCall(&Api::snd_pcm_prepare, THIS_LINE);
 
       CanPause = canPause;
       Format = fmt.Get();
+      Frequency = freq;
     }
 
     void Close()
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       Pcm.Close();
       CanPause = false;
       Format = SND_PCM_FORMAT_UNKNOWN;
+      DelayFrames = 0;
     }
 
-    void Write(Chunk& buffer)
+    void Convert(Chunk& buffer) const
     {
       switch (Format)
       {
@@ -357,13 +434,36 @@ namespace Sound::Alsa
         assert(!"Unsupported format");
         break;
       }
+    }
+
+    void Write(Chunk& buffer)
+    {
+      Convert(buffer);
       Pcm.Write(buffer);
+      DelayFrames = Pcm.GetDelay();
+    }
+
+    //! @return frames written, 0 if device is not ready to accept data
+    std::size_t TryWriteMmap(const Sample* data, std::size_t size)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      const auto written = Pcm.TryWriteMmap(data, size);
+      DelayFrames = Pcm.GetDelay();
+      return written;
+    }
+
+    //! @brief Wait for period available without locking device
+    void Wait()
+    {
+      // limited timeout to handle paused state and stopping
+      Pcm.Wait(PeriodTime * 2);
     }
 
     void Pause()
     {
       if (CanPause)
       {
+        const std::lock_guard<std::mutex> lock(Guard);
         Pcm.CheckedCall(&Api::snd_pcm_pause, 1, THIS_LINE);
       }
     }
@@ -372,15 +472,130 @@ namespace Sound::Alsa
     {
       if (CanPause)
       {
+        const std::lock_guard<std::mutex> lock(Guard);
         Pcm.CheckedCall(&Api::snd_pcm_pause, 0, THIS_LINE);
       }
     }
 
+    //! @brief Delay of the last written sample as of last write operation
+    Time::Milliseconds GetDelay(std::size_t extraFrames) const
+    {
+      return Frequency ? Time::Milliseconds::FromRatio(DelayFrames + extraFrames, Frequency) : Time::Milliseconds();
+    }
+
+  private:
+    void SetMmapParameters(snd_pcm_hw_params_t& hwParams, snd_pcm_format_t fmt, unsigned freq,
+                           Time::Milliseconds lat, Time::Milliseconds period)
+    {
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params_set_access, &hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED, THIS_LINE);
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params_set_format, &hwParams, fmt, THIS_LINE);
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params_set_channels, &hwParams, unsigned(Sample::CHANNELS), THIS_LINE);
+      unsigned rate = freq;
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params_set_rate_near, &hwParams, &rate, static_cast<int*>(nullptr),
+                      THIS_LINE);
+      if (rate != freq)
+      {
+        throw MakeFormattedError(THIS_LINE, translate("ALSA backend error: samplerate %1%Hz is not supported."),
+                                 freq);
+      }
+      snd_pcm_uframes_t periodSize = freq * period.Get() / period.PER_SECOND;
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params_set_period_size_near, &hwParams, &periodSize,
+                      static_cast<int*>(nullptr), THIS_LINE);
+      snd_pcm_uframes_t bufferSize = std::max<snd_pcm_uframes_t>(freq * lat.Get() / lat.PER_SECOND, periodSize * 2);
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params_set_buffer_size_near, &hwParams, &bufferSize, THIS_LINE);
+      Dbg("Setting mmap parameters: rate=%1%Hz period=%2% buffer=%3% frames", freq, periodSize, bufferSize);
+      Pcm.CheckedCall(&Api::snd_pcm_hw_params, &hwParams, THIS_LINE);
+
+      const std::shared_ptr<snd_pcm_sw_params_t> swParams =
+          Allocate<snd_pcm_sw_params_t>(AlsaApi, &Api::snd_pcm_sw_params_malloc, &Api::snd_pcm_sw_params_free);
+      Pcm.CheckedCall(&Api::snd_pcm_sw_params_current, swParams.get(), THIS_LINE);
+      // start as soon as the first period is ready and wake up writer on each period
+      Pcm.CheckedCall(&Api::snd_pcm_sw_params_set_start_threshold, swParams.get(), periodSize, THIS_LINE);
+      Pcm.CheckedCall(&Api::snd_pcm_sw_params_set_avail_min, swParams.get(), periodSize, THIS_LINE);
+      Pcm.CheckedCall(&Api::snd_pcm_sw_params, swParams.get(), THIS_LINE);
+      PeriodTime = Time::Milliseconds::FromRatio(periodSize, freq);
+    }
+
   private:
     const Api::Ptr AlsaApi;
     PCMDevice Pcm;
     bool CanPause;
     snd_pcm_format_t Format;
+    uint_t Frequency = 0;
+    Time::Milliseconds PeriodTime;
+    std::mutex Guard;
+    std::atomic<std::size_t> DelayFrames = 0;
+  };
+
+  // Render-ahead ring filled by rendering thread and drained to device by period-driven writer thread
+  class MmapStream
+  {
+  public:
+    typedef std::shared_ptr<MmapStream> Ptr;
+
+    explicit MmapStream(DeviceWrapper::Ptr dev)
+      : Dev(std::move(dev))
+      , Chunks(RING_CHUNKS)
+      , Writer([this]() { WriteLoop(); })
+    {}
+
+    ~MmapStream()
+    {
+      if (Writer.joinable())
+      {
+        Active = false;
+        Chunks.Reset();
+        Writer.join();
+      }
+    }
+
+    void Add(Chunk data)
+    {
+      Dev->Convert(data);
+      Queued += data.size();
+      Chunks.Add(std::move(data));
+    }
+
+    //! @brief Wait until all the queued data is passed to device
+    void Flush()
+    {
+      Chunks.Flush();
+      Chunks.Reset();
+      Writer.join();
+    }
+
+    Time::Milliseconds GetDelay() const
+    {
+      return Dev->GetDelay(Queued);
+    }
+
+  private:
+    void WriteLoop()
+    {
+      Chunk data;
+      while (Chunks.Get(data))
+      {
+        for (const Sample *pos = data.data(), *lim = pos + data.size(); pos != lim && Active;)
+        {
+          if (const auto written = Dev->TryWriteMmap(pos, lim - pos))
+          {
+            pos += written;
+            Queued -= written;
+          }
+          else
+          {
+            Dev->Wait();
+          }
+        }
+      }
+    }
+
+  private:
+    const DeviceWrapper::Ptr Dev;
+    Async::SpscQueue<Chunk> Chunks;
+    std::atomic<std::size_t> Queued = 0;
+    std::atomic<bool> Active = true;
+    std::thread Writer;
   };
 
   class MixerElementsIterator
@@ -694,6 +909,25 @@ namespace Sound::Alsa
       return Time::Milliseconds(val);
     }
 
+    //! @return zero period in case of non-mmap mode
+    Time::Milliseconds GetPeriod() const
+    {
+      using namespace Parameters::ZXTune::Sound::Backends::Alsa;
+      Parameters::IntType mmap = MMAP_DEFAULT;
+      Accessor.FindValue(MMAP, mmap);
+      if (!mmap)
+      {
+        return {};
+      }
+      Parameters::IntType val = PERIOD_DEFAULT;
+      if (Accessor.FindValue(PERIOD, val) && !Math::InRange<Parameters::IntType>(val, PERIOD_MIN, PERIOD_MAX))
+      {
+        throw MakeFormattedError(THIS_LINE, translate("ALSA backend error: period (%1%) is out of range (%2%..%3%)."),
+                                 static_cast<int_t>(val), PERIOD_MIN, PERIOD_MAX);
+      }
+      return Time::Milliseconds(val);
+    }
+
   private:
     const Parameters::Accessor& Accessor;
   };
@@ -714,13 +948,22 @@ namespace Sound::Alsa
     void Startup() override
     {
       Dbg("Starting");
-      Objects = OpenDevices();
+      auto objects = OpenDevices();
+      const std::lock_guard<std::mutex> lock(Guard);
+      Objects = std::move(objects);
       Dbg("Started");
     }
 
     void Shutdown() override
     {
       Dbg("Stopping");
+      if (Objects.Stream)
+      {
+        // play the rest of render-ahead ring
+        Objects.Stream->Flush();
+      }
+      const std::lock_guard<std::mutex> lock(Guard);
+      Objects.Stream.reset();
       Objects.Vol.reset();
       Objects.Mix.reset();
       Objects.Dev.reset();
@@ -741,7 +984,14 @@ namespace Sound::Alsa
 
     void FrameFinish(Chunk buffer) override
     {
-      Objects.Dev->Write(buffer);
+      if (Objects.Stream)
+      {
+        Objects.Stream->Add(std::move(buffer));
+      }
+      else
+      {
+        Objects.Dev->Write(buffer);
+      }
     }
 
     VolumeControl::Ptr GetVolumeControl() const override
@@ -749,10 +999,21 @@ namespace Sound::Alsa
       return CreateVolumeControlDelegate(Objects.Vol);
     }
 
+    Time::Milliseconds GetPlaybackDelay() const override
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      if (Objects.Stream)
+      {
+        return Objects.Stream->GetDelay();
+      }
+      return Objects.Dev ? Objects.Dev->GetDelay(0) : Time::Milliseconds();
+    }
+
   private:
     struct AlsaObjects
     {
       DeviceWrapper::Ptr Dev;
+      MmapStream::Ptr Stream;
       Mixer::Ptr Mix;
       VolumeControl::Ptr Vol;
     };
@@ -765,7 +1026,12 @@ namespace Sound::Alsa
 
       AlsaObjects res;
       res.Dev = MakePtr<DeviceWrapper>(AlsaApi, deviceId);
-      res.Dev->SetParameters(backend.GetLatency(), *sound);
+      const auto period = backend.GetPeriod();
+      res.Dev->SetParameters(backend.GetLatency(), period, *sound);
+      if (period)
+      {
+        res.Stream = MakePtr<MmapStream>(res.Dev);
+      }
       res.Mix = MakePtr<Mixer>(AlsaApi, deviceId, backend.GetMixerName());
       res.Vol = MakePtr<VolumeControl>(res.Mix);
       return res;
@@ -774,6 +1040,7 @@ namespace Sound::Alsa
   private:
     const Api::Ptr AlsaApi;
     const Parameters::Accessor::Ptr Params;
+    mutable std::mutex Guard;
     AlsaObjects Objects;
   };
 
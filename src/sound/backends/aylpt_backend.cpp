@@ -92,6 +92,11 @@ namespace Sound::AyLpt
       return VolumeControl::Ptr();
     }
 
+    virtual Time::Milliseconds GetPlaybackDelay() const
+    {
+      return {};
+    }
+
     virtual void Startup()
     {
       Reset();
@@ -18,13 +18,22 @@
 // library includes
 #include <async/worker.h>
 #include <debug/log.h>
+#include <debug/metrics.h>
+#include <module/players/delayed_state.h>
 #include <module/players/pipeline.h>
+#include <module/track_state.h>
 #include <parameters/tracking_helper.h>
 #include <sound/impl/fft_analyzer.h>
+#include <sound/backends_parameters.h>
 #include <sound/render_params.h>
 #include <sound/sound_parameters.h>
 // std includes
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
 
 #define FILE_TAG B3D60DB5
 
@@ -75,26 +84,55 @@ namespace Sound::BackendBase
       Delegate->OnFinish();
     }
 
+    void OnTransition() override
+    {
+      Delegate->OnTransition();
+    }
+
   private:
     const BackendCallback::Ptr Delegate;
     const BackendWorker::Ptr Worker;
   };
 
+  // Single module in playback sequence
+  struct Track
+  {
+    Module::PipelinedRenderer::Ptr Renderer;
+    Time::Milliseconds Duration;
+    // crossfade with previous track
+    Time::Milliseconds Fading;
+    std::size_t FadingSamples = 0;
+
+    static Track Create(const Module::Holder& holder, Parameters::Accessor::Ptr params)
+    {
+      using namespace Parameters::ZXTune::Sound;
+      Track result;
+      result.Renderer = Module::CreatePipelinedRenderer(holder, params);
+      result.Duration = holder.GetModuleInformation()->Duration();
+      auto crossfade = CROSSFADE_DEFAULT;
+      params->FindValue(CROSSFADE, crossfade);
+      result.Fading = Time::Milliseconds::FromRatio(crossfade, CROSSFADE_PRECISION);
+      result.FadingSamples = std::size_t(GetSoundFrequency(*params)) * result.Fading.Get() / result.Fading.PER_SECOND;
+      return result;
+    }
+  };
+
   class RendererWrapper : public Module::Renderer
   {
   public:
     using Ptr = std::shared_ptr<RendererWrapper>;
 
-    RendererWrapper(Module::Renderer::Ptr delegate, BackendCallback::Ptr callback)
-      : Delegate(std::move(delegate))
+    RendererWrapper(Track track, BackendCallback::Ptr callback)
+      : Current(std::move(track))
       , Callback(std::move(callback))
-      , State(Delegate->GetState())
+      , State(Current.Renderer->GetState())
       , SeekRequest(NO_SEEK)
-      , Analyzer(FFTAnalyzer::Create())
+      , Analyzer(FFTAnalyzer::CreateSnapshotting())
     {}
 
     Module::State::Ptr GetState() const override
     {
+      const std::lock_guard<std::mutex> lock(Guard);
       return State;
     }
 
@@ -108,10 +146,24 @@ namespace Sound::BackendBase
       const auto request = SeekRequest.exchange(NO_SEEK);
       if (request != NO_SEEK)
       {
-        Delegate->SetPosition(Time::AtMillisecond(request));
+        CancelFading();
+        Current.Renderer->SetPosition(Time::AtMillisecond(request));
+      }
+      const auto& state = *Current.Renderer->GetState();
+      Callback->OnFrame(state);
+      const auto frameStart = state.At();
+      auto result = Current.Renderer->Render(looped);
+      if (result.empty())
+      {
+        if (SwitchToNext())
+        {
+          result = Current.Renderer->Render(looped);
+        }
+      }
+      else if (!looped.Enabled)
+      {
+        MixNext(looped, frameStart, result);
       }
-      Callback->OnFrame(*State);
-      auto result = Delegate->Render(looped);
       Analyzer->FeedSound(result.data(), result.size());
       return result;
     }
@@ -119,7 +171,8 @@ namespace Sound::BackendBase
     void Reset() override
     {
       SeekRequest = NO_SEEK;
-      Delegate->Reset();
+      CancelFading();
+      Current.Renderer->Reset();
     }
 
     void SetPosition(Time::AtMillisecond request) override
@@ -127,11 +180,80 @@ namespace Sound::BackendBase
       SeekRequest = request.Get();
     }
 
+    void SetNext(Track next)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      // restart crossfade if any
+      FadingPosition = 0;
+      Next = std::move(next);
+    }
+
+  private:
+    // called from playback thread only
+    void MixNext(const Sound::LoopParameters& looped, Time::AtMillisecond frameStart, Sound::Chunk& data)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      if (!Next.Renderer || !Next.FadingSamples)
+      {
+        return;
+      }
+      if (frameStart.Get() + Next.Fading.Get() < Current.Duration.Get())
+      {
+        return;
+      }
+      const auto size = data.size();
+      FadingBuffer.resize(size);
+      const auto done = Next.Renderer->Render(looped, FadingBuffer.data(), size);
+      std::fill(FadingBuffer.begin() + done, FadingBuffer.end(), Sample());
+      for (std::size_t idx = 0; idx != size; ++idx, ++FadingPosition)
+      {
+        const auto in = std::min<Sample::WideType>(FADING_SCALE * FadingPosition / Next.FadingSamples, FADING_SCALE);
+        const auto out = FADING_SCALE - in;
+        const auto cur = data[idx];
+        const auto next = FadingBuffer[idx];
+        data[idx] = Sample((cur.Left() * out + next.Left() * in) / FADING_SCALE,
+                           (cur.Right() * out + next.Right() * in) / FADING_SCALE);
+      }
+    }
+
+    bool SwitchToNext()
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        if (!Next.Renderer)
+        {
+          return false;
+        }
+        Dbg("Switch to next track after %1% crossfaded samples", FadingPosition);
+        Current = std::move(Next);
+        Next = Track();
+        FadingPosition = 0;
+        State = Current.Renderer->GetState();
+      }
+      Callback->OnTransition();
+      return true;
+    }
+
+    void CancelFading()
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      if (FadingPosition)
+      {
+        Next.Renderer->Reset();
+        FadingPosition = 0;
+      }
+    }
+
   private:
     static const uint_t NO_SEEK = ~uint_t(0);
-    const Module::Renderer::Ptr Delegate;
+    static const Sample::WideType FADING_SCALE = 1 << 15;
+    Track Current;
     const BackendCallback::Ptr Callback;
-    const Module::State::Ptr State;
+    mutable std::mutex Guard;
+    Module::State::Ptr State;
+    Track Next;
+    std::size_t FadingPosition = 0;
+    std::vector<Sample> FadingBuffer;
     std::atomic<uint_t> SeekRequest;
     const FFTAnalyzer::Ptr Analyzer;
   };
@@ -157,16 +279,452 @@ namespace Sound::BackendBase
     mutable LoopParameters Value;
   };
 
+  // Values of state at the start of frame rendered in advance
+  template<class Base>
+  class StateSnapshotBase : public Base
+  {
+  public:
+    explicit StateSnapshotBase(const Module::State& state)
+      : Position(state.At())
+      , Played(state.Total())
+      , Loops(state.LoopCount())
+    {}
+
+    Time::AtMillisecond At() const override
+    {
+      return Position;
+    }
+
+    Time::Milliseconds Total() const override
+    {
+      return Played;
+    }
+
+    uint_t LoopCount() const override
+    {
+      return Loops;
+    }
+
+  private:
+    const Time::AtMillisecond Position;
+    const Time::Milliseconds Played;
+    const uint_t Loops;
+  };
+
+  using StateSnapshot = StateSnapshotBase<Module::State>;
+
+  class TrackStateSnapshot : public StateSnapshotBase<Module::TrackState>
+  {
+  public:
+    explicit TrackStateSnapshot(const Module::TrackState& state)
+      : StateSnapshotBase(state)
+      , Pos(state.Position())
+      , Pat(state.Pattern())
+      , Ln(state.Line())
+      , Tmp(state.Tempo())
+      , Qrk(state.Quirk())
+      , Chans(state.Channels())
+    {}
+
+    uint_t Position() const override
+    {
+      return Pos;
+    }
+
+    uint_t Pattern() const override
+    {
+      return Pat;
+    }
+
+    uint_t Line() const override
+    {
+      return Ln;
+    }
+
+    uint_t Tempo() const override
+    {
+      return Tmp;
+    }
+
+    uint_t Quirk() const override
+    {
+      return Qrk;
+    }
+
+    uint_t Channels() const override
+    {
+      return Chans;
+    }
+
+  private:
+    const uint_t Pos;
+    const uint_t Pat;
+    const uint_t Ln;
+    const uint_t Tmp;
+    const uint_t Qrk;
+    const uint_t Chans;
+  };
+
+  Module::State::Ptr CaptureState(const Module::State& state)
+  {
+    if (const auto track = dynamic_cast<const Module::TrackState*>(&state))
+    {
+      return MakePtr<TrackStateSnapshot>(*track);
+    }
+    return MakePtr<StateSnapshot>(state);
+  }
+
+  /*
+    Frames and transitions happened while rendering in advance are captured to be reported from playback thread when
+    the sound is passed to output.
+  */
+  class DeferredCallback : public BackendCallback
+  {
+  public:
+    using Ptr = std::shared_ptr<DeferredCallback>;
+
+    explicit DeferredCallback(BackendCallback::Ptr delegate)
+      : Delegate(std::move(delegate))
+    {}
+
+    void OnStart() override
+    {
+      Delegate->OnStart();
+    }
+
+    void OnFrame(const Module::State& state) override
+    {
+      Frame = CaptureState(state);
+    }
+
+    void OnStop() override
+    {
+      Delegate->OnStop();
+    }
+
+    void OnPause() override
+    {
+      Delegate->OnPause();
+    }
+
+    void OnResume() override
+    {
+      Delegate->OnResume();
+    }
+
+    void OnFinish() override
+    {
+      Delegate->OnFinish();
+    }
+
+    void OnTransition() override
+    {
+      Happened = true;
+    }
+
+    //! @return State of the last rendered frame start
+    Module::State::Ptr FetchFrame()
+    {
+      return std::move(Frame);
+    }
+
+    //! @return true if transition happened since previous call
+    bool FetchTransition()
+    {
+      return Happened.exchange(false);
+    }
+
+  private:
+    const BackendCallback::Ptr Delegate;
+    // accessed from render thread only
+    Module::State::Ptr Frame;
+    std::atomic<bool> Happened = false;
+  };
+
+  // Sound rendered in advance, filled by render thread and drained by playback thread
+  class RenderAheadBuffer
+  {
+  public:
+    using Ptr = std::shared_ptr<RenderAheadBuffer>;
+
+    RenderAheadBuffer(uint_t samplerate, Time::Milliseconds limit)
+      : Samplerate(samplerate)
+      , Limit(std::max<std::size_t>(1, std::size_t(samplerate) * limit.Get() / limit.PER_SECOND))
+      , Underruns(Debug::Metrics::GetCounter("sound.underruns"))
+    {}
+
+    static const uint_t NO_SEEK = ~uint_t(0);
+
+    void Open()
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Drop();
+      Active = true;
+      Failed = false;
+      UnderrunsCount = 0;
+    }
+
+    void Close()
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        Active = false;
+      }
+      NotFull.notify_all();
+      NotEmpty.notify_all();
+    }
+
+    //! @brief Drop all the rendered sound and request rendering from specified position
+    void Seek(Time::AtMillisecond position)
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        Drop();
+        SeekRequest = position.Get();
+      }
+      NotFull.notify_all();
+    }
+
+    bool IsActive() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Active && !Failed;
+    }
+
+    //! @return Value changed on each seek to detect outdated data
+    //! @param seek Set to requested position if any, so data rendered from it matches returned generation
+    uint_t GetGeneration(uint_t& seek)
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      seek = SeekRequest;
+      SeekRequest = NO_SEEK;
+      return Generation;
+    }
+
+    //! @brief Store rendered data, waiting for free space
+    //! @param frame State at the start of data
+    //! @param data Empty chunk is the end of playback
+    //! @param transition Next track is started in the data
+    //! @return false if buffer is not active anymore
+    bool Put(uint_t generation, Module::State::Ptr frame, Chunk data, bool transition)
+    {
+      {
+        std::unique_lock<std::mutex> lock(Guard);
+        NotFull.wait(lock, [this, generation]() {
+          return !Active || Generation != generation || BufferedSamples < Limit;
+        });
+        if (!Active)
+        {
+          return false;
+        }
+        if (Generation != generation)
+        {
+          // track switching cannot be undone by seeking
+          PendingTransition |= transition;
+          return true;
+        }
+        BufferedSamples += data.size();
+        Entries.push_back({std::move(frame), std::move(data), transition});
+      }
+      NotEmpty.notify_one();
+      return true;
+    }
+
+    //! @brief Wait for seeking after the end of playback
+    void WaitForSeek(uint_t generation)
+    {
+      std::unique_lock<std::mutex> lock(Guard);
+      NotFull.wait(lock, [this, generation]() { return !Active || Generation != generation; });
+    }
+
+    void Fail(const Error& err)
+    {
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        LastError = err;
+        Failed = true;
+      }
+      NotEmpty.notify_all();
+    }
+
+    //! @brief Get the next portion of rendered sound, waiting for rendering if required
+    //! @param frame Set to state at the start of result
+    //! @param transition Set if next track is started in result
+    Chunk Get(Module::State::Ptr& frame, bool& transition)
+    {
+      Chunk result;
+      {
+        std::unique_lock<std::mutex> lock(Guard);
+        if (Entries.empty() && Primed && !Failed)
+        {
+          ++UnderrunsCount;
+          Underruns.Add();
+        }
+        NotEmpty.wait(lock, [this]() { return !Entries.empty() || Failed || !Active; });
+        if (Failed)
+        {
+          throw LastError;
+        }
+        if (Entries.empty())
+        {
+          return result;
+        }
+        auto& entry = Entries.front();
+        frame = std::move(entry.Frame);
+        result = std::move(entry.Data);
+        transition = entry.Transition || PendingTransition;
+        PendingTransition = false;
+        Entries.pop_front();
+        BufferedSamples -= result.size();
+        // no underruns expected after the end of playback
+        Primed = !result.empty();
+      }
+      NotFull.notify_one();
+      return result;
+    }
+
+    Time::Milliseconds GetBuffered() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Time::Milliseconds(BufferedSamples * Time::Milliseconds::PER_SECOND / Samplerate);
+    }
+
+    uint_t GetUnderruns() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return UnderrunsCount;
+    }
+
+  private:
+    void Drop()
+    {
+      for (const auto& entry : Entries)
+      {
+        PendingTransition |= entry.Transition;
+      }
+      Entries.clear();
+      BufferedSamples = 0;
+      ++Generation;
+      // waiting for the first portion after start or seek is not an underrun
+      Primed = false;
+    }
+
+  private:
+    struct Entry
+    {
+      Module::State::Ptr Frame;
+      Chunk Data;
+      bool Transition;
+    };
+
+    const uint_t Samplerate;
+    const std::size_t Limit;
+    Debug::Metrics::Counter& Underruns;
+    mutable std::mutex Guard;
+    std::condition_variable NotFull;
+    std::condition_variable NotEmpty;
+    std::deque<Entry> Entries;
+    std::size_t BufferedSamples = 0;
+    uint_t Generation = 0;
+    uint_t SeekRequest = NO_SEEK;
+    bool Active = false;
+    bool Primed = false;
+    bool PendingTransition = false;
+    bool Failed = false;
+    Error LastError;
+    uint_t UnderrunsCount = 0;
+  };
+
+  // Fills render-ahead buffer in separate thread so output is not affected by rendering hiccups
+  class RenderAheadWorker : public Async::Worker
+  {
+  public:
+    RenderAheadWorker(Parameters::Accessor::Ptr params, Module::Renderer::Ptr render,
+                      DeferredCallback::Ptr callback, RenderAheadBuffer::Ptr buffer)
+      : Looped(std::move(params))
+      , Renderer(std::move(render))
+      , Callback(std::move(callback))
+      , Buffer(std::move(buffer))
+      , RenderTime(Debug::Metrics::GetHistogram("sound.render"))
+    {}
+
+    void Initialize() override
+    {
+      Dbg("Render-ahead started");
+    }
+
+    void Finalize() override
+    {
+      Dbg("Render-ahead stopped");
+    }
+
+    void Suspend() override {}
+
+    void Resume() override {}
+
+    void ExecuteCycle() override
+    {
+      uint_t seek = RenderAheadBuffer::NO_SEEK;
+      const auto generation = Buffer->GetGeneration(seek);
+      try
+      {
+        if (seek != RenderAheadBuffer::NO_SEEK)
+        {
+          Renderer->SetPosition(Time::AtMillisecond(seek));
+        }
+        auto data = Render();
+        const bool finished = data.empty();
+        if (Buffer->Put(generation, Callback->FetchFrame(), std::move(data), Callback->FetchTransition()) && finished)
+        {
+          // playback may be continued after seeking
+          Buffer->WaitForSeek(generation);
+        }
+      }
+      catch (const std::exception& e)
+      {
+        Buffer->Fail(Error(THIS_LINE, e.what()));
+      }
+      catch (const Error& e)
+      {
+        Buffer->Fail(e);
+      }
+    }
+
+    bool IsFinished() const override
+    {
+      return !Buffer->IsActive();
+    }
+
+  private:
+    Sound::Chunk Render()
+    {
+      const Debug::Metrics::ScopedTimer timer(RenderTime);
+      return Renderer->Render(*Looped);
+    }
+
+  private:
+    const LoopParameterAdapter Looped;
+    const Module::Renderer::Ptr Renderer;
+    const DeferredCallback::Ptr Callback;
+    const RenderAheadBuffer::Ptr Buffer;
+    Debug::Metrics::Histogram& RenderTime;
+  };
+
   class AsyncWrapper : public Async::Worker
   {
   public:
     AsyncWrapper(Parameters::Accessor::Ptr params, BackendCallback::Ptr callback, Module::Renderer::Ptr render,
-                 BackendWorker::Ptr worker)
+                 BackendWorker::Ptr worker, RenderAheadBuffer::Ptr buffer, Async::Job::Ptr renderJob)
       : Looped(std::move(params))
       , Callback(std::move(callback))
       , Renderer(std::move(render))
       , Worker(std::move(worker))
+      , Buffer(std::move(buffer))
+      , RenderJob(std::move(renderJob))
       , Playing(false)
+      , RenderTime(Debug::Metrics::GetHistogram("sound.render"))
+      , OutputTime(Debug::Metrics::GetHistogram("sound.output"))
+      , Frames(Debug::Metrics::GetCounter("sound.frames"))
     {}
 
     void Initialize() override
@@ -182,6 +740,7 @@ namespace Sound::BackendBase
       }
       try
       {
+        StartRenderAhead();
         // initial frame rendering
         RenderFrame();
         Dbg("Initialized");
@@ -189,6 +748,7 @@ namespace Sound::BackendBase
       catch (const Error& e)
       {
         Dbg("Deinitialize backend worker due to error while rendering initial frame");
+        StopRenderAhead();
         Callback->OnStop();
         throw Error(THIS_LINE, translate("Failed to initialize playback.")).AddSuberror(e);
       }
@@ -200,6 +760,7 @@ namespace Sound::BackendBase
       {
         Dbg("Finalizing");
         Playing = false;
+        StopRenderAhead();
         Callback->OnStop();
         Dbg("Finalized");
       }
@@ -256,10 +817,12 @@ namespace Sound::BackendBase
     {
       try
       {
-        auto data = Renderer->Render(*Looped);
+        auto data = Render();
         if (!data.empty())
         {
           Playing = true;
+          Frames.Add();
+          const Debug::Metrics::ScopedTimer timer(OutputTime);
           Worker->FrameFinish(std::move(data));
         }
         else
@@ -279,13 +842,58 @@ namespace Sound::BackendBase
       }
     }
 
+    Sound::Chunk Render()
+    {
+      if (Buffer)
+      {
+        Module::State::Ptr frame;
+        bool transition = false;
+        auto result = Buffer->Get(frame, transition);
+        if (frame)
+        {
+          Callback->OnFrame(*frame);
+        }
+        if (transition)
+        {
+          Callback->OnTransition();
+        }
+        return result;
+      }
+      const Debug::Metrics::ScopedTimer timer(RenderTime);
+      return Renderer->Render(*Looped);
+    }
+
+    void StartRenderAhead()
+    {
+      if (Buffer)
+      {
+        Buffer->Open();
+        RenderJob->Start();
+      }
+    }
+
+    void StopRenderAhead()
+    {
+      if (Buffer)
+      {
+        Buffer->Close();
+        RenderJob->Stop();
+      }
+    }
+
   private:
     const LoopParameterAdapter Looped;
     const BackendWorker::Ptr Delegate;
     const BackendCallback::Ptr Callback;
     const Module::Renderer::Ptr Renderer;
     const BackendWorker::Ptr Worker;
+    // optional, see CreateSystemBackend
+    const RenderAheadBuffer::Ptr Buffer;
+    const Async::Job::Ptr RenderJob;
     std::atomic<bool> Playing;
+    Debug::Metrics::Histogram& RenderTime;
+    Debug::Metrics::Histogram& OutputTime;
+    Debug::Metrics::Counter& Frames;
   };
 
   class StubBackendCallback : public BackendCallback
@@ -302,6 +910,8 @@ namespace Sound::BackendBase
     void OnResume() override {}
 
     void OnFinish() override {}
+
+    void OnTransition() override {}
   };
 
   BackendCallback::Ptr CreateCallback(BackendCallback::Ptr callback, BackendWorker::Ptr worker)
@@ -314,9 +924,10 @@ namespace Sound::BackendBase
   class ControlInternal : public PlaybackControl
   {
   public:
-    ControlInternal(Async::Job::Ptr job, Module::Renderer::Ptr renderer)
+    ControlInternal(Async::Job::Ptr job, Module::Renderer::Ptr renderer, RenderAheadBuffer::Ptr buffer)
       : Job(std::move(job))
       , Renderer(std::move(renderer))
+      , Buffer(std::move(buffer))
     {}
 
     void Play() override
@@ -345,7 +956,15 @@ namespace Sound::BackendBase
     {
       try
       {
-        Renderer->SetPosition(request);
+        // rendered sound is dropped along with seeking to keep them consistent
+        if (Buffer)
+        {
+          Buffer->Seek(request);
+        }
+        else
+        {
+          Renderer->SetPosition(request);
+        }
       }
       catch (const Error& e)
       {
@@ -361,20 +980,71 @@ namespace Sound::BackendBase
   private:
     const Async::Job::Ptr Job;
     const Module::Renderer::Ptr Renderer;
+    const RenderAheadBuffer::Ptr Buffer;
+  };
+
+  class TransitionControlInternal : public TransitionControl
+  {
+  public:
+    TransitionControlInternal(Parameters::Accessor::Ptr params, RendererWrapper::Ptr renderer)
+      : Params(std::move(params))
+      , Renderer(std::move(renderer))
+    {}
+
+    void SetNext(Module::Holder::Ptr module) override
+    {
+      try
+      {
+        // heavy renderer creation is performed in caller's thread
+        Renderer->SetNext(module ? Track::Create(*module, Params) : Track());
+      }
+      catch (const Error& e)
+      {
+        throw Error(THIS_LINE, translate("Failed to schedule next module playback.")).AddSuberror(e);
+      }
+    }
+
+  private:
+    const Parameters::Accessor::Ptr Params;
+    const RendererWrapper::Ptr Renderer;
+  };
+
+  // Sound passed to output or buffered in advance
+  class PlaybackDelay : public Module::StateDelay
+  {
+  public:
+    PlaybackDelay(BackendWorker::Ptr worker, RenderAheadBuffer::Ptr buffer)
+      : Worker(std::move(worker))
+      , Buffer(std::move(buffer))
+    {}
+
+    Time::Milliseconds Get() const override
+    {
+      const auto delay = Worker->GetPlaybackDelay();
+      return Buffer ? delay + Buffer->GetBuffered() : delay;
+    }
+
+  private:
+    const BackendWorker::Ptr Worker;
+    const RenderAheadBuffer::Ptr Buffer;
   };
 
   class BackendInternal : public Backend
   {
   public:
-    BackendInternal(BackendWorker::Ptr worker, RendererWrapper::Ptr renderer, Async::Job::Ptr job)
+    BackendInternal(Parameters::Accessor::Ptr params, BackendWorker::Ptr worker, RendererWrapper::Ptr renderer,
+                    Async::Job::Ptr job, RenderAheadBuffer::Ptr buffer)
       : Worker(std::move(worker))
       , Renderer(std::move(renderer))
-      , Control(MakePtr<ControlInternal>(std::move(job), Renderer))
+      , Buffer(std::move(buffer))
+      , Delay(MakePtr<PlaybackDelay>(Worker, Buffer))
+      , Control(MakePtr<ControlInternal>(std::move(job), Renderer, Buffer))
+      , Transition(MakePtr<TransitionControlInternal>(std::move(params), Renderer))
     {}
 
     Module::State::Ptr GetState() const override
     {
-      return Renderer->GetState();
+      return Module::CreateDelayedState(Renderer->GetState(), Delay);
     }
 
     Analyzer::Ptr GetAnalyzer() const override
@@ -392,25 +1062,77 @@ namespace Sound::BackendBase
       return Worker->GetVolumeControl();
     }
 
+    TransitionControl::Ptr GetTransitionControl() const override
+    {
+      return Transition;
+    }
+
+    Statistic GetStatistic() const override
+    {
+      Statistic result;
+      if (Buffer)
+      {
+        result.Buffered = Buffer->GetBuffered();
+        result.Underruns = Buffer->GetUnderruns();
+      }
+      return result;
+    }
+
   private:
     const BackendWorker::Ptr Worker;
     const RendererWrapper::Ptr Renderer;
+    const RenderAheadBuffer::Ptr Buffer;
+    const Module::StateDelay::Ptr Delay;
     const PlaybackControl::Ptr Control;
+    const TransitionControl::Ptr Transition;
   };
+
+  Backend::Ptr CreateBackend(Parameters::Accessor::Ptr globalParams, Module::Holder::Ptr holder,
+                             BackendCallback::Ptr origCallback, BackendWorker::Ptr worker,
+                             Time::Milliseconds renderAhead)
+  {
+    auto track = Track::Create(*holder, globalParams);
+    auto callback = CreateCallback(std::move(origCallback), worker);
+    if (!renderAhead.Get())
+    {
+      auto renderer = MakePtr<RendererWrapper>(std::move(track), callback);
+      auto asyncWorker = MakePtr<AsyncWrapper>(globalParams, std::move(callback), renderer, worker,
+                                               RenderAheadBuffer::Ptr(), Async::Job::Ptr());
+      auto job = Async::CreateJob(std::move(asyncWorker));
+      return MakePtr<BackendInternal>(std::move(globalParams), std::move(worker), std::move(renderer), std::move(job),
+                                      RenderAheadBuffer::Ptr());
+    }
+    Dbg("Use %1%ms render-ahead", renderAhead.Get());
+    auto deferred = MakePtr<DeferredCallback>(callback);
+    auto renderer = MakePtr<RendererWrapper>(std::move(track), deferred);
+    auto buffer = MakePtr<RenderAheadBuffer>(GetSoundFrequency(*globalParams), renderAhead);
+    auto renderJob = Async::CreateJob(MakePtr<RenderAheadWorker>(globalParams, renderer, std::move(deferred), buffer));
+    auto asyncWorker =
+        MakePtr<AsyncWrapper>(globalParams, std::move(callback), renderer, worker, buffer, std::move(renderJob));
+    auto job = Async::CreateJob(std::move(asyncWorker));
+    return MakePtr<BackendInternal>(std::move(globalParams), std::move(worker), std::move(renderer), std::move(job),
+                                    std::move(buffer));
+  }
 }  // namespace Sound::BackendBase
 
 namespace Sound
 {
   Backend::Ptr CreateBackend(Parameters::Accessor::Ptr globalParams, Module::Holder::Ptr holder,
-                             BackendCallback::Ptr origCallback, BackendWorker::Ptr worker)
+                             BackendCallback::Ptr callback, BackendWorker::Ptr worker)
   {
-    auto origRenderer = Module::CreatePipelinedRenderer(*holder, globalParams);
-    auto callback = BackendBase::CreateCallback(std::move(origCallback), worker);
-    auto renderer = MakePtr<BackendBase::RendererWrapper>(std::move(origRenderer), callback);
-    auto asyncWorker =
-        MakePtr<BackendBase::AsyncWrapper>(std::move(globalParams), std::move(callback), renderer, worker);
-    auto job = Async::CreateJob(std::move(asyncWorker));
-    return MakePtr<BackendBase::BackendInternal>(std::move(worker), std::move(renderer), std::move(job));
+    return BackendBase::CreateBackend(std::move(globalParams), std::move(holder), std::move(callback),
+                                      std::move(worker), {});
+  }
+
+  Backend::Ptr CreateSystemBackend(Parameters::Accessor::Ptr globalParams, Module::Holder::Ptr holder,
+                                   BackendCallback::Ptr callback, BackendWorker::Ptr worker)
+  {
+    using namespace Parameters::ZXTune::Sound::Backends;
+    auto renderAhead = RENDER_AHEAD_DEFAULT;
+    globalParams->FindValue(RENDER_AHEAD, renderAhead);
+    const Time::Milliseconds duration(std::max<Parameters::IntType>(renderAhead, 0));
+    return BackendBase::CreateBackend(std::move(globalParams), std::move(holder), std::move(callback),
+                                      std::move(worker), duration);
   }
 }  // namespace Sound
 
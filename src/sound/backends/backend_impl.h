@@ -31,6 +31,8 @@ namespace Sound
     virtual void FrameStart(const Module::State& state) = 0;
     virtual void FrameFinish(Chunk buffer) = 0;
     virtual VolumeControl::Ptr GetVolumeControl() const = 0;
+    //! @return duration of sound passed to FrameFinish but not heard yet
+    virtual Time::Milliseconds GetPlaybackDelay() const = 0;
   };
 
   class BackendWorkerFactory
@@ -44,4 +46,10 @@ namespace Sound
 
   Backend::Ptr CreateBackend(Parameters::Accessor::Ptr globalParams, Module::Holder::Ptr holder,
                              BackendCallback::Ptr callback, BackendWorker::Ptr worker);
+
+  //! @brief Backend for real-time playback with optional rendering in advance
+  //! @see Parameters::ZXTune::Sound::Backends::RENDER_AHEAD
+  //! @note Worker's FrameStart is called in rendering thread, so should not depend on output timing
+  Backend::Ptr CreateSystemBackend(Parameters::Accessor::Ptr globalParams, Module::Holder::Ptr holder,
+                                   BackendCallback::Ptr callback, BackendWorker::Ptr worker);
 }  // namespace Sound
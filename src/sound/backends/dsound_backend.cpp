@@ -455,6 +455,11 @@ namespace Sound::DirectSound
       return CreateVolumeControlDelegate(Objects.Volume);
     }
 
+    Time::Milliseconds GetPlaybackDelay() const
+    {
+      return {};
+    }
+
   private:
     struct DSObjects
     {
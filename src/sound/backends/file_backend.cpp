@@ -307,6 +307,11 @@ namespace Sound::File
       return VolumeControl::Ptr();
     }
 
+    Time::Milliseconds GetPlaybackDelay() const override
+    {
+      return {};
+    }
+
   private:
     void SetStream(Receiver::Ptr str)
     {
@@ -53,6 +53,11 @@ namespace Sound
       virtual int snd_pcm_drain (snd_pcm_t *pcm) = 0;
       virtual snd_pcm_sframes_t snd_pcm_writei (snd_pcm_t *pcm, const void *buffer, snd_pcm_uframes_t size) = 0;
       virtual int snd_pcm_set_params (snd_pcm_t *pcm, snd_pcm_format_t format, snd_pcm_access_t access, unsigned int channels, unsigned int rate, int soft_resample, unsigned int latency) = 0;
+      virtual int snd_pcm_delay (snd_pcm_t *pcm, snd_pcm_sframes_t *delayp) = 0;
+      virtual int snd_pcm_wait (snd_pcm_t *pcm, int timeout) = 0;
+      virtual snd_pcm_sframes_t snd_pcm_avail_update (snd_pcm_t *pcm) = 0;
+      virtual int snd_pcm_mmap_begin (snd_pcm_t *pcm, const snd_pcm_channel_area_t **areas, snd_pcm_uframes_t *offset, snd_pcm_uframes_t *frames) = 0;
+      virtual snd_pcm_sframes_t snd_pcm_mmap_commit (snd_pcm_t *pcm, snd_pcm_uframes_t offset, snd_pcm_uframes_t frames) = 0;
       virtual int snd_pcm_format_mask_malloc (snd_pcm_format_mask_t ** ptr) = 0;
       virtual void snd_pcm_format_mask_free (snd_pcm_format_mask_t * obj) = 0;
       virtual int snd_pcm_format_mask_test (const snd_pcm_format_mask_t *mask, snd_pcm_format_t val) = 0;
@@ -61,6 +66,19 @@ namespace Sound
       virtual int snd_pcm_hw_params_any (snd_pcm_t *pcm, snd_pcm_hw_params_t *params) = 0;
       virtual int snd_pcm_hw_params_can_pause (const snd_pcm_hw_params_t *params) = 0;
       virtual void snd_pcm_hw_params_get_format_mask (snd_pcm_hw_params_t *params, snd_pcm_format_mask_t *mask) = 0;
+      virtual int snd_pcm_hw_params_set_access (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_access_t access) = 0;
+      virtual int snd_pcm_hw_params_set_format (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_format_t val) = 0;
+      virtual int snd_pcm_hw_params_set_channels (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, unsigned int val) = 0;
+      virtual int snd_pcm_hw_params_set_rate_near (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, unsigned int *val, int *dir) = 0;
+      virtual int snd_pcm_hw_params_set_period_size_near (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_uframes_t *val, int *dir) = 0;
+      virtual int snd_pcm_hw_params_set_buffer_size_near (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_uframes_t *val) = 0;
+      virtual int snd_pcm_hw_params (snd_pcm_t *pcm, snd_pcm_hw_params_t *params) = 0;
+      virtual int snd_pcm_sw_params_malloc(snd_pcm_sw_params_t ** ptr) = 0;
+      virtual void snd_pcm_sw_params_free (snd_pcm_sw_params_t * obj) = 0;
+      virtual int snd_pcm_sw_params_current (snd_pcm_t *pcm, snd_pcm_sw_params_t *params) = 0;
+      virtual int snd_pcm_sw_params_set_start_threshold (snd_pcm_t *pcm, snd_pcm_sw_params_t *params, snd_pcm_uframes_t val) = 0;
+      virtual int snd_pcm_sw_params_set_avail_min (snd_pcm_t *pcm, snd_pcm_sw_params_t *params, snd_pcm_uframes_t val) = 0;
+      virtual int snd_pcm_sw_params (snd_pcm_t *pcm, snd_pcm_sw_params_t *params) = 0;
       virtual int snd_pcm_info_malloc (snd_pcm_info_t ** ptr) = 0;
       virtual void snd_pcm_info_free (snd_pcm_info_t * obj) = 0;
       virtual void snd_pcm_info_set_device (snd_pcm_info_t *obj, unsigned int val) = 0;
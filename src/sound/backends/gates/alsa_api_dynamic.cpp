@@ -272,6 +272,46 @@ namespace Sound
         return func(pcm, format, access, channels, rate, soft_resample, latency);
       }
       
+      int snd_pcm_delay (snd_pcm_t *pcm, snd_pcm_sframes_t *delayp) override
+      {
+        static const char NAME[] = "snd_pcm_delay";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_sframes_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, delayp);
+      }
+      
+      int snd_pcm_wait (snd_pcm_t *pcm, int timeout) override
+      {
+        static const char NAME[] = "snd_pcm_wait";
+        typedef int ( *FunctionType)(snd_pcm_t *, int);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, timeout);
+      }
+      
+      snd_pcm_sframes_t snd_pcm_avail_update (snd_pcm_t *pcm) override
+      {
+        static const char NAME[] = "snd_pcm_avail_update";
+        typedef snd_pcm_sframes_t ( *FunctionType)(snd_pcm_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm);
+      }
+      
+      int snd_pcm_mmap_begin (snd_pcm_t *pcm, const snd_pcm_channel_area_t **areas, snd_pcm_uframes_t *offset, snd_pcm_uframes_t *frames) override
+      {
+        static const char NAME[] = "snd_pcm_mmap_begin";
+        typedef int ( *FunctionType)(snd_pcm_t *, const snd_pcm_channel_area_t **, snd_pcm_uframes_t *, snd_pcm_uframes_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, areas, offset, frames);
+      }
+      
+      snd_pcm_sframes_t snd_pcm_mmap_commit (snd_pcm_t *pcm, snd_pcm_uframes_t offset, snd_pcm_uframes_t frames) override
+      {
+        static const char NAME[] = "snd_pcm_mmap_commit";
+        typedef snd_pcm_sframes_t ( *FunctionType)(snd_pcm_t *, snd_pcm_uframes_t, snd_pcm_uframes_t);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, offset, frames);
+      }
+      
       int snd_pcm_format_mask_malloc (snd_pcm_format_mask_t ** ptr) override
       {
         static const char NAME[] = "snd_pcm_format_mask_malloc";
@@ -336,6 +376,110 @@ namespace Sound
         return func(params, mask);
       }
       
+      int snd_pcm_hw_params_set_access (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_access_t access) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params_set_access";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *, snd_pcm_access_t);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, access);
+      }
+      
+      int snd_pcm_hw_params_set_format (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_format_t val) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params_set_format";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *, snd_pcm_format_t);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val);
+      }
+      
+      int snd_pcm_hw_params_set_channels (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, unsigned int val) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params_set_channels";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *, unsigned int);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val);
+      }
+      
+      int snd_pcm_hw_params_set_rate_near (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, unsigned int *val, int *dir) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params_set_rate_near";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *, unsigned int *, int *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val, dir);
+      }
+      
+      int snd_pcm_hw_params_set_period_size_near (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_uframes_t *val, int *dir) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params_set_period_size_near";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *, snd_pcm_uframes_t *, int *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val, dir);
+      }
+      
+      int snd_pcm_hw_params_set_buffer_size_near (snd_pcm_t *pcm, snd_pcm_hw_params_t *params, snd_pcm_uframes_t *val) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params_set_buffer_size_near";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *, snd_pcm_uframes_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val);
+      }
+      
+      int snd_pcm_hw_params (snd_pcm_t *pcm, snd_pcm_hw_params_t *params) override
+      {
+        static const char NAME[] = "snd_pcm_hw_params";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_hw_params_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params);
+      }
+      
+      int snd_pcm_sw_params_malloc(snd_pcm_sw_params_t ** ptr) override
+      {
+        static const char NAME[] = "snd_pcm_sw_params_malloc";
+        typedef int ( *FunctionType)(snd_pcm_sw_params_t **);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(ptr);
+      }
+      
+      void snd_pcm_sw_params_free (snd_pcm_sw_params_t * obj) override
+      {
+        static const char NAME[] = "snd_pcm_sw_params_free";
+        typedef void ( *FunctionType)(snd_pcm_sw_params_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(obj);
+      }
+      
+      int snd_pcm_sw_params_current (snd_pcm_t *pcm, snd_pcm_sw_params_t *params) override
+      {
+        static const char NAME[] = "snd_pcm_sw_params_current";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_sw_params_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params);
+      }
+      
+      int snd_pcm_sw_params_set_start_threshold (snd_pcm_t *pcm, snd_pcm_sw_params_t *params, snd_pcm_uframes_t val) override
+      {
+        static const char NAME[] = "snd_pcm_sw_params_set_start_threshold";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_sw_params_t *, snd_pcm_uframes_t);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val);
+      }
+      
+      int snd_pcm_sw_params_set_avail_min (snd_pcm_t *pcm, snd_pcm_sw_params_t *params, snd_pcm_uframes_t val) override
+      {
+        static const char NAME[] = "snd_pcm_sw_params_set_avail_min";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_sw_params_t *, snd_pcm_uframes_t);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params, val);
+      }
+      
+      int snd_pcm_sw_params (snd_pcm_t *pcm, snd_pcm_sw_params_t *params) override
+      {
+        static const char NAME[] = "snd_pcm_sw_params";
+        typedef int ( *FunctionType)(snd_pcm_t *, snd_pcm_sw_params_t *);
+        const FunctionType func = Lib.GetSymbol<FunctionType>(NAME);
+        return func(pcm, params);
+      }
+      
       int snd_pcm_info_malloc (snd_pcm_info_t ** ptr) override
       {
         static const char NAME[] = "snd_pcm_info_malloc";
@@ -43,6 +43,11 @@ namespace Sound::Null
     {
       return VolumeControl::Ptr();
     }
+
+    Time::Milliseconds GetPlaybackDelay() const override
+    {
+      return {};
+    }
   };
 
   class BackendWorkerFactory : public Sound::BackendWorkerFactory
@@ -412,6 +412,11 @@ namespace Sound::OpenAl
       return CreateVolumeControlDelegate(Stat->Vol);
     }
 
+    virtual Time::Milliseconds GetPlaybackDelay() const
+    {
+      return {};
+    }
+
   private:
     const Api::Ptr OalApi;
     const Parameters::Accessor::Ptr Params;
@@ -278,6 +278,11 @@ namespace Sound::Oss
       return VolumeController;
     }
 
+    Time::Milliseconds GetPlaybackDelay() const override
+    {
+      return {};
+    }
+
     void Startup() override
     {
       assert(!MixHandle.Valid() && !DevHandle.Valid());
@@ -90,6 +90,11 @@ namespace Sound::PulseAudio
       return VolumeControl::Ptr();
     }
 
+    Time::Milliseconds GetPlaybackDelay() const override
+    {
+      return {};
+    }
+
   private:
     std::shared_ptr<pa_simple> OpenDevice() const
     {
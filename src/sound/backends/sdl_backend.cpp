@@ -247,6 +247,11 @@ namespace Sound::Sdl
       return VolumeControl::Ptr();
     }
 
+    virtual Time::Milliseconds GetPlaybackDelay() const
+    {
+      return {};
+    }
+
   private:
     void CheckCall(bool ok, Error::LocationRef loc) const
     {
@@ -107,9 +107,14 @@ namespace Sound
     {
       try
       {
-        if (const auto factory = FindFactory(backendId))
+        const auto it = std::find(Factories.begin(), Factories.end(), backendId);
+        if (it != Factories.end())
         {
-          return Sound::CreateBackend(Options, module, std::move(callback), factory->CreateWorker(Options, module));
+          auto worker = it->Factory->CreateWorker(Options, module);
+          // rendering in advance makes sense only for real-time output
+          return (it->Caps & CAP_TYPE_MASK) == CAP_TYPE_SYSTEM
+                     ? Sound::CreateSystemBackend(Options, module, std::move(callback), std::move(worker))
+                     : Sound::CreateBackend(Options, module, std::move(callback), std::move(worker));
         }
         throw MakeFormattedError(THIS_LINE, translate("Backend '%1%' not registered."), backendId);
       }
@@ -121,7 +126,7 @@ namespace Sound
 
     void Register(const String& id, const char* description, uint_t caps, BackendWorkerFactory::Ptr factory) override
     {
-      Factories.push_back(FactoryWithId(id, factory));
+      Factories.push_back(FactoryWithId(id, caps, factory));
       const BackendInformation::Ptr info = MakePtr<StaticBackendInformation>(id, description, caps, Error());
       Infos.push_back(info);
       Dbg("Service(%1%): Registered backend %2%", this, id);
@@ -165,24 +170,20 @@ namespace Sound
       return ids;
     }
 
-    BackendWorkerFactory::Ptr FindFactory(const String& id) const
-    {
-      const std::vector<FactoryWithId>::const_iterator it = std::find(Factories.begin(), Factories.end(), id);
-      return it != Factories.end() ? it->Factory : BackendWorkerFactory::Ptr();
-    }
-
   private:
     const Parameters::Accessor::Ptr Options;
     std::vector<BackendInformation::Ptr> Infos;
     struct FactoryWithId
     {
       String Id;
+      uint_t Caps = 0;
       BackendWorkerFactory::Ptr Factory;
 
       FactoryWithId() {}
 
-      FactoryWithId(String id, BackendWorkerFactory::Ptr factory)
+      FactoryWithId(String id, uint_t caps, BackendWorkerFactory::Ptr factory)
         : Id(std::move(id))
+        , Caps(caps)
         , Factory(std::move(factory))
       {}
 
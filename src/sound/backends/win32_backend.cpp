@@ -460,6 +460,11 @@ namespace Sound::Win32
       return CreateVolumeControlDelegate(Objects.Volume);
     }
 
+    virtual Time::Milliseconds GetPlaybackDelay() const
+    {
+      return {};
+    }
+
   private:
     ::WAVEFORMATEX GetFormat() const
     {
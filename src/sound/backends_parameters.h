@@ -28,6 +28,12 @@ namespace Parameters
         //! @brief Semicolon-delimited backends identifiers order
         const auto ORDER = PREFIX + "order"_id;
 
+        //! Default value
+        const IntType RENDER_AHEAD_DEFAULT = 0;
+        //! @brief Duration of sound in ms rendered in advance for system playback backends
+        //! @note Zero means rendering of each frame right before its output
+        const auto RENDER_AHEAD = PREFIX + "render_ahead"_id;
+
         //! @brief Any file-based backend parameters namespace
         namespace File
         {
@@ -110,6 +116,16 @@ namespace Parameters
           const IntType LATENCY_DEFAULT = 100;
           //! Latency in mS
           const auto LATENCY = PREFIX + "latency"_id;
+
+          //! Default value
+          const IntType MMAP_DEFAULT = 0;
+          //! Use period-driven mmap output with buffer size specified by latency
+          const auto MMAP = PREFIX + "mmap"_id;
+
+          //! Default value
+          const IntType PERIOD_DEFAULT = 10;
+          //! Period size in mS for mmap output
+          const auto PERIOD = PREFIX + "period"_id;
           //@}
         }  // namespace Alsa
 
@@ -9,49 +9,47 @@
  **/
 
 // common includes
+#include <contract.h>
 #include <make_ptr.h>
 // library includes
 #include <sound/impl/fft_analyzer.h>
 // std includes
 #include <algorithm>
 #include <array>
-#include <complex>
+#include <atomic>
+#include <cmath>
 #include <utility>
+#include <vector>
 
 namespace Sound
 {
-  //! @brief %Sound analyzer interface
-  class FFTAnalyzerImpl : public FFTAnalyzer
+  // Ring buffer of mono samples
+  class SoundWindow
   {
-  private:
-    static const std::size_t WindowSizeLog = 10;
-    static const std::size_t WindowSize = 1 << WindowSizeLog;
-
   public:
-    void GetSpectrum(LevelType* result, std::size_t limit) const override
+    explicit SoundWindow(std::size_t size)
+      : Input(size)
+    {}
+
+    std::size_t GetSize() const
     {
-      Produced = 0;
-      FFT(result, limit);
+      return Input.size();
     }
 
-    void FeedSound(const Sample* samples, std::size_t count) override
+    void Feed(const Sample* samples, std::size_t count)
     {
-      const uint_t MAX_PRODUCED_DELTA = 10;
-      if (Produced >= MAX_PRODUCED_DELTA)
+      const auto size = Input.size();
+      if (count >= size)
       {
-        return;
-      }
-      if (count >= WindowSize)
-      {
-        samples = samples + count - WindowSize;
-        count = WindowSize;
+        samples = samples + count - size;
+        count = size;
       }
       for (auto *it = samples, *lim = samples + count; it != lim; ++it)
       {
         static_assert(Sound::Sample::MID == 0, "Incompatible sample type");
         const auto level = (it->Left() + it->Right()) / 2;
         Input[Cursor] = level;
-        if (++Cursor == WindowSize)
+        if (++Cursor == size)
         {
           Cursor = 0;
           ++Produced;
@@ -59,123 +57,352 @@ namespace Sound
       }
     }
 
+    //! @return windows count produced since the last call
+    uint_t GetProduced() const
+    {
+      return Produced;
+    }
+
+    void ResetProduced()
+    {
+      Produced = 0;
+    }
+
+    //! @brief Sequentially calls target for the oldest and for the newest parts of data
+    template<class Target>
+    void Enumerate(Target&& target) const
+    {
+      const auto* const start = Input.data();
+      target(start + Cursor, Input.size() - Cursor);
+      target(start, Cursor);
+    }
+
   private:
-    using Complex = std::complex<float>;
+    std::vector<int_t> Input;
+    std::size_t Cursor = 0;
+    uint_t Produced = 0;
+  };
+
+  /*
+    Real-input FFT of size N computed via complex FFT of size N/2 applied to even samples as real part and odd samples
+    as imaginary one with subsequent splitting.
+
+    Complex part uses structure-of-arrays layout and per-stage contiguous twiddles tables, so compiler is able to
+    vectorize butterflies.
+  */
+  class SpectrumCalculator
+  {
+  public:
+    using LevelType = Analyzer::LevelType;
+
+    explicit SpectrumCalculator(uint_t windowSizeLog)
+      : WindowSizeLog(windowSizeLog)
+      , WindowSize(std::size_t(1) << windowSizeLog)
+      , HalfSize(WindowSize / 2)
+      , Window(WindowSize)
+      , BitRev(HalfSize)
+      , TwiddleRe(HalfSize)
+      , TwiddleIm(HalfSize)
+      , SplitRe(HalfSize)
+      , SplitIm(HalfSize)
+      , Linear(WindowSize)
+      , Re(HalfSize)
+      , Im(HalfSize)
+    {
+      Require(windowSizeLog >= FFTAnalyzer::MIN_WINDOW_SIZE_LOG && windowSizeLog <= FFTAnalyzer::MAX_WINDOW_SIZE_LOG);
+      FillHammingWindow();
+      FillBitReverse();
+      FillTwiddles();
+    }
+
+    std::size_t GetWindowSize() const
+    {
+      return WindowSize;
+    }
+
+    std::size_t GetBinsCount() const
+    {
+      return HalfSize;
+    }
 
-    class Lookup
+    void Calculate(const SoundWindow& input, LevelType* result, std::size_t limit)
     {
-    private:
-      Lookup()
+      LoadInput(input);
+      Transform();
+      const auto toFill = std::min(limit, HalfSize);
+      for (std::size_t idx = 0; idx < toFill; ++idx)
       {
-        for (std::size_t idx = 0; idx < BitRev.size(); ++idx)
-        {
-          BitRev[idx] = ReverseBits(idx);
-        }
-        for (std::size_t idx = 0; idx < Sinus.size(); ++idx)
-        {
-          const auto angle = GetAngle(idx);
-          Sinus[idx] = std::sin(angle);
-        }
-        HammingWindow();
+        result[idx] = ToLevel(GetMagnitude(idx + 1));
       }
+      std::fill_n(result + toFill, limit - toFill, LevelType());
+    }
+
+  private:
+    static float GetAngle(std::size_t idx, std::size_t size)
+    {
+      return 2.0f * 3.14159265358f * idx / size;
+    }
 
-      static float GetAngle(std::size_t idx)
+    // http://dspsystem.narod.ru/add/win/win.html
+    void FillHammingWindow()
+    {
+      const auto a0 = 0.54f;
+      const auto a1 = 0.46f;
+      for (std::size_t idx = 0; idx < WindowSize; ++idx)
       {
-        return 2.0f * 3.14159265358f * idx / WindowSize;
+        Window[idx] = a0 - a1 * std::cos(GetAngle(idx, WindowSize));
       }
+    }
 
-      // http://dspsystem.narod.ru/add/win/win.html
-      void HammingWindow()
+    void FillBitReverse()
+    {
+      const auto bits = WindowSizeLog - 1;
+      for (std::size_t idx = 0; idx < HalfSize; ++idx)
       {
-        const auto a0 = 0.54f;
-        const auto a1 = 0.46f;
-        for (std::size_t idx = 0; idx < Window.size(); ++idx)
+        std::size_t reversed = 0;
+        for (uint_t bit = 0, val = idx; bit < bits; ++bit, val >>= 1)
         {
-          const auto angle = GetAngle(idx);
-          Window[idx] = a0 - a1 * std::cos(angle);
+          reversed = (reversed << 1) | (val & 1);
         }
+        BitRev[idx] = reversed;
       }
+    }
 
-      static const Lookup& Instance()
+    void FillTwiddles()
+    {
+      // stage with butterfly span 'half' uses twiddles at [half - 1, 2 * half - 1)
+      for (std::size_t half = 1; half < HalfSize; half *= 2)
       {
-        static const Lookup INSTANCE;
-        return INSTANCE;
+        for (std::size_t idx = 0; idx < half; ++idx)
+        {
+          const auto angle = GetAngle(idx, 2 * half);
+          TwiddleRe[half - 1 + idx] = std::cos(angle);
+          TwiddleIm[half - 1 + idx] = -std::sin(angle);
+        }
       }
-
-      static uint_t ReverseBits(uint_t val)
+      for (std::size_t idx = 0; idx < HalfSize; ++idx)
       {
-        uint_t reversed = 0;
-        for (uint_t loop = 0; loop < WindowSizeLog; ++loop)
+        const auto angle = GetAngle(idx, WindowSize);
+        SplitRe[idx] = std::cos(angle);
+        SplitIm[idx] = -std::sin(angle);
+      }
+    }
+
+    void LoadInput(const SoundWindow& input)
+    {
+      auto* target = Linear.data();
+      const auto* window = Window.data();
+      input.Enumerate([&target, &window](const int_t* data, std::size_t count) {
+        for (std::size_t idx = 0; idx < count; ++idx)
         {
-          reversed <<= 1;
-          reversed += (val & 1);
-          val >>= 1;
+          target[idx] = window[idx] * data[idx];
         }
-        return reversed;
+        target += count;
+        window += count;
+      });
+      for (std::size_t idx = 0; idx < HalfSize; ++idx)
+      {
+        const auto pos = BitRev[idx];
+        Re[pos] = Linear[2 * idx];
+        Im[pos] = Linear[2 * idx + 1];
       }
+    }
 
-    public:
-      static std::array<Complex, WindowSize> ToComplex(const std::array<int_t, WindowSize>& input, std::size_t offset)
+    void Transform()
+    {
+      float* const re = Re.data();
+      float* const im = Im.data();
+      for (std::size_t half = 1; half < HalfSize; half *= 2)
       {
-        const auto& self = Instance();
-        std::array<Complex, WindowSize> result;
-        for (std::size_t idx = 0; idx < WindowSize; ++idx)
+        const float* const wr = TwiddleRe.data() + half - 1;
+        const float* const wi = TwiddleIm.data() + half - 1;
+        for (std::size_t block = 0; block < HalfSize; block += 2 * half)
         {
-          result[idx] = self.Window[idx] * input[(offset + self.BitRev[idx]) % WindowSize];
+          float* const ar = re + block;
+          float* const ai = im + block;
+          float* const br = ar + half;
+          float* const bi = ai + half;
+          for (std::size_t idx = 0; idx < half; ++idx)
+          {
+            const auto tr = br[idx] * wr[idx] - bi[idx] * wi[idx];
+            const auto ti = br[idx] * wi[idx] + bi[idx] * wr[idx];
+            br[idx] = ar[idx] - tr;
+            bi[idx] = ai[idx] - ti;
+            ar[idx] += tr;
+            ai[idx] += ti;
+          }
         }
-        return result;
       }
+    }
 
-      static Complex Polar(uint_t val)
+    // idx in [1, HalfSize]
+    float GetMagnitude(std::size_t idx) const
+    {
+      if (idx == HalfSize)
       {
-        const auto& sinus = Instance().Sinus;
-        return Complex(sinus[(val + WindowSize / 4) % WindowSize], sinus[val]);
+        return std::abs(Re[0] - Im[0]);
       }
+      const auto mirror = HalfSize - idx;
+      // even = (Z[k] + conj(Z[M-k])) / 2, odd = (Z[k] - conj(Z[M-k])) / 2i
+      const auto evenRe = (Re[idx] + Re[mirror]) / 2;
+      const auto evenIm = (Im[idx] - Im[mirror]) / 2;
+      const auto oddRe = (Im[idx] + Im[mirror]) / 2;
+      const auto oddIm = (Re[mirror] - Re[idx]) / 2;
+      const auto wr = SplitRe[idx];
+      const auto wi = SplitIm[idx];
+      const auto outRe = evenRe + oddRe * wr - oddIm * wi;
+      const auto outIm = evenIm + oddRe * wi + oddIm * wr;
+      return std::sqrt(outRe * outRe + outIm * outIm);
+    }
+
+    static LevelType ToLevel(float magnitude)
+    {
+      const uint_t LIMIT = LevelType::PRECISION;
+      const uint_t raw = magnitude / (256 * 32);
+      return LevelType(std::min(raw, LIMIT), LIMIT);
+    }
+
+  private:
+    const uint_t WindowSizeLog;
+    const std::size_t WindowSize;
+    const std::size_t HalfSize;
+    std::vector<float> Window;
+    std::vector<std::size_t> BitRev;
+    std::vector<float> TwiddleRe;
+    std::vector<float> TwiddleIm;
+    std::vector<float> SplitRe;
+    std::vector<float> SplitIm;
+    // working area
+    std::vector<float> Linear;
+    std::vector<float> Re;
+    std::vector<float> Im;
+  };
 
-    private:
-      std::array<uint_t, WindowSize> BitRev;
-      std::array<float, WindowSize> Sinus;
-      std::array<float, WindowSize> Window;
-    };
+  //! @brief Computes spectrum on demand in GetSpectrum call
+  class FFTAnalyzerImpl : public FFTAnalyzer
+  {
+  public:
+    explicit FFTAnalyzerImpl(uint_t windowSizeLog)
+      : Calculator(windowSizeLog)
+      , Input(Calculator.GetWindowSize())
+    {}
+
+    void GetSpectrum(LevelType* result, std::size_t limit) const override
+    {
+      Input.ResetProduced();
+      Calculator.Calculate(Input, result, limit);
+    }
 
-    void FFT(LevelType* result, std::size_t limit) const
+    void FeedSound(const Sample* samples, std::size_t count) override
     {
-      auto cplx = Lookup::ToComplex(Input, Cursor);
-      uint_t exchanges = 1;
-      uint_t factFact = WindowSize / 2;
-      for (uint_t i = WindowSizeLog; i != 0; --i, exchanges *= 2, factFact /= 2)
+      const uint_t MAX_PRODUCED_DELTA = 10;
+      if (Input.GetProduced() < MAX_PRODUCED_DELTA)
       {
-        for (uint_t j = 0; j != exchanges; ++j)
-        {
-          const auto fact = Lookup::Polar(j * factFact);
-          for (uint_t k = j; k < WindowSize; k += exchanges * 2)
-          {
-            const auto k1 = k + exchanges;
-            const auto tmp = fact * cplx[k1];
-            cplx[k1] = cplx[k] - tmp;
-            cplx[k] += tmp;
-          }
-        }
+        Input.Feed(samples, count);
       }
+    }
+
+  private:
+    mutable SpectrumCalculator Calculator;
+    mutable SoundWindow Input;
+  };
+
+  // Lock-free exchange of the latest value between single writer and single reader
+  template<class T>
+  class TripleBuffer
+  {
+  public:
+    explicit TripleBuffer(const T& init)
+      : Slots{init, init, init}
+    {}
 
-      const std::size_t toFill = std::min(limit, WindowSize / 2);
-      for (std::size_t i = 0; i < toFill; ++i)
+    T& GetBack()
+    {
+      return Slots[Back];
+    }
+
+    void Publish()
+    {
+      Back = Middle.exchange(Back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    const T& GetFront() const
+    {
+      if (Middle.load(std::memory_order_relaxed) & FRESH)
       {
-        const uint_t LIMIT = LevelType::PRECISION;
-        const uint_t raw = std::abs(cplx[i + 1]) / (256 * 32);
-        result[i] = LevelType(std::min(raw, LIMIT), LIMIT);
+        Front = Middle.exchange(Front, std::memory_order_acq_rel) & INDEX_MASK;
       }
-      std::fill_n(result + toFill, limit - toFill, LevelType());
+      return Slots[Front];
     }
 
   private:
-    mutable uint_t Produced = 0;
-    std::array<int_t, WindowSize> Input;
-    std::size_t Cursor = 0;
+    static const uint_t INDEX_MASK = 3;
+    static const uint_t FRESH = 4;
+    std::array<T, 3> Slots;
+    uint_t Back = 0;
+    mutable uint_t Front = 1;
+    mutable std::atomic<uint_t> Middle = 2;
   };
 
-  FFTAnalyzer::Ptr FFTAnalyzer::Create()
+  //! @brief Computes spectrum in FeedSound call and publishes it for GetSpectrum callers without locking
+  class SnapshottingFFTAnalyzer : public FFTAnalyzer
+  {
+  public:
+    explicit SnapshottingFFTAnalyzer(uint_t windowSizeLog)
+      : Calculator(windowSizeLog)
+      , Input(Calculator.GetWindowSize())
+      , Snapshots(std::vector<LevelType>(Calculator.GetBinsCount()))
+    {}
+
+    void GetSpectrum(LevelType* result, std::size_t limit) const override
+    {
+      Requested.store(true, std::memory_order_relaxed);
+      const auto& snapshot = Snapshots.GetFront();
+      const auto toCopy = std::min(limit, snapshot.size());
+      std::copy_n(snapshot.begin(), toCopy, result);
+      std::fill_n(result + toCopy, limit - toCopy, LevelType());
+    }
+
+    void FeedSound(const Sample* samples, std::size_t count) override
+    {
+      // skip calculation if nobody is interested in result for some time
+      const uint_t MAX_IDLE_FEEDS = 10;
+      if (Requested.exchange(false, std::memory_order_relaxed))
+      {
+        IdleFeeds = 0;
+      }
+      else if (IdleFeeds >= MAX_IDLE_FEEDS)
+      {
+        return;
+      }
+      else
+      {
+        ++IdleFeeds;
+      }
+      Input.Feed(samples, count);
+      if (count != 0)
+      {
+        auto& snapshot = Snapshots.GetBack();
+        Calculator.Calculate(Input, snapshot.data(), snapshot.size());
+        Snapshots.Publish();
+      }
+    }
+
+  private:
+    SpectrumCalculator Calculator;
+    SoundWindow Input;
+    TripleBuffer<std::vector<LevelType>> Snapshots;
+    mutable std::atomic<bool> Requested = true;
+    uint_t IdleFeeds = 0;
+  };
+
+  FFTAnalyzer::Ptr FFTAnalyzer::Create(uint_t windowSizeLog)
+  {
+    return MakePtr<FFTAnalyzerImpl>(windowSizeLog);
+  }
+
+  FFTAnalyzer::Ptr FFTAnalyzer::CreateSnapshotting(uint_t windowSizeLog)
   {
-    return MakePtr<FFTAnalyzerImpl>();
+    return MakePtr<SnapshottingFFTAnalyzer>(windowSizeLog);
   }
 }  // namespace Sound
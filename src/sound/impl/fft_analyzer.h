@@ -26,6 +26,16 @@ namespace Sound
     // TODO: use std::span when available
     virtual void FeedSound(const Sample* samples, std::size_t count) = 0;
 
-    static Ptr Create();
+    //! Supported range of analyzed window size in samples (binary logarithm)
+    static const uint_t MIN_WINDOW_SIZE_LOG = 4;
+    static const uint_t MAX_WINDOW_SIZE_LOG = 16;
+    static const uint_t DEFAULT_WINDOW_SIZE_LOG = 10;
+
+    //! @brief Creates analyzer calculating spectrum in GetSpectrum call
+    static Ptr Create(uint_t windowSizeLog = DEFAULT_WINDOW_SIZE_LOG);
+
+    //! @brief Creates analyzer calculating spectrum in FeedSound call (e.g. in rendering thread)
+    //! @note Result is published to single GetSpectrum caller thread without locking
+    static Ptr CreateSnapshotting(uint_t windowSizeLog = DEFAULT_WINDOW_SIZE_LOG);
   };
 }  // namespace Sound
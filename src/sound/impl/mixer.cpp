@@ -45,6 +45,11 @@ namespace Sound
       return Core.Mix(in);
     }
 
+    void ApplyData(const typename Base::InBlockType& in, std::size_t count, Sample* out) const override
+    {
+      Core.Mix(in, count, out);
+    }
+
     void SetMatrix(const typename Base::Matrix& data) override
     {
       if (std::any_of(data.begin(), data.end(), [](Gain gain) { return !gain.IsNormalized(); }))
@@ -13,6 +13,8 @@
 // library includes
 #include <sound/gain.h>
 #include <sound/multichannel_sample.h>
+// std includes
+#include <algorithm>
 
 namespace Sound
 {
@@ -52,6 +54,37 @@ namespace Sound
       return Sample(out[0].Integer(), out[1].Integer());
     }
 
+    // Channel-major mixing of small blocks, vectorizable by compiler
+    void Mix(const std::array<const Sample::Type*, ChannelsCount>& in, std::size_t count, Sample* out) const
+    {
+      static_assert(Sample::CHANNELS == 2, "Incompatible sound channels count");
+      int_t left[BLOCK_SIZE];
+      int_t right[BLOCK_SIZE];
+      for (std::size_t done = 0; done < count;)
+      {
+        const std::size_t todo = std::min(count - done, BLOCK_SIZE);
+        std::fill_n(left, todo, 0);
+        std::fill_n(right, todo, 0);
+        for (uint_t inChan = 0; inChan != ChannelsCount; ++inChan)
+        {
+          const Sample::Type* const src = in[inChan] + done;
+          const int_t leftCoeff = Matrix[inChan][0].Raw();
+          const int_t rightCoeff = Matrix[inChan][1].Raw();
+          for (std::size_t idx = 0; idx != todo; ++idx)
+          {
+            const int_t val = src[idx];
+            left[idx] += leftCoeff * val;
+            right[idx] += rightCoeff * val;
+          }
+        }
+        for (std::size_t idx = 0; idx != todo; ++idx)
+        {
+          out[done + idx] = Sample(left[idx] / PRECISION, right[idx] / PRECISION);
+        }
+        done += todo;
+      }
+    }
+
     void SetMatrix(const MatrixType& matrix)
     {
       for (uint_t inChan = 0; inChan != ChannelsCount; ++inChan)
@@ -65,6 +98,7 @@ namespace Sound
 
   private:
     static const int_t PRECISION = 256;
+    static constexpr std::size_t BLOCK_SIZE = 256;
     typedef Math::FixedPoint<int_t, PRECISION> Coeff;
     typedef std::array<Coeff, Sample::CHANNELS> CoeffRow;
     typedef std::array<CoeffRow, ChannelsCount> CoeffMatrix;
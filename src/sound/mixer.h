@@ -20,10 +20,26 @@ namespace Sound
   {
   public:
     typedef typename MultichannelSample<Channels>::Type InDataType;
+    typedef std::array<const Sample::Type*, Channels> InBlockType;
     typedef std::shared_ptr<const FixedChannelsMixer<Channels> > Ptr;
     virtual ~FixedChannelsMixer() = default;
 
     virtual Sample ApplyData(const InDataType& in) const = 0;
+
+    //! @brief Mixes channel-major data
+    //! @param in per-channel runs of @p count samples
+    virtual void ApplyData(const InBlockType& in, std::size_t count, Sample* out) const
+    {
+      InDataType sample;
+      for (std::size_t idx = 0; idx != count; ++idx)
+      {
+        for (uint_t chan = 0; chan != Channels; ++chan)
+        {
+          sample[chan] = in[chan][idx];
+        }
+        out[idx] = ApplyData(sample);
+      }
+    }
   };
 
   typedef FixedChannelsMixer<1> OneChannelMixer;
@@ -61,6 +61,16 @@ namespace Parameters
       const auto FADEOUT = PREFIX + "fadeout"_id;
       //@}
 
+      //@{
+      //! @name Crossfade of sequentially played modules in milliseconds
+      const IntType CROSSFADE_PRECISION = 1000;
+
+      //! Default value- gapless transition
+      const IntType CROSSFADE_DEFAULT = 0;
+      //! Parameter name
+      const auto CROSSFADE = PREFIX + "crossfade"_id;
+      //@}
+
       //@{
       //! @name Gain in percents
       const IntType GAIN_PRECISION = 100;
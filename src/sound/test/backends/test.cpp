@@ -0,0 +1,577 @@
+/**
+ *
+ * @file
+ *
+ * @brief  Backend base implementation test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <make_ptr.h>
+#include <module/players/pipeline.h>
+#include <parameters/container.h>
+#include <sound/backends/backend_impl.h>
+#include <sound/backends_parameters.h>
+#include <sound/loop.h>
+#include <sound/sound_parameters.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  void Test(const std::string& msg, bool val)
+  {
+    if (val)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << std::endl;
+      throw 1;
+    }
+  }
+
+  template<class T>
+  void Test(const std::string& msg, T result, T reference)
+  {
+    if (result == reference)
+    {
+      std::cout << "Passed test for " << msg << std::endl;
+    }
+    else
+    {
+      std::cout << "Failed test for " << msg << " (got: " << result << " expected: " << reference << ")" << std::endl;
+      throw 1;
+    }
+  }
+
+  const uint_t FRAME_DURATION_MS = 20;
+
+  typedef std::chrono::steady_clock Clock;
+
+  class SyntheticState : public Module::State
+  {
+  public:
+    Time::AtMillisecond At() const override
+    {
+      return Time::AtMillisecond(Frame * FRAME_DURATION_MS);
+    }
+
+    Time::Milliseconds Total() const override
+    {
+      return Time::Milliseconds(Done * FRAME_DURATION_MS);
+    }
+
+    uint_t LoopCount() const override
+    {
+      return 0;
+    }
+
+    std::atomic<uint_t> Frame = {0};
+    std::atomic<uint_t> Done = {0};
+  };
+
+  // Produces unique non-silent sound for each frame of each module, optionally stalling periodically
+  class SyntheticRenderer : public Module::Renderer
+  {
+  public:
+    SyntheticRenderer(uint_t seed, uint_t frames, uint_t stallPeriod, uint_t stallMs, uint_t samplerate)
+      : Seed(seed)
+      , Frames(frames)
+      , StallPeriod(stallPeriod)
+      , StallDuration(stallMs)
+      , FrameSamples(samplerate * FRAME_DURATION_MS / 1000)
+      , State(std::make_shared<SyntheticState>())
+    {}
+
+    Module::State::Ptr GetState() const override
+    {
+      return State;
+    }
+
+    Sound::Chunk Render(const Sound::LoopParameters& /*looped*/) override
+    {
+      const uint_t frame = State->Frame;
+      if (frame >= Frames)
+      {
+        return {};
+      }
+      if (StallPeriod && frame % StallPeriod == StallPeriod - 1)
+      {
+        std::this_thread::sleep_for(StallDuration);
+      }
+      Sound::Chunk result(FrameSamples);
+      for (std::size_t idx = 0; idx != FrameSamples; ++idx)
+      {
+        const auto val = static_cast<Sound::Sample::Type>((Seed * 7919 + frame * 131 + idx * 17) % 20000);
+        result[idx] = Sound::Sample(val, static_cast<Sound::Sample::Type>(-val));
+      }
+      ++State->Frame;
+      ++State->Done;
+      return result;
+    }
+
+    void Reset() override
+    {
+      State->Frame = 0;
+    }
+
+    void SetPosition(Time::AtMillisecond position) override
+    {
+      State->Frame = position.Get() / FRAME_DURATION_MS;
+    }
+
+  private:
+    const uint_t Seed;
+    const uint_t Frames;
+    const uint_t StallPeriod;
+    const std::chrono::milliseconds StallDuration;
+    const std::size_t FrameSamples;
+    const std::shared_ptr<SyntheticState> State;
+  };
+
+  class SyntheticInformation : public Module::Information
+  {
+  public:
+    explicit SyntheticInformation(uint_t frames)
+      : Frames(frames)
+    {}
+
+    Time::Milliseconds Duration() const override
+    {
+      return Time::Milliseconds(Frames * FRAME_DURATION_MS);
+    }
+
+    Time::Milliseconds LoopDuration() const override
+    {
+      return Duration();
+    }
+
+  private:
+    const uint_t Frames;
+  };
+
+  class SyntheticHolder : public Module::Holder
+  {
+  public:
+    SyntheticHolder(uint_t seed, uint_t frames, uint_t stallPeriod = 0, uint_t stallMs = 0)
+      : Seed(seed)
+      , Frames(frames)
+      , StallPeriod(stallPeriod)
+      , StallMs(stallMs)
+    {}
+
+    Module::Information::Ptr GetModuleInformation() const override
+    {
+      return MakePtr<SyntheticInformation>(Frames);
+    }
+
+    Parameters::Accessor::Ptr GetModuleProperties() const override
+    {
+      return Parameters::Container::Create();
+    }
+
+    Module::Renderer::Ptr CreateRenderer(uint_t samplerate, Parameters::Accessor::Ptr /*params*/) const override
+    {
+      return MakePtr<SyntheticRenderer>(Seed, Frames, StallPeriod, StallMs, samplerate);
+    }
+
+  private:
+    const uint_t Seed;
+    const uint_t Frames;
+    const uint_t StallPeriod;
+    const uint_t StallMs;
+  };
+
+  /*
+    Instant output by default. Real-time device plays sound at specified samplerate keeping up to DEVICE_LATENCY queued,
+    so output is blocked while queue is full and underrun happens if the next portion comes after the queue is drained.
+  */
+  class Device : public Sound::BackendWorker
+  {
+  public:
+    explicit Device(uint_t realtimeSamplerate = 0)
+      : Samplerate(realtimeSamplerate)
+    {}
+
+    void Startup() override
+    {
+      Started = false;
+    }
+
+    void Shutdown() override {}
+
+    void Pause() override
+    {
+      Started = false;
+    }
+
+    void Resume() override {}
+
+    void FrameStart(const Module::State& /*state*/) override {}
+
+    void FrameFinish(Sound::Chunk buffer) override
+    {
+      const auto now = Clock::now();
+      if (Samplerate)
+      {
+        if (Started && now > QueuedEnd)
+        {
+          ++Underruns;
+        }
+        Started = true;
+        QueuedEnd = std::max(now, QueuedEnd) + std::chrono::microseconds(buffer.size() * 1000000ull / Samplerate);
+      }
+      {
+        const std::lock_guard<std::mutex> lock(Guard);
+        Arrivals.emplace_back(Output.size(), now);
+        Output.insert(Output.end(), buffer.begin(), buffer.end());
+        PlaybackThread = std::this_thread::get_id();
+      }
+      if (Samplerate)
+      {
+        std::this_thread::sleep_until(QueuedEnd - DEVICE_LATENCY);
+      }
+    }
+
+    Sound::VolumeControl::Ptr GetVolumeControl() const override
+    {
+      return {};
+    }
+
+    Time::Milliseconds GetPlaybackDelay() const override
+    {
+      return {};
+    }
+
+    std::size_t GetSamples() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Output.size();
+    }
+
+    std::vector<Sound::Sample> GetOutput() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Output;
+    }
+
+    //! @return Time when specified sample was passed to output
+    Clock::time_point GetArrival(std::size_t sample) const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      const auto it = std::upper_bound(Arrivals.begin(), Arrivals.end(), sample,
+                                       [](std::size_t smp, const Arrival& arr) { return smp < arr.first; });
+      return it == Arrivals.begin() ? Clock::time_point() : std::prev(it)->second;
+    }
+
+    std::thread::id GetPlaybackThread() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return PlaybackThread;
+    }
+
+    uint_t GetUnderruns() const
+    {
+      return Underruns;
+    }
+
+  private:
+    static constexpr std::chrono::milliseconds DEVICE_LATENCY{100};
+    typedef std::pair<std::size_t, Clock::time_point> Arrival;
+
+    const uint_t Samplerate;
+    // playback thread only
+    bool Started = false;
+    Clock::time_point QueuedEnd;
+    std::atomic<uint_t> Underruns = {0};
+    mutable std::mutex Guard;
+    std::vector<Sound::Sample> Output;
+    std::vector<Arrival> Arrivals;
+    std::thread::id PlaybackThread;
+  };
+
+  class Callback : public Sound::BackendCallback
+  {
+  public:
+    explicit Callback(const Device& dev)
+      : Dev(dev)
+    {}
+
+    void OnStart() override {}
+
+    void OnFrame(const Module::State& state) override
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Frames.push_back({std::this_thread::get_id(), state.At().Get(), Dev.GetSamples()});
+    }
+
+    void OnStop() override {}
+
+    void OnPause() override {}
+
+    void OnResume() override {}
+
+    void OnFinish() override
+    {
+      ++Finishes;
+    }
+
+    void OnTransition() override
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      Transitions.push_back(Dev.GetSamples());
+    }
+
+    std::vector<std::size_t> GetTransitions() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Transitions;
+    }
+
+    struct Frame
+    {
+      std::thread::id Thread;
+      uint_t PositionMs;
+      // already passed to output
+      std::size_t Samples;
+    };
+
+    std::vector<Frame> GetFrames() const
+    {
+      const std::lock_guard<std::mutex> lock(Guard);
+      return Frames;
+    }
+
+    std::atomic<uint_t> Finishes = {0};
+
+  private:
+    const Device& Dev;
+    mutable std::mutex Guard;
+    std::vector<std::size_t> Transitions;
+    std::vector<Frame> Frames;
+  };
+
+  std::vector<Sound::Sample> Reference(const Module::Holder& holder, Parameters::Accessor::Ptr params)
+  {
+    const auto renderer = Module::CreatePipelinedRenderer(holder, std::move(params));
+    const Sound::LoopParameters noLoop;
+    std::vector<Sound::Sample> result;
+    for (auto chunk = renderer->Render(noLoop); !chunk.empty(); chunk = renderer->Render(noLoop))
+    {
+      result.insert(result.end(), chunk.begin(), chunk.end());
+    }
+    return result;
+  }
+
+  std::vector<Sound::Sample> Concat(std::vector<Sound::Sample> lh, const std::vector<Sound::Sample>& rh)
+  {
+    lh.insert(lh.end(), rh.begin(), rh.end());
+    return lh;
+  }
+
+  struct Playback
+  {
+    Playback(Parameters::Accessor::Ptr params, Module::Holder::Ptr holder, uint_t realtimeSamplerate = 0)
+      : Dev(std::make_shared<Device>(realtimeSamplerate))
+      , Cb(std::make_shared<Callback>(*Dev))
+      , Backend(Sound::CreateSystemBackend(std::move(params), std::move(holder), Cb, Dev))
+    {}
+
+    bool WaitForStop(std::chrono::milliseconds timeout = std::chrono::seconds(10)) const
+    {
+      const auto control = Backend->GetPlaybackControl();
+      for (const auto limit = std::chrono::steady_clock::now() + timeout; std::chrono::steady_clock::now() < limit;)
+      {
+        if (control->GetCurrentState() == Sound::PlaybackControl::STOPPED)
+        {
+          return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      return false;
+    }
+
+    const std::shared_ptr<Device> Dev;
+    const std::shared_ptr<Callback> Cb;
+    const Sound::Backend::Ptr Backend;
+  };
+
+  void TestGapless(Parameters::Accessor::Ptr params)
+  {
+    std::cout << "Test gapless transition" << std::endl;
+    const auto first = MakePtr<SyntheticHolder>(1, 50);
+    const auto second = MakePtr<SyntheticHolder>(2, 30);
+    const auto firstRef = Reference(*first, params);
+    const auto secondRef = Reference(*second, params);
+    Playback pb(params, first);
+    pb.Backend->GetTransitionControl()->SetNext(second);
+    pb.Backend->GetPlaybackControl()->Play();
+    Test("gapless stop", pb.WaitForStop());
+    Test("gapless output", pb.Dev->GetOutput() == Concat(firstRef, secondRef));
+    const auto transitions = pb.Cb->GetTransitions();
+    Test<std::size_t>("gapless transitions", transitions.size(), 1);
+    Test("gapless transition position", transitions.front(), firstRef.size());
+    Test<uint_t>("gapless finish", pb.Cb->Finishes, 1);
+  }
+
+  void TestNextReplaced(Parameters::Accessor::Ptr params)
+  {
+    std::cout << "Test replacing of scheduled module" << std::endl;
+    const auto first = MakePtr<SyntheticHolder>(3, 40);
+    const auto replaced = MakePtr<SyntheticHolder>(4, 30);
+    const auto second = MakePtr<SyntheticHolder>(5, 20);
+    Playback pb(params, first);
+    const auto transition = pb.Backend->GetTransitionControl();
+    transition->SetNext(replaced);
+    transition->SetNext(second);
+    pb.Backend->GetPlaybackControl()->Play();
+    Test("replaced stop", pb.WaitForStop());
+    Test("replaced output", pb.Dev->GetOutput() == Concat(Reference(*first, params), Reference(*second, params)));
+    Test<std::size_t>("replaced transitions", pb.Cb->GetTransitions().size(), 1);
+  }
+
+  void TestNextCancelled(Parameters::Accessor::Ptr params)
+  {
+    std::cout << "Test cancelling of scheduled module" << std::endl;
+    const auto first = MakePtr<SyntheticHolder>(6, 40);
+    Playback pb(params, first);
+    const auto transition = pb.Backend->GetTransitionControl();
+    transition->SetNext(MakePtr<SyntheticHolder>(7, 30));
+    transition->SetNext({});
+    pb.Backend->GetPlaybackControl()->Play();
+    Test("cancelled stop", pb.WaitForStop());
+    Test("cancelled output", pb.Dev->GetOutput() == Reference(*first, params));
+    Test<std::size_t>("cancelled transitions", pb.Cb->GetTransitions().size(), 0);
+  }
+
+  void TestCrossfade()
+  {
+    std::cout << "Test crossfade" << std::endl;
+    const auto params = Parameters::Container::Create();
+    params->SetValue(Parameters::ZXTune::Sound::CROSSFADE, 200);
+    const auto first = MakePtr<SyntheticHolder>(8, 50);
+    const auto second = MakePtr<SyntheticHolder>(9, 30);
+    const auto firstRef = Reference(*first, params);
+    const auto secondRef = Reference(*second, params);
+    Playback pb(params, first);
+    pb.Backend->GetTransitionControl()->SetNext(second);
+    pb.Backend->GetPlaybackControl()->Play();
+    Test("crossfade stop", pb.WaitForStop());
+    const auto output = pb.Dev->GetOutput();
+    const std::size_t overlap = firstRef.size() * 200 / (50 * FRAME_DURATION_MS);
+    Test("crossfade duration", output.size(), firstRef.size() + secondRef.size() - overlap);
+    const auto fadeStart = firstRef.size() - overlap;
+    Test("crossfade head", std::equal(firstRef.begin(), firstRef.begin() + fadeStart, output.begin()));
+    Test("crossfade tail", std::equal(secondRef.begin() + overlap, secondRef.end(), output.begin() + firstRef.size()));
+  }
+
+  Parameters::Accessor::Ptr RenderAhead(uint_t ms)
+  {
+    const auto params = Parameters::Container::Create();
+    params->SetValue(Parameters::ZXTune::Sound::Backends::RENDER_AHEAD, ms);
+    return params;
+  }
+
+  void TestRenderAheadFrames()
+  {
+    std::cout << "Test frames reporting with render-ahead" << std::endl;
+    const auto params = RenderAhead(1000);
+    const auto first = MakePtr<SyntheticHolder>(10, 50);
+    const auto second = MakePtr<SyntheticHolder>(11, 30);
+    const auto firstRef = Reference(*first, params);
+    Playback pb(params, first);
+    pb.Backend->GetTransitionControl()->SetNext(second);
+    pb.Backend->GetPlaybackControl()->Play();
+    Test("render-ahead stop", pb.WaitForStop());
+    Test("render-ahead output", pb.Dev->GetOutput() == Concat(firstRef, Reference(*second, params)));
+    const auto transitions = pb.Cb->GetTransitions();
+    Test<std::size_t>("render-ahead transitions", transitions.size(), 1);
+    Test("render-ahead transition position", transitions.front(), firstRef.size());
+    const auto frames = pb.Cb->GetFrames();
+    // including final empty one
+    Test<std::size_t>("render-ahead frames", frames.size(), 81);
+    const auto thread = pb.Dev->GetPlaybackThread();
+    const auto samplerate = Parameters::ZXTune::Sound::FREQUENCY_DEFAULT;
+    for (const auto& frame : frames)
+    {
+      if (frame.Thread != thread)
+      {
+        Test("frame reported from playback thread", false);
+      }
+      if (frame.Samples < firstRef.size() && frame.PositionMs * samplerate / 1000 != frame.Samples)
+      {
+        Test<std::size_t>("frame position matches output", frame.PositionMs * samplerate / 1000, frame.Samples);
+      }
+    }
+  }
+
+  uint_t PlayRealtime(Parameters::Accessor::Ptr params, Module::Holder::Ptr holder, const std::string& msg)
+  {
+    const auto ref = Reference(*holder, params);
+    Playback pb(params, holder, Parameters::ZXTune::Sound::FREQUENCY_DEFAULT);
+    pb.Backend->GetPlaybackControl()->Play();
+    Test(msg + " stop", pb.WaitForStop());
+    Test(msg + " output", pb.Dev->GetOutput() == ref);
+    return pb.Dev->GetUnderruns();
+  }
+
+  void TestUnderruns()
+  {
+    std::cout << "Test device underruns with stalling renderer" << std::endl;
+    // 300ms stall every second of sound, average rendering is faster than real-time
+    const auto holder = MakePtr<SyntheticHolder>(12, 150, 50, 300);
+    Test("underruns without render-ahead", PlayRealtime(Parameters::Container::Create(), holder, "direct") != 0);
+    Test<uint_t>("underruns with render-ahead", PlayRealtime(RenderAhead(1000), holder, "render-ahead"), 0);
+  }
+
+  void TestSeekLatency()
+  {
+    std::cout << "Test seek latency with render-ahead" << std::endl;
+    const auto params = RenderAhead(1000);
+    const auto holder = MakePtr<SyntheticHolder>(13, 500);
+    const auto ref = Reference(*holder, params);
+    Playback pb(params, holder, Parameters::ZXTune::Sound::FREQUENCY_DEFAULT);
+    const auto control = pb.Backend->GetPlaybackControl();
+    control->Play();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const auto seekTime = Clock::now();
+    control->SetPosition(Time::AtMillisecond(400 * FRAME_DURATION_MS));
+    Test("seek stop", pb.WaitForStop());
+    const auto output = pb.Dev->GetOutput();
+    const std::size_t frameSamples = ref.size() / 500;
+    const auto target = ref.begin() + 400 * frameSamples;
+    const auto pos = std::search(output.begin(), output.end(), target, target + frameSamples);
+    Test("seek target found", pos != output.end());
+    Test("seek tail", std::equal(pos, output.end(), target, ref.end()));
+    const auto latency = pb.Dev->GetArrival(pos - output.begin()) - seekTime;
+    Test("seek latency", latency < std::chrono::milliseconds(300));
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    const auto params = Parameters::Container::Create();
+    TestGapless(params);
+    TestNextReplaced(params);
+    TestNextCancelled(params);
+    TestCrossfade();
+    TestRenderAheadFrames();
+    TestUnderruns();
+    TestSeekLatency();
+  }
+  catch (int code)
+  {
+    return code;
+  }
+}
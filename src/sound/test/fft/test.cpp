@@ -0,0 +1,112 @@
+/**
+ *
+ * @file
+ *
+ * @brief  FFT analyzer test
+ *
+ * @author vitamin.caig@gmail.com
+ *
+ **/
+
+#include <error_tools.h>
+#include <math/numeric.h>
+#include <sound/impl/fft_analyzer.h>
+
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <vector>
+
+#define FILE_TAG 4A3F0E52
+
+namespace Sound
+{
+  using LevelType = Analyzer::LevelType;
+
+  const double PI = 3.14159265358979;
+
+  std::vector<Sample> MakeSignal(std::size_t size, std::size_t period1, std::size_t period2)
+  {
+    std::vector<Sample> result(size);
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+      const auto left = 16000 * std::sin(2 * PI * idx / period1);
+      const auto right = 8000 * std::cos(2 * PI * idx / period2) + ((idx * 7919) % 2048) - 1024;
+      result[idx] = Sample(static_cast<Sample::Type>(left), static_cast<Sample::Type>(right));
+    }
+    return result;
+  }
+
+  // straightforward DFT of the last windowSize samples
+  std::vector<uint_t> CalculateReference(const std::vector<Sample>& input, std::size_t windowSize)
+  {
+    const auto* const start = input.data() + input.size() - windowSize;
+    std::vector<uint_t> result(windowSize / 2);
+    for (std::size_t bin = 1; bin <= windowSize / 2; ++bin)
+    {
+      std::complex<double> sum;
+      for (std::size_t idx = 0; idx < windowSize; ++idx)
+      {
+        const auto level = (start[idx].Left() + start[idx].Right()) / 2;
+        const auto window = 0.54 - 0.46 * std::cos(2 * PI * idx / windowSize);
+        sum += std::polar(window * level, -2 * PI * bin * idx / windowSize);
+      }
+      const uint_t raw = std::abs(sum) / (256 * 32);
+      result[bin - 1] = std::min<uint_t>(raw, LevelType::PRECISION);
+    }
+    return result;
+  }
+
+  void Check(const LevelType* levels, const std::vector<uint_t>& reference, std::size_t limit)
+  {
+    for (std::size_t idx = 0; idx < limit; ++idx)
+    {
+      const uint_t ref = idx < reference.size() ? reference[idx] : 0;
+      const uint_t val = levels[idx].Raw();
+      // tolerate rounding on integer boundaries
+      if (Math::Absolute(int_t(val) - int_t(ref)) > 1)
+      {
+        throw MakeFormattedError(THIS_LINE, "Level[%1%]=%2% while expected=%3%", idx, val, ref);
+      }
+    }
+  }
+
+  void TestAnalyzer(const String& name, FFTAnalyzer& analyzer, uint_t windowSizeLog)
+  {
+    std::cout << "Test for " << name << " analyzer with window " << (1 << windowSizeLog) << ": ";
+    const std::size_t windowSize = std::size_t(1) << windowSizeLog;
+    // feed unaligned to window size in several parts
+    const auto signal = MakeSignal(windowSize * 3 + 117, 37, 11);
+    const std::size_t part = signal.size() / 4;
+    analyzer.FeedSound(signal.data(), part);
+    analyzer.FeedSound(signal.data() + part, signal.size() - part);
+    const auto reference = CalculateReference(signal, windowSize);
+    const auto limit = windowSize / 2 + 10;
+    std::vector<LevelType> levels(limit);
+    analyzer.GetSpectrum(levels.data(), levels.size());
+    Check(levels.data(), reference, levels.size());
+    // truncated result
+    analyzer.GetSpectrum(levels.data(), 5);
+    Check(levels.data(), reference, 5);
+    std::cout << "passed" << std::endl;
+  }
+}  // namespace Sound
+
+int main()
+{
+  using namespace Sound;
+  try
+  {
+    for (uint_t sizeLog = FFTAnalyzer::MIN_WINDOW_SIZE_LOG; sizeLog <= 12; ++sizeLog)
+    {
+      TestAnalyzer("on-demand", *FFTAnalyzer::Create(sizeLog), sizeLog);
+      TestAnalyzer("snapshotting", *FFTAnalyzer::CreateSnapshotting(sizeLog), sizeLog);
+    }
+    std::cout << " Succeed!" << std::endl;
+  }
+  catch (const Error& e)
+  {
+    std::cerr << e.ToString();
+    return 1;
+  }
+}